@@ -10,12 +10,10 @@
 #include <AsyncTCP.h>
 // Библиотека позволяет устанавливать постоянное соединение между сервером и клиентом, что делает возможным двустороннюю передачу данных в реальном времени.
 #include <WebSocketsServer.h> 
-// Библиотека используется для работы с JSON (JavaScript Object Notation) данными.
-#include <ArduinoJson.h>
 #include <Arduino.h>
 // Библиотека предоставляет функции для преобразования изображений между различными форматами.
 #include "img_converters.h"
-// Документ хранящий код HTML странички.
+// Документ хранящий HTML страничку, сжатую gzip (генерируется из HomePage.html скриптом Python_INMP441/homepage_gzip.py).
 #include "HomePage.h"
 
 
@@ -29,8 +27,49 @@ AsyncWebServer server(80);
 WebSocketsServer webSocket = WebSocketsServer(81);
 
 
-// Переменная отображает состояние кнопки отвечающей за скачивание теплового снимка.
-bool dataset = false;
+// Режимы включает задача сети (webSocketEvent), а выполняет задача записи (Recording_task.h).
+// Режим массового сбора датасета (кнопка "BULK" на веб-страничке, см. Bulk_capture.h).
+volatile bool bulk = false;
+// Метка (папка датасета) записываемых фраз, не длиннее BULK_MAX_LABEL.
+char bulk_label[32 + 1] = "";
+// Адрес компьютера, на котором запущен Python_INMP441/dataset_receiver.py (задаётся на веб-страничке).
+char bulk_host[64] = "";
+uint16_t bulk_port = 5005;
+// Что отправлять приёмнику: PCM фразы (0) или её спектрограмму (FEATURE_FORMAT_Q12 / FEATURE_FORMAT_UINT8,
+// см. Feature_frames.h), и нужен ли вместе с признаками PCM.
+uint8_t bulk_features = 0;
+bool bulk_features_pcm = false;
+// Метку, адрес приёмника и формат задача сети меняет под recording.lock. Задача записи работает с их
+// копией, которую берёт под тем же мьютексом в начале сеанса и перед каждой фразой (bulk_settings_take).
+struct BulkSettings {
+  char label[sizeof(bulk_label)];
+  char host[sizeof(bulk_host)];
+  uint16_t port;
+  uint8_t features;
+  bool features_pcm;
+};
+BulkSettings bulk_settings;
+
+// Режим живой спектрограммы (кнопка "LIVE" на веб-страничке): строка спектрограммы каждые 10 мс.
+volatile bool live = false;
+
+// Выгрузка записей из flash приёмнику (кнопка "EXPORT" на веб-страничке, см. Sample_store.h).
+volatile bool store_export = false;
+
+/** В документе реализлван двоичный протокол сообщений между устройством и веб-страничкой. **/
+#include "Message_protocol.h"
+/** В документе реализлвана очередь кадров для потоковой передачи аудио на веб-страничку. **/
+#include "Audio_streaming.h"
+// Очередь кадров аудиопотока и состояние подключённых клиентов.
+AudioStream audio_stream;
+/** В документе реализлваны сеансы клиентов: очереди запросов записи (кнопка "DATASET") с метками. **/
+#include "Client_sessions.h"
+// Сеансы подключённых клиентов.
+SessionManager sessions;
+/** В документе реализлвана задача записи: микрофон, спектрограмма и flash работают вне loop(). **/
+#include "Recording_task.h"
+// Очереди между задачей сети (loop()) и задачей записи.
+RecordingTask recording;
 
 /** В документе реализлвана функция webSocketEvent для обработки данных 
 полученых через соеденение сокетов. **/
@@ -68,6 +107,74 @@ int16_t i2s_buffer[256]; // промежуточный буфер
 #include <Audio_processing.h>
 /** В документе реализлваны функции для подключения микрофона и записи аудио. **/
 #include <Audio_recording.h>
+/** В документе реализлваны выделение фраз и их передача приёмнику в режиме массового сбора датасета. **/
+#include "Bulk_capture.h"
+
+// Состояние выделения фраз (кольцевой буфер на 1.5 секунды аудио).
+EnergySegmenter segmenter;
+// Номер следующей фразы в сеансе массового сбора.
+uint32_t bulk_sequence = 0;
+// Сеанс массового сбора начат (фразы сохраняются во flash, даже если приёмник недоступен).
+bool bulk_started = false;
+// Спектрограмма фразы в Q12 и она же в uint8 для кадра признаков (режим FEATURES).
+int16_t feature_rows[SPECTROGRAM_FRAMES * POOLED_BINS];
+uint8_t feature_packed[FEATURE_UINT8_PREFIX + SPECTROGRAM_FRAMES * POOLED_BINS];
+
+
+// ===============================
+// Скопировать в bulk_settings метку, адрес приёмника и формат, заданные веб-страничкой.
+// ===============================
+void bulk_settings_take() {
+  task_lock(&recording.lock);
+  memcpy(bulk_settings.label, bulk_label, sizeof(bulk_settings.label));
+  memcpy(bulk_settings.host, bulk_host, sizeof(bulk_settings.host));
+  bulk_settings.port = bulk_port;
+  bulk_settings.features = bulk_features;
+  bulk_settings.features_pcm = bulk_features_pcm;
+  task_unlock(&recording.lock);
+}
+
+
+// ===============================
+// Отправить фразу приёмнику: PCM (заголовок + метка + отсчёты) или кадр признаков
+// (спектрограмма 99 x 41, в 4-8 раз меньше PCM) и, если запрошено, PCM следом.
+// ===============================
+bool bulk_send(const int16_t* clip) {
+  const BulkSettings* b = &bulk_settings;
+  if (b->features == FEATURE_FORMAT_PCM) {
+    return bulk_send_clip(b->label, bulk_sequence, clip, BULK_CLIP_SAMPLES);
+  }
+  int frames;
+  get_spectrogram(clip, BULK_CLIP_SAMPLES, NULL, NULL, feature_rows, SPECTROGRAM_FRAMES, frames);
+  return feature_send(b->label, bulk_sequence, b->features, b->features_pcm ? FEATURE_FLAG_PCM : 0,
+                      feature_rows, frames, POOLED_BINS, feature_packed) &&
+         (!b->features_pcm || bulk_send_clip(b->label, bulk_sequence, clip, BULK_CLIP_SAMPLES));
+}
+
+/** В документе реализлван кольцевой журнал записей во flash и их выгрузка приёмнику. **/
+#include "Sample_store.h"
+
+// Журнал записей во flash.
+SampleStore sample_store;
+
+
+// ===============================
+// Сохранить запись во flash вместе с меткой, временем, уровнем шума и усилением.
+// Отсчёты дописываются по частям задачей записи (store_pump), буфер samples не меняется до конца записи.
+// ===============================
+void store_recording(const int16_t* samples, uint32_t count, const char* label) {
+  SampleMeta meta;
+  meta.label = label[0] != '\0' ? label : "unlabeled";
+  meta.timestamp_ms = millis();
+  meta.noise_floor = store_noise_floor(samples, count);
+  meta.gain = AUDIO_GAIN << 8;
+  if (!store_append(&sample_store, samples, count, &meta)) {
+    Serial.println("Recording is not stored!");
+    return;
+  }
+  // Показываем на веб-страничке кол-во записей во flash (с учётом сохраняемой).
+  recording_post_control(&recording, CTRL_STORE_COUNT, store_count(&sample_store) + 1);
+}
 
 
 // ===============================
@@ -86,6 +193,14 @@ void setup() {
   // Задержка 500 миллисекунд.
   delay(500);
 
+  // Открываем журнал записей во flash (при первом запуске файл журнала создаётся, это занимает время).
+  if (store_begin(&sample_store, STORE_PATH)) {
+    Serial.printf("Sample store: %u records (%u..%u)\n", store_count(&sample_store),
+                  sample_store.oldest, sample_store.next);
+  } else {
+    Serial.println("Sample store is not available!");
+  }
+
 
   // ===============================
   // Подключение к WiFi.
@@ -106,8 +221,19 @@ void setup() {
         + AsyncWebServerRequest *request - указатель на объект, 
           который содержит всю информацию о запросе, поступившем на сервер.**/
   server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
-    // отправить (200 - http код ответа, метод отправки по html, HTML страничка)
-    request -> send(200, "text\html", getHTML());
+    // Если у браузера уже есть эта версия странички, ответить 304 без тела.
+    const AsyncWebHeader* etag = request -> getHeader("If-None-Match");
+    if (etag != nullptr && etag -> value() == HOMEPAGE_ETAG) {
+      request -> send(304);
+      return;
+    }
+    // Страничка отдаётся прямо из flash (200 - http код ответа, тип text/html, сжатые байты и их размер).
+    AsyncWebServerResponse *response = request -> beginResponse(200, "text/html", HOMEPAGE_GZ, HOMEPAGE_GZ_SIZE);
+    response -> addHeader("Content-Encoding", "gzip");
+    response -> addHeader("ETag", HOMEPAGE_ETAG);
+    // no-cache: браузер хранит страничку, но перед использованием сверяет ETag (после прошивки он меняется).
+    response -> addHeader("Cache-Control", "no-cache");
+    request -> send(response);
   });
 
   // Запуск вебсокета.
@@ -118,6 +244,11 @@ void setup() {
 
   // Запуск вебсервера.
   server.begin();
+
+  // Запуск задачи записи (recording_step() в бесконечном цикле).
+  if (!recording_start(&recording, recording_step)) {
+    Serial.println("Recording task is not started!");
+  }
 }
 
 
@@ -129,43 +260,175 @@ void loop() {
     - Отправку данных клиентам, если это необходимо.**/
   webSocket.loop();
 
-  // Если пользователь нажал кнопку "DATASET" на веб-страничке.
-  if (dataset) {
-    // Прописываем WAV-заголовок в буфере wav_buffer.
-    create_wav_header(wav_buffer, DATA_SIZE);
-
-    Serial.println("Recording 1 second...");
-    // Записываем 1 секунду аудио в буфере wav_buffer.
-    record_to_buffer();
-    Serial.println("Done!");
-
-    //  - uint8_t * d_buff: Указатель на исходное тихое аудио.
-    uint8_t* src  = wav_buffer + WAV_HEADER_SIZE;    // исходные данные (ADC-формат 12 бит)
-    //  - uint8_t* s_buff: Указатель для запизи громкого аудио.
-    uint8_t* dest = wav_buffer + WAV_HEADER_SIZE;    // будем конвертировать "на месте"
-    // Функция увеличивает громкость аудио.
-    audio_scale(dest, src, DATA_SIZE);
-    Serial.println("Volume scaled!");
-
-    // Указатель на аудиосигнал преобразуемый в спектрограму.
-    int16_t *pcm16 = (int16_t*)(wav_buffer + WAV_HEADER_SIZE);
-
-    // Вычисляем спектрограмму и отправляем JPEG-изображение на веб-страничку.
-    process_audio_to_spectrogram(pcm16, SAMPLES_COUNT);
-    
-    Serial.println("Spectrogram Done!");
-
-    //  Размер WAV-аудио в байтах.
-    size_t dataLen = WAV_HEADER_SIZE + DATA_SIZE;
-    // Отправляем WAV-аудио на веб-страничку.
-    sendJson(jsonString, doc_tx, "change_img_type", 1);
-    webSocket.broadcastBIN(wav_buffer, dataLen);
-    
-    Serial.printf("WAV (%u bytes) sent via WebSocket!\n", dataLen);
-
-    // Сбрасывает флаг dataset, чтобы не начать запись снова.
-    dataset = false;
+  // Отправляем веб-страничке то, что подготовила задача записи (JPEG, строки спектрограммы, счётчики).
+  RecordEvent event;
+  while (recording_poll(&recording, &event)) {
+    send_record_event(&event);
+  }
+
+  // Если кто-то из пользователей нажал кнопку "DATASET" на веб-страничке и задача записи свободна:
+  // отдаём ей следующий запрос (клиенты по очереди, одинаковые метки разных клиентов - одной записью).
+  recording_dispatch(&recording, &sessions, millis());
+
+  // Отправляем клиентам ожидающие кадры аудиопотока (столько, сколько позволяет их окно подтверждений).
+  // Очередь кадров общая с задачей записи.
+  task_lock(&recording.lock);
+  stream_pump(&audio_stream, stream_send_ws, millis());
+  StreamStats stream_stats;
+  const bool report = stream_report(&audio_stream, millis(), &stream_stats);
+  task_unlock(&recording.lock);
+  // Раз в секунду показываем на веб-страничке скорость потока и задержку очереди.
+  if (report && stream_stats.bytes_per_sec > 0) {
+    Serial.printf("Stream: %u B/s, queue latency %u ms, dropped %u frames\n",
+                  stream_stats.bytes_per_sec, stream_stats.max_latency_ms, stream_stats.dropped);
+    send_stats(stream_stats.bytes_per_sec, stream_stats.max_latency_ms, stream_stats.dropped);
   }
 }
 
 
+// ===============================
+// Запись по запросу DATASET (задача записи).
+// ===============================
+void record_dataset(const RecordCommand* command) {
+  // Предыдущая запись сохраняется из wav_buffer: дописываем её, прежде чем записывать новую.
+  store_flush(&sample_store);
+  // Прописываем WAV-заголовок в буфере wav_buffer.
+  create_wav_header(wav_buffer, DATA_SIZE);
+
+  Serial.printf("Recording 1 second (%s) for clients 0x%02x...\n", command->label, command->recipients);
+  // Записываем 1 секунду аудио в буфере wav_buffer. Каждая порция сразу увеличивается по громкости
+  // и ставится в очередь аудиопотока запросивших клиентов, так что они получают аудио во время записи.
+  record_to_buffer(command->recipients);
+  // Последний кадр записи: веб-страничка собирает WAV из принятых кадров и скачивает его.
+  task_lock(&recording.lock);
+  stream_finish(&audio_stream, millis());
+  task_unlock(&recording.lock);
+  Serial.println("Done!");
+
+  // Указатель на аудиосигнал преобразуемый в спектрограму.
+  int16_t *pcm16 = (int16_t*)(wav_buffer + WAV_HEADER_SIZE);
+
+  // Сохраняем запись во flash: она будет выгружена приёмнику, даже если веб-страничка её не получила.
+  store_recording(pcm16, SAMPLES_COUNT, command->label);
+
+  // Вычисляем спектрограмму и передаём JPEG-изображение задаче сети для запросивших клиентов.
+  process_audio_to_spectrogram(pcm16, SAMPLES_COUNT, command->recipients);
+
+  Serial.println("Spectrogram Done!");
+
+  // Задача сети покажет запросившим клиентам, сколько их запросов ещё ждёт записи, и отдаст следующий запрос.
+  recording_post_done(&recording, command->recipients);
+}
+
+
+// ===============================
+// Один шаг задачи записи: запрос DATASET, порция непрерывных режимов, запись во flash, выгрузка.
+// Вызывается задачей записи в бесконечном цикле (Recording_task.h).
+// ===============================
+void recording_step() {
+  // Дописываем во flash сохраняемую запись (не больше STORE_WRITE_STEP байт за шаг).
+  store_pump(&sample_store);
+
+  // Непрерывные режимы ждут микрофон в i2s_read, без них задача ждёт запрос записи.
+  const bool continuous = bulk || live || store_export || sample_store.exporting;
+  RecordCommand command;
+  if (recording_wait(&recording, &command, continuous ? 0 : 10)) {
+    record_dataset(&command);
+  }
+
+  // Непрерывным режимам (массовый сбор и живая спектрограмма) каждый шаг читает очередную порцию из I2S.
+  size_t chunk_samples = (bulk || live) ? record_chunk() : 0;
+
+  // Если пользователь включил живую спектрограмму (кнопка "LIVE" на веб-страничке).
+  if (live && chunk_samples > 0) {
+    // Каждые FFT_STEP отсчётов на веб-страничку отправляется новая строка спектрограммы.
+    live_spectrogram_push(i2s_buffer, chunk_samples);
+  }
+
+  // Если пользователь включил массовый сбор датасета (кнопка "BULK" на веб-страничке).
+  if (bulk) {
+    // В начале сеанса подключиться к приёмнику. Если он недоступен, фразы только сохраняются во flash
+    // и выгружаются позже (кнопка "EXPORT").
+    if (!bulk_started) {
+      // Прерываем выгрузку: соединение с приёмником нужно массовому сбору.
+      if (sample_store.exporting) {
+        sample_store.exporting = false;
+        bulk_disconnect();
+        recording_post_control(&recording, CTRL_EXPORT_STATE, 0);
+      }
+      bulk_started = true;
+      segmenter_reset(&segmenter);
+      bulk_sequence = 0;
+      recording_post_control(&recording, CTRL_BULK_STATE, 1);
+      bulk_settings_take();
+      Serial.printf("Connecting to receiver %s:%u...\n", bulk_settings.host, bulk_settings.port);
+      if (!bulk_connect(bulk_settings.host, bulk_settings.port)) {
+        Serial.println("Receiver is not available, clips are stored on the device");
+      }
+    }
+
+    // Запись идёт непрерывно: порция уже прочитана и увеличена по громкости (record_chunk).
+    if (chunk_samples > 0) {
+      // Вырезанная фраза записывается на место аудио в wav_buffer, откуда может ещё сохраняться предыдущая.
+      int16_t* clip = (int16_t*)(wav_buffer + WAV_HEADER_SIZE);
+      if (segmenter.clip_pending) {
+        store_flush(&sample_store);
+      }
+      if (segmenter_process(&segmenter, i2s_buffer, chunk_samples, clip)) {
+        // Метку и формат веб-страничка может сменить во время сеанса, адрес приёмника действует до его конца.
+        bulk_settings_take();
+        // Фраза сохраняется во flash независимо от приёмника, скорость записи не зависит от сети.
+        store_recording(clip, BULK_CLIP_SAMPLES, bulk_settings.label);
+        // Отправляем фразу приёмнику (PCM или признаки, см. bulk_send).
+        if (bulk_connected() && !bulk_send(clip)) {
+          Serial.println("Receiver disconnected, clips are stored on the device");
+          bulk_disconnect();
+        }
+        bulk_sequence++;
+        Serial.printf("Clip %u (%s) %s, %u dropped\n", bulk_sequence, bulk_settings.label,
+                      bulk_connected() ? "sent" : "stored", segmenter.dropped);
+        // Показываем на веб-страничке кол-во записанных фраз.
+        recording_post_control(&recording, CTRL_BULK_COUNT, bulk_sequence);
+      }
+    }
+  } else if (bulk_started) {
+    // Пользователь остановил массовый сбор: закрываем соединение с приёмником.
+    bulk_started = false;
+    bulk_disconnect();
+    Serial.printf("Bulk capture stopped: %u clips recorded\n", bulk_sequence);
+  }
+
+  // Если пользователь нажал кнопку "EXPORT" на веб-страничке: выгружаем записи из flash приёмнику.
+  if (store_export) {
+    if (!sample_store.exporting) {
+      // Приёмник отвечает на запрос номером записи, с которой продолжить (после обрыва - первой не полученной).
+      uint8_t resume[4];
+      bulk_settings_take();
+      Serial.printf("Exporting to receiver %s:%u...\n", bulk_settings.host, bulk_settings.port);
+      if (!sample_store.ready || !bulk_connect(bulk_settings.host, bulk_settings.port) ||
+          !bulk_write((const uint8_t*)STORE_EXPORT_REQUEST, 4) || !bulk_read(resume, sizeof(resume), 2000)) {
+        Serial.println("Receiver is not available!");
+        bulk_disconnect();
+        recording_post_control(&recording, CTRL_EXPORT_STATE, 0);
+        store_export = false;
+        return;
+      }
+      store_export_begin(&sample_store, store_get_u32(resume));
+      recording_post_control(&recording, CTRL_EXPORT_STATE, 1);
+    }
+    // Не больше STORE_WRITE_STEP байт за шаг, чтобы между частями проверять запросы записи.
+    const StoreExportState state = store_export_pump(&sample_store, bulk_write);
+    if (state != STORE_EXPORT_SENDING) {
+      Serial.printf("Export %s: %u records sent, %u overwritten before export\n",
+                    state == STORE_EXPORT_DONE ? "done" : "failed", sample_store.exported, sample_store.lost);
+      bulk_disconnect();
+      recording_post_control(&recording, CTRL_EXPORT_STATE, 0);
+      store_export = false;
+    }
+  } else if (sample_store.exporting) {
+    // Пользователь прервал выгрузку: приёмник продолжит с последней целой записи.
+    sample_store.exporting = false;
+    bulk_disconnect();
+    recording_post_control(&recording, CTRL_EXPORT_STATE, 0);
+  }
+}
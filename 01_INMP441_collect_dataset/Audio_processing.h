@@ -7,6 +7,10 @@
 #include <kissfft/kiss_fftr.h>
 #include <kissfft/kiss_fftr.c>
 #include <kissfft/_kiss_fft_guts.h>
+// Потоковое квантование строк спектрограммы в 0..255 (без деления на каждый элемент).
+#include "Spectrogram_quantizer.h"
+// Кадры признаков (спектрограмма в Q12 / uint8) для приёмника датасета.
+#include "Feature_frames.h"
 
 // Configuration
 
@@ -17,6 +21,7 @@
 #define POOLED_BINS ((SPECTRUM_BINS + POOLING_SIZE - 1) / POOLING_SIZE)  // Число частотных бинов FFT для окна длины FFT_N после усреднения/pooling (~41 bins).
 #define EPSILON 1e-6f         // Маленькая константа для числовой стабильности (избежать деления на ноль и лог(0)) при последующей обработке.
 #define AUDIO_LENGTH 16000    // Длина аудио-сигнала в сэмплах: 16000 — одна секунда при частоте 16 kHz.
+#define SPECTROGRAM_FRAMES (1 + (AUDIO_LENGTH - FFT_N) / FFT_STEP)  // Число строк спектрограммы одной секунды (99).
 
 // Global FFT configuration
 kiss_fftr_cfg fft_cfg = NULL;         // Указатель для конфигурации библиотечного real-FFT.
@@ -104,13 +109,19 @@ void get_spectrogram_segment(float *fft_in, float *output) {
 
 // ===============================
 // Основная функция для построения спектрограммы с определением уровня шума.
+// Каждая строка сразу квантуется в 0..255 и записывается в image_out и/или в Q12 в features_out
+// (признаки для приёмника, Feature_frames.h), спектрограмма целиком в float не хранится.
 // Возвращает true, если уровень звука превышает уровень шума.
 //  - const int16_t *pcm: входной буфер PCM-сэмплов (Pulse Code Modulation - Импульсно-кодовая модуляция (ИКМ)).
 //  - size_t sample_count: длина входного буфера в сэмплах
-//  - float **&spec_out: двумерный динамический массив для хранения спектрограммы.
-//  - int &frames_out: выходной параметр, в который функция записывает число временных кадров (строк) в spec_out.
+//  - SpectrogramQuantizer *quantizer: диапазон квантования (сохраняется между вызовами).
+//  - uint8_t *image_out: буфер на max_frames * POOLED_BINS байт для квантованной спектрограммы (или NULL).
+//  - int16_t *features_out: буфер на max_frames * POOLED_BINS значений log10 энергии в Q12 (или NULL).
+//  - int max_frames: наибольшее число строк в image_out и features_out.
+//  - int &frames_out: выходной параметр, в который функция записывает число временных кадров (строк) в image_out.
 // ===============================
-bool get_spectrogram(const int16_t *pcm, size_t sample_count, float **&spec_out, int &frames_out){
+bool get_spectrogram(const int16_t *pcm, size_t sample_count, SpectrogramQuantizer *quantizer,
+                     uint8_t *image_out, int16_t *features_out, int max_frames, int &frames_out){
   /// Инициализируем Быстрое Преобразование Фурье, если это ещё не было сделано.
   if (!fft_cfg) {
     // kiss_fftr_alloc возвращает конфигурацию, которую нужно сохранить и переиспользовать.
@@ -120,15 +131,8 @@ bool get_spectrogram(const int16_t *pcm, size_t sample_count, float **&spec_out,
   }
   
   // Рассчитать количество кадров.
-  frames_out = 1 + (sample_count - FFT_N) / FFT_STEP;
-  
-  // Выделить двухмерный массив для спектрограммы.
-  // spec_out будет указывать на массив указателей на строки (каждая строка = pooled frequency bins)
-  spec_out = new float*[frames_out];
-  for (int i = 0; i < frames_out; i++) {
-    // для каждой строки выделяем массив float длины POOLED_BINS
-    spec_out[i] = new float[POOLED_BINS];
-  }
+  frames_out = sample_count < FFT_N ? 0 : 1 + (sample_count - FFT_N) / FFT_STEP;
+  if (frames_out > max_frames) frames_out = max_frames;
   
   // Рассчитать среднее значение.
   float mean = 0.0f;
@@ -178,17 +182,29 @@ bool get_spectrogram(const int16_t *pcm, size_t sample_count, float **&spec_out,
   // Обрабатываем каждое окно.
   // временный буфер для FFT входа; размер FFT_N (float)
   float fft_in[FFT_N];
+  // строка спектрограммы до квантования
+  float row[POOLED_BINS];
   int frame_idx = 0;
   
   // Проходим по всем сэмплам на которые был разбит аудио сигнал.
-  for (size_t start = 0; start + FFT_N <= sample_count; start += FFT_STEP) {
+  for (size_t start = 0; start + FFT_N <= sample_count && frame_idx < frames_out; start += FFT_STEP) {
     // Нормализуем выборки: вычитаем среднее и делим на максимум
     for (int i = 0; i < FFT_N; i++) {
       fft_in[i] = ((float)pcm[start + i] - mean) / max_val;
     }
     
     // Вычислить сегмент спектрограммы (АЧХ для аудиосэмпла).
-    get_spectrogram_segment(fft_in, spec_out[frame_idx]);
+    get_spectrogram_segment(fft_in, row);
+    // Сразу квантовать строку в 0..255.
+    if (image_out) {
+      quantizer_row_uint8(quantizer, row, POOLED_BINS, image_out + frame_idx * POOLED_BINS);
+    }
+    // Признаки: log10 энергии в Q12 без потери диапазона.
+    if (features_out) {
+      for (int b = 0; b < POOLED_BINS; b++) {
+        features_out[frame_idx * POOLED_BINS + b] = feature_q12(row[b]);
+      }
+    }
     
     // Увеличить индекс кадров.
     frame_idx++;
@@ -206,88 +222,24 @@ bool get_spectrogram(const int16_t *pcm, size_t sample_count, float **&spec_out,
 
 
 
-
-// ===============================
-// Освободить выделенную память под спектрограмму.
-//  - float **spec: двухмерный массив для спектрограммы (каждая строка = pooled frequency bins).
-//  - int frames: число временных кадров (строк) в спектрограмме.
-// ===============================
-void free_spectrogram(float **spec, int frames) {
-  for (int i = 0; i < frames; i++) {
-    delete[] spec[i];
-  }
-  delete[] spec;
-}
-
-
-
-
-// ============================================================
-// Нормализация спектрограммы в диапазон 0..255
-// spec        — исходная спектрограмма (frames x bins)
-// frames      — число строк (временные шаги)
-// bins        — число столбцов (частотные полосы)
-// Возвращает: одномерный uint8_t буфер размером frames*bins
-// ============================================================
-uint8_t* normalize_spectrogram_uint8(float **spec, int frames, int bins) {
-    // Общее количество элементов спектрограммы.
-    int total = frames * bins;
-    // Выделяем память под нормализованную спктрограмму.
-    uint8_t *buf = (uint8_t*) malloc(total); 
-
-    // Инициализируем переменные для поиска минимума и максимума значений по всей спектрограмме.
-    float min_val = 10000;
-    float max_val = -10000;
-
-    // --- 1. Ищем минимальное и максимальное значение в спектрограмме ---
-    for (int f = 0; f < frames; f++) {
-        for (int b = 0; b < bins; b++) {
-            float v = spec[f][b];
-            if (v < min_val) min_val = v;
-            if (v > max_val) max_val = v;
-        }
-    }
-    // Разница между максимумом и минимумом — диапазон значений.
-    float diff = max_val - min_val;
-
-    // --- 2. Защита: если диапазон слишком маленький -> вернуть нули ---
-    if (diff < 1e-12f) {
-        memset(buf, 0, total);
-        return buf;
-    }
-
-    // --- 3. Нормализуем: (value - min) * 255 / (max - min) ---
-    int idx = 0;
-    for (int f = 0; f < frames; f++) {
-        for (int b = 0; b < bins; b++) {
-            float v = spec[f][b];
-            float norm = (v - min_val) / diff;
-            int scaled = (int)(norm * 255.0f + 0.5f);  // округление
-            if (scaled < 0) scaled = 0;
-            if (scaled > 255) scaled = 255;
-            buf[idx++] = (uint8_t)scaled;
-        }
-    }
-
-    return buf;
-}
-
-
-
+// Квантованная спектрограмма последней записи (строки подряд, как ожидает fmt2jpg).
+uint8_t spectrogram_image[SPECTROGRAM_FRAMES * POOLED_BINS];
+// Диапазон квантования записей сохраняется между записями, чтобы яркость снимков датасета была сопоставима.
+SpectrogramQuantizer image_quantizer = {0, 0, 0, QUANT_DECAY_SHIFT, false};
 
 // ===============================
 // Example usage function
 //  - const int16_t *pcm16: Указатель на аудиосигнал преобразуемый в спектрограму.
 //  - size_t sample_count: Размер дискретизоного аудиосигнала (16000 точек).
+//  - uint8_t recipients: маска клиентов, которым отправляется JPEG (запросившие запись).
+// Вызывается задачей записи: JPEG отправляет веб-страничке задача сети (Recording_task.h).
 // ===============================
-void process_audio_to_spectrogram(const int16_t *pcm16, size_t sample_count)
+void process_audio_to_spectrogram(const int16_t *pcm16, size_t sample_count, uint8_t recipients)
 {
-  // Двумерный массив для спектрограммы (каждая строка = pooled frequency bins).
-  float **spec;
   // Сюда функция get_spectrogram() запишет количество временных кадров спектрограммы.
   int frames;
-  // Построить спектрограмму.
-  bool above_noise = get_spectrogram(pcm16, sample_count, spec, frames);
+  // Построить спектрограмму, квантуя строки по мере вычисления.
+  bool above_noise = get_spectrogram(pcm16, sample_count, &image_quantizer, spectrogram_image, NULL, SPECTROGRAM_FRAMES, frames);
   
   // Выводим в UART: размеры спектрограммы, есть ли звук, текущий сглаженный уровень шума.
   Serial.printf("Spectrogram: %d frames x %d bins (pooled)\n", frames, POOLED_BINS);
@@ -298,27 +250,82 @@ void process_audio_to_spectrogram(const int16_t *pcm16, size_t sample_count)
   // Инициализировать переменную для хранение размера буфера содержащего чёрно-белое изображение.
   size_t len_img;
   // Инициализировать буфер под хранение чёрно-белого изображения.
-  uint8_t *buf_img;
-  // Преобразуем спектрограмму (float) в массив 0…255:
-  uint8_t *buf = normalize_spectrogram_uint8(spec, frames, POOLED_BINS);
+  uint8_t *buf_img = NULL;
   // Рассчитываем длину массива с нормализованной спектрограммой.
   size_t len_buf = frames * POOLED_BINS;
 
   // Преобразуем отмасштабированую спектрограму в чёрно-белое JPEG изображение.
-  bool ok_gray = fmt2jpg(buf, len_buf, 41, 99, PIXFORMAT_GRAYSCALE, 80, &buf_img, &len_img);
-  // Если изображение успешно сжато отправить его пользователю на вебстраничку:
+  bool ok_gray = fmt2jpg(spectrogram_image, len_buf, POOLED_BINS, frames, PIXFORMAT_GRAYSCALE, 80, &buf_img, &len_img);
+  // Если изображение успешно сжато, передать его задаче сети для отправки на вебстраничку (сообщение MSG_JPEG).
+  // Буфер JPEG (выделяет fmt2jpg) освободит задача сети после отправки.
   if(ok_gray){
-    sendJson(jsonString, doc_tx, "change_img_type", 0);
-    webSocket.broadcastBIN(buf_img, len_img);
+    recording_post_buffer(&recording, MSG_JPEG, buf_img, len_img, recipients);
+  } else if (buf_img) {
+    free(buf_img);
   }
 
-  // Освобождаем буфер.
-  if (buf) free(buf);
-  if (buf_img) free(buf_img);
-
   // Обнулить оценку уровня шума. Используется для детекции речи/голоса (VAD).
   smoothed_noise_floor = 0.0f;
+}
+
+
+
+
+
+// ============================================================
+// Живая спектрограмма (кнопка "LIVE" на веб-страничке).
+// Отсчёты поступают порциями; каждые FFT_STEP отсчётов считается одна строка спектрограммы по последним FFT_N
+// отсчётам (как в get_spectrogram()) и отправляется веб-страничке сообщением MSG_ROW из POOLED_BINS байт.
+// Без JPEG и без выделения памяти: окно, строка и диапазон яркости хранятся в статических переменных.
+// ============================================================
+int16_t live_window[FFT_N];           // Последние отсчёты (до FFT_N).
+int live_fill = 0;                    // Кол-во отсчётов в live_window.
+// Диапазон яркости 0..255: расширяется сразу, сужается медленно (1/128 за строку).
+SpectrogramQuantizer live_quantizer = {0, 0, 0, QUANT_DECAY_SHIFT, false};
+uint8_t live_row[POOLED_BINS];        // Строка для сообщения MSG_ROW.
 
-  // Освободить выделенную память под спектрограмму.
-  free_spectrogram(spec, frames);
+// ===============================
+// Посчитать строку по окну live_window, перевести её в 0..255 и передать задаче сети для веб-странички.
+// ===============================
+void live_spectrogram_row() {
+  if (!fft_cfg) {
+    fft_cfg = kiss_fftr_alloc(FFT_N, 0, NULL, NULL);
+    init_hamming_window();
+  }
+
+  // Вычитаем постоянную составляющую окна. Нормировка постоянная (на полную шкалу int16),
+  // чтобы громкость соседних строк можно было сравнивать.
+  int32_t sum = 0;
+  for (int i = 0; i < FFT_N; i++) {
+    sum += live_window[i];
+  }
+  const float mean = (float)sum / FFT_N;
+  float fft_in[FFT_N];
+  for (int i = 0; i < FFT_N; i++) {
+    fft_in[i] = ((float)live_window[i] - mean) / 32768.0f;
+  }
+  float row[POOLED_BINS];
+  get_spectrogram_segment(fft_in, row);
+
+  // Диапазон яркости следует за сигналом.
+  quantizer_row_uint8(&live_quantizer, row, POOLED_BINS, live_row);
+  // Если задача сети не успевает, строка отбрасывается: микрофон ждать не может.
+  recording_post_message(&recording, MSG_ROW, live_row, POOLED_BINS, STREAM_ALL_CLIENTS);
+}
+
+// ===============================
+// Передать живой спектрограмме очередную порцию отсчётов (после audio_scale).
+//  - const int16_t *samples: отсчёты.
+//  - size_t count: кол-во отсчётов.
+// ===============================
+void live_spectrogram_push(const int16_t *samples, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    live_window[live_fill++] = samples[i];
+    if (live_fill == FFT_N) {
+      live_spectrogram_row();
+      // Окна перекрываются на FFT_N - FFT_STEP отсчётов.
+      memmove(live_window, live_window + FFT_STEP, (FFT_N - FFT_STEP) * sizeof(int16_t));
+      live_fill = FFT_N - FFT_STEP;
+    }
+  }
 }
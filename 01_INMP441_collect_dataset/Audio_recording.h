@@ -112,11 +112,16 @@ void create_wav_header(uint8_t *header, uint32_t data_size) {
 
 
 
+// Функция увеличивает громкость аудио (реализована ниже).
+void audio_scale(uint8_t * d_buff, uint8_t* s_buff, uint32_t len);
+
 // ===============================
 // Функция в течение RECORD_TIME секунд читает аудиоданные из I2S-интерфейса (микрофон INMP441) и последовательно 
 // записывает их в заранее выделённый буфер wav_buffer, начиная с позиции сразу после WAV-заголовка.
+// Каждая порция сразу увеличивается по громкости и ставится в очередь аудиопотока (Audio_streaming.h).
+//  - uint8_t recipients: маска клиентов, запросивших запись (Client_sessions.h), только им отправляется аудиопоток.
 // ===============================
-void record_to_buffer() {
+void record_to_buffer(uint8_t recipients) {
   // Переменная запоминает сколько байт прочитано последним вызовом i2s_read.
   size_t bytes_read = 0;
 
@@ -128,6 +133,11 @@ void record_to_buffer() {
   // Счётчик, сколько байт всего уже записано в буфер (начинаем с 0).
   size_t bytes_written = 0;
 
+  // Следующий кадр аудиопотока будет первым кадром новой записи.
+  task_lock(&recording.lock);
+  stream_begin(&audio_stream, recipients);
+  task_unlock(&recording.lock);
+
   // Момент времени начала записи аудио с микрофона.
   uint32_t start = millis();
   // Выполняем чтение из I2S до тех пор, пока не истечёт RECORD_TIME секунд.
@@ -148,6 +158,12 @@ void record_to_buffer() {
       if (bytes_written + bytes_read <= DATA_SIZE) {
         // Копируем bytes_read байт из временного буфера i2s_buffer в wav_buffer по указателю write_ptr.
         memcpy(write_ptr, i2s_buffer, bytes_read);
+        // Увеличиваем громкость порции "на месте" и ставим её в очередь аудиопотока
+        // (кадры отправляет и подтверждения принимает loop(), не дожидаясь конца записи).
+        audio_scale(write_ptr, write_ptr, bytes_read);
+        task_lock(&recording.lock);
+        stream_push(&audio_stream, (const int16_t*)write_ptr, bytes_read / BYTES_PER_SAMPLE, 0, millis());
+        task_unlock(&recording.lock);
         // 10) Сдвигаем указатель write_ptr дальше на количество записанных байт, чтобы следующий memcpy записал данные после уже записанных.
         write_ptr += bytes_read;
         // Увеличиваем общий счётчик записанных байт.
@@ -167,6 +183,10 @@ void record_to_buffer() {
 
 
 
+// Усиление audio_scale: 12-битный код I2S становится отсчётом int16, умноженным на 32
+// (старший байт = код * 256 / 2048, младший = 0). Сохраняется вместе с записью (Sample_store.h).
+#define AUDIO_GAIN 32
+
 // ===============================
 // Функция увеличивает громкость аудио.
 //  - uint8_t * d_buff: Указатель на исходное тихое аудио.
@@ -190,4 +210,23 @@ void audio_scale(uint8_t * d_buff, uint8_t* s_buff, uint32_t len)
       // Масштабируем 12-бит (0..4095) в диапазон ~0..511 и записываем младший байт результата.
       d_buff[j++] = dac_value * 256 / 2048;
     }
-}
\ No newline at end of file
+}
+
+
+
+
+
+// ===============================
+// Прочитать одну порцию аудио из I2S в i2s_buffer и увеличить её громкость "на месте".
+// Используется непрерывными режимами (массовый сбор датасета, живая спектрограмма).
+// Возвращает кол-во прочитанных отсчётов (0 при ошибке чтения).
+// ===============================
+size_t record_chunk() {
+  size_t bytes_read = 0;
+  esp_err_t result = i2s_read(I2S_PORT, (void*)i2s_buffer, sizeof(i2s_buffer), &bytes_read, portMAX_DELAY);
+  if (result != ESP_OK || bytes_read == 0) {
+    return 0;
+  }
+  audio_scale((uint8_t*)i2s_buffer, (uint8_t*)i2s_buffer, bytes_read);
+  return bytes_read / BYTES_PER_SAMPLE;
+}
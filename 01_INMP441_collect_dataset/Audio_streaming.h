@@ -0,0 +1,284 @@
+#ifndef AUDIO_STREAMING_H
+#define AUDIO_STREAMING_H
+
+// Потоковая передача аудио на веб-страничку.
+//
+// Вместо одного webSocket.broadcastBIN() на 32 КБ после записи каждая порция из I2S сразу
+// кладётся в общую очередь кадров (stream_push), а stream_pump() раздаёт кадры клиентам
+// небольшими сообщениями, не блокируя loop() дольше одной отправки.
+//
+// Обратное давление: веб-страничка подтверждает принятые кадры (сообщение CTRL_ACK с номером кадра),
+// и каждому клиенту отправляется не больше STREAM_WINDOW_BYTES неподтверждённых байт.
+//   - Очередь клиента растёт (медленная сеть) - кадры прореживаются: каждые decimation отсчётов
+//     усредняются в один, decimation удваивается до STREAM_MAX_DECIMATION.
+//   - Очередь клиента переполнена (клиент не отвечает) - самые старые кадры пропускаются.
+// Медленный или зависший клиент не задерживает остальных и запись.
+//
+// Кадры записи получают только клиенты, запросившие её (маска получателей в stream_begin,
+// см. Client_sessions.h): остальные пропускают эти кадры, не расходуя на них сеть и окно.
+//
+// Кадр потока - сообщение MSG_AUDIO (Message_protocol.h, все числа little-endian):
+//   смещение  размер  поле
+//   0         1       MSG_AUDIO
+//   1         1       флаги (STREAM_FLAG_START - первый кадр записи, STREAM_FLAG_END - запись окончена)
+//                     и прореживание в старших 4 битах (1 - все отсчёты, 2 - каждый второй и т.д.)
+//   2         2       длина данных (8 + 2 * кол-во отсчётов)
+//   4         4       номер кадра (подтверждается клиентом сообщением CTRL_ACK)
+//   8         4       номер первого отсчёта кадра от начала записи
+//   12        ...     отсчёты int16 после прореживания (кадр STREAM_FLAG_END без отсчётов)
+//
+// Файл не зависит от ядра Arduino: кадры отправляются через переданную функцию, поэтому
+// очередь и обратное давление проверяются на компьютере (host/audio_stream_test.cc).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "Message_protocol.h"
+
+#define STREAM_HEADER_SIZE    (MSG_HEADER_SIZE + 8)
+#define STREAM_FRAME_SAMPLES  256                // Отсчётов в кадре (как i2s_buffer).
+#define STREAM_POOL_FRAMES    16                 // Очередь кадров (256 мс, 8 КБ).
+#define STREAM_MAX_CLIENTS    5                  // Как WEBSOCKETS_SERVER_CLIENT_MAX на ESP32.
+#define STREAM_WINDOW_BYTES   2048               // Неподтверждённых байт на клиента.
+#define STREAM_DECIMATE_DEPTH 4                  // Кадров в очереди клиента, после которых прореживать.
+#define STREAM_MAX_DECIMATION 4
+#define STREAM_REPORT_MS      1000               // Период статистики.
+
+#define STREAM_ALL_CLIENTS    0xFF               // Маска получателей: все клиенты.
+
+#define STREAM_FLAG_START 1
+#define STREAM_FLAG_END   2
+#define STREAM_DECIMATION_SHIFT 4         // Прореживание в старших битах поля флагов.
+
+
+// Кадр в очереди.
+struct StreamFrame {
+  int16_t samples[STREAM_FRAME_SAMPLES];
+  uint16_t count;                   // Кол-во отсчётов.
+  uint8_t flags;
+  uint32_t offset;                  // Номер первого отсчёта от начала записи.
+  uint32_t capture_ms;              // Время записи кадра в очередь (для задержки очереди).
+  uint8_t recipients;               // Маска клиентов, которым отправляется кадр (бит на клиента).
+};
+
+// Состояние клиента. Кадры с номерами [acked, cursor) отправлены и ждут подтверждения.
+struct StreamClient {
+  bool active;
+  uint32_t cursor;                                 // Номер следующего кадра для отправки.
+  uint32_t acked;                                  // Номер первого неподтверждённого кадра.
+  uint32_t in_flight_bytes;                        // Отправлено и не подтверждено.
+  uint16_t in_flight_size[STREAM_POOL_FRAMES];     // Размер отправленного кадра (по номеру кадра).
+  uint8_t decimation;
+  uint32_t dropped;                                // Пропущенные кадры.
+  uint32_t decimated;                              // Кадры, отправленные с прореживанием.
+};
+
+// Статистика за период STREAM_REPORT_MS.
+struct StreamStats {
+  uint32_t bytes_per_sec;           // Отправлено всем клиентам.
+  uint32_t max_latency_ms;          // Наибольшее время кадра в очереди до отправки.
+  uint32_t dropped;                 // Пропущено кадров всеми клиентами.
+};
+
+// Функция отправки кадра клиенту (на ESP32 - webSocket.sendBIN). false - клиент отключён.
+typedef bool (*stream_send_t)(uint8_t client, const uint8_t* data, size_t size);
+
+struct AudioStream {
+  StreamFrame pool[STREAM_POOL_FRAMES];
+  uint32_t written;                 // Кол-во кадров, записанных в очередь.
+  uint32_t offset;                  // Отсчётов в текущей записи.
+  uint8_t next_flags;               // Флаги следующего кадра.
+  uint8_t recipients;               // Получатели текущей записи.
+  StreamClient clients[STREAM_MAX_CLIENTS];
+  uint8_t packet[STREAM_HEADER_SIZE + STREAM_FRAME_SAMPLES * 2];
+  uint32_t period_start_ms;
+  uint32_t period_bytes;
+  uint32_t period_max_latency_ms;
+  uint32_t period_dropped;
+};
+
+
+// ===============================
+// Клиент подключился: начинает получать кадры, записанные после подключения.
+// ===============================
+void stream_client_connect(AudioStream* s, uint8_t client) {
+  if (client >= STREAM_MAX_CLIENTS) return;
+  StreamClient* c = &s->clients[client];
+  memset(c, 0, sizeof(*c));
+  c->active = true;
+  c->cursor = s->written;
+  c->acked = s->written;
+  c->decimation = 1;
+}
+
+void stream_client_disconnect(AudioStream* s, uint8_t client) {
+  if (client >= STREAM_MAX_CLIENTS) return;
+  s->clients[client].active = false;
+}
+
+
+// Пропущенные кадры (не для этого клиента) не ждут подтверждения.
+void stream_skip_acked(StreamClient* c) {
+  while (c->acked != c->cursor && c->in_flight_size[c->acked % STREAM_POOL_FRAMES] == 0) {
+    c->acked++;
+  }
+}
+
+
+// ===============================
+// Клиент подтвердил приём кадров до sequence включительно.
+// ===============================
+void stream_ack(AudioStream* s, uint8_t client, uint32_t sequence) {
+  if (client >= STREAM_MAX_CLIENTS) return;
+  StreamClient* c = &s->clients[client];
+  // Подтверждение старого или ещё не отправленного кадра не учитывается.
+  if (sequence < c->acked || sequence >= c->cursor) return;
+  const uint32_t end = sequence + 1;
+  if (end - c->acked >= STREAM_POOL_FRAMES) {
+    memset(c->in_flight_size, 0, sizeof(c->in_flight_size));
+    c->in_flight_bytes = 0;
+  } else {
+    for (uint32_t n = c->acked; n < end; n++) {
+      c->in_flight_bytes -= c->in_flight_size[n % STREAM_POOL_FRAMES];
+      c->in_flight_size[n % STREAM_POOL_FRAMES] = 0;
+    }
+  }
+  c->acked = end;
+  stream_skip_acked(c);
+}
+
+
+// ===============================
+// Начать новую запись: следующий кадр получит флаг STREAM_FLAG_START, отсчёты нумеруются с нуля.
+//  - uint8_t recipients: маска клиентов, которым отправляются кадры записи (STREAM_ALL_CLIENTS - всем).
+// ===============================
+void stream_begin(AudioStream* s, uint8_t recipients) {
+  s->offset = 0;
+  s->next_flags = STREAM_FLAG_START;
+  s->recipients = recipients;
+}
+
+
+// ===============================
+// Положить порцию отсчётов (не больше STREAM_FRAME_SAMPLES) в очередь.
+// Клиенты, у которых очередь переполнена, пропускают свой самый старый кадр.
+//  - uint8_t flags: дополнительные флаги кадра (STREAM_FLAG_END).
+//  - uint32_t now_ms: текущее время (millis()).
+// ===============================
+void stream_push(AudioStream* s, const int16_t* samples, size_t count, uint8_t flags, uint32_t now_ms) {
+  if (count > STREAM_FRAME_SAMPLES) count = STREAM_FRAME_SAMPLES;
+  const uint32_t number = s->written;
+  for (int i = 0; i < STREAM_MAX_CLIENTS; i++) {
+    StreamClient* c = &s->clients[i];
+    if (c->active && number - c->cursor >= STREAM_POOL_FRAMES) {
+      // Пропуск чужого кадра потерей не считается.
+      if (s->pool[c->cursor % STREAM_POOL_FRAMES].recipients & (1u << i)) {
+        c->dropped++;
+        s->period_dropped++;
+      }
+      c->cursor++;
+    }
+  }
+  StreamFrame* frame = &s->pool[number % STREAM_POOL_FRAMES];
+  if (count > 0) {
+    memcpy(frame->samples, samples, count * sizeof(int16_t));
+  }
+  frame->count = (uint16_t)count;
+  frame->flags = s->next_flags | flags;
+  frame->offset = s->offset;
+  frame->capture_ms = now_ms;
+  frame->recipients = s->recipients;
+  s->next_flags = 0;
+  s->offset += count;
+  s->written++;
+}
+
+
+// Закончить запись: кадр без отсчётов с флагом STREAM_FLAG_END.
+void stream_finish(AudioStream* s, uint32_t now_ms) {
+  stream_push(s, nullptr, 0, STREAM_FLAG_END, now_ms);
+}
+
+
+// Сформировать сообщение из кадра с прореживанием decimation. Возвращает размер сообщения.
+size_t stream_build_packet(AudioStream* s, uint32_t number, uint8_t decimation) {
+  const StreamFrame* frame = &s->pool[number % STREAM_POOL_FRAMES];
+  uint8_t* out = s->packet;
+  msg_put_u32(out + MSG_HEADER_SIZE, number);
+  msg_put_u32(out + MSG_HEADER_SIZE + 4, frame->offset);
+  int16_t* samples = (int16_t*)(out + STREAM_HEADER_SIZE);
+  size_t count = 0;
+  for (size_t i = 0; i + decimation <= frame->count; i += decimation) {
+    int32_t sum = 0;
+    for (uint8_t j = 0; j < decimation; j++) {
+      sum += frame->samples[i + j];
+    }
+    samples[count++] = (int16_t)(sum / decimation);
+  }
+  const size_t size = STREAM_HEADER_SIZE + count * sizeof(int16_t);
+  msg_header(out, MSG_AUDIO, frame->flags | (decimation << STREAM_DECIMATION_SHIFT),
+             size - MSG_HEADER_SIZE);
+  return size;
+}
+
+
+// ===============================
+// Отправить клиентам ожидающие кадры, пока позволяет окно неподтверждённых байт.
+//  - stream_send_t send: функция отправки.
+//  - uint32_t now_ms: текущее время (millis()).
+// ===============================
+void stream_pump(AudioStream* s, stream_send_t send, uint32_t now_ms) {
+  for (int i = 0; i < STREAM_MAX_CLIENTS; i++) {
+    StreamClient* c = &s->clients[i];
+    while (c->active && c->cursor != s->written && c->in_flight_bytes < STREAM_WINDOW_BYTES &&
+           c->cursor - c->acked < STREAM_POOL_FRAMES) {
+      // Кадр записи, которую клиент не запрашивал, пропускается.
+      if (!(s->pool[c->cursor % STREAM_POOL_FRAMES].recipients & (1u << i))) {
+        c->cursor++;
+        stream_skip_acked(c);
+        continue;
+      }
+      // Прореживание по длине очереди клиента: растёт - вдвое сильнее, опустела - вдвое слабее.
+      const uint32_t depth = s->written - c->cursor;
+      if (depth > STREAM_DECIMATE_DEPTH && c->decimation < STREAM_MAX_DECIMATION) {
+        c->decimation *= 2;
+      } else if (depth <= 1 && c->decimation > 1) {
+        c->decimation /= 2;
+      }
+
+      const size_t size = stream_build_packet(s, c->cursor, c->decimation);
+      if (!send((uint8_t)i, s->packet, size)) {
+        c->active = false;
+        break;
+      }
+      const StreamFrame* frame = &s->pool[c->cursor % STREAM_POOL_FRAMES];
+      const uint32_t latency = now_ms - frame->capture_ms;
+      if (latency > s->period_max_latency_ms) s->period_max_latency_ms = latency;
+      if (c->decimation > 1) c->decimated++;
+      c->in_flight_size[c->cursor % STREAM_POOL_FRAMES] = (uint16_t)size;
+      c->in_flight_bytes += size;
+      s->period_bytes += size;
+      c->cursor++;
+    }
+  }
+}
+
+
+// ===============================
+// Статистика потока. Раз в STREAM_REPORT_MS заполняет stats, начинает новый период и возвращает true.
+// ===============================
+bool stream_report(AudioStream* s, uint32_t now_ms, StreamStats* stats) {
+  const uint32_t elapsed = now_ms - s->period_start_ms;
+  if (elapsed < STREAM_REPORT_MS) return false;
+  stats->bytes_per_sec = (uint32_t)((uint64_t)s->period_bytes * 1000 / elapsed);
+  stats->max_latency_ms = s->period_max_latency_ms;
+  stats->dropped = s->period_dropped;
+  s->period_start_ms = now_ms;
+  s->period_bytes = 0;
+  s->period_max_latency_ms = 0;
+  s->period_dropped = 0;
+  return true;
+}
+
+#endif  // AUDIO_STREAMING_H
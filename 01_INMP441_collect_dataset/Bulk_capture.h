@@ -0,0 +1,397 @@
+#ifndef BULK_CAPTURE_H
+#define BULK_CAPTURE_H
+
+// Массовый сбор датасета (режим BULK на веб-страничке).
+//
+// Вместо одной секунды на каждое нажатие кнопки DATASET устройство пишет звук непрерывно,
+// выделяет фразы по энергии сигнала и сразу отправляет каждую фразу одним кадром по TCP
+// на компьютер, где Python_INMP441/dataset_receiver.py сохраняет её в Dataset/<метка>/.
+//
+// Выделение фраз (segmenter_process):
+//   - сигнал делится на кадры по 10 мс, для кадра считается среднее абсолютное отклонение от среднего;
+//   - уровень шума отслеживается по тихим кадрам (быстро вниз, медленно вверх);
+//   - фраза начинается после BULK_START_FRAMES кадров громче шума в BULK_START_RATIO раз
+//     и заканчивается после BULK_HANGOVER_FRAMES кадров тише шума в BULK_END_RATIO раз;
+//   - из кольцевого буфера вырезается одна секунда (как у файлов датасета) с центром в середине фразы.
+//
+// Кадр протокола (все числа little-endian):
+//   смещение  размер  поле
+//   0         4       "INMP"
+//   4         1       версия протокола (BULK_PROTOCOL_VERSION)
+//   5         1       длина метки в байтах (не больше BULK_MAX_LABEL)
+//   6         2       зарезервировано (0)
+//   8         4       номер фразы в сеансе
+//   12        4       частота дискретизации
+//   16        4       кол-во отсчётов int16
+//   20        4       CRC-32 (как zlib.crc32) метки и отсчётов
+//   24        ...     метка (имя папки датасета, например "0_Zero"), затем отсчёты
+//
+// Файл не зависит от ядра Arduino, кроме передачи по WiFiClient, поэтому выделение фраз и
+// кадры проверяются на компьютере (host/bulk_capture_loopback.cc), где передача идёт через сокеты.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <WiFi.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// --- Протокол ---
+#define BULK_MAGIC            "INMP"
+#define BULK_PROTOCOL_VERSION 1
+#define BULK_HEADER_SIZE      24
+#define BULK_MAX_LABEL        32
+
+// --- Выделение фраз ---
+#define BULK_FRAME_SAMPLES    (SAMPLE_RATE / 100)                // Кадр 10 мс.
+#define BULK_CLIP_SAMPLES     SAMPLES_COUNT                      // Одна фраза - одна секунда, как в датасете.
+#define BULK_RING_SAMPLES     (BULK_CLIP_SAMPLES * 3 / 2)        // Фраза + ожидание её конца (кратно кадру).
+#define BULK_START_RATIO      4                                  // Начало фразы: энергия > шум * 4,
+#define BULK_END_RATIO        2                                  // конец фразы: энергия < шум * 2.
+#define BULK_MIN_ENERGY       16                                 // Порог для очень тихого шума.
+#define BULK_START_FRAMES     3                                  // Громких кадров подряд для начала фразы.
+#define BULK_HANGOVER_FRAMES  20                                 // Тихих кадров подряд для конца фразы (200 мс).
+#define BULK_MIN_SPEECH_SAMPLES (SAMPLE_RATE / 10)               // Более короткие щелчки отбрасываются.
+#define BULK_FLOOR_SHIFT      8                                  // Уровень шума хранится с 8 дробными битами.
+
+
+// Состояние выделения фраз. Отсчёты адресуются номером от начала записи (total).
+struct EnergySegmenter {
+  int16_t ring[BULK_RING_SAMPLES];  // Последние BULK_RING_SAMPLES отсчётов.
+  uint32_t total;                   // Кол-во полученных отсчётов.
+  int32_t noise_floor;              // Уровень шума (энергия тихого кадра) << BULK_FLOOR_SHIFT.
+  bool floor_ready;                 // Уровень шума уже оценён по первому кадру.
+  bool in_speech;                   // Идёт фраза.
+  int loud_run;                     // Громких кадров подряд до начала фразы.
+  int quiet_run;                    // Тихих кадров подряд во время фразы.
+  uint32_t speech_start;            // Первый отсчёт фразы.
+  uint32_t speech_end;              // Отсчёт после последнего громкого кадра фразы.
+  bool clip_pending;                // Фраза найдена, ждём отсчёты до конца её секунды.
+  uint32_t clip_start;              // Первый отсчёт вырезаемой секунды.
+  uint32_t clips;                   // Кол-во вырезанных фраз.
+  uint32_t dropped;                 // Кол-во отброшенных фраз (коротких, длинных или пришедших во время ожидания).
+};
+
+
+// ===============================
+// Сбросить состояние выделения фраз (начало нового сеанса записи).
+// ===============================
+void segmenter_reset(EnergySegmenter* s) {
+  s->total = 0;
+  s->noise_floor = 0;
+  s->floor_ready = false;
+  s->in_speech = false;
+  s->loud_run = 0;
+  s->quiet_run = 0;
+  s->speech_start = 0;
+  s->speech_end = 0;
+  s->clip_pending = false;
+  s->clip_start = 0;
+  s->clips = 0;
+  s->dropped = 0;
+}
+
+
+// ===============================
+// Энергия кадра, который заканчивается отсчётом total: среднее абсолютное отклонение от среднего
+// (постоянная составляющая микрофона на энергию не влияет).
+// Размер кольцевого буфера кратен кадру, поэтому кадр в нём не разрывается.
+// ===============================
+int32_t segmenter_frame_energy(const EnergySegmenter* s) {
+  const int16_t* frame = s->ring + (s->total - BULK_FRAME_SAMPLES) % BULK_RING_SAMPLES;
+  int32_t sum = 0;
+  for (int i = 0; i < BULK_FRAME_SAMPLES; i++) {
+    sum += frame[i];
+  }
+  const int32_t mean = sum / BULK_FRAME_SAMPLES;
+  int32_t deviation = 0;
+  for (int i = 0; i < BULK_FRAME_SAMPLES; i++) {
+    deviation += frame[i] > mean ? frame[i] - mean : mean - frame[i];
+  }
+  return deviation / BULK_FRAME_SAMPLES;
+}
+
+
+// ===============================
+// Обработать энергию очередного кадра: начало и конец фразы, уровень шума.
+// ===============================
+void segmenter_frame(EnergySegmenter* s, int32_t energy) {
+  const int32_t scaled = energy << BULK_FLOOR_SHIFT;
+  if (!s->floor_ready) {
+    s->noise_floor = scaled;
+    s->floor_ready = true;
+  }
+  int32_t start_level = (s->noise_floor * BULK_START_RATIO) >> BULK_FLOOR_SHIFT;
+  int32_t end_level = (s->noise_floor * BULK_END_RATIO) >> BULK_FLOOR_SHIFT;
+  if (start_level < BULK_MIN_ENERGY) start_level = BULK_MIN_ENERGY;
+  if (end_level < BULK_MIN_ENERGY) end_level = BULK_MIN_ENERGY;
+
+  if (!s->in_speech) {
+    if (energy > start_level) {
+      s->loud_run++;
+      if (s->loud_run >= BULK_START_FRAMES) {
+        s->in_speech = true;
+        s->quiet_run = 0;
+        s->speech_start = s->total - BULK_START_FRAMES * BULK_FRAME_SAMPLES;
+        s->speech_end = s->total;
+      }
+      return;
+    }
+    s->loud_run = 0;
+    // Шум отслеживается только вне фразы: быстро вниз, медленно вверх.
+    if (scaled < s->noise_floor) {
+      s->noise_floor += (scaled - s->noise_floor) / 16;
+    } else {
+      s->noise_floor += (scaled - s->noise_floor) / 64;
+    }
+    return;
+  }
+
+  if (energy > end_level) {
+    s->speech_end = s->total;
+    s->quiet_run = 0;
+  } else {
+    s->quiet_run++;
+  }
+  const bool too_long = s->total - s->speech_start >= BULK_CLIP_SAMPLES;
+  if (s->quiet_run < BULK_HANGOVER_FRAMES && !too_long) {
+    return;
+  }
+
+  // Фраза закончилась.
+  s->in_speech = false;
+  s->loud_run = 0;
+  if (too_long) {
+    // Громко дольше секунды - это не фраза, а новый уровень шума (включился вентилятор и т.п.).
+    s->noise_floor = scaled;
+    s->dropped++;
+    return;
+  }
+  if (s->speech_end - s->speech_start < BULK_MIN_SPEECH_SAMPLES || s->clip_pending) {
+    s->dropped++;
+    return;
+  }
+  const uint32_t center = s->speech_start + (s->speech_end - s->speech_start) / 2;
+  s->clip_start = center > BULK_CLIP_SAMPLES / 2 ? center - BULK_CLIP_SAMPLES / 2 : 0;
+  s->clip_pending = true;
+}
+
+
+// ===============================
+// Передать выделению фраз очередную порцию отсчётов.
+//  - EnergySegmenter* s: состояние.
+//  - const int16_t* samples: отсчёты (после audio_scale).
+//  - size_t count: кол-во отсчётов.
+//  - int16_t* clip: буфер на BULK_CLIP_SAMPLES отсчётов для вырезанной фразы.
+// Возвращает true, если в clip записана очередная фраза. Порция не длиннее
+// (BULK_RING_SAMPLES - BULK_CLIP_SAMPLES) отсчётов, поэтому за вызов готовится не больше одной фразы.
+// ===============================
+bool segmenter_process(EnergySegmenter* s, const int16_t* samples, size_t count, int16_t* clip) {
+  bool ready = false;
+  for (size_t i = 0; i < count; i++) {
+    s->ring[s->total % BULK_RING_SAMPLES] = samples[i];
+    s->total++;
+    if (s->total % BULK_FRAME_SAMPLES != 0) {
+      continue;
+    }
+    segmenter_frame(s, segmenter_frame_energy(s));
+
+    // Вырезать секунду, когда получены все её отсчёты.
+    if (s->clip_pending && s->total >= s->clip_start + BULK_CLIP_SAMPLES) {
+      for (uint32_t j = 0; j < BULK_CLIP_SAMPLES; j++) {
+        clip[j] = s->ring[(s->clip_start + j) % BULK_RING_SAMPLES];
+      }
+      s->clip_pending = false;
+      s->clips++;
+      ready = true;
+    }
+  }
+  return ready;
+}
+
+
+// ===============================
+// CRC-32 (полином 0xEDB88320, как zlib.crc32), продолжение подсчёта с crc.
+// ===============================
+uint32_t bulk_crc32(uint32_t crc, const uint8_t* data, size_t size) {
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+
+// Записать 32-битное число в little-endian.
+void bulk_put_u32(uint8_t* out, uint32_t value) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+  out[2] = (value >> 16) & 0xFF;
+  out[3] = (value >> 24) & 0xFF;
+}
+
+
+// ===============================
+// Сформировать заголовок кадра и метку.
+//  - uint8_t* out: буфер не меньше BULK_HEADER_SIZE + BULK_MAX_LABEL байт.
+//  - const char* label: метка (длиннее BULK_MAX_LABEL обрезается).
+//  - uint32_t sequence: номер фразы.
+//  - const int16_t* samples, uint32_t count: отсчёты фразы (little-endian, как на ESP32).
+// Возвращает кол-во записанных байт (заголовок + метка), после которых передаются отсчёты.
+// ===============================
+size_t bulk_frame_header(uint8_t* out, const char* label, uint32_t sequence,
+                         const int16_t* samples, uint32_t count) {
+  size_t label_size = strlen(label);
+  if (label_size > BULK_MAX_LABEL) {
+    label_size = BULK_MAX_LABEL;
+  }
+  memcpy(out, BULK_MAGIC, 4);
+  out[4] = BULK_PROTOCOL_VERSION;
+  out[5] = (uint8_t)label_size;
+  out[6] = 0;
+  out[7] = 0;
+  bulk_put_u32(out + 8, sequence);
+  bulk_put_u32(out + 12, SAMPLE_RATE);
+  bulk_put_u32(out + 16, count);
+  memcpy(out + BULK_HEADER_SIZE, label, label_size);
+  uint32_t crc = bulk_crc32(0, out + BULK_HEADER_SIZE, label_size);
+  crc = bulk_crc32(crc, (const uint8_t*)samples, count * sizeof(int16_t));
+  bulk_put_u32(out + 20, crc);
+  return BULK_HEADER_SIZE + label_size;
+}
+
+
+// ===============================
+// Соединение с приёмником (Python_INMP441/dataset_receiver.py).
+// ===============================
+#if defined(ARDUINO_ARCH_ESP32)
+WiFiClient bulk_client;
+#else
+int bulk_socket = -1;
+#endif
+
+bool bulk_connect(const char* host, uint16_t port) {
+#if defined(ARDUINO_ARCH_ESP32)
+  if (!bulk_client.connect(host, port)) {
+    return false;
+  }
+  // Кадры отправляются целиком, задержка Нейгла не нужна.
+  bulk_client.setNoDelay(true);
+  return true;
+#else
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo* address = nullptr;
+  char service[8];
+  snprintf(service, sizeof(service), "%u", port);
+  if (getaddrinfo(host, service, &hints, &address) != 0) {
+    return false;
+  }
+  bulk_socket = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+  if (bulk_socket < 0 || connect(bulk_socket, address->ai_addr, address->ai_addrlen) != 0) {
+    freeaddrinfo(address);
+    if (bulk_socket >= 0) {
+      close(bulk_socket);
+      bulk_socket = -1;
+    }
+    return false;
+  }
+  freeaddrinfo(address);
+  return true;
+#endif
+}
+
+bool bulk_connected() {
+#if defined(ARDUINO_ARCH_ESP32)
+  return bulk_client.connected();
+#else
+  return bulk_socket >= 0;
+#endif
+}
+
+void bulk_disconnect() {
+#if defined(ARDUINO_ARCH_ESP32)
+  bulk_client.stop();
+#else
+  if (bulk_socket >= 0) {
+    close(bulk_socket);
+    bulk_socket = -1;
+  }
+#endif
+}
+
+// Отправить size байт целиком. При ошибке соединение закрывается.
+bool bulk_write(const uint8_t* data, size_t size) {
+  while (size > 0) {
+#if defined(ARDUINO_ARCH_ESP32)
+    const size_t written = bulk_client.write(data, size);
+    if (written == 0) {
+      bulk_disconnect();
+      return false;
+    }
+#else
+    const ssize_t written = send(bulk_socket, data, size, MSG_NOSIGNAL);
+    if (written <= 0) {
+      bulk_disconnect();
+      return false;
+    }
+#endif
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+// Прочитать ровно size байт, ожидая не дольше timeout_ms. При ошибке соединение закрывается.
+bool bulk_read(uint8_t* data, size_t size, uint32_t timeout_ms) {
+#if defined(ARDUINO_ARCH_ESP32)
+  const uint32_t start = millis();
+  while ((size_t)bulk_client.available() < size) {
+    if (!bulk_client.connected() || millis() - start > timeout_ms) {
+      bulk_disconnect();
+      return false;
+    }
+    delay(1);
+  }
+  if (bulk_client.read(data, size) != (int)size) {
+    bulk_disconnect();
+    return false;
+  }
+#else
+  struct timeval timeout;
+  timeout.tv_sec = timeout_ms / 1000;
+  timeout.tv_usec = (timeout_ms % 1000) * 1000;
+  setsockopt(bulk_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  if (recv(bulk_socket, data, size, MSG_WAITALL) != (ssize_t)size) {
+    bulk_disconnect();
+    return false;
+  }
+#endif
+  return true;
+}
+
+
+// ===============================
+// Отправить фразу одним кадром.
+// ===============================
+bool bulk_send_clip(const char* label, uint32_t sequence, const int16_t* samples, uint32_t count) {
+  uint8_t header[BULK_HEADER_SIZE + BULK_MAX_LABEL];
+  const size_t header_size = bulk_frame_header(header, label, sequence, samples, count);
+  return bulk_write(header, header_size) &&
+         bulk_write((const uint8_t*)samples, count * sizeof(int16_t));
+}
+
+#endif  // BULK_CAPTURE_H
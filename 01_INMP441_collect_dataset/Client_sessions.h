@@ -0,0 +1,141 @@
+#ifndef CLIENT_SESSIONS_H
+#define CLIENT_SESSIONS_H
+
+// Сеансы клиентов веб-странички: запросы записи (кнопка DATASET) от нескольких разметчиков.
+//
+// Вместо общего флага dataset у каждого клиента (номер клиента WebSocket) своя очередь запросов
+// с меткой. Микрофон один, поэтому запросы обслуживаются по очереди:
+//   - следующая запись достаётся клиентам по кругу (round-robin): клиент, нажимающий DATASET
+//     чаще других, не задерживает остальных больше чем на одну запись;
+//   - запросы других клиентов с той же меткой, ожидающие в начале своих очередей, объединяются
+//     с выбранным: одна запись отправляется всем им (пакет);
+//   - результат записи (кадры аудиопотока и JPEG спектрограммы) отправляется только клиентам
+//     пакета (маска получателей), а не всем подключённым.
+// Запросы сверх SESSION_MAX_PENDING у клиента отклоняются, клиент видит длину своей очереди.
+//
+// Файл не зависит от ядра Arduino и проверяется на компьютере (host/client_sessions_sim.cc).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define SESSION_MAX_CLIENTS  5                     // Как WEBSOCKETS_SERVER_CLIENT_MAX на ESP32.
+#define SESSION_MAX_PENDING  4                     // Запросов в очереди клиента.
+#define SESSION_MAX_LABEL    32
+
+
+// Сеанс клиента. Запросы с номерами [head, head + pending) ждут записи.
+struct ClientSession {
+  bool connected;
+  uint8_t head;
+  uint8_t pending;
+  char labels[SESSION_MAX_PENDING][SESSION_MAX_LABEL + 1];
+  uint32_t request_ms[SESSION_MAX_PENDING];        // Время запроса (millis()).
+  // Статистика.
+  uint32_t served;                                 // Получено записей.
+  uint32_t rejected;                               // Отклонено запросов (очередь полна).
+  uint32_t total_wait_ms;                          // Суммарное ожидание от запроса до начала записи.
+  uint32_t max_wait_ms;
+};
+
+struct SessionManager {
+  ClientSession clients[SESSION_MAX_CLIENTS];
+  uint8_t turn;                     // С этого клиента начинается поиск следующей записи.
+  uint32_t recordings;              // Сделано записей.
+  uint32_t batched;                 // Запросов, обслуженных чужой записью (в пакете).
+};
+
+
+// Маска клиента в наборе получателей.
+uint8_t session_bit(uint8_t client) {
+  return (uint8_t)(1u << client);
+}
+
+
+// ===============================
+// Клиент подключился или отключился. Запросы отключившегося клиента отбрасываются.
+// ===============================
+void session_connect(SessionManager* m, uint8_t client) {
+  if (client >= SESSION_MAX_CLIENTS) return;
+  memset(&m->clients[client], 0, sizeof(ClientSession));
+  m->clients[client].connected = true;
+}
+
+void session_disconnect(SessionManager* m, uint8_t client) {
+  if (client >= SESSION_MAX_CLIENTS) return;
+  m->clients[client].connected = false;
+  m->clients[client].pending = 0;
+}
+
+
+// ===============================
+// Запрос записи с меткой label от клиента.
+// Возвращает false, если очередь клиента полна (запрос отклонён).
+// ===============================
+bool session_request(SessionManager* m, uint8_t client, const char* label, uint32_t now_ms) {
+  if (client >= SESSION_MAX_CLIENTS || !m->clients[client].connected) return false;
+  ClientSession* c = &m->clients[client];
+  if (c->pending >= SESSION_MAX_PENDING) {
+    c->rejected++;
+    return false;
+  }
+  const uint8_t slot = (c->head + c->pending) % SESSION_MAX_PENDING;
+  strncpy(c->labels[slot], label != nullptr ? label : "", SESSION_MAX_LABEL);
+  c->labels[slot][SESSION_MAX_LABEL] = '\0';
+  c->request_ms[slot] = now_ms;
+  c->pending++;
+  return true;
+}
+
+
+// Снять первый запрос клиента и учесть время его ожидания.
+void session_pop(ClientSession* c, uint32_t now_ms) {
+  const uint32_t wait = now_ms - c->request_ms[c->head];
+  c->total_wait_ms += wait;
+  if (wait > c->max_wait_ms) c->max_wait_ms = wait;
+  c->served++;
+  c->head = (c->head + 1) % SESSION_MAX_PENDING;
+  c->pending--;
+}
+
+
+// ===============================
+// Выбрать следующую запись (вызывается, когда микрофон свободен).
+//  - char* label: сюда копируется метка записи (SESSION_MAX_LABEL + 1 байт).
+// Возвращает маску получателей записи (0 - запросов нет).
+// ===============================
+uint8_t session_next(SessionManager* m, uint32_t now_ms, char* label) {
+  int chosen = -1;
+  for (int i = 0; i < SESSION_MAX_CLIENTS; i++) {
+    const int client = (m->turn + i) % SESSION_MAX_CLIENTS;
+    if (m->clients[client].connected && m->clients[client].pending > 0) {
+      chosen = client;
+      break;
+    }
+  }
+  if (chosen < 0) return 0;
+
+  ClientSession* first = &m->clients[chosen];
+  memcpy(label, first->labels[first->head], SESSION_MAX_LABEL + 1);
+  uint8_t recipients = 0;
+  for (int client = 0; client < SESSION_MAX_CLIENTS; client++) {
+    ClientSession* c = &m->clients[client];
+    if (c->connected && c->pending > 0 && strcmp(c->labels[c->head], label) == 0) {
+      recipients |= session_bit(client);
+      if (client != chosen) m->batched++;
+      session_pop(c, now_ms);
+    }
+  }
+  // Следующая запись начинается с клиента после выбранного.
+  m->turn = (uint8_t)((chosen + 1) % SESSION_MAX_CLIENTS);
+  m->recordings++;
+  return recipients;
+}
+
+
+// Кол-во запросов клиента, ожидающих записи.
+uint8_t session_pending(const SessionManager* m, uint8_t client) {
+  return client < SESSION_MAX_CLIENTS ? m->clients[client].pending : 0;
+}
+
+#endif  // CLIENT_SESSIONS_H
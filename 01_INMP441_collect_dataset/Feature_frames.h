@@ -0,0 +1,143 @@
+#ifndef FEATURE_FRAMES_H
+#define FEATURE_FRAMES_H
+
+// Передача признаков вместо аудио (режим FEATURES массового сбора датасета).
+//
+// Для обучения нужна спектрограмма фразы (99 x 41 логарифмов энергии, как X_spectrogram_train
+// в ноутбуке), а не 32 КБ PCM. В этом режиме устройство само считает спектрограмму фразы и
+// отправляет приёмнику Python_INMP441/dataset_receiver.py один кадр признаков:
+//   - FEATURE_FORMAT_Q12:   int16 на значение, log10 энергии в Q12 (99 x 41 x 2 = 8118 байт);
+//   - FEATURE_FORMAT_UINT8: минимум и диапазон всей спектрограммы (int32 Q12), затем uint8 на
+//     значение, (v - min) * 255 / диапазон (8 + 99 x 41 = 4067 байт).
+// По запросу (FEATURE_FLAG_PCM) за кадром признаков следует обычный кадр фразы "INMP" с тем же номером.
+//
+// Кадр признаков (все числа little-endian):
+//   смещение  размер  поле
+//   0         4       "FEAT"
+//   4         1       версия (FEATURE_VERSION)
+//   5         1       длина метки в байтах (не больше BULK_MAX_LABEL)
+//   6         1       формат (FEATURE_FORMAT_Q12 / FEATURE_FORMAT_UINT8)
+//   7         1       флаги (FEATURE_FLAG_PCM - за кадром следует PCM фразы)
+//   8         4       номер фразы в сеансе
+//   12        2       кол-во строк (кадров спектрограммы)
+//   14        2       кол-во столбцов (полос частот)
+//   16        4       размер данных в байтах
+//   20        4       CRC-32 (как zlib.crc32) метки и данных
+//   24        ...     метка, затем данные
+//
+// Файл не зависит от ядра Arduino, кроме передачи (bulk_write), и проверяется на компьютере
+// (host/feature_frames_test.cc).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#include "Bulk_capture.h"
+#include "Spectrogram_quantizer.h"
+
+#define FEATURE_MAGIC        "FEAT"
+#define FEATURE_VERSION      1
+#define FEATURE_HEADER_SIZE  24
+
+#define FEATURE_FORMAT_PCM   0            // Признаки не передаются, только PCM (обычный BULK).
+#define FEATURE_FORMAT_Q12   1
+#define FEATURE_FORMAT_UINT8 2
+#define FEATURE_FLAG_PCM     1
+#define FEATURE_UINT8_PREFIX 8            // Минимум и диапазон перед значениями uint8.
+#define FEATURE_SCALE_BITS   24           // Масштаб uint8-квантования в Q24.
+
+
+// log10 энергии в Q12 (int16 вмещает -8..8, EPSILON = 1e-6 даёт не меньше -6).
+int16_t feature_q12(float value) {
+  int32_t q = (int32_t)lrintf(value * (float)(1 << QUANT_FRACTION_BITS));
+  if (q > INT16_MAX) q = INT16_MAX;
+  if (q < INT16_MIN) q = INT16_MIN;
+  return (int16_t)q;
+}
+
+
+// ===============================
+// Квантовать всю спектрограмму в uint8 по её собственному диапазону.
+//  - const int16_t* q12, size_t count: значения в Q12.
+//  - uint8_t* out: буфер на FEATURE_UINT8_PREFIX + count байт.
+// Возвращает размер данных.
+// ===============================
+size_t feature_pack_uint8(const int16_t* q12, size_t count, uint8_t* out) {
+  int32_t min = INT16_MAX;
+  int32_t max = INT16_MIN;
+  for (size_t i = 0; i < count; i++) {
+    if (q12[i] < min) min = q12[i];
+    if (q12[i] > max) max = q12[i];
+  }
+  if (count == 0) min = max = 0;
+  int32_t range = max - min;
+  if (range < QUANT_MIN_RANGE) range = QUANT_MIN_RANGE;
+  bulk_put_u32(out, (uint32_t)min);
+  bulk_put_u32(out + 4, (uint32_t)range);
+  // Одно деление на спектрограмму, на значение - умножение и сдвиг (как в Spectrogram_quantizer.h).
+  // Диапазон спектрограммы шире диапазона строки, поэтому масштаб в Q24: ошибка округления
+  // масштаба остаётся меньше сотой доли шага квантования.
+  const int64_t scale_q24 = (((int64_t)255 << FEATURE_SCALE_BITS) + range / 2) / range;
+  const int64_t half = (int64_t)1 << (FEATURE_SCALE_BITS - 1);
+  uint8_t* values = out + FEATURE_UINT8_PREFIX;
+  for (size_t i = 0; i < count; i++) {
+    const int32_t scaled = (int32_t)(((q12[i] - min) * scale_q24 + half) >> FEATURE_SCALE_BITS);
+    values[i] = (uint8_t)(scaled > 255 ? 255 : scaled);
+  }
+  return FEATURE_UINT8_PREFIX + count;
+}
+
+
+// ===============================
+// Сформировать заголовок кадра признаков и метку.
+//  - uint8_t* out: буфер не меньше FEATURE_HEADER_SIZE + BULK_MAX_LABEL байт.
+//  - const uint8_t* data, uint32_t size: данные кадра (значения Q12 или результат feature_pack_uint8).
+// Возвращает кол-во записанных байт (заголовок + метка), после которых передаются данные.
+// ===============================
+size_t feature_frame_header(uint8_t* out, const char* label, uint32_t sequence, uint8_t format,
+                            uint8_t flags, uint16_t rows, uint16_t bins,
+                            const uint8_t* data, uint32_t size) {
+  size_t label_size = strlen(label);
+  if (label_size > BULK_MAX_LABEL) {
+    label_size = BULK_MAX_LABEL;
+  }
+  memcpy(out, FEATURE_MAGIC, 4);
+  out[4] = FEATURE_VERSION;
+  out[5] = (uint8_t)label_size;
+  out[6] = format;
+  out[7] = flags;
+  bulk_put_u32(out + 8, sequence);
+  out[12] = rows & 0xFF;
+  out[13] = rows >> 8;
+  out[14] = bins & 0xFF;
+  out[15] = bins >> 8;
+  bulk_put_u32(out + 16, size);
+  memcpy(out + FEATURE_HEADER_SIZE, label, label_size);
+  uint32_t crc = bulk_crc32(0, out + FEATURE_HEADER_SIZE, label_size);
+  crc = bulk_crc32(crc, data, size);
+  bulk_put_u32(out + 20, crc);
+  return FEATURE_HEADER_SIZE + label_size;
+}
+
+
+// ===============================
+// Отправить признаки фразы одним кадром.
+//  - const int16_t* q12: спектрограмма rows x bins в Q12 (строки подряд).
+//  - uint8_t* packed: буфер на FEATURE_UINT8_PREFIX + rows * bins байт для FEATURE_FORMAT_UINT8.
+// ===============================
+bool feature_send(const char* label, uint32_t sequence, uint8_t format, uint8_t flags,
+                  const int16_t* q12, uint16_t rows, uint16_t bins, uint8_t* packed) {
+  const uint8_t* data = (const uint8_t*)q12;
+  uint32_t size = (uint32_t)rows * bins * sizeof(int16_t);
+  if (format == FEATURE_FORMAT_UINT8) {
+    size = feature_pack_uint8(q12, (size_t)rows * bins, packed);
+    data = packed;
+  }
+  uint8_t header[FEATURE_HEADER_SIZE + BULK_MAX_LABEL];
+  const size_t header_size = feature_frame_header(header, label, sequence, format, flags,
+                                                  rows, bins, data, size);
+  return bulk_write(header, header_size) && bulk_write(data, size);
+}
+
+#endif  // FEATURE_FRAMES_H
@@ -1,120 +1,279 @@
-// Функция подготавливает и возвращает HTML страничку.
-
-String getHTML() {
-  String html = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-  <meta charset="UTF-8">
-  <title>ESP32 + INMP441</title>
-  <style>
-    body {
-      background-color: #EEEEEE;
-      font-family: Arial, sans-serif;
-      text-align: center;
-      margin: 20px;
-    }
-    button {
-      margin: 5px;
-      padding: 10px 20px;
-      border: none;
-      background-color: #4CAF50;
-      color: white;
-      font-size: 16px;
-      border-radius: 6px;
-      cursor: pointer;
-    }
-    button:hover {
-      background-color: #45a049;
-    }
-    .img-container {
-      width: 245px;
-      height: 100px;
-      margin: 10px auto;
-      position: relative;
-      overflow: hidden;
-      border: 2px solid #555;
-      border-radius: 10px;
-      background-color: #ddd;
-    }
-
-    .rotated {
-      position: absolute;
-      top: 50%;
-      left: 50%;
-      height: 245px;
-      width: 100px;
-      transform: translate(-50%, -50%) rotate(-90deg);
-      transform-origin: center center;
-    }
-  </style>
-</head>
-
-<body>
-  <h2>ESP32 + INMP441</h2>
-
-  <div><b>SPECTROGRAM:</b></div>
-  <div class="img-container">
-    <img id="imgSPECTROGRAM" class="rotated">
-  </div>
-
-  <p>
-    <button type="button" id="BTN_dataset">DATASET</button>
-    <button type="button" onclick="location.reload();">REFRESH PAGE</button>
-  </p>
-
-  <script>
-    var Socket;
-    var img_type = 0;
-
-    document.getElementById('BTN_dataset').addEventListener('click', button_dataset);
-
-    function init() {
-      Socket = new WebSocket('ws://' + window.location.hostname + ':81/');
-      Socket.onmessage = function(event) {
-        processCommand(event);
-      };
-    }
-
-    function processCommand(event) {
-      if (event.data instanceof Blob) {
-        if (img_type == 0) {
-          document.getElementById('imgSPECTROGRAM').src = URL.createObjectURL(event.data);
-        } else if (img_type == 1) {
-          const url = URL.createObjectURL(event.data);
-          const a = document.createElement('a');
-          a.href = url;
-          a.download = 'recording.wav';
-          document.body.appendChild(a);
-          a.click();
-          document.body.removeChild(a);
-          URL.revokeObjectURL(url);
-        } 
-      } else {
-        try {
-          var obj = JSON.parse(event.data);
-          var type = obj.type;
-          if (type === "change_img_type") {
-            img_type = obj.value;
-          }
-        } catch (e) {
-          console.error("Received data is neither Blob nor valid JSON:", event.data);
-        }
-      }
-    }
-
-    function button_dataset() {
-      var btn_cpt = {type: 'dataset', value: true};
-      Socket.send(JSON.stringify(btn_cpt));
-    }
-
-    window.onload = function(event) {
-      init();
-    };
-  </script>
-</body>
-</html>
-)rawliteral";
-
-  return html;
-}
\ No newline at end of file
+// Веб-страничка, сжатая gzip (сгенерировано Python_INMP441/homepage_gzip.py из HomePage.html).
+// Не редактировать: изменить HomePage.html и запустить скрипт заново.
+// Исходный размер 12692 байт, сжатый 4161 байт.
+
+#ifndef HOMEPAGE_H
+#define HOMEPAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ETag странички: браузер присылает его в If-None-Match, и сервер отвечает 304 без тела.
+#define HOMEPAGE_ETAG "\"4ee5d92e\""
+
+const size_t HOMEPAGE_GZ_SIZE = 4161;
+const uint8_t HOMEPAGE_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5b, 0xeb, 0x6f, 0xdc, 0xc6,
+  0x11, 0xff, 0x5e, 0xa0, 0xff, 0xc3, 0xe6, 0x82, 0xe6, 0x78, 0x35, 0x75, 0x0f, 0xe9, 0xe4, 0x2a,
+  0xa7, 0x93, 0x02, 0x59, 0x3e, 0x27, 0x6a, 0x64, 0x4b, 0xd1, 0x23, 0x69, 0x6b, 0x18, 0x02, 0x75,
+  0xdc, 0xd3, 0xd1, 0xe6, 0x91, 0x57, 0x92, 0x27, 0x59, 0x4d, 0x04, 0xf8, 0x91, 0x57, 0x91, 0x34,
+  0x41, 0xda, 0xa2, 0x05, 0x8a, 0xa2, 0x45, 0x3e, 0xf5, 0xab, 0xa2, 0xf8, 0x12, 0xc5, 0x8e, 0xe5,
+  0x7f, 0xe1, 0xee, 0x3f, 0xea, 0xcc, 0xec, 0x92, 0x5c, 0x92, 0xf7, 0x50, 0x5c, 0xd4, 0x81, 0x7d,
+  0xe4, 0x72, 0x76, 0x76, 0x77, 0x66, 0x76, 0xe6, 0x37, 0xb3, 0x9b, 0xfa, 0x2b, 0xd7, 0x37, 0x56,
+  0x77, 0x7e, 0xbb, 0xd9, 0x60, 0xed, 0xa0, 0x63, 0x2f, 0xff, 0xfc, 0x67, 0xf5, 0xe8, 0x97, 0x1b,
+  0x26, 0xfc, 0x32, 0x56, 0xef, 0xf0, 0xc0, 0x60, 0xcd, 0xb6, 0xe1, 0xf9, 0x3c, 0x58, 0xca, 0xed,
+  0xee, 0xdc, 0x98, 0x59, 0xc8, 0x89, 0x2f, 0x81, 0x15, 0xd8, 0x7c, 0xb9, 0xb1, 0xbd, 0x39, 0x37,
+  0xcb, 0xae, 0xb0, 0xb5, 0x5b, 0x37, 0x37, 0xab, 0xd5, 0x4a, 0xbd, 0x24, 0x9a, 0x89, 0xc2, 0x0f,
+  0x8e, 0xe5, 0x23, 0x63, 0xfb, 0xae, 0x79, 0xcc, 0xde, 0x17, 0xcf, 0xf0, 0x66, 0x34, 0xef, 0x1d,
+  0x78, 0x6e, 0xcf, 0x31, 0x67, 0x9a, 0xae, 0xed, 0x7a, 0x35, 0xf6, 0x6a, 0x83, 0xfe, 0x2c, 0x86,
+  0x14, 0x2d, 0xd7, 0x09, 0x66, 0x5a, 0x46, 0xc7, 0xb2, 0x8f, 0x6b, 0x6c, 0xc5, 0xb3, 0x0c, 0x5b,
+  0x67, 0xbe, 0xe1, 0xf8, 0x33, 0x3e, 0xf7, 0xac, 0x56, 0x44, 0x16, 0xf0, 0xfb, 0xc1, 0x8c, 0x61,
+  0x5b, 0x07, 0x4e, 0x8d, 0x35, 0xb9, 0x13, 0x70, 0x2f, 0xfa, 0xd4, 0x31, 0xbc, 0x03, 0x0b, 0x9a,
+  0x67, 0xcb, 0xdd, 0xfb, 0xb2, 0xf1, 0x44, 0xce, 0xa5, 0x17, 0x04, 0xae, 0x13, 0xcf, 0x26, 0xa4,
+  0x9c, 0x8f, 0x08, 0x19, 0xeb, 0x1a, 0xa6, 0x69, 0x39, 0x07, 0x35, 0x56, 0x81, 0xee, 0x2a, 0x0f,
+  0x5c, 0x8a, 0x67, 0x72, 0x98, 0xb2, 0xe3, 0x3a, 0x7c, 0x71, 0xc2, 0x8a, 0xaa, 0xab, 0x2b, 0x37,
+  0xe6, 0xcb, 0x11, 0x85, 0x6c, 0x3e, 0x6a, 0x5b, 0x01, 0x4f, 0x2e, 0xd3, 0xb7, 0xfe, 0xc0, 0x61,
+  0xa0, 0xab, 0x99, 0x31, 0x66, 0x3c, 0xc3, 0xb4, 0x7a, 0x7e, 0x8d, 0xa9, 0x9f, 0x9a, 0x3d, 0xcf,
+  0x47, 0x46, 0x5d, 0xd7, 0x52, 0xd6, 0x9b, 0x58, 0x5a, 0xad, 0xed, 0x1e, 0x72, 0x6f, 0xa2, 0xb8,
+  0xab, 0xf3, 0x46, 0xb9, 0xfa, 0x7a, 0xb2, 0xb3, 0xcf, 0x6d, 0xde, 0x0c, 0x74, 0x66, 0x39, 0xdd,
+  0x5e, 0x70, 0x49, 0xf1, 0x2c, 0x28, 0x8d, 0xa3, 0x17, 0x23, 0x99, 0x17, 0xad, 0xce, 0x01, 0x8c,
+  0xee, 0x04, 0x86, 0xe5, 0xa8, 0x73, 0x3b, 0xb2, 0xcc, 0xa0, 0x0d, 0x5a, 0xaa, 0xaa, 0xec, 0xdb,
+  0xdc, 0x3a, 0x68, 0x07, 0x28, 0x7c, 0x55, 0xf0, 0xe1, 0x44, 0x48, 0x25, 0x46, 0x2f, 0x70, 0xe3,
+  0xe9, 0xb8, 0xbe, 0x15, 0x58, 0xb0, 0x70, 0xe6, 0x71, 0xdb, 0x08, 0xac, 0xc3, 0x58, 0xc2, 0x28,
+  0x89, 0x96, 0xed, 0x1e, 0xd5, 0x58, 0xdb, 0x32, 0x4d, 0xee, 0x64, 0xd4, 0x38, 0x0b, 0xcc, 0x7c,
+  0xd7, 0xb6, 0x4c, 0xf6, 0xea, 0xfc, 0xfc, 0xfc, 0x38, 0x0d, 0x54, 0x12, 0x16, 0x90, 0x95, 0xa7,
+  0x69, 0x9a, 0xf1, 0x7a, 0xc5, 0xc3, 0xab, 0x4d, 0xc3, 0x39, 0x34, 0xfc, 0xf5, 0xb5, 0x77, 0x1b,
+  0x99, 0xe5, 0xce, 0x25, 0x16, 0xf6, 0x53, 0x97, 0x6b, 0x5a, 0x7e, 0xd7, 0x36, 0x60, 0x63, 0xec,
+  0xdb, 0x6e, 0xf3, 0xde, 0xff, 0x69, 0x45, 0xe5, 0x72, 0x6c, 0xbb, 0x56, 0xc7, 0x38, 0xe0, 0x33,
+  0x1e, 0x77, 0x80, 0x01, 0xa9, 0xbd, 0x6b, 0xdd, 0x47, 0x41, 0xf3, 0xcc, 0xa2, 0x8b, 0x9e, 0x1b,
+  0x60, 0x7b, 0xbc, 0xe2, 0x58, 0x37, 0xc6, 0x3e, 0xcc, 0xaa, 0xa7, 0x58, 0x7f, 0xe0, 0x76, 0xc1,
+  0xac, 0xca, 0xbf, 0x88, 0x1a, 0x6c, 0xde, 0x0a, 0x92, 0x2d, 0xa1, 0x68, 0x92, 0xf6, 0x21, 0xa5,
+  0x98, 0x94, 0x57, 0xe0, 0x81, 0x7f, 0x68, 0xb9, 0x5e, 0xa7, 0x26, 0x1e, 0x71, 0x7e, 0xda, 0x0c,
+  0x30, 0xd3, 0x19, 0xfe, 0x5b, 0x60, 0x62, 0x6a, 0xda, 0xcc, 0xeb, 0x65, 0x93, 0x1f, 0x14, 0xb2,
+  0xfd, 0x66, 0x5c, 0xcf, 0x22, 0x89, 0x0b, 0x4f, 0x92, 0x74, 0x28, 0x64, 0xc6, 0xf5, 0x52, 0xe8,
+  0xd3, 0xea, 0x25, 0xe9, 0x23, 0xe1, 0x11, 0x7d, 0x9b, 0xf0, 0x78, 0xed, 0xd9, 0xac, 0x43, 0x84,
+  0x36, 0x21, 0x9c, 0xba, 0x69, 0x1d, 0x2e, 0xd7, 0xf7, 0x97, 0xb7, 0x37, 0x1b, 0xab, 0x3b, 0x5b,
+  0x1b, 0x6f, 0x6e, 0xad, 0xdc, 0xac, 0xd5, 0x4b, 0xfb, 0xcb, 0xf5, 0x12, 0x7e, 0x08, 0x29, 0x58,
+  0xd3, 0x36, 0x7c, 0x7f, 0x29, 0x97, 0xd8, 0x2e, 0x39, 0xe9, 0x45, 0xeb, 0xd0, 0xca, 0x2c, 0x93,
+  0xbe, 0x2a, 0x6c, 0x72, 0x61, 0x27, 0x29, 0x7c, 0xe9, 0xa1, 0x25, 0x5f, 0x75, 0x6c, 0x34, 0xc6,
+  0xf4, 0xa0, 0xc2, 0x4c, 0x89, 0x6d, 0x6c, 0xb1, 0x39, 0x21, 0xe3, 0xa5, 0x1c, 0x58, 0x6a, 0x4e,
+  0x6a, 0x61, 0x29, 0x57, 0xad, 0xe4, 0xa0, 0xa7, 0xa0, 0x0a, 0x39, 0x77, 0xc3, 0xb9, 0x49, 0xb7,
+  0x1a, 0x1c, 0x77, 0xf9, 0x52, 0x4e, 0xbc, 0xe4, 0x88, 0xeb, 0xb5, 0x9d, 0x5b, 0x7b, 0x36, 0xec,
+  0xc9, 0x1c, 0x0d, 0xcf, 0xb6, 0x77, 0x56, 0xb6, 0x76, 0x60, 0x0e, 0x44, 0x71, 0xa9, 0xce, 0xa6,
+  0x11, 0x18, 0x10, 0x7f, 0x72, 0xcb, 0xd7, 0x57, 0x76, 0x56, 0xb6, 0x1b, 0xe9, 0xce, 0xef, 0xf4,
+  0x78, 0x8f, 0x9b, 0x35, 0x60, 0x42, 0x3d, 0x7e, 0x8f, 0xaf, 0xab, 0x60, 0xcb, 0xd0, 0xa1, 0x8c,
+  0x6b, 0x9d, 0x34, 0x84, 0xeb, 0x34, 0x6d, 0xab, 0x79, 0x6f, 0x29, 0x07, 0x3b, 0xc9, 0x40, 0x33,
+  0x2d, 0x82, 0x07, 0x71, 0x0d, 0x53, 0x2b, 0x2c, 0xe6, 0x96, 0xb7, 0x1a, 0x37, 0xb6, 0x1a, 0xdb,
+  0x6f, 0xb1, 0xcd, 0x95, 0x37, 0x1b, 0x89, 0x31, 0xeb, 0xa5, 0x6e, 0x66, 0xf9, 0xc2, 0x7b, 0xd2,
+  0x0c, 0xb6, 0x1b, 0xeb, 0x7b, 0xb6, 0xb1, 0xcf, 0xed, 0x50, 0x6f, 0xf0, 0xd9, 0xed, 0x22, 0x77,
+  0x76, 0x68, 0xd8, 0x3d, 0x18, 0xbe, 0xbc, 0xf7, 0x3b, 0xee, 0xb9, 0x30, 0x3f, 0xfa, 0xad, 0x97,
+  0xc4, 0xd7, 0x71, 0xd4, 0x95, 0xbd, 0x0d, 0x07, 0xa4, 0x47, 0x3f, 0xd3, 0x68, 0x67, 0xf7, 0x76,
+  0x8e, 0x80, 0x31, 0xfd, 0x4c, 0xa3, 0x9d, 0xdb, 0xdb, 0x69, 0x7b, 0x1c, 0x38, 0xcb, 0x87, 0x14,
+  0x3d, 0x58, 0x3b, 0xad, 0x29, 0x32, 0x3e, 0x8a, 0x0b, 0x42, 0x7e, 0x18, 0x78, 0x85, 0x82, 0xd6,
+  0x6e, 0xed, 0x79, 0xbc, 0xc9, 0x41, 0xbf, 0x5e, 0x8e, 0x81, 0x5b, 0x6a, 0xf2, 0xb6, 0x6b, 0x83,
+  0x9f, 0x80, 0x69, 0xbf, 0x3e, 0x5b, 0xac, 0x5c, 0x5d, 0x28, 0x56, 0x8a, 0xb0, 0x51, 0x6b, 0xf3,
+  0xe5, 0xf2, 0x7c, 0x6e, 0x8c, 0xb0, 0x5a, 0xdc, 0x08, 0x7a, 0x1e, 0xf7, 0xc7, 0xcb, 0x2b, 0xb7,
+  0xbc, 0xb9, 0x7a, 0x73, 0xaa, 0x9c, 0x72, 0xcb, 0x21, 0x27, 0x08, 0x62, 0x41, 0xe5, 0xea, 0x54,
+  0x61, 0x29, 0x1d, 0x7a, 0xd0, 0x63, 0x61, 0x6a, 0x87, 0xf9, 0x85, 0x74, 0x17, 0xd8, 0xeb, 0xd9,
+  0xa9, 0xa5, 0x45, 0x37, 0xd1, 0xbc, 0xf7, 0x7b, 0xf6, 0xbd, 0xdc, 0xf2, 0xb5, 0xdd, 0xf5, 0xb7,
+  0x5f, 0x62, 0x6f, 0xf0, 0xfb, 0x5d, 0xd7, 0x03, 0x4b, 0x6f, 0xfc, 0x66, 0x73, 0x23, 0xd5, 0x55,
+  0x58, 0xa9, 0xdc, 0xfc, 0xab, 0xb6, 0xd5, 0xf5, 0x21, 0x3c, 0x36, 0x31, 0x0a, 0xc4, 0x9b, 0x05,
+  0xc7, 0x56, 0xf7, 0x0a, 0xa0, 0xac, 0xc0, 0xf5, 0xc0, 0x7f, 0xe3, 0x80, 0x6d, 0xce, 0x4c, 0x7e,
+  0x68, 0x35, 0x79, 0x44, 0x4e, 0x1f, 0x55, 0xfa, 0xa4, 0xf3, 0x5a, 0xde, 0x0e, 0x3c, 0x6e, 0x74,
+  0x14, 0x72, 0x7c, 0xdd, 0x02, 0x9f, 0x24, 0xc9, 0xd9, 0xb5, 0x92, 0xaf, 0x33, 0xda, 0xa1, 0x0c,
+  0xfd, 0xb3, 0xd3, 0x3c, 0x4e, 0xd2, 0xae, 0x8b, 0xc6, 0x90, 0xbc, 0x03, 0xd4, 0xa6, 0xe7, 0x76,
+  0xbb, 0x30, 0xa3, 0x04, 0xdd, 0x75, 0xd1, 0x98, 0x9a, 0x85, 0x80, 0x9d, 0x4d, 0xcf, 0xea, 0x86,
+  0x92, 0x3f, 0x34, 0x3c, 0xb6, 0x0d, 0x41, 0x92, 0x07, 0x8b, 0x71, 0x03, 0x2e, 0x9a, 0x2d, 0xb1,
+  0x96, 0x61, 0xfb, 0x5c, 0x69, 0x16, 0xa2, 0x84, 0xf8, 0x96, 0xfa, 0x56, 0x2a, 0xb1, 0xc1, 0x5f,
+  0x07, 0x67, 0x83, 0x8b, 0xc1, 0xf9, 0xf0, 0x93, 0xc1, 0xf3, 0xe1, 0x67, 0x83, 0x1f, 0xd8, 0xe0,
+  0xc5, 0xf0, 0xc1, 0xe0, 0x62, 0xf8, 0x08, 0x1a, 0x9f, 0xc2, 0xdf, 0x67, 0x6c, 0xf8, 0x10, 0x7e,
+  0x2e, 0x06, 0xdf, 0x0c, 0xff, 0x38, 0xe8, 0x0f, 0x9e, 0x0f, 0xce, 0x81, 0x46, 0xbb, 0xc9, 0x7d,
+  0x1f, 0x02, 0xe7, 0x5e, 0x17, 0xfc, 0xb2, 0x0b, 0x71, 0xb5, 0xd8, 0x2e, 0xd4, 0x18, 0xf4, 0x39,
+  0x1f, 0xbc, 0xd0, 0xd9, 0xf0, 0xc3, 0xc1, 0xb3, 0xc1, 0xe9, 0xe0, 0xdb, 0xc1, 0xb9, 0xce, 0x06,
+  0x4f, 0xe0, 0xf9, 0x1c, 0xba, 0x9d, 0xe2, 0xe3, 0x29, 0x3c, 0xc0, 0x28, 0xc3, 0x8f, 0x98, 0xd6,
+  0x23, 0x33, 0x2e, 0xe8, 0x4a, 0xf3, 0xa0, 0x5f, 0x14, 0xd3, 0x82, 0xe8, 0xe0, 0x07, 0xec, 0xe6,
+  0xf6, 0x9b, 0x7b, 0xab, 0x1b, 0xb7, 0x20, 0x12, 0xac, 0xc3, 0xb4, 0x2b, 0x3a, 0x35, 0xfc, 0x7a,
+  0xb3, 0xf1, 0x26, 0xbc, 0xcd, 0x8a, 0xb7, 0xad, 0x8d, 0xf7, 0xe0, 0x65, 0x4e, 0xbc, 0xac, 0xec,
+  0x5e, 0x5f, 0xdb, 0x80, 0xd7, 0xaa, 0x78, 0x05, 0x83, 0xdb, 0xd9, 0x86, 0xd7, 0x10, 0x26, 0x08,
+  0xa6, 0x10, 0x58, 0xd6, 0xf7, 0xa4, 0xb3, 0x15, 0x5c, 0xa9, 0x85, 0x4c, 0x94, 0xd8, 0xd2, 0x2b,
+  0x79, 0x73, 0x62, 0x4c, 0xaf, 0x2b, 0xab, 0x6f, 0x0b, 0xbe, 0xf4, 0x26, 0xec, 0x11, 0x39, 0xcb,
+  0x86, 0x1b, 0x8d, 0x95, 0x9d, 0x5d, 0x70, 0xa7, 0xd0, 0x74, 0x35, 0x3b, 0x18, 0xb2, 0xa6, 0xc9,
+  0x20, 0xc7, 0xca, 0x55, 0x65, 0x40, 0x58, 0xdd, 0xee, 0x2d, 0x9a, 0xc5, 0xaf, 0x64, 0xeb, 0xf6,
+  0xce, 0xc6, 0x56, 0x23, 0x6e, 0x5e, 0x48, 0x8c, 0x18, 0x33, 0x79, 0x3d, 0x3b, 0xca, 0x3b, 0xbb,
+  0x8d, 0x5d, 0xfc, 0x36, 0x5b, 0x56, 0x54, 0xfb, 0x0f, 0x90, 0xec, 0x93, 0xe1, 0x83, 0xe1, 0x67,
+  0x6c, 0x70, 0x3a, 0x7c, 0x0c, 0x82, 0x3e, 0x07, 0x3d, 0xbe, 0x88, 0x94, 0x7b, 0x8a, 0x1a, 0xeb,
+  0x0f, 0x9e, 0x0e, 0x1f, 0x93, 0x6a, 0x41, 0xf5, 0xdf, 0x43, 0x87, 0x17, 0x60, 0x0b, 0x0f, 0x07,
+  0xe7, 0x4c, 0x83, 0x7f, 0x7f, 0x2c, 0xb2, 0x95, 0x9e, 0x69, 0xb9, 0x7b, 0xc2, 0x34, 0xc1, 0x80,
+  0x40, 0xd1, 0xc5, 0xd8, 0xae, 0x44, 0xf3, 0x5e, 0xcb, 0x33, 0x3a, 0xe0, 0x34, 0x96, 0xd8, 0xed,
+  0x3b, 0xca, 0xe8, 0x7f, 0x83, 0xe1, 0xce, 0x60, 0xe0, 0x2f, 0xd1, 0x82, 0x5e, 0xd0, 0x40, 0x8f,
+  0xd0, 0xb4, 0x06, 0xdf, 0xc2, 0xbf, 0xa7, 0x83, 0x1f, 0xe1, 0xbf, 0xd3, 0x1a, 0xc3, 0x79, 0x0c,
+  0xbe, 0x43, 0x23, 0x20, 0x42, 0x49, 0x82, 0x93, 0xd3, 0xaa, 0x15, 0x86, 0xb3, 0x05, 0x03, 0xba,
+  0x00, 0x0e, 0x30, 0xdb, 0x4f, 0x80, 0xe8, 0x21, 0x4e, 0x7e, 0xf8, 0xa8, 0xc0, 0x66, 0x18, 0x7c,
+  0xc2, 0x25, 0x3d, 0x67, 0xa2, 0x11, 0xe8, 0xbe, 0x19, 0xf4, 0x87, 0x1f, 0x33, 0x32, 0xe8, 0x27,
+  0xb4, 0xd4, 0x53, 0x64, 0xac, 0x4c, 0x18, 0x83, 0xf5, 0x88, 0xfd, 0x81, 0xcd, 0x7b, 0x22, 0xf8,
+  0xeb, 0xf2, 0x25, 0xb8, 0x1f, 0x3e, 0x01, 0xb2, 0xeb, 0x20, 0xb8, 0x16, 0xe4, 0xa6, 0xdb, 0xec,
+  0x75, 0x00, 0x3e, 0x15, 0x0f, 0x78, 0xd0, 0xb0, 0x39, 0x3e, 0x5e, 0x3b, 0x5e, 0x33, 0xb5, 0xbc,
+  0x12, 0xce, 0xf3, 0x85, 0x22, 0x64, 0x11, 0x8d, 0x43, 0xf8, 0xb6, 0x6e, 0xf9, 0xb0, 0xed, 0xb9,
+  0xa7, 0xe5, 0x29, 0x1a, 0xe7, 0x75, 0x99, 0xc8, 0x84, 0xa4, 0x21, 0x58, 0x9b, 0xc8, 0x16, 0x77,
+  0xf5, 0x65, 0x78, 0x22, 0xdd, 0xa5, 0x18, 0xe2, 0xc2, 0x2e, 0xc3, 0x10, 0xe9, 0x2e, 0xc5, 0x50,
+  0x38, 0x98, 0xcb, 0xb0, 0x14, 0x94, 0x53, 0x99, 0xaa, 0xb1, 0x73, 0x34, 0xdb, 0xb6, 0xe1, 0x1c,
+  0x70, 0xe0, 0x2b, 0xc2, 0x51, 0x44, 0x5c, 0x88, 0x34, 0xd5, 0xea, 0x39, 0x4d, 0x8a, 0x70, 0x96,
+  0x63, 0x05, 0x5a, 0x21, 0xc6, 0xed, 0xc2, 0x6b, 0x82, 0x19, 0x38, 0xfc, 0x88, 0xbd, 0xc7, 0xf7,
+  0xc5, 0xbb, 0x96, 0x3f, 0xf2, 0x6b, 0xa5, 0x52, 0x1e, 0xa2, 0xde, 0x91, 0xe5, 0x98, 0xee, 0x51,
+  0x31, 0x02, 0x4e, 0x6d, 0xd7, 0x0f, 0x1c, 0x30, 0x71, 0xf8, 0x94, 0xaf, 0x2d, 0x54, 0x4a, 0xf9,
+  0x18, 0x62, 0x8b, 0xbe, 0xc5, 0x7d, 0xcb, 0x31, 0xbc, 0xe3, 0x1d, 0x88, 0x63, 0xc0, 0x36, 0x6f,
+  0x78, 0x9e, 0x71, 0xbc, 0xdf, 0x6b, 0xb5, 0xb8, 0x97, 0x8f, 0x33, 0x80, 0xd8, 0xc6, 0x80, 0x66,
+  0xec, 0xc2, 0x63, 0xa0, 0xaa, 0x8c, 0x12, 0x9a, 0x24, 0x74, 0x54, 0xd8, 0x60, 0xdf, 0x55, 0x00,
+  0xd2, 0x00, 0x58, 0xb4, 0xfc, 0xac, 0x99, 0xa1, 0x27, 0xc3, 0x8d, 0xba, 0x04, 0xf7, 0x8b, 0x4d,
+  0xd8, 0xad, 0x01, 0x5f, 0xc3, 0x94, 0xe7, 0x3a, 0x98, 0x9f, 0x56, 0xd1, 0x13, 0xec, 0x04, 0x16,
+  0xce, 0xac, 0xcd, 0x75, 0x3a, 0xc2, 0xdb, 0xe3, 0xc6, 0x91, 0x32, 0xd5, 0x38, 0x6a, 0x43, 0x91,
+  0x29, 0x64, 0x43, 0x9e, 0xdb, 0x04, 0xba, 0x55, 0xb7, 0xd3, 0x31, 0x1c, 0x53, 0x12, 0x44, 0xbc,
+  0x4e, 0xd2, 0xe9, 0x14, 0x7a, 0x88, 0xaf, 0x53, 0x81, 0xa5, 0x1f, 0x6b, 0x83, 0x81, 0x77, 0xb8,
+  0x00, 0xbf, 0xd0, 0x1f, 0x3e, 0x12, 0x01, 0xe8, 0x09, 0x3c, 0x3e, 0x80, 0x86, 0x53, 0xf0, 0x10,
+  0x9f, 0x33, 0x20, 0xef, 0x43, 0x33, 0x05, 0xa8, 0xe1, 0xe7, 0xf8, 0x3b, 0x2a, 0x4c, 0xa5, 0x43,
+  0x19, 0x06, 0x21, 0x74, 0x28, 0xe8, 0x13, 0xbf, 0x1c, 0x3c, 0x29, 0xa6, 0xec, 0x64, 0xe4, 0x0a,
+  0xe2, 0x25, 0x5a, 0x2d, 0xa6, 0xbd, 0x22, 0x5a, 0x8b, 0xb8, 0x7b, 0xc1, 0xae, 0xfc, 0xc0, 0x70,
+  0x9a, 0xdc, 0x6d, 0xb1, 0x15, 0xd4, 0xf8, 0x35, 0xd2, 0x78, 0x21, 0x21, 0x15, 0x74, 0xd1, 0xae,
+  0xcd, 0x8b, 0xdc, 0xf3, 0x5c, 0x4f, 0xcb, 0xed, 0x3a, 0x60, 0xff, 0x60, 0xae, 0x10, 0xf4, 0x51,
+  0x6d, 0x4c, 0x4a, 0xb6, 0x96, 0xd3, 0x59, 0xcc, 0x38, 0x96, 0x1a, 0x03, 0x58, 0x03, 0x56, 0x1d,
+  0xa7, 0xf6, 0x27, 0xe1, 0x83, 0x08, 0xf6, 0x38, 0x1e, 0x68, 0x25, 0xee, 0xba, 0xa8, 0x7e, 0x3f,
+  0xb4, 0xc0, 0xbe, 0x85, 0x95, 0xa3, 0xba, 0xdf, 0x85, 0x57, 0x4d, 0xf4, 0x29, 0x24, 0xe8, 0xdc,
+  0x56, 0xcb, 0xa7, 0xfd, 0x10, 0xa7, 0xc5, 0x47, 0x6d, 0xcb, 0xe6, 0x4c, 0x93, 0x5f, 0xae, 0xb0,
+  0x2a, 0xab, 0x2f, 0xc9, 0xf1, 0x8a, 0xfb, 0xc7, 0x01, 0x5f, 0xe7, 0xce, 0x41, 0xd0, 0x4e, 0xac,
+  0x14, 0x39, 0x05, 0x62, 0x03, 0xe0, 0xc0, 0x68, 0x9c, 0xbb, 0x88, 0x22, 0x25, 0x13, 0x75, 0x51,
+  0x48, 0xda, 0xb2, 0x8d, 0x03, 0x7f, 0x0c, 0x2d, 0x0c, 0x58, 0x49, 0xd3, 0xdb, 0x34, 0x62, 0xaa,
+  0x43, 0xe5, 0x6a, 0xdc, 0x03, 0x62, 0x77, 0xe0, 0xf5, 0xb8, 0xda, 0x0f, 0x35, 0xa6, 0x2c, 0xe1,
+  0x4a, 0xc8, 0x64, 0x79, 0xca, 0x52, 0x32, 0x6a, 0xdb, 0xf1, 0xc0, 0x46, 0x28, 0xf9, 0x0f, 0xb7,
+  0x02, 0xe8, 0x1c, 0x17, 0x0b, 0x7a, 0xc3, 0x1f, 0x75, 0xd0, 0x8c, 0xce, 0x14, 0xad, 0x41, 0xd6,
+  0x0f, 0x96, 0x65, 0xf3, 0x3d, 0xc9, 0x46, 0xc3, 0xce, 0xba, 0x90, 0x85, 0x3e, 0x4a, 0x51, 0x3a,
+  0x8b, 0xe7, 0xaf, 0xcb, 0xe9, 0x17, 0xd4, 0xd1, 0xc2, 0xcf, 0x4b, 0xca, 0xfa, 0xd2, 0xd6, 0x72,
+  0x92, 0xf1, 0x88, 0x93, 0x66, 0x41, 0x16, 0x98, 0xb4, 0x7a, 0xa1, 0xd6, 0xa5, 0x25, 0x15, 0x92,
+  0x65, 0x74, 0x4f, 0x79, 0x04, 0x7a, 0x36, 0xe8, 0x8f, 0xfa, 0x59, 0x73, 0x82, 0xb9, 0x59, 0xad,
+  0x3c, 0x5a, 0x2b, 0x52, 0xfb, 0xc0, 0x32, 0x85, 0x91, 0x52, 0x7a, 0x90, 0x78, 0x56, 0xf2, 0x06,
+  0xe8, 0x93, 0x10, 0xf4, 0x65, 0x82, 0xa6, 0xe5, 0x40, 0xb8, 0x78, 0x6b, 0xe7, 0x26, 0x62, 0x48,
+  0xe2, 0xf6, 0x06, 0xcb, 0xcb, 0x84, 0x64, 0x63, 0x33, 0xcf, 0x6a, 0xd1, 0x1b, 0xa4, 0x27, 0x79,
+  0x55, 0x67, 0x8c, 0x03, 0x46, 0x18, 0x3b, 0x59, 0xc2, 0x68, 0xa9, 0xc9, 0x8e, 0x9d, 0x4e, 0x94,
+  0x8a, 0xa4, 0xe6, 0x43, 0xcb, 0xba, 0xd4, 0x98, 0x0a, 0x30, 0xbc, 0xec, 0xa0, 0x71, 0x42, 0xf3,
+  0xd2, 0xa3, 0x12, 0xa8, 0x4c, 0x8d, 0x87, 0x7e, 0xfb, 0xef, 0x08, 0x13, 0xc9, 0xb5, 0x3e, 0x04,
+  0x6c, 0x19, 0xa2, 0xe9, 0xe1, 0x9f, 0xc8, 0xd3, 0xfe, 0x10, 0xa2, 0x38, 0x44, 0xf5, 0x98, 0x56,
+  0x3c, 0xa5, 0x3c, 0x00, 0x9d, 0xf9, 0x39, 0xc1, 0xbc, 0x2f, 0xc0, 0x43, 0xa3, 0xaf, 0x4f, 0xa2,
+  0x4d, 0xf0, 0xf7, 0xe7, 0x80, 0x10, 0x91, 0xe9, 0x87, 0x40, 0xfc, 0x9c, 0x49, 0x5f, 0x4e, 0x7e,
+  0x1c, 0x92, 0x08, 0x40, 0x87, 0x83, 0x33, 0x20, 0xed, 0x43, 0xf2, 0x20, 0x9c, 0x38, 0x30, 0x7e,
+  0x06, 0xcc, 0x3e, 0x19, 0x7e, 0x15, 0x66, 0x15, 0x21, 0x34, 0x9d, 0x22, 0x99, 0xb8, 0x8c, 0xf2,
+  0xd2, 0x92, 0x51, 0x11, 0x79, 0x4a, 0x40, 0x6a, 0xae, 0xf5, 0x32, 0x76, 0x1b, 0x41, 0x29, 0x75,
+  0x66, 0x31, 0x53, 0x30, 0x5f, 0x99, 0x80, 0x44, 0x06, 0x2c, 0xde, 0xf3, 0xa3, 0x1c, 0x8e, 0xb2,
+  0x82, 0xc4, 0x26, 0xc6, 0x34, 0x2a, 0xb3, 0x83, 0xef, 0x76, 0xf9, 0x81, 0x8c, 0x17, 0xd7, 0x6c,
+  0x77, 0x5f, 0xbb, 0x8d, 0x4f, 0xe4, 0x97, 0x29, 0xbc, 0x69, 0xb4, 0xb3, 0x43, 0xbf, 0x24, 0x5e,
+  0xc0, 0x7f, 0x6e, 0x90, 0x07, 0x52, 0x1a, 0xa4, 0x43, 0xbd, 0xa3, 0xb3, 0xf7, 0x71, 0x4c, 0x98,
+  0x20, 0x15, 0x59, 0x4b, 0xc8, 0x3e, 0x7f, 0xa2, 0x7a, 0x82, 0xb1, 0x72, 0x48, 0x16, 0x01, 0x41,
+  0x16, 0xbe, 0xd7, 0x84, 0x99, 0xed, 0x6e, 0xad, 0x4b, 0x0c, 0xb3, 0xb1, 0x7f, 0x17, 0xa2, 0x28,
+  0xbc, 0x6b, 0xc8, 0x55, 0x81, 0x19, 0x63, 0xd6, 0x0b, 0x89, 0x62, 0x62, 0xb9, 0x04, 0x7b, 0x3c,
+  0xf7, 0x48, 0xfb, 0x9f, 0x96, 0x38, 0x7d, 0x5c, 0xca, 0x49, 0x13, 0x23, 0xab, 0x29, 0x93, 0xa6,
+  0xba, 0xdc, 0xa9, 0xbc, 0x28, 0xa1, 0x4d, 0xf0, 0x9a, 0xb0, 0xf7, 0xc3, 0xea, 0x44, 0xca, 0x8e,
+  0x42, 0xe7, 0x8c, 0x4b, 0x1e, 0xed, 0x9d, 0xa7, 0xf0, 0x94, 0x55, 0x8c, 0xc9, 0x6c, 0xab, 0x3f,
+  0x99, 0xad, 0x2c, 0x7a, 0x4c, 0x66, 0xbb, 0x90, 0x66, 0x7b, 0x32, 0x02, 0x53, 0xfe, 0x0b, 0x9c,
+  0xd0, 0x0b, 0xf2, 0x3e, 0x67, 0xe0, 0x5a, 0x10, 0x2b, 0x42, 0x7a, 0x1b, 0xa6, 0x95, 0x3f, 0x50,
+  0xa6, 0x78, 0x36, 0x7c, 0x0c, 0x8d, 0x11, 0x15, 0xb8, 0x16, 0xf2, 0x49, 0x7d, 0xf0, 0x49, 0x19,
+  0x10, 0xd9, 0x5f, 0x54, 0x93, 0xd2, 0x73, 0x74, 0x3d, 0x88, 0x43, 0xfb, 0xd2, 0x93, 0x3d, 0x82,
+  0x8f, 0x5f, 0x92, 0x3f, 0x82, 0x9e, 0xcf, 0x84, 0x53, 0x7b, 0x0e, 0x5f, 0x3e, 0x11, 0xdd, 0x29,
+  0xa5, 0x05, 0xb0, 0x0a, 0xa3, 0x3d, 0x03, 0x37, 0xf5, 0x23, 0xb8, 0x30, 0x46, 0x50, 0xf4, 0xf9,
+  0xf0, 0xe3, 0xa8, 0xda, 0x11, 0x45, 0x65, 0x9f, 0x3b, 0xe6, 0x1e, 0x56, 0xc6, 0x3d, 0xd7, 0xd6,
+  0xee, 0xf1, 0x63, 0x5d, 0xf8, 0x0f, 0x2c, 0x5c, 0xe1, 0xd9, 0x84, 0xaf, 0xe8, 0x9e, 0xe0, 0x1f,
+  0x18, 0x62, 0x22, 0xe9, 0x66, 0x4c, 0x93, 0x94, 0xec, 0x83, 0x0f, 0xa0, 0xb9, 0x50, 0x6c, 0xb9,
+  0x5e, 0xc3, 0x68, 0xb6, 0xb5, 0x08, 0xb6, 0x23, 0xe8, 0x4c, 0x98, 0x10, 0x50, 0x30, 0x0d, 0xb9,
+  0x59, 0x84, 0xff, 0xe0, 0xa7, 0x4e, 0xc8, 0xb4, 0x28, 0xa1, 0x04, 0xb3, 0xae, 0x5c, 0x29, 0x88,
+  0xa1, 0x8a, 0xdd, 0x9e, 0xdf, 0x26, 0x0e, 0x45, 0x3c, 0x36, 0x5d, 0x75, 0x4d, 0xbe, 0x12, 0x68,
+  0x56, 0x81, 0xbd, 0xc6, 0xca, 0xf7, 0x6f, 0xdc, 0x50, 0xb5, 0xad, 0xd0, 0x97, 0x15, 0x75, 0x25,
+  0x61, 0x67, 0x9c, 0x55, 0x24, 0x80, 0x0f, 0xbe, 0x28, 0x70, 0x5a, 0xc3, 0x32, 0xa4, 0xe0, 0x97,
+  0x81, 0x3f, 0x92, 0x43, 0xd1, 0x0f, 0xe1, 0x63, 0x59, 0x4f, 0x40, 0x94, 0xf1, 0x84, 0x90, 0xf9,
+  0x80, 0x80, 0xc7, 0x12, 0x00, 0xae, 0x04, 0x38, 0x59, 0x4d, 0x8d, 0x9c, 0x36, 0x3f, 0xa5, 0xd3,
+  0x5a, 0x68, 0xf7, 0x52, 0x63, 0x49, 0x42, 0xc1, 0x24, 0xa3, 0x0c, 0x6c, 0xd6, 0x19, 0x08, 0xf0,
+  0xfd, 0xec, 0x04, 0x71, 0xd5, 0x96, 0x4e, 0x3d, 0x0b, 0x8b, 0xaa, 0xe4, 0x64, 0x52, 0x86, 0xb6,
+  0xa2, 0x85, 0xbd, 0x92, 0xa0, 0x3e, 0x95, 0x62, 0x3d, 0xc1, 0x8d, 0x80, 0x26, 0x28, 0x12, 0xa7,
+  0x44, 0x6d, 0x84, 0x51, 0x61, 0x2e, 0x5b, 0x3e, 0x01, 0x4b, 0x46, 0x42, 0x86, 0x06, 0x8f, 0xe6,
+  0xfc, 0x80, 0xa2, 0xf4, 0x05, 0x95, 0x73, 0x68, 0x4b, 0x3d, 0x8c, 0x76, 0xcf, 0x29, 0x52, 0x5c,
+  0xe0, 0x9e, 0x1a, 0x7e, 0xa1, 0x6c, 0x15, 0xd8, 0x62, 0x1a, 0x6d, 0xa0, 0xef, 0x71, 0xdb, 0xe0,
+  0xce, 0x52, 0x8a, 0x37, 0x58, 0x90, 0x3a, 0x13, 0x5f, 0x87, 0x8f, 0x0b, 0xe9, 0x6d, 0x10, 0xf9,
+  0x66, 0x12, 0x9b, 0x62, 0xad, 0x51, 0x1e, 0x6b, 0x7a, 0xc6, 0x11, 0x65, 0xb1, 0x5a, 0xa2, 0x70,
+  0x33, 0x03, 0x5a, 0x2d, 0x27, 0x6d, 0x4c, 0xa4, 0xb4, 0xa9, 0xb4, 0x59, 0x34, 0x2a, 0x87, 0xbb,
+  0xd9, 0x2d, 0x20, 0xfb, 0xbd, 0xf6, 0x1a, 0xbd, 0xa9, 0x46, 0x20, 0x77, 0x44, 0x2a, 0x74, 0x76,
+  0xa1, 0xab, 0x26, 0x3b, 0xcd, 0xb0, 0x0a, 0xfc, 0x05, 0xb5, 0xfe, 0x92, 0x55, 0x17, 0x53, 0x21,
+  0x47, 0xe4, 0xe4, 0x94, 0xaa, 0xdd, 0xee, 0xde, 0x89, 0xe6, 0xa5, 0xb6, 0x62, 0xf2, 0x33, 0xf6,
+  0xcb, 0x2c, 0x7e, 0xa1, 0xe9, 0xdc, 0xb6, 0xee, 0x4c, 0x64, 0x0e, 0xc4, 0x73, 0x48, 0x3c, 0xab,
+  0x9c, 0x93, 0x9e, 0x64, 0x24, 0xd9, 0xed, 0x05, 0x71, 0x39, 0x40, 0x61, 0x92, 0x2c, 0x0c, 0xd0,
+  0x81, 0x19, 0xae, 0x4b, 0x91, 0x6f, 0xc2, 0xca, 0x64, 0xa1, 0x71, 0x4c, 0x99, 0xb1, 0xa6, 0x54,
+  0x84, 0x09, 0xe8, 0x3d, 0x23, 0xf2, 0x4f, 0xc9, 0x2e, 0xaa, 0x0c, 0xcc, 0x0e, 0x1c, 0xf5, 0xe0,
+  0xb4, 0x40, 0xe6, 0x26, 0x70, 0x25, 0x7a, 0xd8, 0xef, 0x44, 0xfd, 0x50, 0x56, 0x06, 0x34, 0x32,
+  0x1e, 0x30, 0xc5, 0x51, 0xfd, 0xce, 0xc2, 0x42, 0x61, 0x3f, 0x1e, 0x0a, 0x6c, 0x52, 0x8f, 0x67,
+  0xa8, 0x14, 0x99, 0xb1, 0x72, 0x88, 0x26, 0xfb, 0x23, 0x7a, 0x72, 0x51, 0x7f, 0x7c, 0x82, 0xc6,
+  0xac, 0x27, 0x9a, 0x85, 0x9f, 0xc7, 0xdd, 0xf2, 0x2d, 0x6e, 0x84, 0x0b, 0x72, 0xf5, 0x80, 0x35,
+  0x71, 0x44, 0x3d, 0xf1, 0x3e, 0xfc, 0x2c, 0xe3, 0xc8, 0xc7, 0xc5, 0xf8, 0xa4, 0x03, 0x37, 0x79,
+  0x13, 0x90, 0x11, 0xf5, 0x58, 0x92, 0xf9, 0xf0, 0xf2, 0xb2, 0x62, 0x33, 0x54, 0x61, 0xe5, 0x80,
+  0x56, 0x9d, 0x26, 0xbf, 0x44, 0xec, 0x4e, 0xa4, 0xf2, 0xd3, 0x22, 0x32, 0xca, 0xe4, 0xdf, 0x54,
+  0x0a, 0x81, 0x78, 0x28, 0x4b, 0x2b, 0x4f, 0xa2, 0x32, 0x0c, 0xe9, 0xee, 0x29, 0x56, 0x8e, 0x49,
+  0x03, 0x54, 0x84, 0x19, 0x15, 0x45, 0x49, 0xbf, 0xcf, 0x51, 0x3e, 0x02, 0xa1, 0x8b, 0x20, 0x08,
+  0x4c, 0x1f, 0x0b, 0x94, 0x8f, 0x58, 0x3d, 0x94, 0x2f, 0xe8, 0x23, 0x82, 0xe7, 0x89, 0x48, 0x17,
+  0x96, 0xd8, 0xf5, 0x68, 0xb1, 0xf1, 0x34, 0x63, 0xe8, 0xfd, 0x1a, 0xab, 0x8c, 0xc5, 0x51, 0xa9,
+  0x28, 0x78, 0x32, 0xaa, 0xf7, 0x6c, 0xb2, 0xb7, 0x01, 0xd6, 0x7d, 0x64, 0x1c, 0x6a, 0x09, 0x36,
+  0x61, 0xb6, 0xad, 0x86, 0xb2, 0x49, 0xe3, 0x08, 0xa0, 0x96, 0x72, 0x05, 0x7e, 0x60, 0x78, 0x91,
+  0x06, 0x62, 0xf4, 0x08, 0xfb, 0x71, 0x61, 0x1c, 0x5b, 0x11, 0x29, 0xdf, 0x17, 0x83, 0xd7, 0xe4,
+  0x24, 0x74, 0xc5, 0x3e, 0x6a, 0xca, 0xb3, 0xae, 0x66, 0x12, 0xd9, 0x3f, 0xbe, 0xd1, 0xe9, 0xda,
+  0xdc, 0xaf, 0x51, 0x50, 0x5d, 0xc3, 0x50, 0x96, 0x41, 0xb6, 0x45, 0xdf, 0xb6, 0x9a, 0x5c, 0xa3,
+  0x89, 0xea, 0x72, 0xbe, 0x57, 0xd2, 0xe0, 0x16, 0x76, 0xc9, 0x42, 0xa1, 0x70, 0x32, 0x19, 0x6c,
+  0x7d, 0x4d, 0x58, 0xe9, 0x41, 0x58, 0x94, 0x8b, 0x12, 0x3a, 0x7c, 0x01, 0xe7, 0x9e, 0x50, 0x3e,
+  0xee, 0x6e, 0x2a, 0xd9, 0x9d, 0x52, 0x28, 0xa0, 0x0e, 0xfd, 0xe1, 0x57, 0x82, 0xe6, 0x29, 0x7b,
+  0x6f, 0xe5, 0x5d, 0xa6, 0x55, 0xae, 0xe2, 0xeb, 0x5f, 0x86, 0x1f, 0xeb, 0x0c, 0x1f, 0x69, 0x83,
+  0xeb, 0xa2, 0x14, 0x08, 0x56, 0x16, 0x46, 0x0a, 0xb2, 0x5d, 0xc5, 0x4d, 0xf4, 0xa3, 0x9d, 0x1d,
+  0x8e, 0x07, 0x01, 0x86, 0x66, 0x85, 0x16, 0xfb, 0x25, 0xba, 0x1d, 0x8a, 0x5c, 0x2a, 0x5c, 0x03,
+  0xf3, 0x7d, 0x44, 0x0c, 0x2e, 0x10, 0x95, 0xa9, 0xbb, 0x1b, 0xfd, 0x86, 0x74, 0x43, 0xf0, 0xef,
+  0x63, 0x89, 0x04, 0x25, 0xff, 0x0b, 0xe9, 0x85, 0x42, 0x56, 0x78, 0xe4, 0x45, 0x0e, 0x09, 0x3d,
+  0xc7, 0x0f, 0x19, 0x3f, 0x10, 0x5a, 0x59, 0x68, 0x5e, 0x81, 0x1b, 0x18, 0x76, 0xca, 0x0b, 0xc0,
+  0x77, 0x09, 0x81, 0x54, 0xd4, 0x53, 0x45, 0xf0, 0x41, 0xe4, 0x10, 0x46, 0x66, 0x0b, 0x53, 0xeb,
+  0x7a, 0xc0, 0x25, 0x49, 0xd4, 0x6d, 0x76, 0x24, 0x8d, 0x62, 0x04, 0x40, 0x05, 0xb0, 0xa6, 0x1a,
+  0x4e, 0x24, 0x0e, 0x81, 0xc2, 0x0c, 0x33, 0x08, 0x85, 0xda, 0xa7, 0xe2, 0x45, 0xa2, 0x2a, 0x4a,
+  0xc3, 0x1b, 0x1b, 0x26, 0x95, 0xbe, 0x77, 0x45, 0xdf, 0xbb, 0x51, 0xdf, 0xd8, 0xba, 0xa1, 0x35,
+  0xd3, 0x4f, 0x2e, 0x48, 0xde, 0xb6, 0x41, 0x5f, 0x49, 0x9d, 0xa2, 0xca, 0x98, 0x05, 0x22, 0x4a,
+  0xf3, 0x81, 0xe6, 0xbb, 0x8b, 0x49, 0x26, 0xe8, 0x0d, 0x22, 0x26, 0xf5, 0x50, 0x17, 0x20, 0xa7,
+  0xdb, 0x61, 0xeb, 0x9d, 0x88, 0xb7, 0x5c, 0x4c, 0x32, 0xc8, 0x26, 0x0a, 0x79, 0x27, 0x63, 0x50,
+  0x2d, 0x95, 0x75, 0x95, 0x42, 0x79, 0xb8, 0x99, 0x09, 0x18, 0x4e, 0x15, 0x25, 0x51, 0x25, 0x45,
+  0x48, 0xf5, 0x4e, 0x3f, 0x53, 0x20, 0xb5, 0x24, 0xcb, 0x24, 0x16, 0xcf, 0x16, 0xdc, 0xc5, 0x4d,
+  0x42, 0x8c, 0x16, 0xf9, 0xad, 0xb5, 0x1b, 0x37, 0x94, 0x43, 0x02, 0x95, 0xb1, 0x08, 0x11, 0x73,
+  0x57, 0x55, 0xa3, 0x4b, 0x87, 0x0c, 0xe2, 0x03, 0x39, 0x58, 0x1e, 0xb6, 0x6a, 0xa3, 0xd5, 0x09,
+  0xd8, 0x78, 0x5e, 0x78, 0xcc, 0x89, 0x7f, 0x53, 0x01, 0x4a, 0x21, 0x42, 0x84, 0x0d, 0x73, 0xaa,
+  0x4c, 0xa3, 0x99, 0x9d, 0x42, 0x03, 0x83, 0xcd, 0x56, 0x71, 0xb0, 0x72, 0xb9, 0x3c, 0x8d, 0x6e,
+  0x41, 0xd2, 0x8d, 0x5a, 0x5c, 0x6a, 0xdc, 0x39, 0x20, 0x98, 0x4a, 0x53, 0x1d, 0xb5, 0x48, 0x92,
+  0xd2, 0x1c, 0x34, 0xe7, 0xd1, 0xa1, 0x4e, 0x10, 0x77, 0x59, 0x1f, 0x25, 0xea, 0xf8, 0x4e, 0x25,
+  0x1e, 0xed, 0xf6, 0x3c, 0x7b, 0x4c, 0xd9, 0x23, 0x2e, 0xd2, 0xc0, 0x9e, 0x56, 0x4a, 0x2d, 0x06,
+  0x1e, 0xd7, 0x96, 0xa0, 0x2d, 0x7f, 0xa2, 0x18, 0x83, 0xe0, 0x66, 0xa8, 0xe7, 0x4e, 0x82, 0xa1,
+  0x4c, 0xc5, 0xb5, 0xbc, 0x3a, 0x53, 0xa3, 0xd8, 0xf6, 0x78, 0x0b, 0x88, 0x61, 0x78, 0xa5, 0xd1,
+  0x74, 0x8f, 0x1c, 0xbc, 0x40, 0x84, 0x27, 0x5c, 0xe2, 0xb6, 0x05, 0x9e, 0x07, 0xe3, 0x50, 0xf1,
+  0xf5, 0xbd, 0x90, 0x3b, 0x5e, 0x1c, 0x2b, 0x1a, 0x90, 0xd2, 0x3b, 0xe6, 0x6a, 0xdb, 0xb2, 0x4d,
+  0xcd, 0x50, 0xd9, 0xd3, 0x91, 0xa0, 0x56, 0x18, 0xd3, 0xcd, 0xe3, 0x1d, 0xf7, 0x90, 0x67, 0xba,
+  0xa1, 0x14, 0x3c, 0x7e, 0xe8, 0xde, 0x53, 0xa4, 0x00, 0x13, 0xcc, 0xe0, 0xd1, 0xc8, 0xfb, 0x26,
+  0x0f, 0x5a, 0xd5, 0x03, 0x40, 0x0c, 0x20, 0xff, 0x44, 0x54, 0x23, 0x0e, 0xc1, 0x21, 0xb3, 0x19,
+  0x7e, 0x24, 0x0a, 0x96, 0x10, 0x2d, 0xfa, 0x61, 0x94, 0x38, 0x23, 0x28, 0x88, 0xfe, 0xbe, 0x4f,
+  0x59, 0xbc, 0x12, 0xdd, 0x20, 0xd5, 0xa1, 0xfc, 0x08, 0xc0, 0x85, 0xdf, 0x1e, 0x01, 0x8d, 0xa2,
+  0x33, 0xe7, 0x51, 0x50, 0x47, 0xd6, 0x4b, 0xc9, 0xb0, 0x6f, 0x4f, 0x3c, 0x00, 0xa5, 0x9b, 0x56,
+  0xf9, 0x42, 0x91, 0x36, 0xfa, 0x9d, 0xa9, 0x2b, 0x45, 0xc8, 0xae, 0xa5, 0xf2, 0x25, 0x50, 0xd6,
+  0x2b, 0xb6, 0x7a, 0x6b, 0x34, 0x3b, 0x1f, 0x3c, 0x6b, 0x14, 0x78, 0x9f, 0xbd, 0x01, 0xa9, 0x4b,
+  0x4d, 0xcd, 0xa1, 0x2e, 0x73, 0x8a, 0xac, 0x56, 0x6c, 0x24, 0x97, 0xbc, 0xbc, 0x0e, 0x27, 0x0b,
+  0x94, 0xf1, 0xe5, 0xb8, 0xfc, 0xb4, 0x35, 0x60, 0xa9, 0x5c, 0x5d, 0x43, 0x76, 0xba, 0x58, 0x7e,
+  0xd7, 0xc3, 0x52, 0x7e, 0x19, 0xd8, 0xff, 0x34, 0x31, 0x4e, 0x81, 0x4f, 0x99, 0x3f, 0x63, 0x39,
+  0x2b, 0xb7, 0xc3, 0x32, 0x2a, 0x12, 0xc1, 0x86, 0x8e, 0xe3, 0x55, 0x8f, 0x3f, 0xe2, 0x76, 0xce,
+  0xcb, 0x1c, 0x63, 0x8c, 0x3c, 0xb1, 0x18, 0x05, 0xcf, 0xfe, 0x83, 0x70, 0x46, 0x80, 0x79, 0xb5,
+  0xd8, 0x45, 0xd0, 0xeb, 0x05, 0x25, 0xf5, 0x5f, 0x81, 0x8d, 0x3f, 0xa7, 0xc2, 0xfb, 0x63, 0xcc,
+  0xa2, 0xa2, 0xbc, 0x0b, 0x2c, 0x9f, 0xe1, 0x28, 0x35, 0xbc, 0x01, 0x06, 0x39, 0x15, 0xf5, 0xfe,
+  0x1e, 0xf3, 0xf6, 0x73, 0xbc, 0xcf, 0x23, 0x90, 0xdb, 0xb8, 0x6b, 0x1d, 0x94, 0xfb, 0x9f, 0xb1,
+  0xea, 0xcc, 0x02, 0x13, 0xfd, 0x10, 0xc1, 0x01, 0x88, 0x82, 0x7d, 0xf3, 0xe9, 0xa0, 0x5f, 0xc8,
+  0x96, 0xbd, 0x12, 0x07, 0xf8, 0x93, 0xb5, 0x1f, 0xde, 0xb5, 0xd1, 0x59, 0x17, 0x6f, 0xee, 0x03,
+  0xb6, 0xd1, 0x2e, 0x7b, 0x87, 0x40, 0x44, 0xe0, 0x91, 0xf9, 0xeb, 0x9f, 0x01, 0xdd, 0xc1, 0xf4,
+  0x21, 0x79, 0xfd, 0x9e, 0x5c, 0x82, 0x72, 0x34, 0x41, 0xf7, 0x62, 0x10, 0xcb, 0x8e, 0xdf, 0xeb,
+  0xa3, 0x84, 0xa9, 0x6d, 0x1e, 0x07, 0x6d, 0xb0, 0x67, 0x79, 0x59, 0xb6, 0x24, 0xbd, 0x50, 0x64,
+  0x32, 0xc5, 0xee, 0x71, 0x46, 0x10, 0x89, 0x1b, 0x12, 0x93, 0xc5, 0x20, 0x4a, 0xfe, 0x7a, 0xe2,
+  0x5c, 0x60, 0xea, 0x5e, 0x98, 0x64, 0xb1, 0x91, 0x38, 0xe4, 0xdd, 0x07, 0x37, 0x74, 0xf5, 0x63,
+  0x4f, 0xfc, 0xc5, 0xad, 0x8a, 0xb0, 0xfb, 0xa2, 0xbc, 0x44, 0x1c, 0xde, 0x50, 0xab, 0x97, 0xe4,
+  0xdd, 0xe1, 0x7a, 0x49, 0xfe, 0xaf, 0x17, 0xff, 0x05, 0x24, 0xfd, 0x74, 0xee, 0x94, 0x31, 0x00,
+  0x00,
+};
+
+#endif  // HOMEPAGE_H
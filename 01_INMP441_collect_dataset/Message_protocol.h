@@ -0,0 +1,142 @@
+#ifndef MESSAGE_PROTOCOL_H
+#define MESSAGE_PROTOCOL_H
+
+// Двоичный протокол сообщений между устройством и веб-страничкой (вместо JSON через ArduinoJson).
+//
+// Каждое сообщение WebSocket (двоичное) содержит одно или несколько сообщений протокола подряд:
+//   смещение  размер  поле
+//   0         1       тип (MessageType)
+//   1         1       флаги (смысл зависит от типа, для MSG_CONTROL - ключ ControlKey)
+//   2         2       длина данных в байтах (little-endian)
+//   4         ...     данные
+//
+// Типы:
+//   MSG_CONTROL - ключ в поле флагов, данные: значение int32, за ним строки с нулём в конце:
+//                 для CTRL_DATASET - метка, для CTRL_BULK - метка и адрес приёмника "host:port",
+//                 для CTRL_EXPORT - адрес приёмника;
+//   MSG_JPEG    - спектрограмма записи (JPEG);
+//   MSG_ROW     - строка живой спектрограммы (POOLED_BINS байт яркости);
+//   MSG_AUDIO   - кадр аудиопотока (Audio_streaming.h);
+//   MSG_STATS   - статистика аудиопотока: байт/с, задержка очереди (мс), пропущено кадров (uint32).
+//
+// Сообщения формируются в буферах вызывающего без выделения памяти. Такой же разбор реализован
+// на веб-страничке (HomePage.h) и в Python_INMP441/device_messages.py.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define MSG_HEADER_SIZE 4
+
+enum MessageType : uint8_t {
+  MSG_CONTROL = 1,
+  MSG_JPEG = 2,
+  MSG_ROW = 3,
+  MSG_AUDIO = 4,
+  MSG_STATS = 5,
+};
+
+enum ControlKey : uint8_t {
+  // Веб-страничка -> устройство.
+  CTRL_DATASET = 1,     // Записать одну секунду (кнопка DATASET) с меткой.
+  CTRL_BULK = 2,        // Включить (1) или выключить (0) массовый сбор датасета, метка и адрес приёмника.
+  CTRL_LIVE = 3,        // Включить или выключить живую спектрограмму.
+  CTRL_ACK = 4,         // Подтверждение кадра аудиопотока (номер кадра).
+  CTRL_EXPORT = 5,      // Начать (1) или прервать (0) выгрузку записей из flash, адрес приёмника.
+  CTRL_FEATURES = 6,    // Что отправлять приёмнику в режиме BULK: формат признаков (Feature_frames.h),
+                        // бит 8 - вместе с PCM фразы.
+  // Устройство -> веб-страничка.
+  CTRL_BULK_STATE = 16, // Массовый сбор включён (1) или остановлен (0).
+  CTRL_BULK_COUNT = 17, // Отправлено фраз.
+  CTRL_STORE_COUNT = 18, // Записей во flash (Sample_store.h).
+  CTRL_EXPORT_STATE = 19, // Выгрузка идёт (1) или закончена (0).
+  CTRL_QUEUE = 20,      // Запросов DATASET клиента, ожидающих записи (отправляется только ему).
+};
+
+// Разобранное сообщение. payload указывает внутрь исходного буфера.
+struct Message {
+  uint8_t type;
+  uint8_t flags;
+  const uint8_t* payload;
+  uint16_t length;
+};
+
+
+// Записать 16/32-битное число в little-endian.
+void msg_put_u16(uint8_t* out, uint16_t value) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+}
+
+void msg_put_u32(uint8_t* out, uint32_t value) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+  out[2] = (value >> 16) & 0xFF;
+  out[3] = (value >> 24) & 0xFF;
+}
+
+uint32_t msg_get_u32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+
+// ===============================
+// Записать заголовок сообщения. Данные длиной length записываются вызывающим сразу после него.
+// Возвращает MSG_HEADER_SIZE.
+// ===============================
+size_t msg_header(uint8_t* out, uint8_t type, uint8_t flags, uint16_t length) {
+  out[0] = type;
+  out[1] = flags;
+  msg_put_u16(out + 2, length);
+  return MSG_HEADER_SIZE;
+}
+
+
+// Сообщение MSG_CONTROL (8 байт). Возвращает размер сообщения.
+size_t msg_control(uint8_t* out, uint8_t key, int32_t value) {
+  msg_header(out, MSG_CONTROL, key, 4);
+  msg_put_u32(out + MSG_HEADER_SIZE, (uint32_t)value);
+  return MSG_HEADER_SIZE + 4;
+}
+
+
+// Сообщение MSG_STATS (16 байт). Возвращает размер сообщения.
+size_t msg_stats(uint8_t* out, uint32_t bytes_per_sec, uint32_t max_latency_ms, uint32_t dropped) {
+  msg_header(out, MSG_STATS, 0, 12);
+  msg_put_u32(out + MSG_HEADER_SIZE, bytes_per_sec);
+  msg_put_u32(out + MSG_HEADER_SIZE + 4, max_latency_ms);
+  msg_put_u32(out + MSG_HEADER_SIZE + 8, dropped);
+  return MSG_HEADER_SIZE + 12;
+}
+
+
+// ===============================
+// Разобрать очередное сообщение из data[0..size).
+// Возвращает размер сообщения (заголовок + данные) или 0, если сообщение обрезано.
+// ===============================
+size_t msg_parse(const uint8_t* data, size_t size, Message* message) {
+  if (size < MSG_HEADER_SIZE) return 0;
+  const uint16_t length = data[2] | (data[3] << 8);
+  if (size - MSG_HEADER_SIZE < length) return 0;
+  message->type = data[0];
+  message->flags = data[1];
+  message->payload = data + MSG_HEADER_SIZE;
+  message->length = length;
+  return MSG_HEADER_SIZE + length;
+}
+
+
+// ===============================
+// Строка с нулём в конце внутри данных сообщения начиная с *offset.
+// Возвращает указатель на строку и сдвигает *offset за неё, или nullptr, если нуля нет.
+// ===============================
+const char* msg_string(const Message* message, size_t* offset) {
+  if (*offset >= message->length) return nullptr;
+  const uint8_t* start = message->payload + *offset;
+  const void* end = memchr(start, 0, message->length - *offset);
+  if (end == nullptr) return nullptr;
+  *offset = (const uint8_t*)end - message->payload + 1;
+  return (const char*)start;
+}
+
+#endif  // MESSAGE_PROTOCOL_H
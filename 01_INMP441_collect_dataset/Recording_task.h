@@ -0,0 +1,343 @@
+#ifndef RECORDING_TASK_H
+#define RECORDING_TASK_H
+
+// Задача записи: микрофон, спектрограмма, JPEG и flash вне loop().
+//
+// Запись по кнопке DATASET раньше шла прямо в loop(): пока record_to_buffer() писал секунду аудио,
+// а затем считались спектрограмма и JPEG, webSocket.loop() почти не вызывался, и ping/pong,
+// подключения клиентов и подтверждения аудиопотока ждали конца записи. Теперь всё, что читает
+// микрофон (DATASET, BULK, LIVE), пишет во flash и передаёт приёмнику, выполняет отдельная задача
+// FreeRTOS, а loop() (задача сети) только обслуживает сокеты. Задачи обмениваются через две очереди:
+//   - команды (задача сети -> задача записи): запрос записи с меткой и маской получателей;
+//   - события (задача записи -> задача сети): управляющие сообщения, строки живой спектрограммы,
+//     JPEG и конец записи. WebSocketsServer не потокобезопасен, поэтому веб-страничке отправляет
+//     только задача сети.
+// Общее состояние задач защищено одним мьютексом (task_lock):
+//   - очередь кадров аудиопотока (Audio_streaming.h): задача записи добавляет кадры, задача сети
+//     отправляет их и принимает подтверждения;
+//   - метка, адрес приёмника и формат массового сбора и выгрузки: задача сети меняет их по сообщениям
+//     веб-странички, задача записи читает только свою копию, взятую под мьютексом (bulk_settings_take).
+// Флаги режимов (bulk, live, store_export) - volatile bool, их задача записи проверяет каждый шаг.
+// Сеансы клиентов (Client_sessions.h) меняет только задача сети: следующий запрос отдаётся задаче
+// записи, когда она свободна (recording_dispatch), то есть по-прежнему по одному.
+//
+// На компьютере очереди, мьютекс и задача реализованы на pthread (host/recording_task_sim.cc).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Client_sessions.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#define RECORD_COMMANDS      SESSION_MAX_CLIENTS  // Команд в очереди задачи записи.
+#define RECORD_EVENTS        16                   // Событий в очереди задачи сети.
+#define RECORD_EVENT_DATA    48                   // Данные события в самой очереди (строка спектрограммы - 41 байт).
+#define RECORD_POST_MS       100                  // Ожидание места в очереди для JPEG и управляющих сообщений.
+#define RECORD_TASK_STACK    16384                // Стек задачи записи (FFT, fmt2jpg, кадры приёмнику).
+#define RECORD_TASK_PRIORITY 1                    // Как у loop(): на одном ядре задачи делят время поровну.
+#define RECORD_TASK_CORE     0                    // loop() работает на ядре 1.
+
+
+// ===============================
+// Очередь и мьютекс.
+// ===============================
+#if defined(ARDUINO_ARCH_ESP32)
+typedef QueueHandle_t TaskQueue;
+typedef SemaphoreHandle_t TaskLock;
+
+bool task_queue_create(TaskQueue* q, size_t length, size_t item_size) {
+  *q = xQueueCreate(length, item_size);
+  return *q != NULL;
+}
+
+bool task_queue_send(TaskQueue* q, const void* item, uint32_t timeout_ms) {
+  return xQueueSend(*q, item, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+bool task_queue_receive(TaskQueue* q, void* item, uint32_t timeout_ms) {
+  return xQueueReceive(*q, item, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+// Мьютекс рекурсивный: webSocket.sendBIN() при обрыве соединения сам вызывает webSocketEvent
+// (отключение клиента), который снова берёт мьютекс очереди аудиопотока.
+bool task_lock_create(TaskLock* l) {
+  *l = xSemaphoreCreateRecursiveMutex();
+  return *l != NULL;
+}
+
+void task_lock(TaskLock* l) {
+  xSemaphoreTakeRecursive(*l, portMAX_DELAY);
+}
+
+void task_unlock(TaskLock* l) {
+  xSemaphoreGiveRecursive(*l);
+}
+#else
+struct TaskQueue {
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  uint8_t* items;
+  size_t item_size;
+  size_t length;
+  size_t head;
+  size_t count;
+};
+typedef pthread_mutex_t TaskLock;
+
+bool task_queue_create(TaskQueue* q, size_t length, size_t item_size) {
+  q->items = (uint8_t*)malloc(length * item_size);
+  q->item_size = item_size;
+  q->length = length;
+  q->head = 0;
+  q->count = 0;
+  pthread_mutex_init(&q->mutex, NULL);
+  pthread_cond_init(&q->changed, NULL);
+  return q->items != NULL;
+}
+
+// Срок ожидания timeout_ms от текущего момента для pthread_cond_timedwait.
+struct timespec task_deadline(uint32_t timeout_ms) {
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += timeout_ms / 1000;
+  deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+  if (deadline.tv_nsec >= 1000000000) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000;
+  }
+  return deadline;
+}
+
+bool task_queue_send(TaskQueue* q, const void* item, uint32_t timeout_ms) {
+  const struct timespec deadline = task_deadline(timeout_ms);
+  pthread_mutex_lock(&q->mutex);
+  while (q->count == q->length && timeout_ms > 0 &&
+         pthread_cond_timedwait(&q->changed, &q->mutex, &deadline) != ETIMEDOUT) {
+  }
+  const bool room = q->count < q->length;
+  if (room) {
+    memcpy(q->items + (q->head + q->count) % q->length * q->item_size, item, q->item_size);
+    q->count++;
+    pthread_cond_broadcast(&q->changed);
+  }
+  pthread_mutex_unlock(&q->mutex);
+  return room;
+}
+
+bool task_queue_receive(TaskQueue* q, void* item, uint32_t timeout_ms) {
+  const struct timespec deadline = task_deadline(timeout_ms);
+  pthread_mutex_lock(&q->mutex);
+  while (q->count == 0 && timeout_ms > 0 &&
+         pthread_cond_timedwait(&q->changed, &q->mutex, &deadline) != ETIMEDOUT) {
+  }
+  const bool ready = q->count > 0;
+  if (ready) {
+    memcpy(item, q->items + q->head * q->item_size, q->item_size);
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    pthread_cond_broadcast(&q->changed);
+  }
+  pthread_mutex_unlock(&q->mutex);
+  return ready;
+}
+
+bool task_lock_create(TaskLock* l) {
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  const bool created = pthread_mutex_init(l, &attr) == 0;
+  pthread_mutexattr_destroy(&attr);
+  return created;
+}
+
+void task_lock(TaskLock* l) {
+  pthread_mutex_lock(l);
+}
+
+void task_unlock(TaskLock* l) {
+  pthread_mutex_unlock(l);
+}
+#endif
+
+
+// ===============================
+// Команды и события.
+// ===============================
+// Запрос записи (кнопка DATASET), выбранный сеансами клиентов.
+struct RecordCommand {
+  uint8_t recipients;                    // Маска клиентов пакета (Client_sessions.h).
+  char label[SESSION_MAX_LABEL + 1];
+};
+
+enum RecordEventType : uint8_t {
+  RECORD_EVENT_CONTROL = 1,              // Управляющее сообщение key = value всем клиентам.
+  RECORD_EVENT_MESSAGE = 2,              // Сообщение протокола типа key, данные в data.
+  RECORD_EVENT_BUFFER = 3,               // Сообщение протокола типа key, данные в buffer (malloc).
+  RECORD_EVENT_DONE = 4,                 // Запись по команде закончена.
+};
+
+struct RecordEvent {
+  uint8_t type;                          // RecordEventType.
+  uint8_t key;                           // Ключ управляющего сообщения или тип сообщения протокола.
+  uint8_t recipients;                    // Маска получателей (0xFF - все клиенты).
+  int32_t value;
+  uint16_t size;                         // Размер данных сообщения.
+  uint8_t* buffer;                       // Освобождает задача сети после отправки.
+  uint8_t data[RECORD_EVENT_DATA];
+};
+
+struct RecordingTask {
+  TaskQueue commands;
+  TaskQueue events;
+  TaskLock lock;                         // Очередь кадров аудиопотока (Audio_streaming.h).
+  void (*step)();                        // Один шаг задачи записи, вызывается в бесконечном цикле.
+  volatile bool running;
+  bool busy;                             // Команда выполняется (меняет только задача сети).
+  uint32_t dropped;                      // Событий отброшено: очередь задачи сети была полна.
+};
+
+
+// ===============================
+// Создать очереди и запустить задачу записи, которая повторяет step().
+// ===============================
+#if defined(ARDUINO_ARCH_ESP32)
+void recording_task_body(void* arg) {
+  RecordingTask* t = (RecordingTask*)arg;
+  while (t->running) {
+    t->step();
+  }
+  vTaskDelete(NULL);
+}
+#else
+pthread_t recording_thread;
+
+void* recording_task_body(void* arg) {
+  RecordingTask* t = (RecordingTask*)arg;
+  while (t->running) {
+    t->step();
+  }
+  return NULL;
+}
+#endif
+
+bool recording_start(RecordingTask* t, void (*step)()) {
+  if (!task_queue_create(&t->commands, RECORD_COMMANDS, sizeof(RecordCommand)) ||
+      !task_queue_create(&t->events, RECORD_EVENTS, sizeof(RecordEvent)) ||
+      !task_lock_create(&t->lock)) {
+    return false;
+  }
+  t->step = step;
+  t->running = true;
+  t->busy = false;
+#if defined(ARDUINO_ARCH_ESP32)
+  return xTaskCreatePinnedToCore(recording_task_body, "recording", RECORD_TASK_STACK, t,
+                                 RECORD_TASK_PRIORITY, NULL, RECORD_TASK_CORE) == pdPASS;
+#else
+  return pthread_create(&recording_thread, NULL, recording_task_body, t) == 0;
+#endif
+}
+
+
+// ===============================
+// Задача сети.
+// ===============================
+// Если задача записи свободна, отдать ей следующий запрос сеансов клиентов.
+// Возвращает маску получателей отданной записи (0 - задача занята или запросов нет).
+uint8_t recording_dispatch(RecordingTask* t, SessionManager* m, uint32_t now_ms) {
+  if (t->busy) return 0;
+  RecordCommand command;
+  command.recipients = session_next(m, now_ms, command.label);
+  if (command.recipients == 0) return 0;
+  // Очередь команд вмещает запрос от каждого клиента, а занята не больше чем одним.
+  t->busy = task_queue_send(&t->commands, &command, 0);
+  return t->busy ? command.recipients : 0;
+}
+
+// Взять очередное событие задачи записи, не ожидая. Событие RECORD_EVENT_DONE освобождает задачу.
+bool recording_poll(RecordingTask* t, RecordEvent* event) {
+  if (!task_queue_receive(&t->events, event, 0)) return false;
+  if (event->type == RECORD_EVENT_DONE) t->busy = false;
+  return true;
+}
+
+
+// ===============================
+// Задача записи.
+// ===============================
+// Ждать команду не дольше timeout_ms (0 - только проверить очередь).
+bool recording_wait(RecordingTask* t, RecordCommand* command, uint32_t timeout_ms) {
+  return task_queue_receive(&t->commands, command, timeout_ms);
+}
+
+bool recording_post(RecordingTask* t, const RecordEvent* event, uint32_t timeout_ms) {
+  if (task_queue_send(&t->events, event, timeout_ms)) return true;
+  t->dropped++;
+  return false;
+}
+
+// Управляющее сообщение всем клиентам (состояние режимов, счётчики записей).
+bool recording_post_control(RecordingTask* t, uint8_t key, int32_t value) {
+  RecordEvent event;
+  memset(&event, 0, sizeof(event));
+  event.type = RECORD_EVENT_CONTROL;
+  event.key = key;
+  event.value = value;
+  return recording_post(t, &event, RECORD_POST_MS);
+}
+
+// Короткое сообщение (строка живой спектрограммы). Если задача сети не успевает, оно отбрасывается:
+// следующая строка придёт через 10 мс, а микрофон ждать не может.
+bool recording_post_message(RecordingTask* t, uint8_t type, const uint8_t* data, size_t size,
+                            uint8_t recipients) {
+  if (size > RECORD_EVENT_DATA) return false;
+  RecordEvent event;
+  event.type = RECORD_EVENT_MESSAGE;
+  event.key = type;
+  event.recipients = recipients;
+  event.value = 0;
+  event.size = (uint16_t)size;
+  event.buffer = NULL;
+  memcpy(event.data, data, size);
+  return recording_post(t, &event, 0);
+}
+
+// Сообщение в буфере buffer (JPEG спектрограммы, выделен malloc). Буфер переходит задаче сети,
+// а если очередь так и не освободилась, освобождается здесь.
+bool recording_post_buffer(RecordingTask* t, uint8_t type, uint8_t* buffer, size_t size,
+                           uint8_t recipients) {
+  RecordEvent event;
+  memset(&event, 0, sizeof(event));
+  event.type = RECORD_EVENT_BUFFER;
+  event.key = type;
+  event.recipients = recipients;
+  event.size = (uint16_t)size;
+  event.buffer = buffer;
+  if (recording_post(t, &event, RECORD_POST_MS)) return true;
+  free(buffer);
+  return false;
+}
+
+// Запись по команде закончена. Это событие не отбрасывается: без него задача сети не отдаст
+// следующую команду.
+void recording_post_done(RecordingTask* t, uint8_t recipients) {
+  RecordEvent event;
+  memset(&event, 0, sizeof(event));
+  event.type = RECORD_EVENT_DONE;
+  event.recipients = recipients;
+  while (!task_queue_send(&t->events, &event, RECORD_POST_MS)) {
+  }
+}
+
+#endif  // RECORDING_TASK_H
@@ -0,0 +1,452 @@
+#ifndef SAMPLE_STORE_H
+#define SAMPLE_STORE_H
+
+// Хранилище записей на устройстве (кольцевой журнал во flash).
+//
+// Каждая запись (кнопка DATASET или фраза режима BULK) сохраняется во flash до отправки, поэтому
+// обрыв WebSocket или недоступный приёмник не теряют записи, а скорость записи не зависит от сети.
+// Записи выгружаются на компьютер кнопкой EXPORT приёмнику Python_INMP441/dataset_receiver.py,
+// выгрузка продолжается с места обрыва.
+//
+// Журнал - файл STORE_PATH из STORE_RECORDS ячеек фиксированного размера. Запись с номером n
+// хранится в ячейке n % STORE_RECORDS, новые записи затирают самые старые. Ячейка (все числа little-endian):
+//   смещение  размер  поле
+//   0         4       "SMPL"
+//   4         1       версия (STORE_VERSION)
+//   5         1       длина метки в байтах (не больше STORE_MAX_LABEL)
+//   6         2       зарезервировано (0)
+//   8         4       номер записи (растёт на 1, не сбрасывается при перезагрузке)
+//   12        4       время записи (millis())
+//   16        4       кол-во отсчётов int16 (не больше STORE_MAX_SAMPLES)
+//   20        4       уровень шума: среднее абсолютное отклонение тихого кадра 10 мс, << 8
+//   24        2       усиление: отсчёт int16 / код I2S, << 8
+//   26        2       частота дискретизации
+//   28        4       CRC-32 (как zlib.crc32) метки и отсчётов
+//   32        32      метка, дополненная нулями
+//   64        ...     отсчёты
+// Выгрузка: устройство подключается к приёмнику и отправляет запрос STORE_EXPORT_REQUEST, приёмник
+// отвечает номером следующей нужной ему записи (uint32), и записи с этого номера передаются в том же
+// виде, что во flash (64 байта + отсчёты), подряд одна за другой.
+//
+// Запись ячейки: сначала стирается сигнатура "SMPL", затем пишутся отсчёты (по STORE_WRITE_STEP байт
+// за вызов store_pump, чтобы не задерживать чтение I2S), последними - метка и заголовок. Поэтому
+// ячейка с сигнатурой всегда содержит целую запись, и после перезагрузки store_begin() находит
+// журнал по заголовкам ячеек.
+//
+// На ESP32 файл хранится в LittleFS. На компьютере файл хранится в памяти и переживает
+// store_end()/store_begin(), как flash переживает перезагрузку (host/sample_store_test.cc).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "Bulk_capture.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <LittleFS.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define STORE_PATH          "/samples.bin"
+#define STORE_MAGIC         "SMPL"
+#define STORE_VERSION       1
+#define STORE_HEADER_SIZE   32
+#define STORE_MAX_LABEL     32
+#define STORE_MAX_SAMPLES   SAMPLES_COUNT                 // Одна секунда, как файлы датасета.
+#define STORE_RECORD_SIZE   (STORE_HEADER_SIZE + STORE_MAX_LABEL + STORE_MAX_SAMPLES * 2)
+#define STORE_RECORDS       32                            // ~1 МБ (раздел LittleFS по умолчанию 1.5 МБ).
+#define STORE_WRITE_STEP    2048                          // Байт за вызов store_pump / store_export_pump.
+#define STORE_EXPORT_REQUEST "EXPT"                       // Запрос номера продолжения выгрузки.
+
+
+// ===============================
+// Файл журнала: чтение и запись по смещению.
+// ===============================
+#if defined(ARDUINO_ARCH_ESP32)
+struct StoreFile {
+  File file;
+};
+
+bool store_file_open(StoreFile* f, const char* path, uint32_t size) {
+  // При первом запуске раздел форматируется.
+  if (!LittleFS.begin(true)) {
+    return false;
+  }
+  File existing = LittleFS.open(path, "r");
+  const bool ready = existing && existing.size() == size;
+  if (existing) existing.close();
+  if (!ready) {
+    // Файл создаётся один раз на весь размер, дальше ячейки только перезаписываются.
+    File created = LittleFS.open(path, "w");
+    if (!created) return false;
+    uint8_t zeros[256];
+    memset(zeros, 0, sizeof(zeros));
+    for (uint32_t written = 0; written < size; written += sizeof(zeros)) {
+      const size_t step = size - written < sizeof(zeros) ? size - written : sizeof(zeros);
+      if (created.write(zeros, step) != step) {
+        created.close();
+        return false;
+      }
+    }
+    created.close();
+  }
+  f->file = LittleFS.open(path, "r+");
+  return (bool)f->file;
+}
+
+bool store_file_read(StoreFile* f, uint32_t offset, void* data, size_t size) {
+  return f->file.seek(offset) && f->file.read((uint8_t*)data, size) == size;
+}
+
+bool store_file_write(StoreFile* f, uint32_t offset, const void* data, size_t size) {
+  return f->file.seek(offset) && f->file.write((const uint8_t*)data, size) == size;
+}
+
+void store_file_flush(StoreFile* f) {
+  f->file.flush();
+}
+
+void store_file_close(StoreFile* f) {
+  f->file.close();
+}
+#else
+// Файл в памяти. Содержимое сохраняется после store_file_close(), как flash после перезагрузки.
+struct StoreFile {
+  uint8_t* data;
+  uint32_t size;
+};
+
+struct StoreRamFile {
+  char path[32];
+  uint8_t* data;
+  uint32_t size;
+};
+StoreRamFile store_ram_files[4];
+
+bool store_file_open(StoreFile* f, const char* path, uint32_t size) {
+  StoreRamFile* free_slot = nullptr;
+  for (StoreRamFile& ram : store_ram_files) {
+    if (ram.data != nullptr && strcmp(ram.path, path) == 0 && ram.size == size) {
+      f->data = ram.data;
+      f->size = size;
+      return true;
+    }
+    if (ram.data == nullptr && free_slot == nullptr) free_slot = &ram;
+  }
+  if (free_slot == nullptr || strlen(path) >= sizeof(free_slot->path)) return false;
+  free_slot->data = (uint8_t*)calloc(size, 1);
+  if (free_slot->data == nullptr) return false;
+  strcpy(free_slot->path, path);
+  free_slot->size = size;
+  f->data = free_slot->data;
+  f->size = size;
+  return true;
+}
+
+bool store_file_read(StoreFile* f, uint32_t offset, void* data, size_t size) {
+  if (offset > f->size || size > f->size - offset) return false;
+  memcpy(data, f->data + offset, size);
+  return true;
+}
+
+bool store_file_write(StoreFile* f, uint32_t offset, const void* data, size_t size) {
+  if (offset > f->size || size > f->size - offset) return false;
+  memcpy(f->data + offset, data, size);
+  return true;
+}
+
+void store_file_flush(StoreFile*) {}
+
+void store_file_close(StoreFile* f) {
+  f->data = nullptr;
+}
+
+// Стереть файл (как форматирование раздела).
+void store_ram_erase(const char* path) {
+  for (StoreRamFile& ram : store_ram_files) {
+    if (ram.data != nullptr && strcmp(ram.path, path) == 0) {
+      free(ram.data);
+      ram.data = nullptr;
+    }
+  }
+}
+#endif
+
+
+// Описание записи.
+struct SampleMeta {
+  const char* label;
+  uint32_t timestamp_ms;
+  uint32_t noise_floor;             // << 8.
+  uint16_t gain;                    // << 8.
+};
+
+enum StoreExportState {
+  STORE_EXPORT_SENDING,             // Выгрузка продолжается.
+  STORE_EXPORT_DONE,                // Выгружены все записи.
+  STORE_EXPORT_FAILED,              // Соединение разорвано.
+};
+
+// Состояние журнала. Целые записи имеют номера [oldest, next).
+struct SampleStore {
+  StoreFile file;
+  bool ready;
+  uint32_t oldest;
+  uint32_t next;
+  // Запись ячейки next по частям (store_pump).
+  bool writing;
+  const int16_t* pending_samples;   // Отсчёты записываются из буфера вызывающего.
+  uint32_t pending_count;
+  uint32_t pending_written;         // Записано байт отсчётов.
+  uint8_t pending_header[STORE_HEADER_SIZE + STORE_MAX_LABEL];
+  // Выгрузка.
+  bool exporting;
+  uint32_t export_sequence;         // Выгружаемая запись.
+  uint32_t export_sent;             // Отправлено байт этой записи.
+  uint32_t export_size;             // Размер этой записи.
+  uint32_t exported;                // Выгружено записей за сеанс.
+  uint32_t lost;                    // Записи, затёртые до выгрузки.
+  uint8_t io[STORE_WRITE_STEP];
+};
+
+
+uint32_t store_get_u32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+uint32_t store_slot_offset(uint32_t sequence) {
+  return (sequence % STORE_RECORDS) * STORE_RECORD_SIZE;
+}
+
+// Прочитать заголовок ячейки slot. Возвращает true, если в ней целая запись, номер которой
+// соответствует ячейке; номер возвращается в *found.
+bool store_read_header(SampleStore* s, uint32_t slot, uint8_t* header, uint32_t* found) {
+  if (!store_file_read(&s->file, slot * STORE_RECORD_SIZE, header, STORE_HEADER_SIZE)) return false;
+  if (memcmp(header, STORE_MAGIC, 4) != 0 || header[4] != STORE_VERSION ||
+      header[5] > STORE_MAX_LABEL || store_get_u32(header + 16) > STORE_MAX_SAMPLES) {
+    return false;
+  }
+  *found = store_get_u32(header + 8);
+  return *found % STORE_RECORDS == slot;
+}
+
+
+// ===============================
+// Открыть журнал и найти в нём записи (после перезагрузки).
+// Журнал - непрерывный ряд номеров, заканчивающийся самой новой целой записью.
+// ===============================
+bool store_begin(SampleStore* s, const char* path) {
+  memset(s, 0, sizeof(*s));
+  if (!store_file_open(&s->file, path, (uint32_t)STORE_RECORD_SIZE * STORE_RECORDS)) {
+    return false;
+  }
+  uint8_t header[STORE_HEADER_SIZE];
+  uint32_t sequence[STORE_RECORDS];
+  bool valid[STORE_RECORDS];
+  bool any = false;
+  uint32_t newest = 0;
+  for (uint32_t slot = 0; slot < STORE_RECORDS; slot++) {
+    valid[slot] = store_read_header(s, slot, header, &sequence[slot]);
+    if (valid[slot] && (!any || sequence[slot] > newest)) {
+      newest = sequence[slot];
+      any = true;
+    }
+  }
+  if (any) {
+    s->next = newest + 1;
+    s->oldest = newest;
+    while (s->next - s->oldest < STORE_RECORDS && s->oldest > 0) {
+      const uint32_t previous = s->oldest - 1;
+      const uint32_t slot = previous % STORE_RECORDS;
+      if (!valid[slot] || sequence[slot] != previous) break;
+      s->oldest = previous;
+    }
+  }
+  s->ready = true;
+  return true;
+}
+
+void store_end(SampleStore* s) {
+  if (s->ready) store_file_close(&s->file);
+  s->ready = false;
+}
+
+uint32_t store_count(const SampleStore* s) {
+  return s->next - s->oldest;
+}
+
+
+// ===============================
+// Уровень шума записи для SampleMeta: наименьшее среднее абсолютное отклонение кадра 10 мс, << 8
+// (та же мера, что у уровня шума в Bulk_capture.h).
+// ===============================
+uint32_t store_noise_floor(const int16_t* samples, uint32_t count) {
+  uint32_t floor = 0;
+  bool found = false;
+  for (uint32_t start = 0; start + BULK_FRAME_SAMPLES <= count; start += BULK_FRAME_SAMPLES) {
+    int32_t sum = 0;
+    for (int i = 0; i < BULK_FRAME_SAMPLES; i++) sum += samples[start + i];
+    const int32_t mean = sum / BULK_FRAME_SAMPLES;
+    uint32_t deviation = 0;
+    for (int i = 0; i < BULK_FRAME_SAMPLES; i++) {
+      const int32_t v = samples[start + i];
+      deviation += v > mean ? v - mean : mean - v;
+    }
+    const uint32_t energy = (deviation << 8) / BULK_FRAME_SAMPLES;
+    if (!found || energy < floor) {
+      floor = energy;
+      found = true;
+    }
+  }
+  return floor;
+}
+
+
+// Записать следующую порцию отсчётов; после последней - метку и заголовок.
+bool store_write_step(SampleStore* s) {
+  const uint32_t base = store_slot_offset(s->next);
+  const uint32_t total = s->pending_count * sizeof(int16_t);
+  if (s->pending_written < total) {
+    uint32_t step = total - s->pending_written;
+    if (step > STORE_WRITE_STEP) step = STORE_WRITE_STEP;
+    if (!store_file_write(&s->file, base + STORE_HEADER_SIZE + STORE_MAX_LABEL + s->pending_written,
+                          (const uint8_t*)s->pending_samples + s->pending_written, step)) {
+      return false;
+    }
+    s->pending_written += step;
+    return true;
+  }
+  if (!store_file_write(&s->file, base, s->pending_header, sizeof(s->pending_header))) return false;
+  store_file_flush(&s->file);
+  s->writing = false;
+  s->next++;
+  return true;
+}
+
+
+// ===============================
+// Записать всё, что осталось от текущей записи.
+// ===============================
+void store_flush(SampleStore* s) {
+  while (s->writing) {
+    if (!store_write_step(s)) {
+      // Ошибка flash: запись теряется, ячейка остаётся без сигнатуры.
+      s->writing = false;
+      return;
+    }
+  }
+}
+
+
+// ===============================
+// Начать запись в журнал. Отсчёты читаются из samples, пока запись не закончится (store_pump или
+// store_flush), поэтому буфер нельзя менять до тех пор, пока s->writing.
+//  - const int16_t* samples, uint32_t count: отсчёты (не больше STORE_MAX_SAMPLES).
+//  - const SampleMeta* meta: метка, время, уровень шума и усиление.
+// ===============================
+bool store_append(SampleStore* s, const int16_t* samples, uint32_t count, const SampleMeta* meta) {
+  if (!s->ready) return false;
+  store_flush(s);
+  if (count > STORE_MAX_SAMPLES) count = STORE_MAX_SAMPLES;
+  // Ячейка самой старой записи освобождается.
+  if (s->next - s->oldest >= STORE_RECORDS) s->oldest++;
+  const uint8_t erased[4] = {0, 0, 0, 0};
+  if (!store_file_write(&s->file, store_slot_offset(s->next), erased, sizeof(erased))) return false;
+
+  size_t label_size = strlen(meta->label);
+  if (label_size > STORE_MAX_LABEL) label_size = STORE_MAX_LABEL;
+  uint8_t* h = s->pending_header;
+  memset(h, 0, sizeof(s->pending_header));
+  memcpy(h, STORE_MAGIC, 4);
+  h[4] = STORE_VERSION;
+  h[5] = (uint8_t)label_size;
+  bulk_put_u32(h + 8, s->next);
+  bulk_put_u32(h + 12, meta->timestamp_ms);
+  bulk_put_u32(h + 16, count);
+  bulk_put_u32(h + 20, meta->noise_floor);
+  h[24] = meta->gain & 0xFF;
+  h[25] = meta->gain >> 8;
+  h[26] = SAMPLE_RATE & 0xFF;
+  h[27] = (SAMPLE_RATE >> 8) & 0xFF;
+  memcpy(h + STORE_HEADER_SIZE, meta->label, label_size);
+  uint32_t crc = bulk_crc32(0, h + STORE_HEADER_SIZE, label_size);
+  crc = bulk_crc32(crc, (const uint8_t*)samples, count * sizeof(int16_t));
+  bulk_put_u32(h + 28, crc);
+
+  s->pending_samples = samples;
+  s->pending_count = count;
+  s->pending_written = 0;
+  s->writing = true;
+  return true;
+}
+
+
+// ===============================
+// Продолжить запись: не больше STORE_WRITE_STEP байт за вызов (вызывается из loop()).
+// ===============================
+void store_pump(SampleStore* s) {
+  if (s->writing && !store_write_step(s)) {
+    s->writing = false;
+  }
+}
+
+
+// ===============================
+// Начать выгрузку с записи resume (приёмник сообщает номер, следующий за последней сохранённой записью).
+// Если resume больше номера следующей записи (журнал стёрт), выгружается весь журнал.
+// ===============================
+void store_export_begin(SampleStore* s, uint32_t resume) {
+  s->exporting = true;
+  s->export_sequence = resume > s->next ? s->oldest : resume;
+  s->export_sent = 0;
+  s->export_size = 0;
+  s->exported = 0;
+  s->lost = 0;
+}
+
+
+// ===============================
+// Отправить следующую порцию выгрузки (не больше STORE_WRITE_STEP байт за вызов).
+//  - bool (*send)(const uint8_t*, size_t): функция отправки (на ESP32 - bulk_write).
+// ===============================
+StoreExportState store_export_pump(SampleStore* s, bool (*send)(const uint8_t*, size_t)) {
+  if (!s->exporting) return STORE_EXPORT_DONE;
+  // Запись затёрта новыми, пока ждала выгрузки (или во время выгрузки - тогда приёмник
+  // отбросит её по контрольной сумме).
+  if (s->export_sequence < s->oldest) {
+    s->lost += s->oldest - s->export_sequence;
+    s->export_sequence = s->oldest;
+    s->export_sent = 0;
+  }
+  if (s->export_sequence >= s->next) {
+    s->exporting = false;
+    return STORE_EXPORT_DONE;
+  }
+  const uint32_t base = store_slot_offset(s->export_sequence);
+  if (s->export_sent == 0) {
+    uint32_t found;
+    if (!store_read_header(s, s->export_sequence % STORE_RECORDS, s->io, &found) ||
+        found != s->export_sequence) {
+      s->lost++;
+      s->export_sequence++;
+      return STORE_EXPORT_SENDING;
+    }
+    s->export_size = STORE_HEADER_SIZE + STORE_MAX_LABEL + store_get_u32(s->io + 16) * sizeof(int16_t);
+  }
+  uint32_t step = s->export_size - s->export_sent;
+  if (step > STORE_WRITE_STEP) step = STORE_WRITE_STEP;
+  if (!store_file_read(&s->file, base + s->export_sent, s->io, step) || !send(s->io, step)) {
+    s->exporting = false;
+    return STORE_EXPORT_FAILED;
+  }
+  s->export_sent += step;
+  if (s->export_sent == s->export_size) {
+    s->export_sequence++;
+    s->export_sent = 0;
+    s->exported++;
+  }
+  return STORE_EXPORT_SENDING;
+}
+
+#endif  // SAMPLE_STORE_H
@@ -0,0 +1,115 @@
+#ifndef SPECTROGRAM_QUANTIZER_H
+#define SPECTROGRAM_QUANTIZER_H
+
+// Потоковое квантование строк спектрограммы (логарифм энергии) в uint8 / int8.
+//
+// Вместо двух проходов по всей спектрограмме (поиск min/max, затем деление каждого элемента)
+// каждая строка квантуется сразу после вычисления:
+//   - значения строки переводятся в фиксированную точку Q12 (умножение, без деления);
+//   - диапазон [min, max] следует за сигналом: расширяется сразу, сужается на 1/2^decay_shift
+//     разницы за строку (затухающее окно), поэтому строки можно квантовать по мере поступления;
+//   - на строку приходится одно целочисленное деление (масштаб Q16), каждый элемент -
+//     умножение и сдвиг.
+//
+// Одно и то же квантование используется для изображения (uint8, 0..255) и для int8-входа модели
+// (uint8 - 128, параметры квантования TFLite: scale = диапазон / 255, zero_point = -128).
+//
+// Файл не зависит от ядра Arduino и проверяется на компьютере (host/spectrogram_quantizer_test.cc).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#define QUANT_FRACTION_BITS  12                    // Логарифм энергии в Q12.
+#define QUANT_SCALE_BITS     16                    // Масштаб строки в Q16.
+#define QUANT_MIN_RANGE      4                     // Наименьший диапазон (~0.001 в log10).
+#define QUANT_MAX_BINS       64                    // Наибольшая длина строки.
+#define QUANT_DECAY_SHIFT    7                     // Сужение диапазона на 1/128 за строку.
+
+
+struct SpectrogramQuantizer {
+  int32_t min_q;                    // Диапазон в Q12.
+  int32_t max_q;
+  int32_t scale_q16;                // 255 / (max - min) в Q16, пересчитывается для каждой строки.
+  uint8_t decay_shift;
+  bool ready;                       // Диапазон задан первой строкой.
+};
+
+
+// ===============================
+// Сбросить диапазон; следующая строка задаст его заново.
+//  - uint8_t decay_shift: скорость сужения диапазона (0 - каждая строка нормируется сама по себе).
+// ===============================
+void quantizer_reset(SpectrogramQuantizer* q, uint8_t decay_shift) {
+  q->min_q = 0;
+  q->max_q = 0;
+  q->scale_q16 = 0;
+  q->decay_shift = decay_shift;
+  q->ready = false;
+}
+
+
+// ===============================
+// Квантовать строку row[0..bins) в out[0..bins) (0..255) и обновить диапазон.
+// Строка целиком входит в обновлённый диапазон, поэтому значения только округляются.
+// ===============================
+void quantizer_row_uint8(SpectrogramQuantizer* q, const float* row, int bins, uint8_t* out) {
+  if (bins > QUANT_MAX_BINS) bins = QUANT_MAX_BINS;
+  if (bins <= 0) return;
+  // Один проход по строке: перевод в Q12 и минимум/максимум строки.
+  int32_t fixed[QUANT_MAX_BINS];
+  int32_t row_min = INT32_MAX;
+  int32_t row_max = INT32_MIN;
+  for (int b = 0; b < bins; b++) {
+    fixed[b] = (int32_t)lrintf(row[b] * (float)(1 << QUANT_FRACTION_BITS));
+    if (fixed[b] < row_min) row_min = fixed[b];
+    if (fixed[b] > row_max) row_max = fixed[b];
+  }
+
+  // Затухающее окно: расширяется сразу, сужается на долю разницы.
+  if (!q->ready) {
+    q->min_q = row_min;
+    q->max_q = row_max;
+    q->ready = true;
+  }
+  q->min_q = row_min < q->min_q ? row_min : q->min_q + ((row_min - q->min_q) >> q->decay_shift);
+  q->max_q = row_max > q->max_q ? row_max : q->max_q - ((q->max_q - row_max) >> q->decay_shift);
+  int32_t range = q->max_q - q->min_q;
+  if (range < QUANT_MIN_RANGE) range = QUANT_MIN_RANGE;
+  q->scale_q16 = (int32_t)(((255 << QUANT_SCALE_BITS) + range / 2) / range);
+
+  // (v - min) * 255 / range с округлением. v - min <= range, произведение < 2^24.
+  const int32_t half = 1 << (QUANT_SCALE_BITS - 1);
+  for (int b = 0; b < bins; b++) {
+    int32_t v = fixed[b] - q->min_q;
+    if (v < 0) v = 0;
+    if (v > range) v = range;
+    const int32_t scaled = (v * q->scale_q16 + half) >> QUANT_SCALE_BITS;
+    out[b] = (uint8_t)(scaled > 255 ? 255 : scaled);
+  }
+}
+
+
+// ===============================
+// То же для int8-входа модели: out = uint8 - 128 (zero_point = -128).
+// ===============================
+void quantizer_row_int8(SpectrogramQuantizer* q, const float* row, int bins, int8_t* out) {
+  uint8_t* bytes = (uint8_t*)out;
+  quantizer_row_uint8(q, row, bins, bytes);
+  if (bins > QUANT_MAX_BINS) bins = QUANT_MAX_BINS;
+  for (int b = 0; b < bins; b++) {
+    out[b] = (int8_t)(bytes[b] - 128);
+  }
+}
+
+
+// Параметры квантования последней строки для int8-входа:
+// log10 энергии = min + scale * (q - zero_point), min = q->min_q / 2^QUANT_FRACTION_BITS.
+void quantizer_params(const SpectrogramQuantizer* q, float* scale, int32_t* zero_point) {
+  int32_t range = q->max_q - q->min_q;
+  if (range < QUANT_MIN_RANGE) range = QUANT_MIN_RANGE;
+  *scale = (float)range / (255.0f * (float)(1 << QUANT_FRACTION_BITS));
+  *zero_point = -128;
+}
+
+#endif  // SPECTROGRAM_QUANTIZER_H
@@ -0,0 +1,252 @@
+// Host test of the audio streaming queue (Audio_streaming.h).
+//
+// A local stand-in replaces the WebSocket server and the browsers: every client
+// has a link of fixed bandwidth, a message is delivered once all its bytes went
+// through, and the client acknowledges it after a round trip, as the web page
+// does. The recording loop of the sketch is simulated in milliseconds: a
+// 256-sample I2S chunk every 16 ms, stream_pump() every millisecond.
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/audio_stream_test.cc -o audio_stream_test
+//   ./audio_stream_test
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include "Audio_streaming.h"
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+constexpr int kRecordingSamples = kSampleRate;
+constexpr uint32_t kChunkMs = 1000 * STREAM_FRAME_SAMPLES / kSampleRate;
+constexpr uint32_t kAckDelayMs = 5;
+constexpr uint32_t kDrainMs = 1000;
+
+// Stand-in for one WebSocket connection and the page behind it.
+struct Client {
+  const char* name = "";
+  uint32_t bytes_per_ms = 0;  // Link bandwidth, 0 - the client stopped reading.
+
+  // Link: messages in transit and the bytes of the first one already sent.
+  std::deque<std::vector<uint8_t>> link;
+  uint32_t link_progress = 0;
+  // Acknowledgements on their way back: (due time, frame number).
+  std::deque<std::pair<uint32_t, uint32_t>> acks;
+
+  // What the page reassembled, as HomePage.h does.
+  std::vector<int16_t> pcm = std::vector<int16_t>(kRecordingSamples, 0);
+  bool started = false;
+  bool finished = false;
+  uint32_t messages = 0;
+  uint32_t bytes = 0;
+  uint32_t last_sequence = 0;
+  bool out_of_order = false;
+  bool malformed = false;
+  uint32_t max_in_flight = 0;
+};
+
+std::vector<Client> clients;
+uint32_t now_ms = 0;
+
+void AddClient(const char* name, uint32_t bytes_per_ms) {
+  Client client;
+  client.name = name;
+  client.bytes_per_ms = bytes_per_ms;
+  clients.push_back(client);
+}
+
+bool Send(uint8_t client, const uint8_t* data, size_t size) {
+  if (client >= clients.size()) {
+    return false;
+  }
+  clients[client].link.emplace_back(data, data + size);
+  return true;
+}
+
+// The page: decodes a frame, upsamples decimated samples back and queues the
+// acknowledgement.
+void Receive(Client* client, const std::vector<uint8_t>& message) {
+  Message parsed = {};
+  if (msg_parse(message.data(), message.size(), &parsed) != message.size() ||
+      parsed.type != MSG_AUDIO) {
+    client->malformed = true;
+    return;
+  }
+  const uint8_t flags = parsed.flags & 0x0F;
+  const uint8_t decimation = parsed.flags >> STREAM_DECIMATION_SHIFT;
+  const uint32_t sequence = msg_get_u32(parsed.payload);
+  const uint32_t offset = msg_get_u32(parsed.payload + 4);
+  if (client->messages > 0 && sequence <= client->last_sequence) {
+    client->out_of_order = true;
+  }
+  client->messages++;
+  client->bytes += message.size();
+  client->last_sequence = sequence;
+  client->started |= (flags & STREAM_FLAG_START) != 0;
+  client->finished |= (flags & STREAM_FLAG_END) != 0;
+
+  const size_t count = (message.size() - STREAM_HEADER_SIZE) / sizeof(int16_t);
+  for (size_t i = 0; i < count; i++) {
+    int16_t sample;
+    memcpy(&sample, message.data() + STREAM_HEADER_SIZE + i * sizeof(int16_t),
+           sizeof(sample));
+    for (int j = 0; j < decimation; j++) {
+      const size_t position = offset + i * decimation + j;
+      if (position < client->pcm.size()) {
+        client->pcm[position] = sample;
+      }
+    }
+  }
+  client->acks.emplace_back(now_ms + kAckDelayMs, sequence);
+}
+
+// One millisecond of the network.
+void Tick(AudioStream* stream) {
+  for (size_t i = 0; i < clients.size(); i++) {
+    Client& client = clients[i];
+    uint32_t budget = client.bytes_per_ms;
+    while (budget > 0 && !client.link.empty()) {
+      const uint32_t left = client.link.front().size() - client.link_progress;
+      const uint32_t step = budget < left ? budget : left;
+      client.link_progress += step;
+      budget -= step;
+      if (client.link_progress == client.link.front().size()) {
+        Receive(&client, client.link.front());
+        client.link.pop_front();
+        client.link_progress = 0;
+      }
+    }
+    while (!client.acks.empty() && client.acks.front().first <= now_ms) {
+      stream_ack(stream, i, client.acks.front().second);
+      client.acks.pop_front();
+    }
+    const uint32_t in_flight = stream->clients[i].in_flight_bytes;
+    if (in_flight > client.max_in_flight) {
+      client.max_in_flight = in_flight;
+    }
+  }
+}
+
+int failures = 0;
+
+void Check(bool condition, const char* client, const char* what) {
+  if (!condition) {
+    printf("FAIL %s: %s\n", client, what);
+    failures++;
+  }
+}
+
+AudioStream stream;
+
+}  // namespace
+
+int main() {
+  AddClient("fast", 1000);
+  AddClient("adequate", 48);  // 48 KB/s for 32 KB/s of audio.
+  AddClient("slow", 12);      // Needs decimation by 4.
+  AddClient("stalled", 0);
+
+  std::vector<int16_t> recording(kRecordingSamples);
+  for (int i = 0; i < kRecordingSamples; i++) {
+    recording[i] = static_cast<int16_t>(
+        8000 * sin(2 * M_PI * 440 * i / kSampleRate) + (i % 97) - 48);
+  }
+
+  memset(&stream, 0, sizeof(stream));
+  for (size_t i = 0; i < clients.size(); i++) {
+    stream_client_connect(&stream, i);
+  }
+
+  stream_begin(&stream, STREAM_ALL_CLIENTS);
+  uint32_t reported_dropped = 0;
+  uint32_t max_latency = 0;
+  size_t pushed = 0;
+  const uint32_t end_ms = (kRecordingSamples / STREAM_FRAME_SAMPLES + 1) * kChunkMs +
+                          kDrainMs;
+  for (now_ms = 0; now_ms <= end_ms; now_ms++) {
+    if (now_ms % kChunkMs == 0 && pushed <= recording.size()) {
+      if (pushed < recording.size()) {
+        const size_t count = std::min<size_t>(STREAM_FRAME_SAMPLES,
+                                              recording.size() - pushed);
+        stream_push(&stream, recording.data() + pushed, count, 0, now_ms);
+        pushed += count;
+      } else {
+        stream_finish(&stream, now_ms);
+        pushed++;
+      }
+    }
+    stream_pump(&stream, Send, now_ms);
+    Tick(&stream);
+    StreamStats stats;
+    // The last period is closed early to collect its counters.
+    if (stream_report(&stream, now_ms, &stats) ||
+        (now_ms == end_ms &&
+         stream_report(&stream, now_ms + STREAM_REPORT_MS, &stats))) {
+      printf("t=%4u ms: %u B/s, max queue latency %u ms, dropped %u\n", now_ms,
+             stats.bytes_per_sec, stats.max_latency_ms, stats.dropped);
+      reported_dropped += stats.dropped;
+      if (stats.max_latency_ms > max_latency) {
+        max_latency = stats.max_latency_ms;
+      }
+    }
+  }
+  uint32_t total_dropped = 0;
+  for (size_t i = 0; i < clients.size(); i++) {
+    const Client& client = clients[i];
+    const StreamClient& state = stream.clients[i];
+    total_dropped += state.dropped;
+    printf("%-8s: %3u messages, %6u bytes, dropped %2u, decimated %2u, "
+           "max in flight %4u\n",
+           client.name, client.messages, client.bytes, state.dropped,
+           state.decimated, client.max_in_flight);
+    Check(!client.out_of_order, client.name, "frames out of order");
+    Check(!client.malformed, client.name, "malformed message");
+    Check(client.max_in_flight <= STREAM_WINDOW_BYTES + sizeof(stream.packet),
+          client.name, "window exceeded");
+  }
+  Check(reported_dropped == total_dropped, "stats", "dropped count mismatch");
+  Check(max_latency <= STREAM_POOL_FRAMES * kChunkMs, "stats",
+        "queue latency above the queue length");
+
+  // Fast links get every sample unchanged.
+  for (int i = 0; i < 2; i++) {
+    const Client& client = clients[i];
+    Check(client.started && client.finished, client.name, "incomplete recording");
+    Check(stream.clients[i].dropped == 0, client.name, "frames dropped");
+    Check(stream.clients[i].decimated == 0, client.name, "frames decimated");
+    Check(client.pcm == recording, client.name, "samples differ");
+  }
+
+  // The slow link keeps up by decimation instead of dropping frames.
+  {
+    const Client& client = clients[2];
+    Check(client.started && client.finished, client.name, "incomplete recording");
+    Check(stream.clients[2].decimated > 0, client.name, "no decimation");
+    Check(stream.clients[2].dropped == 0, client.name, "frames dropped");
+    double error = 0;
+    for (int i = 0; i < kRecordingSamples; i++) {
+      error += fabs(client.pcm[i] - recording[i]);
+    }
+    Check(error / kRecordingSamples < 4000, client.name, "samples too far off");
+  }
+
+  // The stalled client gets one window and then loses old frames, without
+  // holding back the others (checked above).
+  {
+    const Client& client = clients[3];
+    Check(client.messages == 0, client.name, "received data over a dead link");
+    Check(stream.clients[3].dropped > 0, client.name, "no frames dropped");
+    Check(stream.clients[3].in_flight_bytes <= STREAM_WINDOW_BYTES +
+                                                   sizeof(stream.packet),
+          client.name, "window exceeded");
+  }
+
+  printf(failures == 0 ? "PASS\n" : "%d FAILURES\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+// Host stand-in for the ESP32 side of the bulk dataset capture.
+//
+// The WAV files of a dataset are played back as one continuous recording:
+// every utterance is surrounded by noise at the background level of its own
+// file, as the microphone would hear between utterances, and the stream is
+// fed in I2S-sized chunks to the same segmenter and framing code that the
+// 01_INMP441_collect_dataset sketch runs (Bulk_capture.h). Every cut clip is
+// sent over TCP to Python_INMP441/dataset_receiver.py, labelled with the
+// directory of the file being played.
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/bulk_capture_loopback.cc -o bulk_capture_loopback
+//   ./bulk_capture_loopback --port=5005 --dataset=../Python_INMP441/Dataset
+//
+// The last line of the output, "clips=<n> files=<m> dropped=<d>", is parsed by
+// Python_INMP441/dataset_receiver_test.py.
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Recording parameters of 01_INMP441_collect_dataset.ino.
+#define SAMPLE_RATE 16000
+#define RECORD_TIME 1
+#define SAMPLES_COUNT (SAMPLE_RATE * RECORD_TIME)
+
+#include "Bulk_capture.h"
+
+namespace {
+
+// Samples per i2s_read() call of the sketch (int16_t i2s_buffer[256]).
+constexpr size_t kChunkSamples = 256;
+// Noise played before and after every file. Longer than the clip, so that
+// every clip is cut before the next file starts and keeps its label.
+constexpr size_t kGapSamples = SAMPLE_RATE * 3 / 2;
+
+struct Recording {
+  std::string label;
+  std::vector<int16_t> samples;
+};
+
+// Reads the PCM data of a 16-bit mono WAV file.
+bool ReadWav(const std::string& path, std::vector<int16_t>* samples) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t size;
+  while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + size);
+  }
+  fclose(file);
+  if (data.size() < 12 || memcmp(data.data(), "RIFF", 4) != 0) {
+    return false;
+  }
+  size_t offset = 12;
+  while (offset + 8 <= data.size()) {
+    const uint32_t chunk_size = data[offset + 4] | (data[offset + 5] << 8) |
+                                (data[offset + 6] << 16) |
+                                (data[offset + 7] << 24);
+    if (memcmp(data.data() + offset, "data", 4) == 0) {
+      const size_t available =
+          std::min<size_t>(chunk_size, data.size() - offset - 8);
+      samples->resize(available / 2);
+      memcpy(samples->data(), data.data() + offset + 8, samples->size() * 2);
+      return true;
+    }
+    offset += 8 + chunk_size + (chunk_size & 1);
+  }
+  return false;
+}
+
+std::vector<std::string> SortedEntries(const std::string& path) {
+  std::vector<std::string> entries;
+  DIR* dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return entries;
+  }
+  while (struct dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      entries.push_back(entry->d_name);
+    }
+  }
+  closedir(dir);
+  std::sort(entries.begin(), entries.end());
+  return entries;
+}
+
+// Loads <dataset>/<label>/*.wav.
+std::vector<Recording> LoadDataset(const std::string& dataset) {
+  std::vector<Recording> recordings;
+  for (const std::string& label : SortedEntries(dataset)) {
+    const std::string label_dir = dataset + "/" + label;
+    for (const std::string& name : SortedEntries(label_dir)) {
+      if (name.size() < 4 || name.compare(name.size() - 4, 4, ".wav") != 0) {
+        continue;
+      }
+      Recording recording;
+      recording.label = label;
+      if (ReadWav(label_dir + "/" + name, &recording.samples)) {
+        recordings.push_back(std::move(recording));
+      }
+    }
+  }
+  return recordings;
+}
+
+// Frames at the start of a recording that are taken as its background.
+constexpr size_t kBackgroundFrames = 10;
+
+// Background level of a recording: the median energy (as
+// segmenter_frame_energy computes it) of its first kBackgroundFrames frames,
+// recorded before the word.
+int BackgroundEnergy(const std::vector<int16_t>& samples) {
+  std::vector<int> energies;
+  for (size_t start = 0; start + BULK_FRAME_SAMPLES <= samples.size() &&
+                         energies.size() < kBackgroundFrames;
+       start += BULK_FRAME_SAMPLES) {
+    int sum = 0;
+    for (int i = 0; i < BULK_FRAME_SAMPLES; i++) {
+      sum += samples[start + i];
+    }
+    const int mean = sum / BULK_FRAME_SAMPLES;
+    int deviation = 0;
+    for (int i = 0; i < BULK_FRAME_SAMPLES; i++) {
+      deviation += abs(samples[start + i] - mean);
+    }
+    energies.push_back(deviation / BULK_FRAME_SAMPLES);
+  }
+  if (energies.empty()) {
+    return 0;
+  }
+  std::sort(energies.begin(), energies.end());
+  return energies[energies.size() / 2];
+}
+
+// Deterministic uniform noise of the given energy, so that every run cuts the
+// same clips. The mean absolute deviation of uniform noise in [-a, a] is a / 2.
+void AppendNoise(size_t count, int energy, uint32_t* seed,
+                 std::vector<int16_t>* out) {
+  const int amplitude = std::max(1, 2 * energy);
+  for (size_t i = 0; i < count; i++) {
+    *seed = *seed * 1664525u + 1013904223u;
+    out->push_back(static_cast<int16_t>(
+        static_cast<int>((*seed >> 16) % (2 * amplitude + 1)) - amplitude));
+  }
+}
+
+const char* FlagValue(const char* arg, const char* name) {
+  const size_t length = strlen(name);
+  return strncmp(arg, name, length) == 0 ? arg + length : nullptr;
+}
+
+EnergySegmenter segmenter;
+int16_t clip[BULK_CLIP_SAMPLES];
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string host = "127.0.0.1";
+  std::string dataset = "../Python_INMP441/Dataset";
+  int port = 5005;
+  for (int i = 1; i < argc; i++) {
+    if (const char* value = FlagValue(argv[i], "--host=")) {
+      host = value;
+    } else if (const char* value = FlagValue(argv[i], "--port=")) {
+      port = atoi(value);
+    } else if (const char* value = FlagValue(argv[i], "--dataset=")) {
+      dataset = value;
+    } else {
+      fprintf(stderr, "Unknown argument %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  const std::vector<Recording> recordings = LoadDataset(dataset);
+  if (recordings.empty()) {
+    fprintf(stderr, "No WAV files in %s\n", dataset.c_str());
+    return 1;
+  }
+  if (!bulk_connect(host.c_str(), port)) {
+    fprintf(stderr, "Cannot connect to %s:%d\n", host.c_str(), port);
+    return 1;
+  }
+
+  segmenter_reset(&segmenter);
+  uint32_t sequence = 0;
+  uint32_t seed = 1;
+  for (const Recording& recording : recordings) {
+    const int background = BackgroundEnergy(recording.samples);
+    std::vector<int16_t> stream;
+    AppendNoise(kGapSamples, background, &seed, &stream);
+    stream.insert(stream.end(), recording.samples.begin(),
+                  recording.samples.end());
+    AppendNoise(kGapSamples, background, &seed, &stream);
+
+    for (size_t offset = 0; offset < stream.size(); offset += kChunkSamples) {
+      const size_t count = std::min(kChunkSamples, stream.size() - offset);
+      if (segmenter_process(&segmenter, stream.data() + offset, count, clip)) {
+        if (!bulk_send_clip(recording.label.c_str(), sequence, clip,
+                            BULK_CLIP_SAMPLES)) {
+          fprintf(stderr, "Receiver disconnected\n");
+          return 1;
+        }
+        sequence++;
+      }
+    }
+  }
+  bulk_disconnect();
+
+  printf("clips=%u files=%zu dropped=%u\n", sequence, recordings.size(),
+         segmenter.dropped);
+  return 0;
+}
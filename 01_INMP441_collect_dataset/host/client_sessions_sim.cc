@@ -0,0 +1,211 @@
+// Host simulation of several labelers sharing one device (Client_sessions.h).
+//
+// Fake clients press DATASET on their own schedules: one presses it whenever
+// its queue has room, two share a label and press it at nearly the same time,
+// one presses it rarely. The single microphone takes one second per recording
+// plus the spectrogram. Audio goes through the real stream queue
+// (Audio_streaming.h) with the recording's recipient mask, and a 3 KB JPEG is
+// sent to the same recipients.
+//
+// Measured per client: requests served, mean and longest wait, and the bytes it
+// received. Compared with the former sketch, where any client set one global
+// flag and every result was broadcast to all clients.
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/client_sessions_sim.cc -o client_sessions_sim
+//   ./client_sessions_sim
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "Audio_streaming.h"
+#include "Client_sessions.h"
+
+namespace {
+
+constexpr uint32_t kRunMs = 120000;
+constexpr uint32_t kRecordMs = 1000;
+constexpr uint32_t kProcessMs = 150;           // Spectrogram and JPEG.
+constexpr uint32_t kChunkMs = 16;              // One 256-sample I2S chunk.
+constexpr uint32_t kJpegBytes = 3000;
+
+// A labeler: presses DATASET every period_ms (0 - whenever its queue has room).
+struct Labeler {
+  const char* name;
+  const char* label;
+  uint32_t period_ms;
+  uint32_t phase_ms;
+  uint32_t requests = 0;
+  uint64_t bytes = 0;                          // Audio frames and JPEGs received.
+  uint32_t recordings_received = 0;
+};
+
+std::vector<Labeler> labelers = {
+    {"eager", "0_Zero", 0, 0},
+    {"pair A", "1_One", 2500, 100},
+    {"pair B", "1_One", 2500, 400},
+    {"rare", "2_Two", 5000, 700},
+};
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// The stream's send function: every client reads at once and acknowledges
+// after the pump, as a page on a fast link does.
+std::vector<std::pair<uint8_t, uint32_t>> acks;
+
+bool Send(uint8_t client, const uint8_t* data, size_t size) {
+  if (client >= labelers.size()) return false;
+  labelers[client].bytes += size;
+  if ((data[1] & STREAM_FLAG_END) != 0) labelers[client].recordings_received++;
+  acks.emplace_back(client, msg_get_u32(data + MSG_HEADER_SIZE));
+  return true;
+}
+
+bool Presses(const Labeler& l, uint32_t now) {
+  return l.period_ms != 0 && now >= l.phase_ms && (now - l.phase_ms) % l.period_ms == 0;
+}
+
+AudioStream stream;
+SessionManager sessions;
+
+// One recording from now: one second of stream frames, then the JPEG.
+// Returns the time the microphone is free again.
+uint32_t Record(uint8_t recipients, uint32_t now) {
+  static int16_t chunk[STREAM_FRAME_SAMPLES];
+  stream_begin(&stream, recipients);
+  const uint32_t end = now + kRecordMs;
+  for (; now < end; now += kChunkMs) {
+    stream_push(&stream, chunk, STREAM_FRAME_SAMPLES, 0, now);
+    stream_pump(&stream, Send, now);
+    for (const auto& ack : acks) stream_ack(&stream, ack.first, ack.second);
+    acks.clear();
+  }
+  stream_finish(&stream, now);
+  stream_pump(&stream, Send, now);
+  for (const auto& ack : acks) stream_ack(&stream, ack.first, ack.second);
+  acks.clear();
+  for (size_t i = 0; i < labelers.size(); i++) {
+    if (recipients & session_bit(i)) labelers[i].bytes += kJpegBytes;
+  }
+  return now + kProcessMs;
+}
+
+// Requests arriving while the microphone is busy are handled by loop() when
+// it is free again, so both schemes see them at the next free moment.
+void SimulateSessions() {
+  memset(&stream, 0, sizeof(stream));
+  memset(&sessions, 0, sizeof(sessions));
+  for (size_t i = 0; i < labelers.size(); i++) {
+    stream_client_connect(&stream, i);
+    session_connect(&sessions, i);
+  }
+  uint32_t busy_until = 0;
+  for (uint32_t now = 0; now < kRunMs; now++) {
+    for (size_t i = 0; i < labelers.size(); i++) {
+      Labeler& l = labelers[i];
+      const bool press = l.period_ms == 0 ? session_pending(&sessions, i) < SESSION_MAX_PENDING
+                                          : Presses(l, now);
+      if (press && session_request(&sessions, i, l.label, now)) l.requests++;
+    }
+    if (now < busy_until) continue;
+    char label[SESSION_MAX_LABEL + 1];
+    const uint8_t recipients = session_next(&sessions, now, label);
+    if (recipients != 0) busy_until = Record(recipients, now);
+  }
+}
+
+// The former sketch: any press sets one flag; a recording clears it and goes
+// to everybody. Presses while the flag is set are merged into one recording.
+struct Baseline {
+  uint32_t requests = 0;
+  uint32_t recordings = 0;
+  uint32_t merged = 0;
+  uint64_t bytes_per_client = 0;
+};
+
+Baseline SimulateBaseline() {
+  Baseline b;
+  bool dataset = false;
+  uint32_t busy_until = 0;
+  const uint64_t recording_bytes =
+      (kRecordMs / kChunkMs) * (STREAM_HEADER_SIZE + STREAM_FRAME_SAMPLES * 2) +
+      STREAM_HEADER_SIZE + kJpegBytes;
+  uint32_t eager_pending = 0;
+  for (uint32_t now = 0; now < kRunMs; now++) {
+    for (size_t i = 0; i < labelers.size(); i++) {
+      const Labeler& l = labelers[i];
+      // The eager labeler presses again as soon as its last press was served.
+      const bool press = l.period_ms == 0 ? eager_pending == 0 : Presses(l, now);
+      if (!press) continue;
+      b.requests++;
+      if (dataset) b.merged++;
+      dataset = true;
+      if (l.period_ms == 0) eager_pending = 1;
+    }
+    if (now < busy_until || !dataset) continue;
+    dataset = false;
+    eager_pending = 0;
+    b.recordings++;
+    b.bytes_per_client += recording_bytes;
+    busy_until = now + kRecordMs + kProcessMs;
+  }
+  return b;
+}
+
+}  // namespace
+
+int main() {
+  SimulateSessions();
+
+  const double minutes = kRunMs / 60000.0;
+  printf("%.0f s, %zu clients, one recording = %u ms + %u ms processing\n\n",
+         kRunMs / 1000.0, labelers.size(), kRecordMs, kProcessMs);
+  printf("sessions: %u recordings (%.1f/min), %u requests served by a shared recording\n",
+         sessions.recordings, sessions.recordings / minutes, sessions.batched);
+  printf("  %-7s %-7s %9s %7s %9s %9s %9s\n", "client", "label", "requests", "served",
+         "mean wait", "max wait", "KB recv");
+  double sum = 0;
+  double sum_squares = 0;
+  uint32_t served_total = 0;
+  for (size_t i = 0; i < labelers.size(); i++) {
+    const Labeler& l = labelers[i];
+    const ClientSession& c = sessions.clients[i];
+    printf("  %-7s %-7s %9u %7u %7u ms %6u ms %9.0f\n", l.name, l.label, l.requests, c.served,
+           c.served ? c.total_wait_ms / c.served : 0, c.max_wait_ms, l.bytes / 1024.0);
+    // Share of the client's requests that were served.
+    const double ratio = l.requests ? static_cast<double>(c.served) / l.requests : 1.0;
+    sum += ratio;
+    sum_squares += ratio * ratio;
+    served_total += c.served;
+    Check(l.recordings_received == c.served, "client got recordings it did not request");
+    Check(c.served + session_pending(&sessions, i) == l.requests, "request lost");
+    if (l.period_ms != 0) {
+      Check(c.max_wait_ms <= SESSION_MAX_CLIENTS * (kRecordMs + kProcessMs),
+            "a client waited longer than one round");
+    }
+  }
+  const double jain = sum * sum / (labelers.size() * sum_squares);
+  printf("  fairness (Jain, served/requested): %.3f, %.1f results delivered/min\n\n", jain,
+         served_total / minutes);
+  Check(jain > 0.95, "unfair");
+  Check(sessions.batched > 0, "same-label requests were not batched");
+
+  const Baseline b = SimulateBaseline();
+  printf("global flag: %u recordings (%.1f/min) for %u presses, %u presses merged away,\n"
+         "  every client received every recording: %.0f KB each\n",
+         b.recordings, b.recordings / minutes, b.requests, b.merged,
+         b.bytes_per_client / 1024.0);
+
+  printf(failures == 0 ? "PASS\n" : "%d FAILURES\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+// Host test of the feature frames of the bulk capture (Feature_frames.h).
+//
+// A 99 x 41 spectrogram of log10 energies (the shape of one X_spectrogram_train
+// element) is framed in both formats. Checked: the frame layout and CRC, the
+// uint8 quantization error against the float values, and the frame sizes
+// against the PCM frame of the same one-second clip.
+//
+// With --port=<n> the same spectrogram is instead sent to
+// Python_INMP441/dataset_receiver.py on 127.0.0.1:<n>: one int16 frame, then
+// one uint8 frame followed by the clip's PCM. Python_INMP441/dataset_receiver_test.py
+// compares the saved .npy files with Value().
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/feature_frames_test.cc -o feature_frames_test
+//   ./feature_frames_test
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Recording parameters of 01_INMP441_collect_dataset.ino.
+#define SAMPLE_RATE 16000
+#define RECORD_TIME 1
+#define SAMPLES_COUNT (SAMPLE_RATE * RECORD_TIME)
+
+#include "Feature_frames.h"
+
+namespace {
+
+constexpr int kRows = 99;                      // SPECTROGRAM_FRAMES.
+constexpr int kBins = 41;                      // POOLED_BINS.
+constexpr char kLabel[] = "1_One";
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Log10 energy of row r, bin b: -6 .. 3, the range get_spectrogram() produces.
+// Repeated in Python_INMP441/dataset_receiver_test.py.
+float Value(int r, int b) {
+  return -6.0f + 9.0f * static_cast<float>((r * kBins + b) * 37 % 1000) / 1000.0f;
+}
+
+std::vector<int16_t> Features() {
+  std::vector<int16_t> q12(kRows * kBins);
+  for (int r = 0; r < kRows; r++) {
+    for (int b = 0; b < kBins; b++) {
+      q12[r * kBins + b] = feature_q12(Value(r, b));
+    }
+  }
+  return q12;
+}
+
+uint32_t GetU32(const uint8_t* in) {
+  return in[0] | in[1] << 8 | in[2] << 16 | static_cast<uint32_t>(in[3]) << 24;
+}
+
+int32_t GetI32(const uint8_t* in) { return static_cast<int32_t>(GetU32(in)); }
+
+int Network(int port) {
+  const std::vector<int16_t> q12 = Features();
+  std::vector<uint8_t> packed(FEATURE_UINT8_PREFIX + q12.size());
+  std::vector<int16_t> pcm(SAMPLES_COUNT);
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>(i * 7 % 2000 - 1000);
+  }
+  if (!bulk_connect("127.0.0.1", port)) {
+    fprintf(stderr, "Cannot connect to 127.0.0.1:%d\n", port);
+    return 1;
+  }
+  const bool sent =
+      feature_send(kLabel, 0, FEATURE_FORMAT_Q12, 0, q12.data(), kRows, kBins, packed.data()) &&
+      feature_send(kLabel, 1, FEATURE_FORMAT_UINT8, FEATURE_FLAG_PCM, q12.data(), kRows, kBins,
+                   packed.data()) &&
+      bulk_send_clip(kLabel, 1, pcm.data(), pcm.size());
+  bulk_disconnect();
+  printf("sent=%d\n", sent ? 1 : 0);
+  return sent ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc == 2 && strncmp(argv[1], "--port=", 7) == 0) {
+    return Network(atoi(argv[1] + 7));
+  }
+
+  const std::vector<int16_t> q12 = Features();
+
+  // Q12 keeps the value to 1/8192.
+  float q12_error = 0;
+  for (int r = 0; r < kRows; r++) {
+    for (int b = 0; b < kBins; b++) {
+      q12_error = fmaxf(q12_error, fabsf(q12[r * kBins + b] / 4096.0f - Value(r, b)));
+    }
+  }
+  Check(q12_error <= 0.5f / 4096 + 1e-6f, "Q12 error");
+
+  // uint8: one range for the whole spectrogram, rounding error of half a step.
+  std::vector<uint8_t> packed(FEATURE_UINT8_PREFIX + q12.size());
+  const size_t packed_size = feature_pack_uint8(q12.data(), q12.size(), packed.data());
+  Check(packed_size == FEATURE_UINT8_PREFIX + q12.size(), "uint8 size");
+  const int32_t low = GetI32(packed.data());
+  const int32_t range = GetI32(packed.data() + 4);
+  float uint8_error = 0;
+  uint8_t lowest = 255, highest = 0;
+  for (size_t i = 0; i < q12.size(); i++) {
+    const uint8_t v = packed[FEATURE_UINT8_PREFIX + i];
+    lowest = v < lowest ? v : lowest;
+    highest = v > highest ? v : highest;
+    const float value = (low + v * range / 255.0f) / 4096.0f;
+    uint8_error = fmaxf(uint8_error, fabsf(value - q12[i] / 4096.0f));
+  }
+  const float step = range / 255.0f / 4096.0f;
+  printf("uint8: range %.2f..%.2f, step %.4f, max error %.4f (log10)\n", low / 4096.0f,
+         (low + range) / 4096.0f, step, uint8_error);
+  Check(lowest == 0 && highest == 255, "uint8 does not span 0..255");
+  Check(uint8_error <= step / 2 + 1e-4f, "uint8 error above half a step");
+
+  // Frame layout.
+  uint8_t header[FEATURE_HEADER_SIZE + BULK_MAX_LABEL];
+  const size_t header_size = feature_frame_header(
+      header, kLabel, 7, FEATURE_FORMAT_UINT8, FEATURE_FLAG_PCM, kRows, kBins, packed.data(),
+      packed_size);
+  uint32_t crc = bulk_crc32(0, reinterpret_cast<const uint8_t*>(kLabel), strlen(kLabel));
+  crc = bulk_crc32(crc, packed.data(), packed_size);
+  Check(header_size == FEATURE_HEADER_SIZE + strlen(kLabel) &&
+            memcmp(header, FEATURE_MAGIC, 4) == 0 && header[4] == FEATURE_VERSION &&
+            header[5] == strlen(kLabel) && header[6] == FEATURE_FORMAT_UINT8 &&
+            header[7] == FEATURE_FLAG_PCM && GetU32(header + 8) == 7 &&
+            (header[12] | header[13] << 8) == kRows && (header[14] | header[15] << 8) == kBins &&
+            GetU32(header + 16) == packed_size && GetU32(header + 20) == crc,
+        "frame header");
+
+  // Bytes on the wire per one-second clip.
+  const size_t pcm_frame = BULK_HEADER_SIZE + strlen(kLabel) + SAMPLES_COUNT * 2;
+  const size_t q12_frame = header_size + q12.size() * 2;
+  const size_t uint8_frame = header_size + packed_size;
+  printf("per clip: PCM %zu bytes, features int16 %zu (%.1fx less), uint8 %zu (%.1fx less)\n",
+         pcm_frame, q12_frame, static_cast<double>(pcm_frame) / q12_frame, uint8_frame,
+         static_cast<double>(pcm_frame) / uint8_frame);
+  Check(pcm_frame >= 3 * q12_frame && pcm_frame >= 7 * uint8_frame, "features are not smaller");
+
+  printf(failures == 0 ? "PASS\n" : "%d FAILURES\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+// Host dump of the web page as the sketch serves it (HomePage.h).
+//
+// Writes the compiled HOMEPAGE_GZ bytes, the body of the "/" response, to
+// stdout; with "--etag" prints the ETag header value instead.
+// Python_INMP441/homepage_gzip_test.py checks that the body gunzips to
+// HomePage.html and that the ETag matches it.
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/homepage_dump.cc -o homepage_dump
+//   ./homepage_dump | gunzip
+
+#include <cstdio>
+#include <cstring>
+
+// On the ESP32 PROGMEM places the array in flash; on the host it is a plain
+// const array.
+#define PROGMEM
+
+#include "HomePage.h"
+
+int main(int argc, char** argv) {
+  if (argc == 2 && strcmp(argv[1], "--etag") == 0) {
+    printf("%s\n", HOMEPAGE_ETAG);
+    return 0;
+  }
+  if (fwrite(HOMEPAGE_GZ, 1, HOMEPAGE_GZ_SIZE, stdout) != HOMEPAGE_GZ_SIZE ||
+      sizeof(HOMEPAGE_GZ) != HOMEPAGE_GZ_SIZE) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+// Host dump of the binary message protocol (Message_protocol.h).
+//
+// Without arguments prints, one per line, "<name> <hex>" for every kind of
+// message the sketch sends, encoded by the same functions the sketch uses, and
+// then the per-message overhead against the JSON text messages they replaced
+// and the number of heap allocations made by the encoders.
+//
+// With "--parse <hex>" decodes a control message as handleMessage() in
+// socketConnection.h does and prints "key=<k> value=<v> strings=<s1>|<s2>".
+//
+// Python_INMP441/device_messages_test.py runs both modes against the Python
+// decoder and encoder.
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/message_protocol_dump.cc -o message_protocol_dump
+//   ./message_protocol_dump
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Audio_streaming.h"
+#include "Message_protocol.h"
+
+namespace {
+
+size_t allocations = 0;
+
+void PrintHex(const char* name, const uint8_t* data, size_t size) {
+  printf("%s ", name);
+  for (size_t i = 0; i < size; i++) {
+    printf("%02x", data[i]);
+  }
+  printf("\n");
+}
+
+// The text sendJson() produced with ArduinoJson for the same message.
+size_t JsonSize(const char* type, long value) {
+  char text[64];
+  return snprintf(text, sizeof(text), "{\"type\":\"%s\",\"value\":%ld}", type,
+                  value);
+}
+
+bool Unhex(const char* hex, std::vector<uint8_t>* out) {
+  const size_t length = strlen(hex);
+  if (length % 2 != 0) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i += 2) {
+    char byte[3] = {hex[i], hex[i + 1], 0};
+    char* end = nullptr;
+    out->push_back(static_cast<uint8_t>(strtoul(byte, &end, 16)));
+    if (*end != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int Parse(const char* hex) {
+  std::vector<uint8_t> data;
+  if (!Unhex(hex, &data)) {
+    printf("bad hex\n");
+    return 1;
+  }
+  Message message = {};
+  if (msg_parse(data.data(), data.size(), &message) != data.size() ||
+      message.type != MSG_CONTROL || message.length < 4) {
+    printf("malformed\n");
+    return 1;
+  }
+  std::string strings;
+  size_t offset = 4;
+  const char* text;
+  while ((text = msg_string(&message, &offset)) != nullptr) {
+    if (!strings.empty()) {
+      strings += "|";
+    }
+    strings += text;
+  }
+  printf("key=%u value=%d strings=%s\n", message.flags,
+         static_cast<int32_t>(msg_get_u32(message.payload)), strings.c_str());
+  return 0;
+}
+
+AudioStream stream;
+
+bool Ignore(uint8_t, const uint8_t*, size_t) { return true; }
+
+}  // namespace
+
+// Counts heap allocations; the encoders below must not make any.
+void* operator new(size_t size) {
+  allocations++;
+  void* p = malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+int main(int argc, char** argv) {
+  if (argc == 3 && strcmp(argv[1], "--parse") == 0) {
+    return Parse(argv[2]);
+  }
+
+  const size_t before = allocations;
+  uint8_t control[8];
+  const size_t control_size = msg_control(control, CTRL_BULK_COUNT, 12345);
+  uint8_t negative[8];
+  msg_control(negative, CTRL_BULK_STATE, -1);
+  uint8_t stats[16];
+  const size_t stats_size = msg_stats(stats, 32768, 17, 3);
+
+  uint8_t row[MSG_HEADER_SIZE + 41];
+  msg_header(row, MSG_ROW, 0, 41);
+  for (int i = 0; i < 41; i++) {
+    row[MSG_HEADER_SIZE + i] = static_cast<uint8_t>(i * 6);
+  }
+
+  int16_t samples[STREAM_FRAME_SAMPLES];
+  for (int i = 0; i < STREAM_FRAME_SAMPLES; i++) {
+    samples[i] = static_cast<int16_t>(i * 100 - 12800);
+  }
+  stream_client_connect(&stream, 0);
+  stream_begin(&stream, STREAM_ALL_CLIENTS);
+  stream_push(&stream, samples, 8, 0, 0);
+  size_t audio_size = stream_build_packet(&stream, 0, 1);
+  uint8_t audio[STREAM_HEADER_SIZE + 16];
+  memcpy(audio, stream.packet, audio_size);
+  stream_push(&stream, samples, 8, 0, 0);
+  const size_t decimated_size = stream_build_packet(&stream, 1, 2);
+  uint8_t decimated[STREAM_HEADER_SIZE + 16];
+  memcpy(decimated, stream.packet, decimated_size);
+  stream_finish(&stream, 0);
+  stream_pump(&stream, Ignore, 0);
+  const size_t end_size = stream_build_packet(&stream, 2, 1);
+  uint8_t end[STREAM_HEADER_SIZE];
+  memcpy(end, stream.packet, end_size);
+
+  // Several messages in one WebSocket message.
+  uint8_t batch[sizeof(control) + sizeof(stats)];
+  memcpy(batch, control, control_size);
+  memcpy(batch + control_size, stats, stats_size);
+  const size_t encoder_allocations = allocations - before;
+
+  PrintHex("control", control, control_size);
+  PrintHex("negative", negative, sizeof(negative));
+  PrintHex("stats", stats, stats_size);
+  PrintHex("row", row, sizeof(row));
+  PrintHex("audio", audio, audio_size);
+  PrintHex("decimated", decimated, decimated_size);
+  PrintHex("end", end, end_size);
+  PrintHex("batch", batch, sizeof(batch));
+
+  // Overhead: bytes that are not the payload itself.
+  const size_t json_count = JsonSize("bulk_count", 12345);
+  const size_t json_stats = JsonSize("stream_rate", 32768) +
+                            JsonSize("stream_latency", 17) +
+                            JsonSize("stream_dropped", 3);
+  const size_t json_image = JsonSize("change_img_type", 0);
+  printf("overhead bulk_count: json=%zu binary=%zu\n", json_count, control_size);
+  printf("overhead stats: json=%zu (3 messages) binary=%zu (1 message)\n",
+         json_stats, stats_size);
+  printf("overhead jpeg: json=%zu (extra message) binary=%d\n", json_image,
+         MSG_HEADER_SIZE);
+  printf("overhead audio frame: binary=%d of %zu bytes\n", STREAM_HEADER_SIZE,
+         sizeof(stream.packet));
+  printf("encoder allocations=%zu\n", encoder_allocations);
+  return encoder_allocations == 0 ? 0 : 1;
+}
@@ -0,0 +1,305 @@
+// Host simulation of the recording task (Recording_task.h) with stubbed sockets.
+//
+// The network side is a fake webSocket.loop(): pings from every client every
+// 20 ms, DATASET presses, a client connecting mid-capture, and the page's
+// stream acknowledgements. Each event is stamped when it "arrives". Its latency
+// is the time until loop() handles it. A recording blocks for one second in
+// 16 ms chunks, as i2s_read() does, then spins the CPU for the spectrogram and
+// JPEG.
+//
+// Two runs in real time:
+//   - inline, the former sketch: loop() records itself; webSocket.loop() is
+//     called between I2S chunks but not during the spectrogram and JPEG;
+//   - task: the same work in a pthread behind Recording_task.h, loop() only
+//     services sockets, polls events and dispatches the next request.
+// Checked: event latency in the task run stays under kLatencyBoundMs while the
+// inline run stalls for the processing time, and every requester gets its
+// audio, JPEG and queue update.
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/recording_task_sim.cc -o recording_task_sim -lpthread
+//   ./recording_task_sim
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Audio_streaming.h"
+#include "Client_sessions.h"
+#include "Recording_task.h"
+
+namespace {
+
+constexpr uint32_t kRunMs = 5000;
+constexpr uint32_t kRecordMs = 1000;
+constexpr uint32_t kChunkMs = 16;              // One 256-sample I2S chunk.
+constexpr uint32_t kProcessMs = 150;           // Spectrogram and JPEG.
+constexpr uint32_t kJpegBytes = 3000;
+constexpr uint32_t kPingMs = 20;
+constexpr uint32_t kPressMs = 1200;
+constexpr uint32_t kConnectMs = 2100;          // Client 3 connects during a recording.
+constexpr uint32_t kLatencyBoundMs = 25;
+constexpr int kClients = 4;
+
+using Clock = std::chrono::steady_clock;
+Clock::time_point start;
+
+uint32_t Now() {
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+}
+
+void SleepUntil(uint32_t ms) {
+  std::this_thread::sleep_until(start + std::chrono::milliseconds(ms));
+}
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// What a client's page received.
+struct Page {
+  bool connected = false;
+  uint32_t requests = 0;
+  uint32_t recordings = 0;                     // Stream frames with STREAM_FLAG_END.
+  uint32_t jpegs = 0;
+  uint32_t queue_updates = 0;
+};
+
+// Network events of one run.
+struct Run {
+  Page pages[kClients];
+  std::vector<uint32_t> latencies;             // Ping and connect latencies, ms.
+  std::vector<std::pair<uint8_t, uint32_t>> acks;
+  uint32_t next_ping = 0;
+  uint32_t next_press = 0;
+  bool connect_done = false;
+};
+
+Run run;
+AudioStream stream;
+SessionManager sessions;
+RecordingTask recording;
+
+bool Send(uint8_t client, const uint8_t* data, size_t size) {
+  if (client >= kClients || !run.pages[client].connected) return false;
+  if ((data[1] & STREAM_FLAG_END) != 0) run.pages[client].recordings++;
+  run.acks.emplace_back(client, msg_get_u32(data + MSG_HEADER_SIZE));
+  (void)size;
+  return true;
+}
+
+void SendJpeg(uint8_t recipients) {
+  for (int i = 0; i < kClients; i++) {
+    if (recipients & session_bit(i)) run.pages[i].jpegs++;
+  }
+}
+
+void SendQueue(uint8_t recipients) {
+  for (int i = 0; i < kClients; i++) {
+    if (recipients & session_bit(i)) run.pages[i].queue_updates++;
+  }
+}
+
+void Connect(int client) {
+  run.pages[client].connected = true;
+  task_lock(&recording.lock);
+  stream_client_connect(&stream, client);
+  task_unlock(&recording.lock);
+  session_connect(&sessions, client);
+}
+
+// The stubbed webSocket.loop(): handles every event that has arrived by now.
+void WebSocketLoop() {
+  const uint32_t now = Now();
+  // Acknowledgements of the frames sent by the last pump.
+  task_lock(&recording.lock);
+  for (const auto& ack : run.acks) stream_ack(&stream, ack.first, ack.second);
+  task_unlock(&recording.lock);
+  run.acks.clear();
+  for (; run.next_ping <= now; run.next_ping += kPingMs) {
+    for (int i = 0; i < kClients; i++) {
+      if (run.pages[i].connected) run.latencies.push_back(now - run.next_ping);
+    }
+  }
+  if (!run.connect_done && now >= kConnectMs) {
+    run.latencies.push_back(now - kConnectMs);
+    Connect(3);
+    run.connect_done = true;
+  }
+  // Clients 0 and 1 press DATASET with their own labels, client 2 only watches.
+  for (; run.next_press <= now; run.next_press += kPressMs) {
+    for (int i = 0; i < 2; i++) {
+      if (session_request(&sessions, i, i == 0 ? "0_Zero" : "1_One", now)) {
+        run.pages[i].requests++;
+      }
+    }
+  }
+}
+
+void PumpStream() {
+  task_lock(&recording.lock);
+  stream_pump(&stream, Send, Now());
+  task_unlock(&recording.lock);
+}
+
+// One recording. service() is what the former record_to_buffer() called between chunks.
+void Record(uint8_t recipients, void (*service)()) {
+  static int16_t chunk[STREAM_FRAME_SAMPLES];
+  task_lock(&recording.lock);
+  stream_begin(&stream, recipients);
+  task_unlock(&recording.lock);
+  const uint32_t begin = Now();
+  for (uint32_t t = kChunkMs; t <= kRecordMs; t += kChunkMs) {
+    SleepUntil(begin + t);                     // i2s_read() waits for the DMA buffer.
+    task_lock(&recording.lock);
+    stream_push(&stream, chunk, STREAM_FRAME_SAMPLES, 0, Now());
+    task_unlock(&recording.lock);
+    if (service != nullptr) service();
+  }
+  task_lock(&recording.lock);
+  stream_finish(&stream, Now());
+  task_unlock(&recording.lock);
+  // Spectrogram and JPEG keep the CPU busy.
+  const uint32_t busy_until = Now() + kProcessMs;
+  volatile uint32_t spin = 0;
+  while (Now() < busy_until) spin++;
+}
+
+void ServiceInline() {
+  WebSocketLoop();
+  PumpStream();
+}
+
+void Reset() {
+  run = Run();
+  memset(&stream, 0, sizeof(stream));
+  memset(&sessions, 0, sizeof(sessions));
+  start = Clock::now();
+  for (int i = 0; i < 3; i++) Connect(i);
+}
+
+// The former loop(): records inline.
+void RunInline() {
+  Reset();
+  while (Now() < kRunMs) {
+    WebSocketLoop();
+    char label[SESSION_MAX_LABEL + 1];
+    const uint8_t recipients = session_next(&sessions, Now(), label);
+    if (recipients != 0) {
+      Record(recipients, ServiceInline);
+      SendJpeg(recipients);
+      SendQueue(recipients);
+    }
+    PumpStream();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// recording_step() of the task run.
+void TaskStep() {
+  RecordCommand command;
+  if (!recording_wait(&recording, &command, 10)) return;
+  Record(command.recipients, nullptr);
+  recording_post_buffer(&recording, MSG_JPEG, static_cast<uint8_t*>(malloc(kJpegBytes)),
+                        kJpegBytes, command.recipients);
+  recording_post_done(&recording, command.recipients);
+}
+
+// send_record_event() of the sketch.
+void PollEvents() {
+  RecordEvent event;
+  while (recording_poll(&recording, &event)) {
+    if (event.type == RECORD_EVENT_BUFFER) {
+      SendJpeg(event.recipients);
+      free(event.buffer);
+    } else if (event.type == RECORD_EVENT_DONE) {
+      SendQueue(event.recipients);
+    }
+  }
+}
+
+// The new loop(): only sockets, events and dispatch.
+void RunTask() {
+  Reset();
+  recording.busy = false;
+  while (Now() < kRunMs) {
+    WebSocketLoop();
+    PollEvents();
+    recording_dispatch(&recording, &sessions, Now());
+    PumpStream();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // Let the last recording finish so that every served request is delivered.
+  while (recording.busy) {
+    WebSocketLoop();
+    PollEvents();
+    PumpStream();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+struct Summary {
+  uint32_t max_ms;
+  uint32_t p99_ms;
+  uint32_t over_bound;
+};
+
+Summary Report(const char* name) {
+  std::vector<uint32_t> sorted = run.latencies;
+  std::sort(sorted.begin(), sorted.end());
+  Summary s;
+  s.max_ms = sorted.empty() ? 0 : sorted.back();
+  s.p99_ms = sorted.empty() ? 0 : sorted[sorted.size() * 99 / 100];
+  s.over_bound = static_cast<uint32_t>(
+      sorted.end() - std::upper_bound(sorted.begin(), sorted.end(), kLatencyBoundMs));
+  printf("%-7s %zu events, latency p99 %u ms, max %u ms, %u over %u ms; recordings %u\n", name,
+         sorted.size(), s.p99_ms, s.max_ms, s.over_bound, kLatencyBoundMs, sessions.recordings);
+  for (int i = 0; i < kClients; i++) {
+    const Page& p = run.pages[i];
+    const ClientSession& c = sessions.clients[i];
+    printf("  client %d: %u requests, %u served, %u recordings, %u JPEG, %u queue updates\n", i,
+           p.requests, c.served, p.recordings, p.jpegs, p.queue_updates);
+    Check(p.recordings == c.served && p.jpegs == c.served && p.queue_updates == c.served,
+          "requester did not get its recording");
+  }
+  Check(sessions.recordings >= 3, "too few recordings");
+  return s;
+}
+
+}  // namespace
+
+int main() {
+  printf("%u ms per run, recording %u ms + %u ms processing, pings every %u ms\n\n", kRunMs,
+         kRecordMs, kProcessMs, kPingMs);
+
+  // The queues and the lock are also used by the inline run; its thread idles.
+  Check(recording_start(&recording, TaskStep), "recording task");
+  recording.busy = true;                       // Nothing is dispatched during the inline run.
+  RunInline();
+  const Summary inline_run = Report("inline");
+  RunTask();
+  const Summary task_run = Report("task");
+  recording.running = false;
+  pthread_join(recording_thread, nullptr);
+
+  Check(task_run.max_ms <= kLatencyBoundMs, "network events waited for the recording");
+  // A ping arrives at most kPingMs after the stall begins.
+  Check(inline_run.max_ms >= kProcessMs - kPingMs, "inline run did not stall");
+  Check(recording.dropped == 0, "events dropped");
+  printf("\nworst network event: %u ms inline, %u ms with the recording task\n",
+         inline_run.max_ms, task_run.max_ms);
+
+  printf(failures == 0 ? "PASS\n" : "%d FAILURES\n", failures);
+  return failures == 0 ? 0 : 1;
+}
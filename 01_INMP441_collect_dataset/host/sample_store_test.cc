@@ -0,0 +1,236 @@
+// Host test of the on-device sample store (Sample_store.h).
+//
+// The store runs on its RAM-backed file, which survives store_end() /
+// store_begin() the way flash survives a reboot. Checked: records read back
+// intact, the log is found again after a reboot, the oldest records are
+// overwritten when the log is full, a write torn by a reboot loses only that
+// record, and an export cut off mid-record resumes without gaps or duplicates.
+//
+// With --port=<n> the store is instead exported to
+// Python_INMP441/dataset_receiver.py on 127.0.0.1:<n> in two sessions, the
+// first one dropped halfway; the last line "exported=<n> stored=<m>" is parsed
+// by Python_INMP441/dataset_receiver_test.py.
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/sample_store_test.cc -o sample_store_test
+//   ./sample_store_test
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Recording parameters of 01_INMP441_collect_dataset.ino.
+#define SAMPLE_RATE 16000
+#define RECORD_TIME 1
+#define SAMPLES_COUNT (SAMPLE_RATE * RECORD_TIME)
+
+#include "Sample_store.h"
+
+namespace {
+
+constexpr char kPath[] = "/test.bin";
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Distinct, reproducible samples for record number n.
+std::vector<int16_t> Samples(uint32_t n) {
+  std::vector<int16_t> samples(STORE_MAX_SAMPLES);
+  for (size_t i = 0; i < samples.size(); i++) {
+    samples[i] = static_cast<int16_t>((i * 37 + n * 1009) % 4001) - 2000;
+  }
+  return samples;
+}
+
+std::string Label(uint32_t n) { return std::to_string(n % 10) + "_Word"; }
+
+// Buffer of the record being written: the store reads it until the write ends.
+std::vector<int16_t> pending;
+
+void Append(SampleStore* store, uint32_t n, bool finish) {
+  pending = Samples(n);
+  const std::string label = Label(n);
+  SampleMeta meta = {label.c_str(), 1000 * n, 256 * 12, 32 * 256};
+  Check(store_append(store, pending.data(), pending.size(), &meta), "append");
+  if (finish) {
+    while (store->writing) {
+      store_pump(store);
+    }
+  }
+}
+
+// Export sink: everything sent, optionally failing after a byte budget.
+std::vector<uint8_t> sink;
+size_t sink_budget = SIZE_MAX;
+
+bool Sink(const uint8_t* data, size_t size) {
+  if (size > sink_budget) {
+    return false;
+  }
+  sink_budget -= size;
+  sink.insert(sink.end(), data, data + size);
+  return true;
+}
+
+// Parses the exported stream as dataset_receiver.py does; returns the numbers
+// of the complete records with a valid CRC and their data.
+std::vector<uint32_t> ParseExport(const std::vector<uint8_t>& data, bool* intact) {
+  std::vector<uint32_t> numbers;
+  size_t offset = 0;
+  *intact = true;
+  while (offset + STORE_HEADER_SIZE + STORE_MAX_LABEL <= data.size()) {
+    const uint8_t* header = data.data() + offset;
+    if (memcmp(header, STORE_MAGIC, 4) != 0) {
+      *intact = false;
+      break;
+    }
+    const uint32_t sequence = store_get_u32(header + 8);
+    const uint32_t count = store_get_u32(header + 16);
+    const size_t size = STORE_HEADER_SIZE + STORE_MAX_LABEL + count * 2;
+    if (offset + size > data.size()) {
+      break;
+    }
+    const uint8_t* label = header + STORE_HEADER_SIZE;
+    uint32_t crc = bulk_crc32(0, label, header[5]);
+    crc = bulk_crc32(crc, label + STORE_MAX_LABEL, count * 2);
+    const std::vector<int16_t> expected = Samples(sequence);
+    *intact &= crc == store_get_u32(header + 28) &&
+               std::string(reinterpret_cast<const char*>(label), header[5]) ==
+                   Label(sequence) &&
+               memcmp(label + STORE_MAX_LABEL, expected.data(), count * 2) == 0 &&
+               store_get_u32(header + 12) == 1000 * sequence;
+    numbers.push_back(sequence);
+    offset += size;
+  }
+  return numbers;
+}
+
+SampleStore store;
+
+int Network(int port) {
+  store_ram_erase(kPath);
+  store_begin(&store, kPath);
+  for (uint32_t n = 0; n < 12; n++) {
+    Append(&store, n, true);
+  }
+  uint32_t exported = 0;
+  for (int session = 0; session < 2; session++) {
+    if (!bulk_connect("127.0.0.1", port)) {
+      fprintf(stderr, "Cannot connect to 127.0.0.1:%d\n", port);
+      return 1;
+    }
+    uint8_t resume[4];
+    if (!bulk_write(reinterpret_cast<const uint8_t*>(STORE_EXPORT_REQUEST), 4) ||
+        !bulk_read(resume, sizeof(resume), 2000)) {
+      fprintf(stderr, "No resume point from the receiver\n");
+      return 1;
+    }
+    store_export_begin(&store, store_get_u32(resume));
+    // The first session is dropped in the middle of the seventh record.
+    while (store_export_pump(&store, bulk_write) == STORE_EXPORT_SENDING) {
+      if (session == 0 && store.exported == 6 && store.export_sent > 0) {
+        break;
+      }
+    }
+    exported += store.exported;
+    bulk_disconnect();
+  }
+  printf("exported=%u stored=%u\n", exported, store_count(&store));
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc == 2 && strncmp(argv[1], "--port=", 7) == 0) {
+    return Network(atoi(argv[1] + 7));
+  }
+
+  // Empty store.
+  Check(store_begin(&store, kPath), "open");
+  Check(store_count(&store) == 0, "new store is not empty");
+
+  // Records read back intact and survive a reboot.
+  for (uint32_t n = 0; n < 5; n++) {
+    Append(&store, n, true);
+  }
+  store_end(&store);
+  store_begin(&store, kPath);
+  Check(store.oldest == 0 && store.next == 5, "log not found after reboot");
+  store_export_begin(&store, 0);
+  while (store_export_pump(&store, Sink) == STORE_EXPORT_SENDING) {
+  }
+  bool intact;
+  std::vector<uint32_t> numbers = ParseExport(sink, &intact);
+  Check(intact && numbers == std::vector<uint32_t>({0, 1, 2, 3, 4}), "export");
+
+  // A full log overwrites its oldest records.
+  for (uint32_t n = 5; n < STORE_RECORDS + 8; n++) {
+    Append(&store, n, true);
+  }
+  Check(store.oldest == 8 && store.next == STORE_RECORDS + 8, "wrap around");
+  store_end(&store);
+  store_begin(&store, kPath);
+  Check(store.oldest == 8 && store.next == STORE_RECORDS + 8,
+        "wrapped log not found after reboot");
+
+  // A reboot in the middle of a write loses that record only (and the oldest
+  // one, whose cell it was overwriting).
+  Append(&store, STORE_RECORDS + 8, false);
+  store_pump(&store);
+  store_pump(&store);
+  store_end(&store);
+  store_begin(&store, kPath);
+  Check(store.oldest == 9 && store.next == STORE_RECORDS + 8, "torn write");
+
+  // Export cut off in the middle of a record and resumed from the last
+  // complete one, as the receiver reports it.
+  sink.clear();
+  sink_budget = 5 * STORE_RECORD_SIZE + 1000;
+  store_export_begin(&store, 0);
+  StoreExportState state;
+  while ((state = store_export_pump(&store, Sink)) == STORE_EXPORT_SENDING) {
+  }
+  Check(state == STORE_EXPORT_FAILED, "export did not fail");
+  Check(store.lost == 9, "records lost before export");
+  numbers = ParseExport(sink, &intact);
+  Check(intact && numbers.size() == 5 && numbers.front() == 9, "first export session");
+  const uint32_t resume = numbers.back() + 1;
+  sink.clear();
+  sink_budget = SIZE_MAX;
+  store_export_begin(&store, resume);
+  while ((state = store_export_pump(&store, Sink)) == STORE_EXPORT_SENDING) {
+  }
+  Check(state == STORE_EXPORT_DONE, "export did not finish");
+  std::vector<uint32_t> rest = ParseExport(sink, &intact);
+  numbers.insert(numbers.end(), rest.begin(), rest.end());
+  bool contiguous = intact && numbers.size() == store_count(&store);
+  for (size_t i = 0; contiguous && i < numbers.size(); i++) {
+    contiguous = numbers[i] == store.oldest + i;
+  }
+  Check(contiguous, "resumed export has gaps or duplicates");
+
+  // A receiver ahead of the store (the flash was erased) gets everything.
+  store_export_begin(&store, store.next + 100);
+  Check(store.export_sequence == store.oldest, "resume after erase");
+
+  // Noise floor: the quietest 10 ms frame.
+  std::vector<int16_t> quiet(STORE_MAX_SAMPLES, 0);
+  for (size_t i = 0; i < quiet.size(); i++) {
+    quiet[i] = static_cast<int16_t>(i < 8000 ? (i % 2 ? 1000 : -1000) : (i % 2 ? 10 : -10));
+  }
+  Check(store_noise_floor(quiet.data(), quiet.size()) == 10 * 256, "noise floor");
+
+  printf("%u records stored, %u..%u\n", store_count(&store), store.oldest, store.next - 1);
+  printf(failures == 0 ? "PASS\n" : "%d FAILURES\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+// Host test of the streaming spectrogram quantizer (Spectrogram_quantizer.h).
+//
+// Rows of log10 energies, shaped like the 99 x 41 spectrogram of a one-second
+// recording, are quantized row by row and compared with a float reference
+// using the quantizer's own range, then timed against the former two-pass
+// normalize_spectrogram_uint8() of Audio_processing.h (float** input, malloc
+// per call, one float division per element).
+//
+// Build and run from the sketch directory:
+//   g++ -std=c++17 -O2 -I. host/spectrogram_quantizer_test.cc -o spectrogram_quantizer_test
+//   ./spectrogram_quantizer_test
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Spectrogram_quantizer.h"
+
+namespace {
+
+constexpr int kFrames = 99;
+constexpr int kBins = 41;
+constexpr int kRuns = 2000;
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// The removed two-pass normalization, kept as the timing baseline.
+uint8_t* NormalizeTwoPass(float** spec, int frames, int bins) {
+  const int total = frames * bins;
+  uint8_t* buf = static_cast<uint8_t*>(malloc(total));
+  float min_val = 10000;
+  float max_val = -10000;
+  for (int f = 0; f < frames; f++) {
+    for (int b = 0; b < bins; b++) {
+      min_val = std::fmin(min_val, spec[f][b]);
+      max_val = std::fmax(max_val, spec[f][b]);
+    }
+  }
+  const float diff = max_val - min_val;
+  int idx = 0;
+  for (int f = 0; f < frames; f++) {
+    for (int b = 0; b < bins; b++) {
+      int scaled = static_cast<int>((spec[f][b] - min_val) / diff * 255.0f + 0.5f);
+      buf[idx++] = static_cast<uint8_t>(scaled < 0 ? 0 : scaled > 255 ? 255 : scaled);
+    }
+  }
+  return buf;
+}
+
+// Silence, a word in the middle, silence: log10 energies between -6 and 4.
+std::vector<std::vector<float>> MakeSpectrogram() {
+  std::vector<std::vector<float>> rows(kFrames, std::vector<float>(kBins));
+  srand(1);
+  for (int f = 0; f < kFrames; f++) {
+    const float loudness = (f > 30 && f < 70) ? 6.0f * sinf(M_PI * (f - 30) / 40) : 0;
+    for (int b = 0; b < kBins; b++) {
+      const float noise = static_cast<float>(rand() % 1000) / 1000.0f;
+      rows[f][b] = -5.0f + noise + loudness * expf(-b / 12.0f) + 2.0f;
+    }
+  }
+  return rows;
+}
+
+}  // namespace
+
+int main() {
+  const std::vector<std::vector<float>> rows = MakeSpectrogram();
+
+  // Every row matches the float quantization over the range it was given.
+  SpectrogramQuantizer q;
+  quantizer_reset(&q, QUANT_DECAY_SHIFT);
+  int max_error = 0;
+  int32_t widest = 0;
+  int32_t last_range = 0;
+  bool narrowed_gradually = true;
+  for (int f = 0; f < kFrames; f++) {
+    uint8_t out[kBins];
+    quantizer_row_uint8(&q, rows[f].data(), kBins, out);
+    const float min = static_cast<float>(q.min_q) / (1 << QUANT_FRACTION_BITS);
+    const float range = static_cast<float>(q.max_q - q.min_q) / (1 << QUANT_FRACTION_BITS);
+    for (int b = 0; b < kBins; b++) {
+      const int expected = static_cast<int>(lrintf((rows[f][b] - min) / range * 255.0f));
+      max_error = std::max(max_error, abs(expected - out[b]));
+    }
+    const int32_t current = q.max_q - q.min_q;
+    if (last_range > 0 && current < last_range &&
+        last_range - current > (last_range >> QUANT_DECAY_SHIFT) + 1) {
+      narrowed_gradually = false;
+    }
+    widest = std::max(widest, current);
+    last_range = current;
+  }
+  printf("max error vs float: %d, widest range %.2f, final range %.2f (log10)\n",
+         max_error, static_cast<float>(widest) / (1 << QUANT_FRACTION_BITS),
+         static_cast<float>(last_range) / (1 << QUANT_FRACTION_BITS));
+  Check(max_error <= 1, "quantized values differ from float by more than 1");
+  Check(narrowed_gradually, "range narrowed faster than the decay");
+  Check(last_range < widest, "range did not narrow after the word");
+
+  // A row is always quantized over its full extent.
+  {
+    SpectrogramQuantizer fresh;
+    quantizer_reset(&fresh, 0);
+    uint8_t out[kBins];
+    quantizer_row_uint8(&fresh, rows[50].data(), kBins, out);
+    uint8_t lo = 255, hi = 0;
+    for (int b = 0; b < kBins; b++) {
+      lo = std::min(lo, out[b]);
+      hi = std::max(hi, out[b]);
+    }
+    Check(lo == 0 && hi == 255, "row does not span 0..255");
+  }
+
+  // Flat rows do not divide by zero.
+  {
+    SpectrogramQuantizer flat;
+    quantizer_reset(&flat, QUANT_DECAY_SHIFT);
+    const std::vector<float> constant(kBins, -1.5f);
+    uint8_t out[kBins];
+    quantizer_row_uint8(&flat, constant.data(), kBins, out);
+    Check(out[0] == 0 && out[kBins - 1] == 0, "flat row is not zero");
+  }
+
+  // int8 model input is the same quantization shifted by the zero point.
+  {
+    SpectrogramQuantizer a, b;
+    quantizer_reset(&a, QUANT_DECAY_SHIFT);
+    quantizer_reset(&b, QUANT_DECAY_SHIFT);
+    bool same = true;
+    for (int f = 0; f < kFrames; f++) {
+      uint8_t u[kBins];
+      int8_t s[kBins];
+      quantizer_row_uint8(&a, rows[f].data(), kBins, u);
+      quantizer_row_int8(&b, rows[f].data(), kBins, s);
+      for (int i = 0; i < kBins; i++) {
+        same &= s[i] == static_cast<int8_t>(u[i] - 128);
+      }
+    }
+    float scale;
+    int32_t zero_point;
+    quantizer_params(&b, &scale, &zero_point);
+    Check(same, "int8 output is not uint8 - 128");
+    Check(zero_point == -128 && fabsf(scale * 255 * (1 << QUANT_FRACTION_BITS) -
+                                      (b.max_q - b.min_q)) < 1,
+          "int8 parameters");
+  }
+
+  // Timing: whole spectrogram, two-pass float vs streaming fixed point.
+  std::vector<float*> pointers;
+  for (auto& row : rows) {
+    pointers.push_back(const_cast<float*>(row.data()));
+  }
+  uint32_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < kRuns; run++) {
+    uint8_t* buf = NormalizeTwoPass(pointers.data(), kFrames, kBins);
+    checksum += buf[run % (kFrames * kBins)];
+    free(buf);
+  }
+  const double two_pass_us =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+          .count() / kRuns;
+  static uint8_t image[kFrames * kBins];
+  start = std::chrono::steady_clock::now();
+  for (int run = 0; run < kRuns; run++) {
+    for (int f = 0; f < kFrames; f++) {
+      quantizer_row_uint8(&q, rows[f].data(), kBins, image + f * kBins);
+    }
+    checksum += image[run % (kFrames * kBins)];
+  }
+  const double streaming_us =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+          .count() / kRuns;
+  printf("99x41 spectrogram: two-pass %.1f us + malloc, streaming %.1f us (checksum %u)\n",
+         two_pass_us, streaming_us, checksum);
+
+  printf(failures == 0 ? "PASS\n" : "%d FAILURES\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -1,21 +1,184 @@
-// Выделить память для работы с Json(200 байт).
-StaticJsonDocument<200> doc_tx; // для передачи данных.
-StaticJsonDocument<200> doc_rx; // для приёма данных.
-String jsonString = "";
+// Буфер для сообщений с данными, которые нужно передать одним сообщением WebSocket вместе с заголовком
+// (JPEG спектрограммы 41x99 в градациях серого занимает 2-4 КБ).
+#define MSG_TX_SIZE 8192
+uint8_t msg_tx[MSG_TX_SIZE];
 
-// Функция отправляет данные на вебстраничку к клиенту.
-void sendJson(String jsonString ,StaticJsonDocument<200> doc, String l_type, int l_value) {
-    // Создать JSON обьект.
-    JsonObject object = doc.to<JsonObject>();
-    // Записать данные в JSON обьект.
-    object["type"] = l_type;
-    object["value"] = l_value;
-    // Конвертировать JSON обьект в строку.
-    serializeJson(doc, jsonString);
-    // Отправить данные на вебстраничку к клиенту.
-    webSocket.broadcastTXT(jsonString);
-    // Очистить JSON документ.
-    doc.clear();
+// Функция отправляет на вебстраничку управляющее сообщение (ключ ControlKey и значение).
+void send_control(uint8_t key, int32_t value) {
+    uint8_t message[MSG_HEADER_SIZE + 4];
+    webSocket.broadcastBIN(message, msg_control(message, key, value));
+}
+
+// Функция отправляет управляющее сообщение только клиенту с номером num.
+void send_control_to(uint8_t num, uint8_t key, int32_t value) {
+    uint8_t message[MSG_HEADER_SIZE + 4];
+    webSocket.sendBIN(num, message, msg_control(message, key, value));
+}
+
+// Функция отправляет клиенту кол-во его запросов DATASET, ожидающих записи.
+void send_queue(uint8_t num) {
+    send_control_to(num, CTRL_QUEUE, session_pending(&sessions, num));
+}
+
+// Функция отправляет на вебстраничку статистику аудиопотока.
+void send_stats(uint32_t bytes_per_sec, uint32_t max_latency_ms, uint32_t dropped) {
+    uint8_t message[MSG_HEADER_SIZE + 12];
+    webSocket.broadcastBIN(message, msg_stats(message, bytes_per_sec, max_latency_ms, dropped));
+}
+
+// Функция отправляет сообщение типа type с данными data клиентам из маски recipients
+// (бит на номер клиента, STREAM_ALL_CLIENTS - всем).
+bool send_message(uint8_t type, const uint8_t* data, size_t size, uint8_t recipients) {
+    if (size > MSG_TX_SIZE - MSG_HEADER_SIZE) {
+        Serial.printf("Message of %u bytes is too large\n", size);
+        return false;
+    }
+    msg_header(msg_tx, type, 0, size);
+    memcpy(msg_tx + MSG_HEADER_SIZE, data, size);
+    if (recipients == STREAM_ALL_CLIENTS) {
+        return webSocket.broadcastBIN(msg_tx, MSG_HEADER_SIZE + size);
+    }
+    bool sent = true;
+    for (uint8_t num = 0; num < SESSION_MAX_CLIENTS; num++) {
+        if (recipients & session_bit(num)) {
+            sent &= webSocket.sendBIN(num, msg_tx, MSG_HEADER_SIZE + size);
+        }
+    }
+    return sent;
+}
+
+// Функция отправляет веб-страничке событие задачи записи (Recording_task.h), вызывается из loop().
+void send_record_event(const RecordEvent* event) {
+    switch (event->type) {
+      case RECORD_EVENT_CONTROL:
+        send_control(event->key, event->value);
+        break;
+      case RECORD_EVENT_MESSAGE:
+        send_message(event->key, event->data, event->size, event->recipients);
+        break;
+      case RECORD_EVENT_BUFFER:
+        send_message(event->key, event->buffer, event->size, event->recipients);
+        free(event->buffer);
+        break;
+      case RECORD_EVENT_DONE:
+        // Показываем запросившим клиентам, сколько их запросов ещё ждёт записи.
+        for (uint8_t num = 0; num < SESSION_MAX_CLIENTS; num++) {
+          if (event->recipients & session_bit(num)) {
+            send_queue(num);
+          }
+        }
+        break;
+      default:
+        break;
+    }
+}
+
+// Функция отправляет кадр аудиопотока (Audio_streaming.h) клиенту с номером num.
+bool stream_send_ws(uint8_t num, const uint8_t* data, size_t size) {
+    return webSocket.sendBIN(num, (uint8_t*)data, size);
+}
+
+// Функция разбирает адрес приёмника "host:port" в bulk_host и bulk_port (порт необязателен).
+// Вызывается под recording.lock: задача записи копирует адрес в bulk_settings_take().
+void set_receiver(const char* receiver) {
+  if (receiver == nullptr) {
+    receiver = "";
+  }
+  const char* colon = strrchr(receiver, ':');
+  size_t host_length = colon != nullptr ? (size_t)(colon - receiver) : strlen(receiver);
+  if (host_length >= sizeof(bulk_host)) {
+    host_length = sizeof(bulk_host) - 1;
+  }
+  memcpy(bulk_host, receiver, host_length);
+  bulk_host[host_length] = '\0';
+  if (colon != nullptr) {
+    bulk_port = atoi(colon + 1);
+  }
+}
+
+/** Функция handleMessage обрабатывает одно сообщение протокола (Message_protocol.h), принятое от клиента.
+    - byte num (номер клиента)
+    - const Message* message (разобранное сообщение)**/
+void handleMessage(byte num, const Message* message) {
+  // От веб-странички приходят только управляющие сообщения со значением int32.
+  if (message->type != MSG_CONTROL || message->length < 4) {
+    Serial.printf("Unexpected message type %u from user %u\n", message->type, num);
+    return;
+  }
+  const uint8_t key = message->flags;
+  const int32_t value = (int32_t)msg_get_u32(message->payload);
+
+  // Подтверждения кадров аудиопотока приходят часто, поэтому обрабатываются без вывода в порт.
+  if (key == CTRL_ACK) {
+    task_lock(&recording.lock);
+    stream_ack(&audio_stream, num, (uint32_t)value);
+    task_unlock(&recording.lock);
+    return;
+  }
+  // Выведим пользователя от которого были приняты данные.
+  Serial.println("Received from user: " + String(num));
+  Serial.printf("Key: %u, value: %d\n", key, value);
+
+  // Исходя из ключа управляющего сообщения выполним соответствующий блок кода.
+  // Если ключ отображает состояние кнопки отвечающей за скачивание теплового снимка.
+  if (key == CTRL_DATASET) {
+    // Запрос ставится в очередь сеанса клиента вместе с меткой, void loop() {} отдаёт запросы клиентов
+    // задаче записи по очереди, и результат отправляется только запросившим.
+    size_t offset = 4;
+    const char* label = msg_string(message, &offset);
+    if (value && !session_request(&sessions, num, label, millis())) {
+      Serial.printf("Queue of user %u is full\n", num);
+    }
+    // Показываем клиенту длину его очереди.
+    send_queue(num);
+  }
+  // Если ключ отображает состояние кнопки массового сбора датасета.
+  else if (key == CTRL_BULK) {
+    // Вместе с включением передаются метка фраз и адрес приёмника "host:port" (строки после значения).
+    if (value) {
+      size_t offset = 4;
+      const char* label = msg_string(message, &offset);
+      const char* receiver = msg_string(message, &offset);
+      task_lock(&recording.lock);
+      strlcpy(bulk_label, label != nullptr ? label : "", sizeof(bulk_label));
+      set_receiver(receiver);
+      task_unlock(&recording.lock);
+    }
+    // Присвоим bool bulk значение, чтобы задача записи начала или остановила непрерывную запись.
+    // Массовый сбор и выгрузка используют одно соединение с приёмником, поэтому выгрузка прерывается.
+    bulk = value != 0;
+    if (bulk) {
+      store_export = false;
+    }
+  }
+  // Если ключ отображает выбор передаваемых данных массового сбора (PCM или признаки).
+  else if (key == CTRL_FEATURES) {
+    const uint8_t format = value & 0xFF;
+    task_lock(&recording.lock);
+    bulk_features = format <= FEATURE_FORMAT_UINT8 ? format : FEATURE_FORMAT_PCM;
+    bulk_features_pcm = bulk_features != FEATURE_FORMAT_PCM && (value & 0x100) != 0;
+    task_unlock(&recording.lock);
+  }
+  // Если ключ отображает состояние кнопки выгрузки записей из flash.
+  else if (key == CTRL_EXPORT) {
+    if (value) {
+      size_t offset = 4;
+      task_lock(&recording.lock);
+      set_receiver(msg_string(message, &offset));
+      task_unlock(&recording.lock);
+    }
+    // Во время массового сбора соединение с приёмником занято, выгрузка не начинается.
+    store_export = value != 0 && !bulk;
+    if (value && bulk) {
+      send_control(CTRL_EXPORT_STATE, 0);
+    }
+  }
+  // Если ключ отображает состояние кнопки живой спектрограммы.
+  else if (key == CTRL_LIVE) {
+    // Присвоим bool live значение, чтобы задача записи начала или остановила отправку строк спектрограммы.
+    live = value != 0;
+  }
+  Serial.println("");
 }
 
 /** Функция webSocketEvent обработывает данные полученные от клиента через соеденение вебсокетов.
@@ -29,38 +192,38 @@ void webSocketEvent(byte num, WStype_t type, uint8_t * payload, size_t length) {
     // Обработка отключения клиента:
     case WStype_DISCONNECTED: // Если клиент отключился, выполнить следующий блок кода.
       Serial.println("Client " + String(num) + " disconnected");
+      // Больше не отправлять клиенту кадры аудиопотока, его запросы записи отменяются.
+      task_lock(&recording.lock);
+      stream_client_disconnect(&audio_stream, num);
+      task_unlock(&recording.lock);
+      session_disconnect(&sessions, num);
       break;
     // Обработка подключения клиента:
     case WStype_CONNECTED:    // Если клиент подключился, выполнить следующий блок кода.
       Serial.println("Client " + String(num) + " connected");
+      // Клиент получает кадры аудиопотока, записанные после подключения, и начинает свой сеанс.
+      task_lock(&recording.lock);
+      stream_client_connect(&audio_stream, num);
+      task_unlock(&recording.lock);
+      session_connect(&sessions, num);
       break;
-    // Обработка текстовых данных, отправленных клиентом:
-    case WStype_TEXT:   // Если клиент отправил текстовые данные, обработать их.
-      // Записать данные переданные от клиента "payload" в памяти контролера "doc_rx".
-      DeserializationError error = deserializeJson(doc_rx, payload);
-      // Если произошла ошибка при записи, вывести сообщение об ошибке.
-      if (error) {
-        Serial.print(F("deserializeJson() failed: "));
-        Serial.println(error.f_str());
-        return;
-      }
-      // При успешной записи JSON строки в память контролера обработать её.
-      else {
-        // Выведим пользователя от которого были приняты данные.
-        Serial.println("Received from user: " + String(num));
-        // Определим тип JSON строки обратившись к ней по ключу ["type"].
-        const char* msg_type = doc_rx["type"];
-        Serial.println("Type: " + String(msg_type));
-
-        // Исходя из типа принятой JSON строки выполним соответствующий блок кода.
-        // Если переменная отображает состояние кнопки отвечающей за скачивание теплового снимка.
-        if(String(msg_type) == "dataset") {
-          // Присвоим bool dataset значение true чтобы в void loop() {} 
-          // выполнить блок кода отвечающий за отправку теплового снимка на вебстраничку для скачивания.
-          dataset = doc_rx["value"];
+    // Обработка двоичных данных, отправленных клиентом: одно или несколько сообщений протокола подряд.
+    case WStype_BIN: {
+      Message message;
+      size_t offset = 0;
+      while (offset < length) {
+        const size_t size = msg_parse(payload + offset, length - offset, &message);
+        // Обрезанное сообщение отбрасывается вместе с остатком данных.
+        if (size == 0) {
+          Serial.printf("Truncated message from user %u\n", num);
+          break;
         }
+        handleMessage(num, &message);
+        offset += size;
       }
-      Serial.println("");
+      break;
+    }
+    default:
       break;
   }
 }
\ No newline at end of file
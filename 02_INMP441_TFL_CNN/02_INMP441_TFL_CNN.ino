@@ -13,6 +13,12 @@
 /** В документе реализлваны функции для обработки аудио и построения спектрограмы. **/
 #include <Audio_processing.h>
 
+/** В документе реализован профилировщик этапов обработки и операций модели. **/
+#include "Profiling.h"
+
+/** В документе реализована загрузка модели из раздела flash без перепрошивки. **/
+#include "ModelLoader.h"
+
 // Пины для подключения светодиодов.
 const int LED1 = 19;  
 const int LED2 = 20;
@@ -26,85 +32,6 @@ void setup() {
   // Прописываем WAV-заголовок в буфере wav_buffer.
   create_wav_header(wav_buffer, DATA_SIZE);
 
-  // TensorFlowLite_ESP32---------------------------------------------------------------------------------------------------------
-  // Для ведения журнала ошибок создадим переменную "error_reporter" на базе предоставляемых библиотекой Tensor Flow Lite структур данных.
-  //static tflite::MicroErrorReporter micro_error_reporter;
-  static tflite::MicroErrorReporter micro_error_reporter;
-  // Переменную "error_reporter" необходимо передать в интерпретатор, который будет в свою очередь передавать в неё список ошибок.
-  error_reporter = &micro_error_reporter;
-
-
-  // Создадим экземпляр модели используя массив данных из документа "TensorFlowLiteModel.h" 
-  model = tflite::GetModel(model_TFLite);
-  // Проверка соответствия версии модели и версии библиотеки.
-  if (model->version() != TFLITE_SCHEMA_VERSION) {
-    TF_LITE_REPORT_ERROR(error_reporter,
-                         "Model provided is schema version %d not equal "
-                         "to supported version %d.",
-                         model->version(), TFLITE_SCHEMA_VERSION);
-    return;
-  }
-  // Выделить обьём памяти для входного, выходного и промежуточных массивов модели,
-  if (tensor_arena == NULL) {
-    // Выделить более медляную память, но большую по обьёму.
-    //tensor_arena = (uint8_t*) ps_calloc(kTensorArenaSize, 1);
-    // Выделить более быструю память, но меньшую по обьёму.
-    //tensor_arena = (uint8_t *) heap_caps_malloc(kTensorArenaSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
-    tensor_arena = (uint8_t*) malloc(kTensorArenaSize);
-  }
-  // Если не удалось выделить обьём памяти для входного, выходного и промежуточных массивов модели, то вывести сообщение об ошибке.
-  if (tensor_arena == NULL) {
-    printf("Couldn't allocate memory of %d bytes\n", kTensorArenaSize);
-    return;
-  }
-
-
-  // Загрузить все методы, что содержит библиотека Tensor Flow Lite, для обработки данных моделью. (Занимает большой обьём памяти)
-  // tflite::AllOpsResolver resolver;
-
-  // Загрузить необходимые методы для обработки данных моделью из библиотеки Tensor Flow Lite.
-  static tflite::MicroMutableOpResolver<9> micro_op_resolver;
-  // AveragePool2D — операция, применяемая в свёрточных нейронных сетях (CNN), для уменьшения ширины и высоты входного тензора.
-  micro_op_resolver.AddAveragePool2D();
-  // MaxPool2D — операция в свёрточных нейронных сетях (CNN), которая выполняет подвыборку данных, уменьшая ширину и высоту входного тензора.
-  micro_op_resolver.AddMaxPool2D();
-  // Reshape — операция, используемая в машинном обучении и обработке данных, которая изменяет форму (размерность) тензора без изменения его данных
-  micro_op_resolver.AddReshape();
-  // FullyConnected (полносвязанный слой) — используется для выполнения нелинейных преобразований данных и играет важную роль в моделях глубокого обучения.
-  micro_op_resolver.AddFullyConnected();
-  // Conv2D (свёрточный слой) — выполняет операцию свёртки над входными данными, чтобы извлекать локальные признаки, использует их для построения более сложных представлений на следующих слоях.
-  micro_op_resolver.AddConv2D();
-  // DepthwiseConv2D — разновидность свёрточного слоя, которая применяется для увеличения вычислительной эффективности и уменьшения количества параметров модели.
-  micro_op_resolver.AddDepthwiseConv2D();
-  // Softmax — функция активации, которая используется в выходных слоях нейронных сетей для задач классификации.
-  micro_op_resolver.AddSoftmax();
-  // Quantize (квантование) — процесс преобразования данных или моделей глубокого обучения, чтобы снизить их размер и вычислительную сложность, сохраняя при этом приемлемую точность.
-  micro_op_resolver.AddQuantize();
-  // Dequantize (деквантование) — процесс обратного преобразования данных из квантованного формата обратно в формат с плавающей точкой или в более высокую точность. 
-  micro_op_resolver.AddDequantize();
-
-
-  // Создадим экземпляр интерпретатора передавав необходимые данные для запуска модели.
-  static tflite::MicroInterpreter static_interpreter(
-    model, micro_op_resolver, tensor_arena, kTensorArenaSize);
-      //model, micro_op_resolver, tensor_arena, kTensorArenaSize, error_reporter);
-
-  interpreter = &static_interpreter;
-
-
-  // Выделим память для внутрених тензоров модели из выделеной ранее памяти tensor_arena.
-  TfLiteStatus allocate_status = interpreter->AllocateTensors();
-  // При неудачном выделении памяти сообщить об ошибке.
-  if (allocate_status != kTfLiteOk) {
-    TF_LITE_REPORT_ERROR(error_reporter, "AllocateTensors() failed");
-    return;
-  }
-
-  // Получить указатель на входной тензор модели.
-  input = interpreter->input(0);
-  // TensorFlowLite_ESP32---------------------------------------------------------------------------------------------------------
-
-
   // Инициализирует последовательный порт (UART) для связи ESP32 ↔ компьютер.
   Serial.begin(115200);
   Serial.println("I2S microphone record demo");
@@ -118,6 +45,22 @@ void setup() {
   delay(500);
 
 
+  // TensorFlowLite_ESP32---------------------------------------------------------------------------------------------------------
+  // Создать профилировщик, который интерпретатор будет вызывать для каждой операции модели.
+  init_profiler();
+
+  // Выделить память для тензоров модели, затем создать интерпретатор для модели из раздела flash,
+  // выбранной командой "model <раздел>" (если выбрана), иначе для встроенной модели.
+  if (init_tflite_arena(profiler) && !load_saved_model()) {
+    init_tflite(profiler);
+  }
+  // Без модели loop() не запускает инференс и ждёт команду "model <источник>".
+  if (interpreter == nullptr || input == nullptr) {
+    Serial.println("No model is loaded, send \"model <source>\"");
+  }
+  // TensorFlowLite_ESP32---------------------------------------------------------------------------------------------------------
+
+
   // Инициализация пинов ESP32 для светодиодов.
   pinMode(LED1, OUTPUT);
   pinMode(LED2, OUTPUT);
@@ -132,15 +75,36 @@ void setup() {
 
 
 void loop() {
-  // Записываем 1 секунду аудио в буфере wav_buffer.
-  record_to_buffer();
+  // Принять команду замены модели и заменить модель, пока интерпретатор не используется.
+  handle_model_command();
+  if (apply_pending_model() == MODEL_SWAP_FAILED) {
+    Serial.println("No model is loaded, inference is stopped");
+  }
+  // Без интерпретатора (модель не загрузилась в setup() или не восстановилась после замены)
+  // модель не запускается: ждём команду "model <источник>".
+  if (interpreter == nullptr || input == nullptr) {
+    delay(100);
+    return;
+  }
+
+  // Начать новый кадр профилирования (одна итерация loop()).
+  if (profiler != nullptr) profiler->BeginFrame();
+
+  {
+    tflite::ScopedMicroProfiler stage(kStageCapture, profiler);
+    // Записываем 1 секунду аудио в буфере wav_buffer.
+    record_to_buffer();
+  }
   
   //  - uint8_t * d_buff: Указатель на исходное тихое аудио.
   uint8_t* src  = wav_buffer + WAV_HEADER_SIZE;    // исходные данные (ADC-формат 12 бит)
   //  - uint8_t* s_buff: Указатель для запизи громкого аудио.
   uint8_t* dest = wav_buffer + WAV_HEADER_SIZE;    // будем конвертировать "на месте"
-  // Функция увеличивает громкость аудио.
-  audio_scale(dest, src, DATA_SIZE);
+  {
+    tflite::ScopedMicroProfiler stage(kStageAudioScale, profiler);
+    // Функция увеличивает громкость аудио.
+    audio_scale(dest, src, DATA_SIZE);
+  }
   
   // Указатель на аудиосигнал преобразуемый в спектрограму.
   int16_t *pcm16 = (int16_t*)(wav_buffer + WAV_HEADER_SIZE);
@@ -148,33 +112,32 @@ void loop() {
   float **spec;
   // Сюда функция get_spectrogram() запишет количество временных кадров спектрограммы.
   int frames;
-  // Построить спектрограмму.
-  bool above_noise = get_spectrogram(pcm16, SAMPLES_COUNT, spec, frames);
+  bool above_noise;
+  {
+    tflite::ScopedMicroProfiler stage(kStageSpectrogram, profiler);
+    // Построить спектрограмму.
+    above_noise = get_spectrogram(pcm16, SAMPLES_COUNT, spec, frames);
+  }
 
 
   // TensorFlowLite_ESP32---------------------------------------------------------------------------------------------------------
   // Если громкость аудио записи выше порогового значения, то выполнить инференс модели.
   if(smoothed_noise_floor > 2.2){
     Serial.println("------------- // smoothed_noise_floor > 4.5 // -------------");
-    // Входной тензор модели (вход модели).
-    float * input_data = input->data.f;
-
-    // Индекс текущего элемента входного тензора модели.
-    int input_idx = 0;
-    // Передаём спектрограмму (в порядке NHWC: [frames][bins][1]) на вход свёрточной нейронной сети.
-    for (int f = 0; f < frames; f++) {
-        for (int b = 0; b < POOLED_BINS; b++) {
-            input_data[input_idx] = spec[f][b];
-            input_idx++;
-        }
-    }
-    
-    // Вызвать модель (произвести преобразование входного изображения в вероятность принадлежности 
-    // данного изображения к каждому из возможных классов).
-    if (kTfLiteOk != interpreter->Invoke()) {
-      TF_LITE_REPORT_ERROR(error_reporter, "Invoke failed.");
+    {
+      // Записи операций модели, которые интерпретатор передаёт профилировщику, вложены в этот этап.
+      tflite::ScopedMicroProfiler stage(kStageInvoke, profiler);
+      // Передаём спектрограмму на вход свёрточной нейронной сети.
+      spectrogram_to_input(spec, frames, input->data.f);
+      
+      // Вызвать модель (произвести преобразование входного изображения в вероятность принадлежности 
+      // данного изображения к каждому из возможных классов).
+      if (kTfLiteOk != interpreter->Invoke()) {
+        TF_LITE_REPORT_ERROR(error_reporter, "Invoke failed.");
+      }
     }
 
+    tflite::ScopedMicroProfiler stage(kStagePostprocess, profiler);
     // Получить выход модели.
     TfLiteTensor* output = interpreter->output(0);
 
@@ -189,7 +152,7 @@ void loop() {
     // Получим наименование предсказаной категории.
     String prediction = getPrediction(kCategoryCount, probabilities, kCategoryLabels);
 
-    Serial.printf("Prediction: %s\n", prediction);
+    Serial.printf("Prediction: %s\n", prediction.c_str());
 
     // Включить предсказаное кол-во светодиодов.
     setLedsByPrediction(prediction);
@@ -201,7 +164,9 @@ void loop() {
 
   // Освободить выделенную память под спектрограмму.
   free_spectrogram(spec, frames);
-  
+
+  // Отправить записи профилировщика за эту итерацию в UART.
+  export_profiler_trace();
 }
 
 
@@ -231,6 +231,27 @@ void free_spectrogram(float **spec, int frames) {
 
 
 
+// ===============================
+// Передать спектрограмму на вход модели.
+//  - float **spec: двухмерный массив для спектрограммы (каждая строка = pooled frequency bins).
+//  - int frames: число временных кадров (строк) в спектрограмме.
+//  - float *input_data: входной тензор модели (input->data.f).
+// ===============================
+void spectrogram_to_input(float **spec, int frames, float *input_data) {
+  // Индекс текущего элемента входного тензора модели.
+  int input_idx = 0;
+  // Передаём спектрограмму (в порядке NHWC: [frames][bins][1]) на вход свёрточной нейронной сети.
+  for (int f = 0; f < frames; f++) {
+      for (int b = 0; b < POOLED_BINS; b++) {
+          input_data[input_idx] = spec[f][b];
+          input_idx++;
+      }
+  }
+}
+
+
+
+
 // ===============================
 // Example usage function
 //  - const int16_t *pcm16: Указатель на аудиосигнал преобразуемый в спектрограму.
@@ -266,15 +287,8 @@ void process_audio_to_spectrogram(const int16_t *pcm16, size_t sample_count)
     //Serial.printf("Input bytes: %d\n", input->bytes);
 
 
-    // Индекс текущего элемента входного тензора модели.
-    int input_idx = 0;
-    // Передаём спектрограмму (в порядке NHWC: [frames][bins][1]) на вход свёрточной нейронной сети.
-    for (int f = 0; f < frames; f++) {
-        for (int b = 0; b < POOLED_BINS; b++) {
-            input_data[input_idx] = spec[f][b];
-            input_idx++;
-        }
-    }
+    // Передаём спектрограмму на вход свёрточной нейронной сети.
+    spectrogram_to_input(spec, frames, input_data);
     
     // Вызвать модель (произвести преобразование входного изображения в вероятность принадлежности 
     // данного изображения к каждому из возможных классов).
@@ -296,7 +310,7 @@ void process_audio_to_spectrogram(const int16_t *pcm16, size_t sample_count)
     // Получим наименование предсказаной категории.
     String prediction = getPrediction(kCategoryCount, probabilities, kCategoryLabels);
 
-    Serial.printf("Prediction: %s\n", prediction);
+    Serial.printf("Prediction: %s\n", prediction.c_str());
   
   }
 
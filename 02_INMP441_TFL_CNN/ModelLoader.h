@@ -0,0 +1,342 @@
+#ifndef MODEL_LOADER_H
+#define MODEL_LOADER_H
+
+// Загрузка модели .tflite без перепрошивки устройства.
+//
+// Модель не копируется в оперативную память: на ESP32 раздел flash с моделью отображается
+// в адресное пространство (esp_partition_mmap), на компьютере файл отображается через mmap.
+// Интерпретатор читает веса напрямую из отображённой памяти.
+//
+// Разделы model_a и model_b описаны в partitions.csv. Новая модель записывается в раздел,
+// который сейчас не используется, например:
+//   parttool.py --port /dev/ttyUSB0 write_partition --partition-name model_b --input model.tflite
+// после чего в мониторе порта отправляется команда "model model_b" (или "model builtin",
+// чтобы вернуться к модели из TensorFlowLiteModel.h). Выбранный раздел запоминается в NVS
+// и загружается при следующем запуске.
+//
+// Замена выполняется в два шага:
+//   request_model_swap() - отобразить и проверить модель (можно вызывать из другой задачи);
+//   apply_pending_model() - вызывается из loop() между инференсами: пересоздаёт интерпретатор
+//                           в той же памяти tensor_arena. Если тензоры новой модели не помещаются
+//                           в tensor_arena, возвращается прежняя модель. Если не удалось вернуть
+//                           и её, интерпретатора нет (MODEL_SWAP_FAILED) и loop() не запускает модель.
+
+#include <atomic>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <Preferences.h>
+#include <esp_idf_version.h>
+#include <esp_partition.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Источник, который означает модель, встроенную в прошивку (массив model_TFLite).
+#define MODEL_SOURCE_BUILTIN "builtin"
+// Подтип разделов с моделями в partitions.csv.
+#define MODEL_PARTITION_SUBTYPE 0x40
+
+// Отображённая в память модель.
+struct MappedModel {
+  const uint8_t* data = nullptr;   // Начало данных модели.
+  size_t size = 0;                 // Размер отображённой области (для раздела - размер раздела).
+  char source[32] = "";            // Имя раздела или путь к файлу.
+#if defined(ARDUINO_ARCH_ESP32)
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_mmap_handle_t handle = 0;
+#else
+  spi_flash_mmap_handle_t handle = 0;
+#endif
+#endif
+};
+
+// Модель, с которой работает интерпретатор (data == nullptr - встроенная модель).
+MappedModel active_model;
+// Проверенная модель, ожидающая замены. Заполняется в request_model_swap(), используется в apply_pending_model().
+MappedModel pending_slot;
+// Указатель на pending_slot, если есть модель, ожидающая замены (nullptr - нет).
+std::atomic<MappedModel*> pending_model(nullptr);
+
+// Результат apply_pending_model().
+enum ModelSwapResult {
+  MODEL_SWAP_NONE,        // Замены не было.
+  MODEL_SWAP_DONE,        // Модель заменена.
+  MODEL_SWAP_REJECTED,    // Новая модель не подошла, работает прежняя.
+  MODEL_SWAP_FAILED,      // Не подошла новая и не удалось вернуть прежнюю: интерпретатора нет.
+};
+
+
+// ===============================
+// Отобразить модель в память.
+//  - const char* source: имя раздела (ESP32) или путь к файлу (компьютер).
+//  - MappedModel* mapped: результат.
+// Возвращает false, если источник не найден или не удалось отобразить его в память.
+// ===============================
+bool map_model(const char* source, MappedModel* mapped) {
+  *mapped = MappedModel();
+  strncpy(mapped->source, source, sizeof(mapped->source) - 1);
+#if defined(ARDUINO_ARCH_ESP32)
+  const esp_partition_t* partition = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)MODEL_PARTITION_SUBTYPE, source);
+  if (partition == NULL) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model partition %s not found", source);
+    return false;
+  }
+  // Отобразить весь раздел: размер модели в разделе не хранится, лишние байты проверке не мешают.
+  const void* data = NULL;
+  esp_err_t err = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                                     &data, &mapped->handle);
+  if (err != ESP_OK) {
+    TF_LITE_REPORT_ERROR(error_reporter, "esp_partition_mmap(%s) failed: %d", source, err);
+    return false;
+  }
+  mapped->data = (const uint8_t*)data;
+  mapped->size = partition->size;
+#else
+  int fd = open(source, O_RDONLY);
+  if (fd < 0) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Cannot open model %s", source);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model %s is empty", source);
+    close(fd);
+    return false;
+  }
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // Отображение остаётся действительным и после закрытия файла.
+  close(fd);
+  if (data == MAP_FAILED) {
+    TF_LITE_REPORT_ERROR(error_reporter, "mmap(%s) failed", source);
+    return false;
+  }
+  mapped->data = (const uint8_t*)data;
+  mapped->size = st.st_size;
+#endif
+  return true;
+}
+
+
+// ===============================
+// Освободить отображение модели.
+// ===============================
+void unmap_model(MappedModel* mapped) {
+  if (mapped->data == nullptr) {
+    return;
+  }
+#if defined(ARDUINO_ARCH_ESP32)
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_munmap(mapped->handle);
+#else
+  spi_flash_munmap(mapped->handle);
+#endif
+#else
+  munmap((void*)mapped->data, mapped->size);
+#endif
+  *mapped = MappedModel();
+}
+
+
+// ===============================
+// Проверить, что данные являются моделью, которую может выполнить скетч:
+// корректный FlatBuffer схемы TFLite нужной версии, вход [1, height, wide, 1] float32,
+// выход из kCategoryCount значений int8 (метки kCategoryLabels не меняются).
+// Операции модели проверяются позже, при AllocateTensors().
+// ===============================
+bool validate_model(const uint8_t* data, size_t size) {
+  // Проверка структуры FlatBuffer: все смещения и длины векторов лежат внутри буфера.
+  flatbuffers::Verifier verifier(data, size);
+  if (!tflite::VerifyModelBuffer(verifier)) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model is not a valid .tflite FlatBuffer");
+    return false;
+  }
+  const tflite::Model* candidate = tflite::GetModel(data);
+  if (candidate->version() != TFLITE_SCHEMA_VERSION) {
+    TF_LITE_REPORT_ERROR(error_reporter,
+                         "Model provided is schema version %d not equal "
+                         "to supported version %d.",
+                         candidate->version(), TFLITE_SCHEMA_VERSION);
+    return false;
+  }
+  if (candidate->subgraphs() == nullptr || candidate->subgraphs()->size() != 1) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model must have exactly one subgraph");
+    return false;
+  }
+  const tflite::SubGraph* subgraph = candidate->subgraphs()->Get(0);
+  if (subgraph->inputs() == nullptr || subgraph->inputs()->size() != 1 ||
+      subgraph->outputs() == nullptr || subgraph->outputs()->size() != 1 ||
+      subgraph->tensors() == nullptr) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model must have one input and one output");
+    return false;
+  }
+
+  // Индексы входного и выходного тензоров.
+  const int32_t input_index = subgraph->inputs()->Get(0);
+  const int32_t output_index = subgraph->outputs()->Get(0);
+  if (input_index < 0 || (uint32_t)input_index >= subgraph->tensors()->size() ||
+      output_index < 0 || (uint32_t)output_index >= subgraph->tensors()->size()) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model input/output tensor index out of range");
+    return false;
+  }
+
+  // Вход: спектрограмма [1, height, wide, 1] в float32, как её заполняет spectrogram_to_input().
+  const tflite::Tensor* input_tensor = subgraph->tensors()->Get(input_index);
+  const int32_t expected_shape[4] = {1, height, wide, 1};
+  const auto* input_shape = input_tensor->shape();
+  bool input_ok = input_tensor->type() == tflite::TensorType_FLOAT32 &&
+                  input_shape != nullptr && input_shape->size() == 4;
+  for (int i = 0; input_ok && i < 4; i++) {
+    input_ok = input_shape->Get(i) == expected_shape[i];
+  }
+  if (!input_ok) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model input must be float32 [1, %d, %d, 1]", height, wide);
+    return false;
+  }
+
+  // Выход: kCategoryCount вероятностей int8 (см. getPrediction()).
+  const tflite::Tensor* output_tensor = subgraph->tensors()->Get(output_index);
+  int output_count = 1;
+  if (output_tensor->shape() != nullptr) {
+    for (uint32_t i = 0; i < output_tensor->shape()->size(); i++) {
+      output_count *= output_tensor->shape()->Get(i);
+    }
+  }
+  if (output_tensor->type() != tflite::TensorType_INT8 || output_count != kCategoryCount) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Model output must be %d int8 values", kCategoryCount);
+    return false;
+  }
+  return true;
+}
+
+
+// ===============================
+// Подготовить замену модели: отобразить источник в память и проверить модель.
+// Сама замена выполняется в apply_pending_model(). Можно вызывать из другой задачи,
+// но только из одной одновременно.
+//  - const char* source: имя раздела, путь к файлу или MODEL_SOURCE_BUILTIN.
+// Возвращает false, если модель не прошла проверку или предыдущая замена ещё не выполнена.
+// ===============================
+bool request_model_swap(const char* source) {
+  if (pending_model.load(std::memory_order_acquire) != nullptr) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Previous model swap is still pending");
+    return false;
+  }
+  if (strcmp(source, MODEL_SOURCE_BUILTIN) == 0) {
+    // Встроенная модель: отображать нечего.
+    pending_slot = MappedModel();
+    strncpy(pending_slot.source, source, sizeof(pending_slot.source) - 1);
+  } else {
+    MappedModel mapped;
+    if (!map_model(source, &mapped)) {
+      return false;
+    }
+    if (!validate_model(mapped.data, mapped.size)) {
+      unmap_model(&mapped);
+      return false;
+    }
+    pending_slot = mapped;
+  }
+  // Опубликовать модель для loop(): все поля pending_slot записаны до сохранения указателя.
+  pending_model.store(&pending_slot, std::memory_order_release);
+  return true;
+}
+
+
+// ===============================
+// Запомнить выбранный источник модели, чтобы загрузить его при следующем запуске.
+// ===============================
+void save_model_source(const char* source) {
+#if defined(ARDUINO_ARCH_ESP32)
+  Preferences preferences;
+  preferences.begin("model", false);
+  preferences.putString("source", source);
+  preferences.end();
+#endif
+}
+
+
+// ===============================
+// Заменить модель, если есть подготовленная request_model_swap().
+// Вызывается из loop() между инференсами, когда интерпретатор не используется.
+// ===============================
+ModelSwapResult apply_pending_model() {
+  MappedModel* next = pending_model.load(std::memory_order_acquire);
+  if (next == nullptr) {
+    return MODEL_SWAP_NONE;
+  }
+  const tflite::Model* previous = model;
+  const tflite::Model* candidate =
+      next->data != nullptr ? tflite::GetModel(next->data) : tflite::GetModel(model_TFLite);
+
+  ModelSwapResult result = MODEL_SWAP_DONE;
+  if (create_interpreter(candidate)) {
+    // Прежняя модель больше не используется интерпретатором.
+    unmap_model(&active_model);
+    active_model = *next;
+    save_model_source(active_model.source);
+    Serial.printf("Model loaded from %s, arena used %u bytes\n", active_model.source,
+                  (unsigned)interpreter->arena_used_bytes());
+  } else {
+    // Тензоры новой модели не поместились в tensor_arena или модель содержит операции,
+    // которых нет в get_op_resolver(): вернуть прежнюю модель.
+    TF_LITE_REPORT_ERROR(error_reporter, "Model from %s rejected, keeping the previous model",
+                         next->source);
+    unmap_model(next);
+    result = MODEL_SWAP_REJECTED;
+    // Интерпретатор прежней модели уже уничтожен и пересоздаётся в той же tensor_arena.
+    // Если модели ещё не было (замена из setup() или после неудачного запуска), возвращать нечего.
+    if (previous != nullptr && !create_interpreter(previous)) {
+      TF_LITE_REPORT_ERROR(error_reporter, "Previous model from %s cannot be restored",
+                           active_model.data != nullptr ? active_model.source : MODEL_SOURCE_BUILTIN);
+      result = MODEL_SWAP_FAILED;
+    }
+  }
+  pending_model.store(nullptr, std::memory_order_release);
+  return result;
+}
+
+
+// ===============================
+// Загрузить модель, выбранную при предыдущем запуске (вызывается в setup() после init_tflite_arena(),
+// до создания интерпретатора встроенной модели).
+// Возвращает false, если источник не задан или модель не загрузилась: тогда setup() загружает встроенную.
+// ===============================
+bool load_saved_model() {
+#if defined(ARDUINO_ARCH_ESP32)
+  Preferences preferences;
+  preferences.begin("model", true);
+  String source = preferences.getString("source", MODEL_SOURCE_BUILTIN);
+  preferences.end();
+  if (source != MODEL_SOURCE_BUILTIN && request_model_swap(source.c_str())) {
+    return apply_pending_model() == MODEL_SWAP_DONE;
+  }
+#endif
+  return false;
+}
+
+
+// ===============================
+// Обработать команду "model <источник>" из последовательного порта.
+// ===============================
+void handle_model_command() {
+#if defined(ARDUINO_ARCH_ESP32)
+  if (Serial.available() == 0) {
+    return;
+  }
+  String line = Serial.readStringUntil('\n');
+  line.trim();
+  if (!line.startsWith("model ")) {
+    return;
+  }
+  String source = line.substring(6);
+  if (!request_model_swap(source.c_str())) {
+    Serial.printf("Model %s rejected\n", source.c_str());
+  }
+#endif
+}
+
+#endif  // MODEL_LOADER_H
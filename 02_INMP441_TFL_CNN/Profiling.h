@@ -0,0 +1,67 @@
+#ifndef PROFILING_H
+#define PROFILING_H
+
+// Профилировщик с кольцевым буфером компактных бинарных записей (индекс операции, тип операции, длительность в тактах).
+#include "tensorflow/lite/micro/micro_trace_profiler.h"
+// ScopedMicroProfiler — замер длительности блока кода от конструктора до деструктора.
+#include "tensorflow/lite/micro/micro_profiler.h"
+
+// 1 - профилировщик всегда подключен к интерпретатору и замеряет этапы обработки,
+// 0 - профилирование отключено (ScopedMicroProfiler с nullptr ничего не делает).
+#define TRACE_PROFILER_ENABLED 1
+
+// Размер пакета, в который выгружаются записи профилировщика перед отправкой в UART.
+#define TRACE_PACKET_SIZE 256
+
+// Наименования этапов обработки. Профилировщик хранит указатели, поэтому строки должны жить всё время работы программы.
+const char* kStageCapture     = "Capture";       // Запись 1 секунды аудио (record_to_buffer).
+const char* kStageAudioScale  = "AudioScale";    // Увеличение громкости (audio_scale).
+const char* kStageSpectrogram = "Spectrogram";   // FFT и построение спектрограммы (get_spectrogram).
+const char* kStageInvoke      = "Invoke";        // Копирование спектрограммы во входной тензор и инференс. Внутри - записи по каждой операции модели.
+const char* kStagePostprocess = "Postprocess";   // Выбор категории (getPrediction) и управление светодиодами.
+
+// Указатель на профилировщик (nullptr - если профилирование отключено).
+tflite::MicroTraceProfiler* profiler = nullptr;
+
+// Буфер для одного бинарного пакета профилировщика.
+uint8_t trace_packet[TRACE_PACKET_SIZE];
+
+
+// ===============================
+// Счётчик тактов процессора. Разрешение GetCurrentTimeTicks() на ESP32 недостаточно для замера отдельных операций модели.
+// ===============================
+uint32_t cpu_cycle_ticks() {
+  return ESP.getCycleCount();
+}
+
+
+// ===============================
+// Создать профилировщик. Вызывается в setup() до создания интерпретатора.
+// ===============================
+void init_profiler() {
+#if TRACE_PROFILER_ENABLED
+  // Частота тактов профилировщика = частота процессора.
+  static tflite::MicroTraceProfiler trace_profiler(cpu_cycle_ticks, getCpuFrequencyMhz() * 1000000UL);
+  profiler = &trace_profiler;
+#endif
+}
+
+
+// ===============================
+// Выгрузить накопленные записи профилировщика в UART бинарными пакетами.
+// Пакеты можно перемешивать с текстовым выводом Serial.print: декодер на компьютере
+// (tensorflow/lite/micro/tools/trace_profiler_decode.py) находит их по сигнатуре и контрольной сумме.
+// ===============================
+void export_profiler_trace() {
+  if (profiler == nullptr) {
+    return;
+  }
+  // Serialize возвращает 0, если в пакет не поместилось ни одного тега и ни одной записи,
+  // поэтому цикл не может бесконечно отправлять пустые пакеты.
+  size_t packet_size;
+  while ((packet_size = profiler->Serialize(trace_packet, sizeof(trace_packet))) > 0) {
+    Serial.write(trace_packet, packet_size);
+  }
+}
+
+#endif  // PROFILING_H
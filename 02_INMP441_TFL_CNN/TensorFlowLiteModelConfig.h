@@ -16,6 +16,8 @@
 #include "tensorflow/lite/schema/schema_generated.h"
 // Этот файл определяет общие типы данных и API для реализации операций, делегатов и других конструкций в TensorFlow Lite.
 #include "tensorflow/lite/c/common.h"
+// Лучший и второй по выходу классы модели (ClassificationHeadTop2).
+#include "tensorflow/lite/micro/kernels/classification_head.h"
 
 
 // Кол-во строк (векторов) передаваемых на вход модели.(41x99 = 4 059)
@@ -34,6 +36,10 @@ constexpr int kCategoryCount = 4;
 //const char* kCategoryLabels[kCategoryCount] = {"0_Zero", "1_One", "2_Two", "3_Three", "4_Four", "5_Five", "6_Six", "7_Seven", "8_Eight", "9_Nine"};
 const char* kCategoryLabels[kCategoryCount] = {"0_Zero", "1_One", "2_Two", "3_Three"};
 
+// Минимальный отрыв выхода лучшего класса от второго (в шагах квантования выхода модели), при котором предсказание принимается.
+// Шаг равен 1/256 для вероятностей SOFTMAX и масштабу логитов для оценок CLASSIFICATION_HEAD. При меньшем отрыве getPrediction() возвращает "Uncertain".
+constexpr int kMinPredictionMargin = 1;
+
 // Инициализировать необходимые структуры данных для работы с библиотекой Tensor Flow Lite.
 // Обьект ErrorReporter предоставляет отчёт об ошибках и отладочную информацию.
 tflite::ErrorReporter* error_reporter = nullptr;
@@ -51,27 +57,184 @@ constexpr int kTensorArenaSize = 100 * 1024;
 // Массив для хранения входных, выходных и промежуточных массивов модели.
 static uint8_t *tensor_arena;//[kTensorArenaSize]; // Maybe we should move this to external
 
+// Память под интерпретатор. Интерпретатор создаётся в ней заново при замене модели (см. ModelLoader.h),
+// поэтому вместо статической переменной внутри функции используется буфер.
+alignas(tflite::MicroInterpreter) static uint8_t interpreter_buffer[sizeof(tflite::MicroInterpreter)];
+// Профилировщик, который передаётся каждому создаваемому интерпретатору (nullptr - без профилирования).
+tflite::MicroProfilerInterface* model_profiler = nullptr;
+
+#ifdef USE_TFLM_COMPRESSION
+// Память для распаковки весов моделей, сжатых в индексы LUT (tensorflow/lite/micro/compression/lut_binning.py и compress.py).
+// Веса распаковываются сюда перед каждым слоем, поэтому её размер — наибольший сжатый фильтр, который ядро читает во время Invoke():
+// фильтр 2-го свёрточного слоя 3x3x16x16 = 2 304 байта. Веса FullyConnected распаковываются один раз в AllocateTensors(), в упакованную копию.
+// Сжатые модели работают, только если библиотека собрана с -DUSE_TFLM_COMPRESSION (например, через build_opt.h скетча).
+constexpr size_t kDecompressionMemorySize = 2304 + 64;
+alignas(16) static uint8_t decompression_memory[kDecompressionMemorySize];
+// Интерпретатор хранит ссылку на этот список, поэтому он статический.
+static const std::initializer_list<tflite::MicroContext::AlternateMemoryRegion> decompression_regions = {
+  {decompression_memory, kDecompressionMemorySize},
+};
+#endif  // USE_TFLM_COMPRESSION
+
+
+
+/** Функция возвращает набор операций, которые интерпретатор может выполнять.
+  Набор общий для всех моделей, загружаемых в устройство, поэтому новая модель может
+  использовать только перечисленные здесь операции.   **/
+tflite::MicroMutableOpResolver<11>& get_op_resolver() {
+  // Загрузить все методы, что содержит библиотека Tensor Flow Lite, для обработки данных моделью. (Занимает большой обьём памяти)
+  // tflite::AllOpsResolver resolver;
+
+  // Загрузить необходимые методы для обработки данных моделью из библиотеки Tensor Flow Lite.
+  static tflite::MicroMutableOpResolver<11> micro_op_resolver;
+  static bool initialized = false;
+  if (initialized) {
+    return micro_op_resolver;
+  }
+  initialized = true;
+  // AveragePool2D — операция, применяемая в свёрточных нейронных сетях (CNN), для уменьшения ширины и высоты входного тензора.
+  micro_op_resolver.AddAveragePool2D();
+  // MaxPool2D — операция в свёрточных нейронных сетях (CNN), которая выполняет подвыборку данных, уменьшая ширину и высоту входного тензора.
+  micro_op_resolver.AddMaxPool2D();
+  // Reshape — операция, используемая в машинном обучении и обработке данных, которая изменяет форму (размерность) тензора без изменения его данных
+  micro_op_resolver.AddReshape();
+  // FullyConnected (полносвязанный слой) — используется для выполнения нелинейных преобразований данных и играет важную роль в моделях глубокого обучения.
+  micro_op_resolver.AddFullyConnected();
+  // Conv2D (свёрточный слой) — выполняет операцию свёртки над входными данными, чтобы извлекать локальные признаки, использует их для построения более сложных представлений на следующих слоях.
+  micro_op_resolver.AddConv2D();
+  // Conv2D + MaxPool2D одной операцией — модели после fuse_conv_max_pool (tensorflow/lite/micro/tools/model_transforms_utils.py) не хранят в tensor_arena полный выход свёртки.
+  micro_op_resolver.AddConv2DMaxPool2D();
+  // DepthwiseConv2D — разновидность свёрточного слоя, которая применяется для увеличения вычислительной эффективности и уменьшения количества параметров модели.
+  micro_op_resolver.AddDepthwiseConv2D();
+  // Softmax — функция активации, которая используется в выходных слоях нейронных сетей для задач классификации.
+  micro_op_resolver.AddSoftmax();
+  // Softmax классификатора, заменённый replace_softmax_with_classification_head (tensorflow/lite/micro/tools/model_transforms_utils.py): оценки классов относительно лучшего (127) без вычисления экспонент, либо те же вероятности по таблице экспонент.
+  micro_op_resolver.AddClassificationHead();
+  // Quantize (квантование) — процесс преобразования данных или моделей глубокого обучения, чтобы снизить их размер и вычислительную сложность, сохраняя при этом приемлемую точность.
+  micro_op_resolver.AddQuantize();
+  // Dequantize (деквантование) — процесс обратного преобразования данных из квантованного формата обратно в формат с плавающей точкой или в более высокую точность. 
+  micro_op_resolver.AddDequantize();
+
+
+  return micro_op_resolver;
+}
+
+
+
+/** Функция создаёт интерпретатор для модели в памяти tensor_arena и выделяет память для тензоров модели.
+  Предыдущий интерпретатор (если он был) уничтожается, его тензоры в tensor_arena перезаписываются.
+  const tflite::Model* new_model - Модель (данные модели должны быть доступны всё время работы интерпретатора).
+  Возвращает false, если не удалось выделить память для тензоров модели.   **/
+bool create_interpreter(const tflite::Model* new_model) {
+  // Уничтожить предыдущий интерпретатор.
+  if (interpreter != nullptr) {
+    interpreter->~MicroInterpreter();
+    interpreter = nullptr;
+    input = nullptr;
+  }
+  // Без памяти tensor_arena (init_tflite_arena() не удалась) интерпретатор не создаётся.
+  if (tensor_arena == NULL) {
+    return false;
+  }
+
+  // Создадим экземпляр интерпретатора передавав необходимые данные для запуска модели.
+  interpreter = new (interpreter_buffer) tflite::MicroInterpreter(
+    new_model, get_op_resolver(), tensor_arena, kTensorArenaSize, nullptr, model_profiler);
+
+#ifdef USE_TFLM_COMPRESSION
+  // Память для распаковки сжатых весов передаётся до AllocateTensors(). Для несжатой модели она не используется.
+  if (interpreter->SetDecompressionMemory(decompression_regions) != kTfLiteOk) {
+    TF_LITE_REPORT_ERROR(error_reporter, "SetDecompressionMemory() failed");
+    return false;
+  }
+#endif  // USE_TFLM_COMPRESSION
+
+  // Выделим память для внутрених тензоров модели из выделеной ранее памяти tensor_arena.
+  TfLiteStatus allocate_status = interpreter->AllocateTensors();
+  // При неудачном выделении памяти сообщить об ошибке.
+  if (allocate_status != kTfLiteOk) {
+    TF_LITE_REPORT_ERROR(error_reporter, "AllocateTensors() failed");
+    return false;
+  }
+
+  model = new_model;
+  // Получить указатель на входной тензор модели.
+  input = interpreter->input(0);
+  return true;
+}
+
+
+
+/** Функция создаёт журнал ошибок и выделяет память tensor_arena для тензоров модели.
+  Вызывается из init_tflite() и из setup() скетча до загрузки модели из раздела flash (ModelLoader.h).
+  tflite::MicroProfilerInterface* profiler - Профилировщик операций модели (nullptr - без профилирования).
+  Возвращает false, если память не удалось выделить.   **/
+bool init_tflite_arena(tflite::MicroProfilerInterface* profiler) {
+  // Для ведения журнала ошибок создадим переменную "error_reporter" на базе предоставляемых библиотекой Tensor Flow Lite структур данных.
+  static tflite::MicroErrorReporter micro_error_reporter;
+  // Переменную "error_reporter" необходимо передать в интерпретатор, который будет в свою очередь передавать в неё список ошибок.
+  error_reporter = &micro_error_reporter;
+  model_profiler = profiler;
+
+  // Выделить обьём памяти для входного, выходного и промежуточных массивов модели,
+  if (tensor_arena == NULL) {
+    // Выделить более медляную память, но большую по обьёму.
+    //tensor_arena = (uint8_t*) ps_calloc(kTensorArenaSize, 1);
+    // Выделить более быструю память, но меньшую по обьёму.
+    //tensor_arena = (uint8_t *) heap_caps_malloc(kTensorArenaSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    tensor_arena = (uint8_t*) malloc(kTensorArenaSize);
+  }
+  // Если не удалось выделить обьём памяти для входного, выходного и промежуточных массивов модели, то вывести сообщение об ошибке.
+  if (tensor_arena == NULL) {
+    printf("Couldn't allocate memory of %d bytes\n", kTensorArenaSize);
+    return false;
+  }
+  return true;
+}
+
+
+
+/** Функция создаёт интерпретатор встроенной модели и выделяет память для её тензоров.
+  Вызывается из setup() скетча и из хостового бенчмарка (host/inmp441_pipeline_benchmark.cc),
+  поэтому обе программы запускают модель одинаково.
+  tflite::MicroProfilerInterface* profiler - Профилировщик операций модели (nullptr - без профилирования).
+  Возвращает false, если модель не удалось загрузить.   **/
+bool init_tflite(tflite::MicroProfilerInterface* profiler) {
+  if (!init_tflite_arena(profiler)) {
+    return false;
+  }
+
+  // Создадим экземпляр модели используя массив данных из документа "TensorFlowLiteModel.h" 
+  const tflite::Model* builtin_model = tflite::GetModel(model_TFLite);
+  // Проверка соответствия версии модели и версии библиотеки.
+  if (builtin_model->version() != TFLITE_SCHEMA_VERSION) {
+    TF_LITE_REPORT_ERROR(error_reporter,
+                         "Model provided is schema version %d not equal "
+                         "to supported version %d.",
+                         builtin_model->version(), TFLITE_SCHEMA_VERSION);
+    return false;
+  }
+
+  // Создать интерпретатор для встроенной в прошивку модели.
+  return create_interpreter(builtin_model);
+}
+
 
 
 /** Функция возвращает наименование категории захваченой датчика.
   int kCategoryCount - Кол-во классов предсказываемых моделью.
-  int8_t probabilities [] - Массив для хранения вероятностей для всех классов.
-  char* kCategoryLabels[] - Массив наименований категорий, которые модель может классифицировать.   **/
+  int8_t probabilities [] - Массив выходов модели для всех классов: вероятности SOFTMAX либо оценки CLASSIFICATION_HEAD.
+  char* kCategoryLabels[] - Массив наименований категорий, которые модель может классифицировать.
+  Возвращает "Uncertain", если отрыв лучшего класса от второго меньше kMinPredictionMargin.   **/
 String getPrediction(int kCategoryCount, int8_t probabilities [], const char* kCategoryLabels[]){
-  // Индекс для категории с наибольшей вероятностью.
-  int idx = 0;
-  // Максимальная вероятность.
-  int8_t maxProbability = probabilities[idx];
-
-  // Пройдём через все сущности "категории" для которых модель возвращает вероятность.
-  for (int i = 1; i < kCategoryCount; i++) {
-    // Если вероятность для текущей сущности "категории" больше максимальная вероятности назначеной ранее,
-    if(probabilities[i] > maxProbability){
-      // Обновим максимальную вероятность.
-      maxProbability = probabilities[i];
-      // Обновим индекс для категории с наибольшей вероятностью.
-      idx = i;
-    }
+  // Отрыв выхода лучшего класса от второго.
+  int margin;
+  // Индекс для категории с наибольшей вероятностью (при равенстве — первой из них).
+  int idx = tflite::ClassificationHeadTop2(probabilities, kCategoryCount, &margin);
+
+  // Если два лучших класса почти не различаются, предсказание не принимается.
+  if(margin < kMinPredictionMargin){
+    return String("Uncertain");
   }
   // Вернём наименование категории с наибольшей вероятностью.
   return String(kCategoryLabels[idx]);
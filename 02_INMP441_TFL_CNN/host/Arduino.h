@@ -0,0 +1,122 @@
+#ifndef INMP441_HOST_ARDUINO_H_
+#define INMP441_HOST_ARDUINO_H_
+
+// Minimal host stand-in for the parts of the Arduino-ESP32 core that the
+// 02_INMP441_TFL_CNN sketch headers use, so that they can be compiled
+// unchanged on the build machine. Time is simulated: millis() only advances
+// when the I2S stub (driver/i2s.h) delivers samples or delay() is called, so
+// record_to_buffer() returns as soon as one second of audio has been served
+// instead of waiting for a wall clock.
+
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define HIGH 0x1
+#define LOW 0x0
+#define OUTPUT 0x03
+
+using std::max;
+using std::min;
+
+// Simulated time in microseconds since start.
+inline uint64_t host_time_us = 0;
+
+inline void host_advance_time_us(uint64_t us) { host_time_us += us; }
+
+inline unsigned long millis() {
+  return static_cast<unsigned long>(host_time_us / 1000);
+}
+
+inline unsigned long micros() {
+  return static_cast<unsigned long>(host_time_us);
+}
+
+inline void delay(unsigned long ms) { host_advance_time_us(ms * 1000ULL); }
+
+inline void pinMode(uint8_t, uint8_t) {}
+
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+class String {
+ public:
+  String() = default;
+  String(const char* str) : str_(str != nullptr ? str : "") {}
+
+  const char* c_str() const { return str_.c_str(); }
+  unsigned int length() const { return str_.length(); }
+
+  bool operator==(const char* other) const { return str_ == other; }
+  bool operator==(const String& other) const { return str_ == other.str_; }
+  bool operator!=(const char* other) const { return str_ != other; }
+
+ private:
+  std::string str_;
+};
+
+// Serial output is discarded unless enabled, so that the per-frame prints of
+// the sketch do not dominate the measured stage times.
+class HostSerial {
+ public:
+  void begin(unsigned long) {}
+  void setEnabled(bool enabled) { enabled_ = enabled; }
+
+  size_t write(const uint8_t* buffer, size_t size) {
+    return enabled_ ? fwrite(buffer, 1, size, stdout) : size;
+  }
+
+  void print(const char* str) { printf("%s", str); }
+  void print(const String& str) { printf("%s", str.c_str()); }
+  void print(int value) { printf("%d", value); }
+  void print(float value) { printf("%f", static_cast<double>(value)); }
+
+  template <typename T>
+  void println(const T& value) {
+    print(value);
+    printf("\n");
+  }
+  void println() { printf("\n"); }
+
+  int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    if (!enabled_) {
+      return 0;
+    }
+    va_list args;
+    va_start(args, format);
+    const int result = vfprintf(stdout, format, args);
+    va_end(args);
+    return result;
+  }
+
+ private:
+  bool enabled_ = false;
+};
+
+inline HostSerial Serial;
+
+// ESP.getCycleCount() and getCpuFrequencyMhz() used by Profiling.h. The host
+// "cycle counter" runs at 1 GHz on the steady clock.
+class HostEsp {
+ public:
+  uint32_t getCycleCount() {
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+};
+
+inline HostEsp ESP;
+
+inline uint32_t getCpuFrequencyMhz() { return 1000; }
+
+#endif  // INMP441_HOST_ARDUINO_H_
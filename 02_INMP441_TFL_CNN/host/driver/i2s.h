@@ -0,0 +1,120 @@
+#ifndef INMP441_HOST_DRIVER_I2S_H_
+#define INMP441_HOST_DRIVER_I2S_H_
+
+// Host stand-in for the ESP-IDF legacy I2S driver used by Audio_recording.h.
+// i2s_read() serves raw microphone words from a buffer set with
+// host_i2s_set_source() and advances the simulated clock of Arduino.h by the
+// time the hardware would need to capture them. Once the source is exhausted
+// the "microphone" returns silence.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Arduino.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY (TickType_t)0xffffffffUL
+
+typedef enum { I2S_NUM_0 = 0, I2S_NUM_1 = 1 } i2s_port_t;
+
+typedef enum {
+  I2S_MODE_MASTER = 1,
+  I2S_MODE_SLAVE = 2,
+  I2S_MODE_TX = 4,
+  I2S_MODE_RX = 8,
+} i2s_mode_t;
+
+typedef enum {
+  I2S_BITS_PER_SAMPLE_8BIT = 8,
+  I2S_BITS_PER_SAMPLE_16BIT = 16,
+  I2S_BITS_PER_SAMPLE_24BIT = 24,
+  I2S_BITS_PER_SAMPLE_32BIT = 32,
+} i2s_bits_per_sample_t;
+
+typedef enum {
+  I2S_CHANNEL_FMT_RIGHT_LEFT,
+  I2S_CHANNEL_FMT_ALL_RIGHT,
+  I2S_CHANNEL_FMT_ALL_LEFT,
+  I2S_CHANNEL_FMT_ONLY_RIGHT,
+  I2S_CHANNEL_FMT_ONLY_LEFT,
+} i2s_channel_fmt_t;
+
+typedef enum {
+  I2S_COMM_FORMAT_STAND_I2S = 0x01,
+  I2S_COMM_FORMAT_STAND_MSB = 0x03,
+} i2s_comm_format_t;
+
+typedef struct {
+  i2s_mode_t mode;
+  uint32_t sample_rate;
+  i2s_bits_per_sample_t bits_per_sample;
+  i2s_channel_fmt_t channel_format;
+  i2s_comm_format_t communication_format;
+  int intr_alloc_flags;
+  int dma_buf_count;
+  int dma_buf_len;
+  bool use_apll;
+} i2s_config_t;
+
+typedef struct {
+  int bck_io_num;
+  int ws_io_num;
+  int data_out_num;
+  int data_in_num;
+} i2s_pin_config_t;
+
+struct HostI2sState {
+  const uint8_t* source = nullptr;
+  size_t source_size = 0;
+  size_t position = 0;
+  // Bytes per second delivered by the configured port.
+  uint32_t byte_rate = 0;
+};
+
+inline HostI2sState host_i2s;
+
+// Sets the raw words returned by subsequent i2s_read() calls.
+inline void host_i2s_set_source(const uint8_t* data, size_t size) {
+  host_i2s.source = data;
+  host_i2s.source_size = size;
+  host_i2s.position = 0;
+}
+
+inline esp_err_t i2s_driver_install(i2s_port_t, const i2s_config_t* config,
+                                    int, void*) {
+  host_i2s.byte_rate = config->sample_rate * (config->bits_per_sample / 8);
+  return ESP_OK;
+}
+
+inline esp_err_t i2s_set_pin(i2s_port_t, const i2s_pin_config_t*) {
+  return ESP_OK;
+}
+
+inline esp_err_t i2s_start(i2s_port_t) { return ESP_OK; }
+
+inline esp_err_t i2s_read(i2s_port_t, void* dest, size_t size,
+                          size_t* bytes_read, TickType_t) {
+  uint8_t* out = static_cast<uint8_t*>(dest);
+  size_t available = 0;
+  if (host_i2s.position < host_i2s.source_size) {
+    available = host_i2s.source_size - host_i2s.position;
+  }
+  const size_t copied = size < available ? size : available;
+  if (copied > 0) {
+    memcpy(out, host_i2s.source + host_i2s.position, copied);
+    host_i2s.position += copied;
+  }
+  memset(out + copied, 0, size - copied);
+  *bytes_read = size;
+  if (host_i2s.byte_rate > 0) {
+    host_advance_time_us(1000000ULL * size / host_i2s.byte_rate);
+  }
+  return ESP_OK;
+}
+
+#endif  // INMP441_HOST_DRIVER_I2S_H_
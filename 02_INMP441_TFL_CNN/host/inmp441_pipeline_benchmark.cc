@@ -0,0 +1,605 @@
+// End-to-end benchmark of the 02_INMP441_TFL_CNN sketch on the host.
+//
+// Every WAV file of Python_INMP441/Dataset is turned back into the raw words
+// the INMP441 delivers over I2S and pushed through the same functions loop()
+// calls on the ESP32: record_to_buffer, audio_scale, get_spectrogram,
+// spectrogram_to_input, MicroInterpreter::Invoke and getPrediction. The
+// sketch headers are compiled unchanged against the stand-ins in host/.
+//
+// For each configuration the benchmark reports the time of every stage in
+// microseconds, the heap allocations made per frame, the peak RAM and the
+// accuracy as JSON, so that an optimisation of any stage can be judged by
+// its effect on the whole pipeline.
+//
+// Usage:
+//   inmp441_pipeline_benchmark [--dataset=<dir>] [--json_output=<file>]
+//                              [--iterations=<n>] [--model=<file.tflite>]
+//
+// --dataset defaults to ../Python_INMP441/Dataset (relative to the sketch
+// directory, where make runs the binary), --json_output to stdout and
+// --iterations, the number of passes over the dataset, to 1. --model replaces
+// the model compiled into TensorFlowLiteModel.h the way ModelLoader.h does it
+// on the device: the file is mapped, validated and the interpreter is rebuilt
+// in the same arena. Other arguments,
+// such as the ones appended by make run_inmp441_pipeline_benchmark, are
+// ignored.
+
+#include <dirent.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Host stand-ins for the Arduino core and the I2S driver, then the sketch
+// headers in the order 02_INMP441_TFL_CNN.ino includes them.
+#include "Arduino.h"
+#include "TensorFlowLiteModel.h"
+#include "TensorFlowLiteModelConfig.h"
+#include <Audio_processing.h>
+#include "ModelLoader.h"
+
+namespace {
+
+// Heap usage of new/delete, which is what get_spectrogram() uses for the
+// spectrogram rows. Each block carries its size in a header so that the live
+// byte count can be maintained without a lookup table.
+struct HeapStats {
+  bool enabled = false;
+  size_t allocations = 0;
+  size_t allocated_bytes = 0;
+  size_t live_bytes = 0;
+  size_t peak_bytes = 0;
+};
+
+HeapStats heap_stats;
+
+constexpr size_t kHeapHeaderSize = alignof(std::max_align_t);
+
+void* TrackedAlloc(size_t size) {
+  uint8_t* block = static_cast<uint8_t*>(malloc(size + kHeapHeaderSize));
+  if (block == nullptr) {
+    fprintf(stderr, "Out of memory allocating %zu bytes\n", size);
+    abort();
+  }
+  *reinterpret_cast<size_t*>(block) = size;
+  if (heap_stats.enabled) {
+    heap_stats.allocations++;
+    heap_stats.allocated_bytes += size;
+  }
+  heap_stats.live_bytes += size;
+  heap_stats.peak_bytes = std::max(heap_stats.peak_bytes, heap_stats.live_bytes);
+  return block + kHeapHeaderSize;
+}
+
+void TrackedFree(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  uint8_t* block = static_cast<uint8_t*>(ptr) - kHeapHeaderSize;
+  heap_stats.live_bytes -= *reinterpret_cast<size_t*>(block);
+  free(block);
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return TrackedAlloc(size); }
+void* operator new[](size_t size) { return TrackedAlloc(size); }
+void operator delete(void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { TrackedFree(ptr); }
+
+namespace {
+
+// Same threshold as loop() in 02_INMP441_TFL_CNN.ino.
+constexpr float kNoiseGate = 2.2f;
+
+enum Stage {
+  kCapture,
+  kAudioScale,
+  kSpectrogram,
+  kInputCopy,
+  kInvoke,
+  kPrediction,
+  kCleanup,
+  kTotal,
+  kStageCount,
+};
+
+const char* kStageNames[kStageCount] = {
+    "capture", "audio_scale", "spectrogram", "input_copy",
+    "invoke",  "prediction",  "cleanup",     "total"};
+
+struct StageStats {
+  int count = 0;
+  double sum_us = 0;
+  double min_us = 0;
+  double max_us = 0;
+
+  void Add(double us) {
+    min_us = count == 0 ? us : std::min(min_us, us);
+    max_us = count == 0 ? us : std::max(max_us, us);
+    sum_us += us;
+    count++;
+  }
+};
+
+struct Recording {
+  std::string path;
+  std::string label;
+  // Index into kCategoryLabels, -1 if the folder is not a model category.
+  int expected;
+  // Raw I2S words that make audio_scale() reproduce the recorded samples.
+  std::vector<uint8_t> i2s_words;
+};
+
+// RunFrame results that are not a category index.
+constexpr int kGated = -1;
+// getPrediction() found the top two categories too close
+// (kMinPredictionMargin); the model still ran.
+constexpr int kUncertain = kCategoryCount;
+
+struct FileResult {
+  const Recording* recording;
+  bool invoked;
+  int predicted;
+};
+
+struct Configuration {
+  Configuration(const char* config_name, bool gated)
+      : name(config_name), noise_gate(gated) {}
+
+  const char* name;
+  // Invoke only if smoothed_noise_floor exceeds kNoiseGate, as on the device.
+  bool noise_gate;
+
+  StageStats stages[kStageCount];
+  int frames = 0;
+  int inferences = 0;
+  int uncertain = 0;
+  int labelled = 0;
+  int correct = 0;
+  size_t allocations = 0;
+  size_t allocated_bytes = 0;
+  size_t peak_heap_bytes = 0;
+  // Rows are expected categories, columns predicted categories plus one
+  // column for uncertain predictions (kUncertain) and one for frames
+  // rejected by the noise gate.
+  int confusion[kCategoryCount][kCategoryCount + 2] = {};
+  std::vector<FileResult> results;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedUs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+uint32_t ReadLe32(const uint8_t* data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+uint16_t ReadLe16(const uint8_t* data) { return data[0] | (data[1] << 8); }
+
+// Reads a 16-bit mono WAV file as saved by 01_INMP441_collect_dataset and
+// converts it into I2S words. audio_scale() keeps the upper byte of
+// (word & 0xfff) * 256 / 2048, so a recorded sample with upper byte h comes
+// from the word h * 8. The recordings made by the device have a zero lower
+// byte and are reproduced exactly; the lower byte of other files is lost.
+bool LoadRecording(const std::string& path, Recording* recording) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    fprintf(stderr, "Cannot open %s\n", path.c_str());
+    return false;
+  }
+  std::vector<uint8_t> bytes;
+  uint8_t chunk[4096];
+  size_t read;
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    bytes.insert(bytes.end(), chunk, chunk + read);
+  }
+  fclose(file);
+
+  if (bytes.size() < 12 || memcmp(bytes.data(), "RIFF", 4) != 0 ||
+      memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+    fprintf(stderr, "%s is not a WAV file\n", path.c_str());
+    return false;
+  }
+  uint16_t channels = 0;
+  uint16_t bits_per_sample = 0;
+  size_t offset = 12;
+  while (offset + 8 <= bytes.size()) {
+    const uint8_t* header = bytes.data() + offset;
+    const size_t size = std::min<size_t>(ReadLe32(header + 4),
+                                         bytes.size() - offset - 8);
+    const uint8_t* body = header + 8;
+    if (memcmp(header, "fmt ", 4) == 0 && size >= 16) {
+      channels = ReadLe16(body + 2);
+      bits_per_sample = ReadLe16(body + 14);
+    } else if (memcmp(header, "data", 4) == 0) {
+      if (channels != 1 || bits_per_sample != 16) {
+        fprintf(stderr, "%s: expected 16-bit mono audio\n", path.c_str());
+        return false;
+      }
+      recording->i2s_words.clear();
+      for (size_t i = 0; i + 1 < size; i += 2) {
+        const uint16_t word = body[i + 1] * 8;
+        recording->i2s_words.push_back(word & 0xff);
+        recording->i2s_words.push_back(word >> 8);
+      }
+      return true;
+    }
+    offset += 8 + size + (size & 1);
+  }
+  fprintf(stderr, "%s has no data chunk\n", path.c_str());
+  return false;
+}
+
+std::vector<std::string> ListDirectory(const std::string& path) {
+  std::vector<std::string> names;
+  DIR* dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return names;
+  }
+  while (dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      names.push_back(entry->d_name);
+    }
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+bool EndsWith(const std::string& str, const char* suffix) {
+  const size_t length = strlen(suffix);
+  return str.size() >= length &&
+         str.compare(str.size() - length, length, suffix) == 0;
+}
+
+// Loads <dataset_dir>/<label>/*.wav.
+std::vector<Recording> LoadDataset(const std::string& dataset_dir) {
+  std::vector<Recording> recordings;
+  for (const std::string& label : ListDirectory(dataset_dir)) {
+    int expected = -1;
+    for (int i = 0; i < kCategoryCount; ++i) {
+      if (label == kCategoryLabels[i]) {
+        expected = i;
+      }
+    }
+    const std::string folder = dataset_dir + "/" + label;
+    for (const std::string& name : ListDirectory(folder)) {
+      if (!EndsWith(name, ".wav")) {
+        continue;
+      }
+      Recording recording;
+      recording.path = folder + "/" + name;
+      recording.label = label;
+      recording.expected = expected;
+      if (LoadRecording(recording.path, &recording)) {
+        recordings.push_back(std::move(recording));
+      }
+    }
+  }
+  return recordings;
+}
+
+// Index of a getPrediction() result: a category, or kUncertain.
+int CategoryIndex(const String& prediction) {
+  for (int i = 0; i < kCategoryCount; ++i) {
+    if (prediction == kCategoryLabels[i]) {
+      return i;
+    }
+  }
+  return kUncertain;
+}
+
+// One iteration of loop() without the LEDs and the profiler export. Returns
+// the predicted category, kUncertain, or kGated if the noise gate rejected
+// the frame.
+int RunFrame(Configuration& config, bool record) {
+  Clock::time_point t[kStageCount + 1];
+  bool ran[kStageCount] = {};
+
+  heap_stats.enabled = true;
+  const size_t allocations = heap_stats.allocations;
+  const size_t allocated_bytes = heap_stats.allocated_bytes;
+  heap_stats.peak_bytes = heap_stats.live_bytes;
+  const size_t live_bytes = heap_stats.live_bytes;
+
+  t[kCapture] = Clock::now();
+  record_to_buffer();
+  ran[kCapture] = true;
+
+  t[kAudioScale] = Clock::now();
+  uint8_t* src = wav_buffer + WAV_HEADER_SIZE;
+  uint8_t* dest = wav_buffer + WAV_HEADER_SIZE;
+  audio_scale(dest, src, DATA_SIZE);
+  ran[kAudioScale] = true;
+
+  t[kSpectrogram] = Clock::now();
+  int16_t* pcm16 = (int16_t*)(wav_buffer + WAV_HEADER_SIZE);
+  float** spec;
+  int frames;
+  get_spectrogram(pcm16, SAMPLES_COUNT, spec, frames);
+  ran[kSpectrogram] = true;
+
+  int predicted = kGated;
+  t[kInputCopy] = t[kInvoke] = t[kPrediction] = Clock::now();
+  if (!config.noise_gate || smoothed_noise_floor > kNoiseGate) {
+    spectrogram_to_input(spec, frames, input->data.f);
+    ran[kInputCopy] = true;
+
+    t[kInvoke] = Clock::now();
+    if (kTfLiteOk != interpreter->Invoke()) {
+      TF_LITE_REPORT_ERROR(error_reporter, "Invoke failed.");
+    }
+    ran[kInvoke] = true;
+
+    t[kPrediction] = Clock::now();
+    TfLiteTensor* output = interpreter->output(0);
+    int8_t probabilities[kCategoryCount];
+    for (int i = 0; i < kCategoryCount; i++) {
+      probabilities[i] = output->data.uint8[i];
+    }
+    String prediction =
+        getPrediction(kCategoryCount, probabilities, kCategoryLabels);
+    predicted = CategoryIndex(prediction);
+    ran[kPrediction] = true;
+  }
+
+  t[kCleanup] = Clock::now();
+  smoothed_noise_floor = 0.0f;
+  free_spectrogram(spec, frames);
+  ran[kCleanup] = true;
+  t[kTotal] = Clock::now();
+
+  heap_stats.enabled = false;
+  if (!record) {
+    return predicted;
+  }
+
+  for (int stage = 0; stage < kTotal; ++stage) {
+    if (ran[stage]) {
+      config.stages[stage].Add(ElapsedUs(t[stage], t[stage + 1]));
+    }
+  }
+  config.stages[kTotal].Add(ElapsedUs(t[kCapture], t[kTotal]));
+  config.frames++;
+  config.allocations += heap_stats.allocations - allocations;
+  config.allocated_bytes += heap_stats.allocated_bytes - allocated_bytes;
+  config.peak_heap_bytes =
+      std::max(config.peak_heap_bytes, heap_stats.peak_bytes - live_bytes);
+  if (predicted != kGated) {
+    config.inferences++;
+  }
+  config.uncertain += predicted == kUncertain;
+  return predicted;
+}
+
+void RunConfiguration(Configuration& config,
+                      const std::vector<Recording>& recordings,
+                      int iterations) {
+  // Warm up once so that the one-time FFT setup is not measured.
+  host_i2s_set_source(recordings[0].i2s_words.data(),
+                      recordings[0].i2s_words.size());
+  RunFrame(config, false);
+
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    for (const Recording& recording : recordings) {
+      host_i2s_set_source(recording.i2s_words.data(),
+                          recording.i2s_words.size());
+      const int predicted = RunFrame(config, true);
+      if (iteration > 0) {
+        continue;
+      }
+      config.results.push_back({&recording, predicted != kGated, predicted});
+      if (recording.expected >= 0) {
+        config.labelled++;
+        config.correct += predicted == recording.expected;
+        const int column = predicted != kGated ? predicted : kCategoryCount + 1;
+        config.confusion[recording.expected][column]++;
+      }
+    }
+  }
+}
+
+// Bytes of the buffers the sketch keeps for the whole run.
+size_t StaticBufferBytes() {
+  return sizeof(wav_buffer) + sizeof(i2s_buffer) + sizeof(fft_out) +
+         sizeof(energy) + sizeof(hamming_coeffs);
+}
+
+size_t FftConfigBytes() {
+  size_t bytes = 0;
+  kiss_fftr_alloc(FFT_N, 0, NULL, &bytes);
+  return bytes;
+}
+
+long MaxRssKb() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+void WriteJsonString(FILE* out, const std::string& str) {
+  fputc('"', out);
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      fputc('\\', out);
+    }
+    fputc(c, out);
+  }
+  fputc('"', out);
+}
+
+void WriteConfiguration(FILE* out, const Configuration& config,
+                        size_t resident_bytes) {
+  fprintf(out, "    {\n      \"name\": \"%s\",\n", config.name);
+  fprintf(out, "      \"noise_gate\": %s,\n",
+          config.noise_gate ? "true" : "false");
+  fprintf(out, "      \"frames\": %d,\n", config.frames);
+  fprintf(out, "      \"inferences\": %d,\n", config.inferences);
+  fprintf(out, "      \"uncertain\": %d,\n", config.uncertain);
+  fprintf(out, "      \"labelled_files\": %d,\n", config.labelled);
+  fprintf(out, "      \"correct\": %d,\n", config.correct);
+  fprintf(out, "      \"accuracy\": %.4f,\n",
+          config.labelled > 0
+              ? static_cast<double>(config.correct) / config.labelled
+              : 0.0);
+  fprintf(out, "      \"stages_us\": {\n");
+  for (int stage = 0; stage < kStageCount; ++stage) {
+    const StageStats& stats = config.stages[stage];
+    fprintf(out,
+            "        \"%s\": {\"count\": %d, \"mean\": %.1f, \"min\": %.1f, "
+            "\"max\": %.1f}%s\n",
+            kStageNames[stage], stats.count,
+            stats.count > 0 ? stats.sum_us / stats.count : 0.0, stats.min_us,
+            stats.max_us, stage + 1 < kStageCount ? "," : "");
+  }
+  fprintf(out, "      },\n");
+  const int frames = std::max(config.frames, 1);
+  fprintf(out, "      \"allocations_per_frame\": %.1f,\n",
+          static_cast<double>(config.allocations) / frames);
+  fprintf(out, "      \"allocated_bytes_per_frame\": %.1f,\n",
+          static_cast<double>(config.allocated_bytes) / frames);
+  fprintf(out, "      \"peak_heap_bytes\": %zu,\n", config.peak_heap_bytes);
+  fprintf(out, "      \"peak_ram_bytes\": %zu,\n",
+          resident_bytes + config.peak_heap_bytes);
+  fprintf(out, "      \"confusion\": {\n        \"columns\": [");
+  for (int i = 0; i < kCategoryCount; ++i) {
+    fprintf(out, "\"%s\", ", kCategoryLabels[i]);
+  }
+  fprintf(out, "\"uncertain\", \"gated\"],\n        \"rows\": [\n");
+  for (int i = 0; i < kCategoryCount; ++i) {
+    fprintf(out, "          [");
+    for (int j = 0; j <= kCategoryCount + 1; ++j) {
+      fprintf(out, "%d%s", config.confusion[i][j],
+              j <= kCategoryCount ? ", " : "");
+    }
+    fprintf(out, "]%s\n", i + 1 < kCategoryCount ? "," : "");
+  }
+  fprintf(out, "        ]\n      },\n      \"files\": [\n");
+  for (size_t i = 0; i < config.results.size(); ++i) {
+    const FileResult& result = config.results[i];
+    fprintf(out, "        {\"file\": ");
+    WriteJsonString(out, result.recording->path);
+    fprintf(out, ", \"label\": ");
+    WriteJsonString(out, result.recording->label);
+    const char* prediction = !result.invoked ? "null"
+                             : result.predicted == kUncertain
+                                 ? "Uncertain"
+                                 : kCategoryLabels[result.predicted];
+    fprintf(out, ", \"prediction\": %s%s%s}%s\n",
+            result.invoked ? "\"" : "", prediction,
+            result.invoked ? "\"" : "",
+            i + 1 < config.results.size() ? "," : "");
+  }
+  fprintf(out, "      ]\n    }");
+}
+
+// Returns the value of a --name=value argument, or nullptr.
+const char* FlagValue(const char* arg, const char* name) {
+  const size_t length = strlen(name);
+  if (strncmp(arg, "--", 2) == 0 && strncmp(arg + 2, name, length) == 0 &&
+      arg[2 + length] == '=') {
+    return arg + 3 + length;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string dataset_dir = "../Python_INMP441/Dataset";
+  std::string json_output = "-";
+  int iterations = 1;
+  const char* model_file = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (const char* dir = FlagValue(argv[i], "dataset")) {
+      dataset_dir = dir;
+    } else if (const char* path = FlagValue(argv[i], "json_output")) {
+      json_output = path;
+    } else if (const char* count = FlagValue(argv[i], "iterations")) {
+      iterations = std::max(atoi(count), 1);
+    } else if (const char* file = FlagValue(argv[i], "model")) {
+      model_file = file;
+    }
+  }
+
+  const std::vector<Recording> recordings = LoadDataset(dataset_dir);
+  if (recordings.empty()) {
+    fprintf(stderr, "No WAV files found in %s\n", dataset_dir.c_str());
+    return 1;
+  }
+
+  // setup() of the sketch, without the profiler.
+  create_wav_header(wav_buffer, DATA_SIZE);
+  if (!init_tflite(nullptr)) {
+    return 1;
+  }
+  if (model_file != nullptr &&
+      !(request_model_swap(model_file) && apply_pending_model() == MODEL_SWAP_DONE)) {
+    return 1;
+  }
+  i2s_install();
+  i2s_setpin();
+  i2s_start(I2S_PORT);
+
+  Configuration configs[] = {
+      {"device", true},
+      {"ungated", false},
+  };
+  for (Configuration& config : configs) {
+    RunConfiguration(config, recordings, iterations);
+  }
+
+  // RAM that stays allocated for the whole run: the tensor arena (allocated
+  // in full, whatever the model uses), the FFT configuration and the global
+  // buffers. Per-frame heap comes on top.
+  const size_t resident_bytes =
+      kTensorArenaSize + FftConfigBytes() + StaticBufferBytes();
+
+  FILE* out = json_output == "-" ? stdout : fopen(json_output.c_str(), "w");
+  if (out == nullptr) {
+    fprintf(stderr, "Cannot write %s\n", json_output.c_str());
+    return 1;
+  }
+  fprintf(out, "{\n  \"benchmark\": \"inmp441_pipeline_benchmark\",\n");
+  fprintf(out, "  \"dataset\": ");
+  WriteJsonString(out, dataset_dir);
+  fprintf(out, ",\n  \"files\": %zu,\n", recordings.size());
+  fprintf(out, "  \"iterations\": %d,\n", iterations);
+  fprintf(out, "  \"model\": ");
+  WriteJsonString(out, model_file != nullptr ? model_file
+                                             : MODEL_SOURCE_BUILTIN);
+  fprintf(out, ",\n  \"model_bytes\": %zu,\n",
+          active_model.data != nullptr
+              ? active_model.size
+              : static_cast<size_t>(model_TFLite_len));
+  fprintf(out, "  \"memory\": {\n");
+  fprintf(out, "    \"tensor_arena_bytes\": %d,\n", kTensorArenaSize);
+  fprintf(out, "    \"arena_used_bytes\": %zu,\n",
+          interpreter->arena_used_bytes());
+  fprintf(out, "    \"fft_config_bytes\": %zu,\n", FftConfigBytes());
+  fprintf(out, "    \"static_buffers_bytes\": %zu,\n", StaticBufferBytes());
+  fprintf(out, "    \"host_max_rss_kb\": %ld\n  },\n", MaxRssKb());
+  fprintf(out, "  \"configurations\": [\n");
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); ++i) {
+    WriteConfiguration(out, configs[i], resident_bytes);
+    fprintf(out, "%s\n", i + 1 < sizeof(configs) / sizeof(configs[0]) ? ","
+                                                                       : "");
+  }
+  fprintf(out, "  ]\n}\n");
+  if (out != stdout) {
+    fclose(out);
+  }
+  return 0;
+}
@@ -0,0 +1,633 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/reference/conv.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/depthwise_conv.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/conv_gemm.h"
+#include "tensorflow/lite/micro/kernels/conv_small_filter.h"
+#include "tensorflow/lite/micro/kernels/conv_winograd.h"
+#include "tensorflow/lite/micro/kernels/depthwise_conv_simd.h"
+#include "tensorflow/lite/micro/kernels/testdata/conv_test_data.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_time.h"
+#include "tensorflow/lite/micro/system_setup.h"
+
+/*
+ * Convolution kernel benchmark. Times the reference kernels against the
+ * variants the reference CONV_2D selects at Prepare time:
+ * ConvPerChannelSmallFilter on the int8 cases of conv_test.cc and on the first
+ * layer of the INMP441 speech CNN, and the im2col + GEMM kernels, int8 and
+ * float, on its second and third layers. The GEMM cases also print the im2col
+ * scratch the kernel requests from the arena, and time the opt-in Winograd
+ * F(2x2,3x3) float kernel on the same layers. Every case checks that both
+ * kernels produce the same output, within float rounding for Winograd.
+ *
+ * The depthwise-separable cases replace the second and third layers with the
+ * 3x3 DEPTHWISE_CONV_2D + 1x1 CONV_2D blocks of the DS-CNN variant of the
+ * notebook, and time them with the kernels the reference operators select,
+ * DepthwiseConvPerChannelSimd and the GEMM kernel, against the full
+ * convolution.
+ */
+
+namespace tflite {
+namespace {
+
+constexpr int kMaxInputElements = 50 * 21 * 16;
+constexpr int kMaxFilterElements = 16 * 3 * 3 * 16;
+constexpr int kMaxOutputElements = 99 * 41 * 16;
+constexpr int kMaxFloatOutputElements = 50 * 21 * 16;
+constexpr int kMaxChannels = 16;
+constexpr int kMaxScratchBytes = 4096;
+
+int8_t generated_input[kMaxInputElements];
+int8_t generated_filter[kMaxFilterElements];
+int32_t generated_bias[kMaxChannels];
+int8_t reference_output[kMaxOutputElements];
+int8_t kernel_output[kMaxOutputElements];
+int8_t depthwise_reference_output[kMaxInputElements];
+int8_t depthwise_output[kMaxInputElements];
+
+float float_input[kMaxInputElements];
+float float_filter[kMaxFilterElements];
+float float_bias[kMaxChannels];
+float float_reference_output[kMaxFloatOutputElements];
+float float_gemm_output[kMaxFloatOutputElements];
+float float_winograd_output[kMaxFloatOutputElements];
+// The filter transformed by ConvWinogradTransformFilter, 4x4 per 3x3 filter.
+float winograd_filter[kMaxFilterElements * 16 / 9];
+
+alignas(16) uint8_t im2col_scratch[kMaxScratchBytes];
+
+struct ConvKernelBenchmarkCase {
+  const char* tag;
+  int input_height;
+  int input_width;
+  int input_depth;
+  int output_depth;
+  int stride;
+  float input_scale;
+  int input_zero_point;
+  const float* filter_scales;
+  float output_scale;
+  int output_zero_point;
+  bool relu6;
+  const int8_t* input_data;
+  const int8_t* filter_data;
+  const int32_t* bias_data;
+  int iterations;
+};
+
+// Filter scales of Int8Filter1x3x3x1ShouldMatchGoldenOddInputPaddingSame.
+const float kFilter1x3x3x1Scales[] = {0.00448552053f};
+
+// Filter scales of Int8Filter8x3x3x3PerChannelScaleRelu6ShouldMatchGolden.
+const float kFilter8x3x3x3Scales[] = {
+    2.18926089e-05, 0.00453596329,  0.000504297379, 0.00184638216,
+    0.00596635276,  0.000199135626, 0.0047677448,   0.00193942268};
+
+// Per channel filter scales of the generated INMP441 layers.
+const float kInmp441FilterScales[] = {
+    0.0031f, 0.0027f, 0.0042f, 0.0019f, 0.0035f, 0.0024f, 0.0051f, 0.0029f,
+    0.0038f, 0.0022f, 0.0045f, 0.0033f, 0.0026f, 0.0040f, 0.0030f, 0.0037f};
+
+// Deterministic data for the INMP441 layers, sized for the largest one. The
+// benchmark measures speed and equality of the two kernels, so the values only
+// need to cover the int8 range.
+void GenerateInmp441Data() {
+  for (int i = 0; i < kMaxInputElements; ++i) {
+    generated_input[i] = static_cast<int8_t>((i * 37 + (i / 41) * 11) % 256 -
+                                             128);
+  }
+  for (int i = 0; i < kMaxFilterElements; ++i) {
+    generated_filter[i] = static_cast<int8_t>((i * 53) % 255 - 127);
+  }
+  for (int i = 0; i < kMaxChannels; ++i) {
+    generated_bias[i] = (i * 997) % 4000 - 2000;
+  }
+}
+
+uint32_t PercentOf(uint32_t part, uint32_t whole) {
+  return whole > 0 ? static_cast<uint32_t>(
+                         (static_cast<uint64_t>(part) * 100 + whole / 2) /
+                         whole)
+                   : 0;
+}
+
+constexpr int kFilterSize = 3;
+
+int OutputSize(int input_size, int stride) {
+  return (input_size + stride - 1) / stride;
+}
+
+ConvParams MakeConvParams(const ConvKernelBenchmarkCase& c) {
+  const int output_height = OutputSize(c.input_height, c.stride);
+  const int output_width = OutputSize(c.input_width, c.stride);
+  ConvParams params = {};
+  params.input_offset = -c.input_zero_point;
+  params.output_offset = c.output_zero_point;
+  params.stride_height = c.stride;
+  params.stride_width = c.stride;
+  params.dilation_height_factor = 1;
+  params.dilation_width_factor = 1;
+  // 'same' padding, as ComputePaddingHeightWidth computes it.
+  params.padding_values.height = std::max(
+      0, ((output_height - 1) * c.stride + kFilterSize - c.input_height) / 2);
+  params.padding_values.width = std::max(
+      0, ((output_width - 1) * c.stride + kFilterSize - c.input_width) / 2);
+  params.quantized_activation_min = c.output_zero_point;
+  params.quantized_activation_max =
+      c.relu6 ? std::min<int32_t>(
+                    127, c.output_zero_point +
+                             static_cast<int32_t>(6.0f / c.output_scale))
+              : 127;
+  params.float_activation_min = c.relu6 ? 0.0f : -3.4e38f;
+  params.float_activation_max = c.relu6 ? 6.0f : 3.4e38f;
+  return params;
+}
+
+void ComputeOutputMultipliers(const ConvKernelBenchmarkCase& c,
+                              int32_t* output_multiplier,
+                              int32_t* output_shift) {
+  for (int channel = 0; channel < c.output_depth; ++channel) {
+    const double effective_scale =
+        static_cast<double>(c.input_scale) *
+        static_cast<double>(c.filter_scales[channel]) /
+        static_cast<double>(c.output_scale);
+    int shift;
+    QuantizeMultiplier(effective_scale, &output_multiplier[channel], &shift);
+    output_shift[channel] = shift;
+  }
+}
+
+void RunConvKernelBenchmark(const ConvKernelBenchmarkCase& c) {
+  const int output_height = OutputSize(c.input_height, c.stride);
+  const int output_width = OutputSize(c.input_width, c.stride);
+  const ConvParams params = MakeConvParams(c);
+  int32_t output_multiplier[kMaxChannels];
+  int32_t output_shift[kMaxChannels];
+  ComputeOutputMultipliers(c, output_multiplier, output_shift);
+
+  const int32_t input_dims[] = {1, c.input_height, c.input_width,
+                                c.input_depth};
+  const int32_t filter_dims[] = {c.output_depth, kFilterSize, kFilterSize,
+                                 c.input_depth};
+  const int32_t bias_dims[] = {c.output_depth};
+  const int32_t output_dims[] = {1, output_height, output_width,
+                                 c.output_depth};
+  const RuntimeShape input_shape(4, input_dims);
+  const RuntimeShape filter_shape(4, filter_dims);
+  const RuntimeShape bias_shape(1, bias_dims);
+  const RuntimeShape output_shape(4, output_dims);
+
+  if (!ConvSmallFilterSupported(params, input_shape, filter_shape,
+                                output_shape)) {
+    MicroPrintf("%s: not supported by ConvPerChannelSmallFilter", c.tag);
+    return;
+  }
+
+  // The per-channel constants are computed once at Prepare time by the
+  // kernel, so they are not part of the timed loop.
+  ConvSmallFilterChannel channels[kMaxChannels];
+  ConvSmallFilterPrepareChannels(params, output_multiplier, output_shift,
+                                 filter_shape, c.filter_data, c.bias_data,
+                                 channels);
+
+  uint32_t start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    reference_integer_ops::ConvPerChannel(
+        params, output_multiplier, output_shift, input_shape, c.input_data,
+        filter_shape, c.filter_data, bias_shape, c.bias_data, output_shape,
+        reference_output);
+  }
+  const uint32_t reference_ticks = GetCurrentTimeTicks() - start;
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    ConvPerChannelSmallFilter(params, channels, input_shape, c.input_data,
+                              filter_shape, c.filter_data, output_shape,
+                              kernel_output);
+  }
+  const uint32_t small_filter_ticks = GetCurrentTimeTicks() - start;
+
+  int mismatches = 0;
+  for (int i = 0; i < output_shape.FlatSize(); ++i) {
+    if (reference_output[i] != kernel_output[i]) {
+      ++mismatches;
+    }
+  }
+
+  MicroPrintf(
+      "%s x%d: reference %u ticks, small filter %u ticks (%u%% of reference)",
+      c.tag, c.iterations, reference_ticks, small_filter_ticks,
+      PercentOf(small_filter_ticks, reference_ticks));
+  MicroPrintf("%s: %s", c.tag,
+              mismatches == 0 ? "outputs are bit-exact"
+                              : "OUTPUTS DIFFER FROM THE REFERENCE");
+}
+
+// Dequantizes the int8 case data, so that the float kernels compute the same
+// convolution.
+void DequantizeCaseData(const ConvKernelBenchmarkCase& c) {
+  const int input_elements = c.input_height * c.input_width * c.input_depth;
+  for (int i = 0; i < input_elements; ++i) {
+    float_input[i] = c.input_scale * (c.input_data[i] - c.input_zero_point);
+  }
+  const int filter_elements = kFilterSize * kFilterSize * c.input_depth;
+  for (int channel = 0; channel < c.output_depth; ++channel) {
+    for (int i = 0; i < filter_elements; ++i) {
+      const int index = channel * filter_elements + i;
+      float_filter[index] = c.filter_scales[channel] * c.filter_data[index];
+    }
+    float_bias[channel] =
+        c.input_scale * c.filter_scales[channel] * c.bias_data[channel];
+  }
+}
+
+void RunConvGemmBenchmark(const ConvKernelBenchmarkCase& c) {
+  const int output_height = OutputSize(c.input_height, c.stride);
+  const int output_width = OutputSize(c.input_width, c.stride);
+  const ConvParams params = MakeConvParams(c);
+  int32_t output_multiplier[kMaxChannels];
+  int32_t output_shift[kMaxChannels];
+  ComputeOutputMultipliers(c, output_multiplier, output_shift);
+
+  const int32_t input_dims[] = {1, c.input_height, c.input_width,
+                                c.input_depth};
+  const int32_t filter_dims[] = {c.output_depth, kFilterSize, kFilterSize,
+                                 c.input_depth};
+  const int32_t bias_dims[] = {c.output_depth};
+  const int32_t output_dims[] = {1, output_height, output_width,
+                                 c.output_depth};
+  const RuntimeShape input_shape(4, input_dims);
+  const RuntimeShape filter_shape(4, filter_dims);
+  const RuntimeShape bias_shape(1, bias_dims);
+  const RuntimeShape output_shape(4, output_dims);
+
+  const size_t int8_scratch_bytes =
+      ConvGemmScratchSize(filter_shape, output_shape, sizeof(int8_t));
+  const size_t float_scratch_bytes =
+      ConvGemmScratchSize(filter_shape, output_shape, sizeof(float));
+  if (!ConvGemmSupported(input_shape, filter_shape, output_shape) ||
+      int8_scratch_bytes > sizeof(im2col_scratch) ||
+      float_scratch_bytes > sizeof(im2col_scratch)) {
+    MicroPrintf("%s: not supported by the GEMM kernels", c.tag);
+    return;
+  }
+
+  // Computed once at Prepare time by the kernel, like the multipliers.
+  int32_t accumulator_init[kMaxChannels];
+  ConvGemmPrepareAccumulators(params, filter_shape, c.filter_data, c.bias_data,
+                              accumulator_init);
+
+  uint32_t start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    reference_integer_ops::ConvPerChannel(
+        params, output_multiplier, output_shift, input_shape, c.input_data,
+        filter_shape, c.filter_data, bias_shape, c.bias_data, output_shape,
+        reference_output);
+  }
+  const uint32_t reference_ticks = GetCurrentTimeTicks() - start;
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    ConvPerChannelGemm(params, output_multiplier, output_shift,
+                       accumulator_init, input_shape, c.input_data,
+                       filter_shape, c.filter_data, output_shape, kernel_output,
+                       im2col_scratch);
+  }
+  const uint32_t gemm_ticks = GetCurrentTimeTicks() - start;
+
+  int mismatches = 0;
+  for (int i = 0; i < output_shape.FlatSize(); ++i) {
+    if (reference_output[i] != kernel_output[i]) {
+      ++mismatches;
+    }
+  }
+
+  MicroPrintf(
+      "%s int8 x%d: reference %u ticks, GEMM %u ticks (%u%% of reference)",
+      c.tag, c.iterations, reference_ticks, gemm_ticks,
+      PercentOf(gemm_ticks, reference_ticks));
+  MicroPrintf("%s int8: %u bytes of im2col scratch, %u bytes persistent, %s",
+              c.tag, static_cast<uint32_t>(int8_scratch_bytes),
+              static_cast<uint32_t>(c.output_depth * sizeof(int32_t)),
+              mismatches == 0 ? "outputs are bit-exact"
+                              : "OUTPUTS DIFFER FROM THE REFERENCE");
+
+  DequantizeCaseData(c);
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    reference_ops::Conv(params, input_shape, float_input, filter_shape,
+                        float_filter, bias_shape, float_bias, output_shape,
+                        float_reference_output, RuntimeShape(), nullptr);
+  }
+  const uint32_t float_reference_ticks = GetCurrentTimeTicks() - start;
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    ConvGemm(params, input_shape, float_input, filter_shape, float_filter,
+             float_bias, output_shape, float_gemm_output, im2col_scratch);
+  }
+  const uint32_t float_gemm_ticks = GetCurrentTimeTicks() - start;
+
+  // The sums are formed in the same order, but a compiler may contract the
+  // multiply-adds of the two kernels differently.
+  mismatches = 0;
+  for (int i = 0; i < output_shape.FlatSize(); ++i) {
+    const float difference =
+        float_reference_output[i] - float_gemm_output[i];
+    if (difference > 1e-5f || difference < -1e-5f) {
+      ++mismatches;
+    }
+  }
+
+  MicroPrintf(
+      "%s float x%d: reference %u ticks, GEMM %u ticks (%u%% of reference)",
+      c.tag, c.iterations, float_reference_ticks, float_gemm_ticks,
+      PercentOf(float_gemm_ticks, float_reference_ticks));
+  MicroPrintf("%s float: %u bytes of im2col scratch, %s", c.tag,
+              static_cast<uint32_t>(float_scratch_bytes),
+              mismatches == 0 ? "outputs match the reference"
+                              : "OUTPUTS DIFFER FROM THE REFERENCE");
+
+  const size_t winograd_filter_bytes = ConvWinogradFilterSize(filter_shape);
+  const size_t winograd_scratch_bytes = ConvWinogradScratchSize(filter_shape);
+  if (!ConvWinogradSupported(params, input_shape, filter_shape,
+                             output_shape) ||
+      winograd_filter_bytes > sizeof(winograd_filter) ||
+      winograd_scratch_bytes > sizeof(im2col_scratch)) {
+    MicroPrintf("%s: not supported by the Winograd kernel", c.tag);
+    return;
+  }
+
+  // Done once at Prepare time by the kernel.
+  ConvWinogradTransformFilter(filter_shape, float_filter, winograd_filter);
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    ConvWinograd(params, input_shape, float_input, filter_shape,
+                 winograd_filter, float_bias, output_shape,
+                 float_winograd_output, im2col_scratch);
+  }
+  const uint32_t winograd_ticks = GetCurrentTimeTicks() - start;
+
+  // The transforms round differently from the direct sums, relative to the
+  // largest output.
+  float max_output = 0.0f;
+  float max_difference = 0.0f;
+  for (int i = 0; i < output_shape.FlatSize(); ++i) {
+    max_output = std::max(max_output, std::abs(float_reference_output[i]));
+    max_difference = std::max(
+        max_difference,
+        std::abs(float_reference_output[i] - float_winograd_output[i]));
+  }
+
+  MicroPrintf(
+      "%s float x%d: reference %u ticks, Winograd %u ticks (%u%% of "
+      "reference)",
+      c.tag, c.iterations, float_reference_ticks, winograd_ticks,
+      PercentOf(winograd_ticks, float_reference_ticks));
+  MicroPrintf("%s float: %u bytes of Winograd scratch, %u bytes persistent, %s",
+              c.tag, static_cast<uint32_t>(winograd_scratch_bytes),
+              static_cast<uint32_t>(winograd_filter_bytes),
+              max_difference <= 1e-5f * std::max(max_output, 1.0f)
+                  ? "outputs match the reference"
+                  : "OUTPUTS DIFFER FROM THE REFERENCE");
+}
+
+// Times the 3x3 DEPTHWISE_CONV_2D (depth multiplier 1) followed by the 1x1
+// CONV_2D that replace a 3x3 CONV_2D of c.input_depth to c.output_depth
+// channels. The depthwise convolution keeps the quantization of the case, and
+// uses the first c.input_depth filter scales.
+void RunDepthwiseSeparableBenchmark(const ConvKernelBenchmarkCase& c) {
+  const int output_height = OutputSize(c.input_height, c.stride);
+  const int output_width = OutputSize(c.input_width, c.stride);
+  const ConvParams params = MakeConvParams(c);
+  int32_t output_multiplier[kMaxChannels];
+  int32_t output_shift[kMaxChannels];
+  ComputeOutputMultipliers(c, output_multiplier, output_shift);
+
+  const int32_t input_dims[] = {1, c.input_height, c.input_width,
+                                c.input_depth};
+  const int32_t filter_dims[] = {c.output_depth, kFilterSize, kFilterSize,
+                                 c.input_depth};
+  const int32_t depthwise_filter_dims[] = {1, kFilterSize, kFilterSize,
+                                           c.input_depth};
+  const int32_t pointwise_filter_dims[] = {c.output_depth, 1, 1,
+                                           c.input_depth};
+  const int32_t depthwise_bias_dims[] = {c.input_depth};
+  const int32_t bias_dims[] = {c.output_depth};
+  const int32_t depthwise_output_dims[] = {1, output_height, output_width,
+                                           c.input_depth};
+  const int32_t output_dims[] = {1, output_height, output_width,
+                                 c.output_depth};
+  const RuntimeShape input_shape(4, input_dims);
+  const RuntimeShape filter_shape(4, filter_dims);
+  const RuntimeShape depthwise_filter_shape(4, depthwise_filter_dims);
+  const RuntimeShape pointwise_filter_shape(4, pointwise_filter_dims);
+  const RuntimeShape depthwise_bias_shape(1, depthwise_bias_dims);
+  const RuntimeShape bias_shape(1, bias_dims);
+  const RuntimeShape depthwise_output_shape(4, depthwise_output_dims);
+  const RuntimeShape output_shape(4, output_dims);
+
+  DepthwiseParams depthwise_params = {};
+  depthwise_params.input_offset = params.input_offset;
+  depthwise_params.output_offset = params.output_offset;
+  depthwise_params.stride_height = params.stride_height;
+  depthwise_params.stride_width = params.stride_width;
+  depthwise_params.dilation_height_factor = 1;
+  depthwise_params.dilation_width_factor = 1;
+  depthwise_params.padding_values = params.padding_values;
+  depthwise_params.depth_multiplier = 1;
+  depthwise_params.quantized_activation_min = params.quantized_activation_min;
+  depthwise_params.quantized_activation_max = params.quantized_activation_max;
+
+  // The 1x1 convolution has no padding.
+  ConvParams pointwise_params = params;
+  pointwise_params.stride_height = 1;
+  pointwise_params.stride_width = 1;
+  pointwise_params.padding_values.height = 0;
+  pointwise_params.padding_values.width = 0;
+
+  if (!DepthwiseConvSimdSupported(depthwise_params, input_shape,
+                                  depthwise_filter_shape,
+                                  depthwise_output_shape) ||
+      !ConvGemmSupported(input_shape, filter_shape, output_shape) ||
+      ConvGemmScratchSize(filter_shape, output_shape, sizeof(int8_t)) >
+          sizeof(im2col_scratch)) {
+    MicroPrintf("%s: not supported by the depthwise SIMD or GEMM kernels",
+                c.tag);
+    return;
+  }
+
+  // Computed once at Prepare time by the kernels.
+  int32_t accumulator_init[kMaxChannels];
+  ConvGemmPrepareAccumulators(params, filter_shape, c.filter_data, c.bias_data,
+                              accumulator_init);
+  int32_t pointwise_accumulator_init[kMaxChannels];
+  ConvGemmPrepareAccumulators(pointwise_params, pointwise_filter_shape,
+                              c.filter_data, c.bias_data,
+                              pointwise_accumulator_init);
+
+  uint32_t start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    ConvPerChannelGemm(params, output_multiplier, output_shift,
+                       accumulator_init, input_shape, c.input_data,
+                       filter_shape, c.filter_data, output_shape, kernel_output,
+                       im2col_scratch);
+  }
+  const uint32_t conv_ticks = GetCurrentTimeTicks() - start;
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    reference_integer_ops::DepthwiseConvPerChannel(
+        depthwise_params, output_multiplier, output_shift, input_shape,
+        c.input_data, depthwise_filter_shape, c.filter_data,
+        depthwise_bias_shape, c.bias_data, depthwise_output_shape,
+        depthwise_reference_output);
+  }
+  const uint32_t depthwise_reference_ticks = GetCurrentTimeTicks() - start;
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    DepthwiseConvPerChannelSimd(depthwise_params, output_multiplier,
+                                output_shift, input_shape, c.input_data,
+                                depthwise_filter_shape, c.filter_data,
+                                c.bias_data, depthwise_output_shape,
+                                depthwise_output);
+  }
+  const uint32_t depthwise_ticks = GetCurrentTimeTicks() - start;
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    reference_integer_ops::ConvPerChannel(
+        pointwise_params, output_multiplier, output_shift,
+        depthwise_output_shape, depthwise_output, pointwise_filter_shape,
+        c.filter_data, bias_shape, c.bias_data, output_shape,
+        reference_output);
+  }
+  const uint32_t pointwise_reference_ticks = GetCurrentTimeTicks() - start;
+
+  start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    ConvPerChannelGemm(pointwise_params, output_multiplier, output_shift,
+                       pointwise_accumulator_init, depthwise_output_shape,
+                       depthwise_output, pointwise_filter_shape, c.filter_data,
+                       output_shape, kernel_output, im2col_scratch);
+  }
+  const uint32_t pointwise_ticks = GetCurrentTimeTicks() - start;
+
+  int mismatches = 0;
+  for (int i = 0; i < depthwise_output_shape.FlatSize(); ++i) {
+    if (depthwise_reference_output[i] != depthwise_output[i]) {
+      ++mismatches;
+    }
+  }
+  for (int i = 0; i < output_shape.FlatSize(); ++i) {
+    if (reference_output[i] != kernel_output[i]) {
+      ++mismatches;
+    }
+  }
+
+  const int output_pixels = output_height * output_width;
+  const uint32_t conv_macs = output_pixels * c.output_depth * kFilterSize *
+                             kFilterSize * c.input_depth;
+  const uint32_t separable_macs =
+      output_pixels * c.input_depth *
+      (kFilterSize * kFilterSize + c.output_depth);
+
+  MicroPrintf("%s: %u MACs as a 3x3 conv, %u MACs separable (%u%%)", c.tag,
+              conv_macs, separable_macs, PercentOf(separable_macs, conv_macs));
+  MicroPrintf(
+      "%s x%d: depthwise reference %u ticks, SIMD %u ticks (%u%% of "
+      "reference)",
+      c.tag, c.iterations, depthwise_reference_ticks, depthwise_ticks,
+      PercentOf(depthwise_ticks, depthwise_reference_ticks));
+  MicroPrintf(
+      "%s x%d: pointwise reference %u ticks, GEMM %u ticks (%u%% of "
+      "reference)",
+      c.tag, c.iterations, pointwise_reference_ticks, pointwise_ticks,
+      PercentOf(pointwise_ticks, pointwise_reference_ticks));
+  MicroPrintf(
+      "%s x%d: 3x3 conv GEMM %u ticks, depthwise SIMD + pointwise GEMM %u "
+      "ticks (%u%% of the conv)",
+      c.tag, c.iterations, conv_ticks, depthwise_ticks + pointwise_ticks,
+      PercentOf(depthwise_ticks + pointwise_ticks, conv_ticks));
+  MicroPrintf("%s: %s", c.tag,
+              mismatches == 0 ? "outputs are bit-exact"
+                              : "OUTPUTS DIFFER FROM THE REFERENCE");
+}
+
+}  // namespace
+}  // namespace tflite
+
+int main(int argc, char** argv) {
+  tflite::InitializeTarget();
+  tflite::GenerateInmp441Data();
+
+  const tflite::ConvKernelBenchmarkCase cases[] = {
+      // conv_test.cc: Int8Filter1x3x3x1ShouldMatchGoldenOddInputPaddingSame.
+      {"Input1x5x5x1Filter1x3x3x1Stride2", 5, 5, 1, 1, 2, 0.00392120517f,
+       -128, tflite::kFilter1x3x3x1Scales, 0.00627814838f, -7, false,
+       tflite::kConvInput1x5x5x1, tflite::kConvFilter1x3x3x1,
+       tflite::kConvZeroBias, 10000},
+      // conv_test.cc: Int8Filter8x3x3x3PerChannelScaleRelu6ShouldMatchGolden.
+      {"Input1x32x32x3Filter8x3x3x3Stride2", 32, 32, 3, 8, 2, 0.00784313772f,
+       -1, tflite::kFilter8x3x3x3Scales, 0.0235294122f, -128, true,
+       tflite::kConvInput1x32x32x3, tflite::kConvFilter8x3x3x3,
+       tflite::kConvBiasQuantized8, 100},
+      // First CONV_2D of the INMP441 speech CNN, with generated data.
+      {"Inmp441Conv1Input1x99x41x1Filter16x3x3x1", 99, 41, 1, 16, 1, 0.05f,
+       -3, tflite::kInmp441FilterScales, 0.1f, -128, false,
+       tflite::generated_input, tflite::generated_filter,
+       tflite::generated_bias, 20},
+  };
+
+  for (const tflite::ConvKernelBenchmarkCase& benchmark_case : cases) {
+    tflite::RunConvKernelBenchmark(benchmark_case);
+    MicroPrintf("");  // null MicroPrintf serves as a newline.
+  }
+
+  const tflite::ConvKernelBenchmarkCase gemm_cases[] = {
+      // Second CONV_2D of the INMP441 speech CNN, with generated data.
+      {"Inmp441Conv2Input1x50x21x16Filter16x3x3x16", 50, 21, 16, 16, 1, 0.1f,
+       -128, tflite::kInmp441FilterScales, 0.1f, -128, false,
+       tflite::generated_input, tflite::generated_filter,
+       tflite::generated_bias, 5},
+      // Third CONV_2D of the INMP441 speech CNN, with generated data.
+      {"Inmp441Conv3Input1x25x11x16Filter8x3x3x16", 25, 11, 16, 8, 1, 0.1f,
+       -128, tflite::kInmp441FilterScales, 0.1f, -128, false,
+       tflite::generated_input, tflite::generated_filter,
+       tflite::generated_bias, 20},
+  };
+
+  for (const tflite::ConvKernelBenchmarkCase& benchmark_case : gemm_cases) {
+    tflite::RunConvGemmBenchmark(benchmark_case);
+    MicroPrintf("");
+  }
+
+  for (const tflite::ConvKernelBenchmarkCase& benchmark_case : gemm_cases) {
+    tflite::RunDepthwiseSeparableBenchmark(benchmark_case);
+    MicroPrintf("");
+  }
+}
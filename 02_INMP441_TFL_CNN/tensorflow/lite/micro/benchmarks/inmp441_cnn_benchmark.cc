@@ -0,0 +1,162 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/benchmarks/micro_benchmark.h"
+#include "tensorflow/lite/micro/benchmarks/testdata/inmp441_one_test_data.h"
+#include "tensorflow/lite/micro/benchmarks/testdata/inmp441_three_test_data.h"
+#include "tensorflow/lite/micro/benchmarks/testdata/inmp441_two_test_data.h"
+#include "tensorflow/lite/micro/benchmarks/testdata/inmp441_zero_test_data.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_profiler.h"
+#include "tensorflow/lite/micro/micro_time.h"
+#include "tensorflow/lite/micro/models/inmp441_cnn_model_data.h"
+#include "tensorflow/lite/micro/system_setup.h"
+
+/*
+ * INMP441 speech CNN benchmark. Evaluates runtime performance of the keyword
+ * model deployed by the 02_INMP441_TFL_CNN sketch (QUANTIZE, three CONV_2D +
+ * MAX_POOL_2D blocks, two FULLY_CONNECTED layers and SOFTMAX on a 99x41 float
+ * spectrogram). The inputs are spectrograms of one recording per class from
+ * Python_INMP441/Dataset, computed with the device algorithm by
+ * Python_INMP441/device_spectrogram.py, so the predicted labels double as a
+ * sanity check for optimized kernels.
+ */
+
+namespace tflite {
+
+using Inmp441CnnBenchmarkRunner = MicroBenchmarkRunner<float>;
+using Inmp441CnnOpResolver = MicroMutableOpResolver<6>;
+
+// Same arena size as the sketch (kTensorArenaSize in
+// TensorFlowLiteModelConfig.h). The amount actually used is reported below.
+// Align arena to 16 bytes to avoid alignment warnings on certain platforms.
+constexpr int kTensorArenaSize = 100 * 1024;
+alignas(16) uint8_t tensor_arena[kTensorArenaSize];
+
+uint8_t op_resolver_buffer[sizeof(Inmp441CnnOpResolver)];
+uint8_t benchmark_runner_buffer[sizeof(Inmp441CnnBenchmarkRunner)];
+
+constexpr int kCategoryCount = 4;
+const char* kCategoryLabels[kCategoryCount] = {"0_Zero", "1_One", "2_Two",
+                                               "3_Three"};
+
+// Initialize benchmark runner instance explicitly to avoid global init order
+// issues on Sparkfun. Use new since static variables within a method
+// are automatically surrounded by locking, which breaks bluepill.
+Inmp441CnnBenchmarkRunner* CreateBenchmarkRunner(MicroProfiler* profiler) {
+  // We allocate Inmp441CnnOpResolver from a global buffer because the
+  // object's lifetime must exceed that of the Inmp441CnnBenchmarkRunner
+  // object. The kernels are the ones registered by the sketch.
+  Inmp441CnnOpResolver* op_resolver =
+      new (op_resolver_buffer) Inmp441CnnOpResolver();
+  op_resolver->AddQuantize();
+  op_resolver->AddConv2D();
+  op_resolver->AddMaxPool2D();
+  op_resolver->AddReshape();
+  op_resolver->AddFullyConnected();
+  op_resolver->AddSoftmax();
+
+  return new (benchmark_runner_buffer)
+      Inmp441CnnBenchmarkRunner(g_inmp441_cnn_model_data, op_resolver,
+                                tensor_arena, kTensorArenaSize, profiler);
+}
+
+// Returns the index of the largest score, the same decision getPrediction()
+// makes in the sketch.
+int Predict(TfLiteTensor* output) {
+  const int8_t* scores = GetTensorData<int8_t>(output);
+  int best = 0;
+  for (int i = 1; i < kCategoryCount; ++i) {
+    if (scores[i] > scores[best]) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+void Inmp441CnnRunNIterations(const float* input, int iterations,
+                              const char* tag,
+                              Inmp441CnnBenchmarkRunner& benchmark_runner,
+                              MicroProfiler& profiler) {
+  benchmark_runner.SetInput(input);
+  uint32_t ticks = 0;
+  uint32_t min_ticks = UINT32_MAX;
+  uint32_t max_ticks = 0;
+  for (int i = 0; i < iterations; ++i) {
+    profiler.ClearEvents();
+    benchmark_runner.RunSingleIteration();
+    const uint32_t invoke_ticks = profiler.GetTotalTicks();
+    ticks += invoke_ticks;
+    min_ticks = invoke_ticks < min_ticks ? invoke_ticks : min_ticks;
+    max_ticks = invoke_ticks > max_ticks ? invoke_ticks : max_ticks;
+  }
+  MicroPrintf("%s took %u ticks (%u ms), per invoke min %u avg %u max %u ticks",
+              tag, ticks, TicksToMs(ticks), min_ticks, ticks / iterations,
+              max_ticks);
+  MicroPrintf("%s predicted %s", tag,
+              kCategoryLabels[Predict(benchmark_runner.GetOutput())]);
+}
+
+}  // namespace tflite
+
+int main(int argc, char** argv) {
+  tflite::InitializeTarget();
+
+  tflite::MicroProfiler profiler;
+
+  uint32_t event_handle = profiler.BeginEvent("InitializeBenchmarkRunner");
+  tflite::Inmp441CnnBenchmarkRunner* benchmark_runner =
+      CreateBenchmarkRunner(&profiler);
+  profiler.EndEvent(event_handle);
+  profiler.Log();
+  MicroPrintf("Arena used bytes: %u of %u",
+              static_cast<unsigned>(benchmark_runner->GetArenaUsedBytes()),
+              static_cast<unsigned>(tflite::kTensorArenaSize));
+  MicroPrintf("");  // null MicroPrintf serves as a newline.
+
+  // Per operator breakdown of a single invocation.
+  tflite::Inmp441CnnRunNIterations(g_inmp441_zero_test_data, 1,
+                                   "ZeroDataIterations(1)", *benchmark_runner,
+                                   profiler);
+  profiler.Log();
+  profiler.LogTicksPerTagCsv();
+  MicroPrintf("");  // null MicroPrintf serves as a newline.
+
+  tflite::Inmp441CnnRunNIterations(g_inmp441_zero_test_data, 10,
+                                   "ZeroDataIterations(10)", *benchmark_runner,
+                                   profiler);
+  MicroPrintf("");  // null MicroPrintf serves as a newline.
+
+  tflite::Inmp441CnnRunNIterations(g_inmp441_one_test_data, 10,
+                                   "OneDataIterations(10)", *benchmark_runner,
+                                   profiler);
+  MicroPrintf("");  // null MicroPrintf serves as a newline.
+
+  tflite::Inmp441CnnRunNIterations(g_inmp441_two_test_data, 10,
+                                   "TwoDataIterations(10)", *benchmark_runner,
+                                   profiler);
+  MicroPrintf("");  // null MicroPrintf serves as a newline.
+
+  tflite::Inmp441CnnRunNIterations(g_inmp441_three_test_data, 10,
+                                   "ThreeDataIterations(10)", *benchmark_runner,
+                                   profiler);
+  MicroPrintf("");  // null MicroPrintf serves as a newline.
+
+  benchmark_runner->PrintAllocations();
+}
@@ -81,6 +81,12 @@ class MicroBenchmarkRunner {
     }
   }
 
+  TfLiteTensor* GetOutput(int output_index = 0) {
+    return interpreter_.output(output_index);
+  }
+
+  size_t GetArenaUsedBytes() const { return interpreter_.arena_used_bytes(); }
+
   void PrintAllocations() const {
     interpreter_.GetMicroAllocator().PrintAllocations();
   }
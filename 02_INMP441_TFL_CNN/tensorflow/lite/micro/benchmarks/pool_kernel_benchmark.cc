@@ -0,0 +1,169 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/pooling.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/pooling_simd.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_time.h"
+#include "tensorflow/lite/micro/system_setup.h"
+
+/*
+ * Pooling kernel benchmark. Times the int8 max and average pooling kernels on
+ * the three 2x2/stride-2 'same' pooling layers of the INMP441 speech CNN:
+ * reference_integer_ops, the channel-vectorised MaxPoolSimd and
+ * AveragePoolSimd, and the 2x2/stride-2 kernels the reference MAX_POOL_2D and
+ * AVERAGE_POOL_2D select for these layers. Every case checks that the 2x2
+ * kernels produce the same output as the reference.
+ */
+
+namespace tflite {
+namespace {
+
+constexpr int kMaxInputElements = 99 * 41 * 16;
+constexpr int kMaxOutputElements = 50 * 21 * 16;
+
+int8_t generated_input[kMaxInputElements];
+int8_t reference_output[kMaxOutputElements];
+int8_t kernel_output[kMaxOutputElements];
+
+struct PoolKernelBenchmarkCase {
+  const char* tag;
+  int input_height;
+  int input_width;
+  int depth;
+  int iterations;
+};
+
+// Deterministic data covering the int8 range. The benchmark measures speed
+// and equality of the kernels, so the values need no meaning.
+void GenerateInput() {
+  for (int i = 0; i < kMaxInputElements; ++i) {
+    generated_input[i] =
+        static_cast<int8_t>((i * 37 + (i / 41) * 11) % 256 - 128);
+  }
+}
+
+uint32_t PercentOf(uint32_t part, uint32_t whole) {
+  return whole > 0 ? static_cast<uint32_t>(
+                         (static_cast<uint64_t>(part) * 100 + whole / 2) /
+                         whole)
+                   : 0;
+}
+
+bool OutputsMatch(const RuntimeShape& output_shape) {
+  for (int i = 0; i < output_shape.FlatSize(); ++i) {
+    if (reference_output[i] != kernel_output[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Runs kernel c.iterations times and returns the elapsed ticks.
+template <typename Kernel>
+uint32_t TimeKernel(const PoolKernelBenchmarkCase& c, const Kernel& kernel) {
+  const uint32_t start = GetCurrentTimeTicks();
+  for (int i = 0; i < c.iterations; ++i) {
+    kernel();
+  }
+  return GetCurrentTimeTicks() - start;
+}
+
+void RunPoolKernelBenchmark(const PoolKernelBenchmarkCase& c) {
+  // 'same' padding of a 2x2/stride-2 window pads only after the input.
+  const int32_t input_dims[] = {1, c.input_height, c.input_width, c.depth};
+  const int32_t output_dims[] = {1, (c.input_height + 1) / 2,
+                                 (c.input_width + 1) / 2, c.depth};
+  const RuntimeShape input_shape(4, input_dims);
+  const RuntimeShape output_shape(4, output_dims);
+
+  PoolParams params = {};
+  params.stride_height = 2;
+  params.stride_width = 2;
+  params.filter_height = 2;
+  params.filter_width = 2;
+  params.quantized_activation_min = -128;
+  params.quantized_activation_max = 127;
+
+  if (!Pool2x2Stride2Supported(params, input_shape, output_shape)) {
+    MicroPrintf("%s: not supported by the 2x2/stride-2 kernels", c.tag);
+    return;
+  }
+
+  const uint32_t max_reference_ticks = TimeKernel(c, [&]() {
+    reference_integer_ops::MaxPool(params, input_shape, generated_input,
+                                   output_shape, reference_output);
+  });
+  const uint32_t max_simd_ticks = TimeKernel(c, [&]() {
+    MaxPoolSimd(params, input_shape, generated_input, output_shape,
+                kernel_output);
+  });
+  const uint32_t max_2x2_ticks = TimeKernel(c, [&]() {
+    MaxPool2x2Stride2Simd(params, input_shape, generated_input, output_shape,
+                          kernel_output);
+  });
+  MicroPrintf(
+      "%s max x%d: reference %u ticks, SIMD %u ticks (%u%%), 2x2 %u ticks "
+      "(%u%%), %s",
+      c.tag, c.iterations, max_reference_ticks, max_simd_ticks,
+      PercentOf(max_simd_ticks, max_reference_ticks), max_2x2_ticks,
+      PercentOf(max_2x2_ticks, max_reference_ticks),
+      OutputsMatch(output_shape) ? "outputs are bit-exact"
+                                 : "OUTPUTS DIFFER FROM THE REFERENCE");
+
+  const uint32_t average_reference_ticks = TimeKernel(c, [&]() {
+    reference_integer_ops::AveragePool(params, input_shape, generated_input,
+                                       output_shape, reference_output);
+  });
+  const uint32_t average_simd_ticks = TimeKernel(c, [&]() {
+    AveragePoolSimd(params, input_shape, generated_input, output_shape,
+                    kernel_output);
+  });
+  const uint32_t average_2x2_ticks = TimeKernel(c, [&]() {
+    AveragePool2x2Stride2Simd(params, input_shape, generated_input,
+                              output_shape, kernel_output);
+  });
+  MicroPrintf(
+      "%s average x%d: reference %u ticks, SIMD %u ticks (%u%%), 2x2 %u "
+      "ticks (%u%%), %s",
+      c.tag, c.iterations, average_reference_ticks, average_simd_ticks,
+      PercentOf(average_simd_ticks, average_reference_ticks),
+      average_2x2_ticks, PercentOf(average_2x2_ticks, average_reference_ticks),
+      OutputsMatch(output_shape) ? "outputs are bit-exact"
+                                 : "OUTPUTS DIFFER FROM THE REFERENCE");
+}
+
+}  // namespace
+}  // namespace tflite
+
+int main(int argc, char** argv) {
+  tflite::InitializeTarget();
+  tflite::GenerateInput();
+
+  const tflite::PoolKernelBenchmarkCase cases[] = {
+      // The MAX_POOL_2D after each CONV_2D of the INMP441 speech CNN.
+      {"Inmp441Pool1Input1x99x41x16", 99, 41, 16, 100},
+      {"Inmp441Pool2Input1x50x21x16", 50, 21, 16, 400},
+      {"Inmp441Pool3Input1x25x11x8", 25, 11, 8, 2000},
+  };
+
+  for (const tflite::PoolKernelBenchmarkCase& benchmark_case : cases) {
+    tflite::RunPoolKernelBenchmark(benchmark_case);
+    MicroPrintf("");  // null MicroPrintf serves as a newline.
+  }
+}
@@ -0,0 +1,239 @@
+# Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Weight binning for LUT compression.
+
+See USAGE.
+"""
+
+import sys
+from typing import ByteString, Optional
+
+import absl.app
+import absl.flags
+import numpy as np
+
+from tflite_micro.tensorflow.lite.micro.compression import model_facade
+from tflite_micro.tensorflow.lite.micro.compression import spec
+from tflite_micro.tensorflow.lite.python import schema_py_generated as tflite
+
+USAGE = f"""\
+Usage: lut_binning.py --input <in.tflite> --output <out.tflite> \\
+    --spec <spec.yaml> [--index_bitwidth 4] [--min_elements 256]
+
+Prepare a post-training quantized model for LUT compression by compress.py.
+
+LUT compression requires each tensor, or each quantization channel of a
+per-channel quantized tensor, to hold no more than 2**index_bitwidth unique
+values. A model quantized to int8 typically uses most of the 256 values in
+each channel. This tool clusters the int8 values of each channel of the filter
+tensors of CONV_2D, DEPTHWISE_CONV_2D, FULLY_CONNECTED and CONV_2D_MAX_POOL_2D
+operators into 2**index_bitwidth values with a 1-D k-means, rewrites the
+tensors with the cluster centers, and writes a spec file listing the binned
+tensors, e.g.:
+
+---
+{spec.EXAMPLE_YAML_SPEC}
+---
+
+Filters with fewer than min_elements values are left untouched: the value
+tables would cost about as much as the indices save.
+
+Binning changes the model's weights. Check the accuracy of the binned model,
+and fine-tune if necessary, before compressing it.
+"""
+
+_FILTER_INPUT_INDEX = 1
+
+_BINNED_BUILTIN_OPERATORS = (
+    tflite.BuiltinOperator.CONV_2D,
+    tflite.BuiltinOperator.DEPTHWISE_CONV_2D,
+    tflite.BuiltinOperator.FULLY_CONNECTED,
+)
+
+_BINNED_CUSTOM_OPERATORS = ("CONV_2D_MAX_POOL_2D", )
+
+_KMEANS_ITERATIONS = 32
+
+
+def _bin_slice(values: np.ndarray, num_bins: int) -> np.ndarray:
+  """Replaces each int8 value with the nearest of at most num_bins centers.
+
+  The centers are found by a k-means over the histogram of the values, started
+  from evenly spaced quantiles, and rounded to int8.
+  """
+  unique = np.unique(values)
+  if len(unique) <= num_bins:
+    return values
+
+  levels = np.arange(-128, 128, dtype=np.float64)
+  counts = np.bincount(values.astype(np.int64).ravel() + 128, minlength=256)
+  counts = counts.astype(np.float64)
+
+  cumulative = np.cumsum(counts) / counts.sum()
+  quantiles = (np.arange(num_bins) + 0.5) / num_bins
+  centers = levels[np.searchsorted(cumulative, quantiles)]
+
+  for _ in range(_KMEANS_ITERATIONS):
+    assignment = np.argmin(np.abs(levels[:, None] - centers[None, :]), axis=1)
+    weight = np.bincount(assignment, weights=counts, minlength=num_bins)
+    total = np.bincount(assignment,
+                        weights=counts * levels,
+                        minlength=num_bins)
+    updated = np.where(weight > 0, total / np.maximum(weight, 1), centers)
+    if np.array_equal(updated, centers):
+      break
+    centers = updated
+
+  centers = np.unique(np.clip(np.round(centers), -128, 127))
+  nearest = np.argmin(np.abs(values.astype(np.float64)[..., None] - centers),
+                      axis=-1)
+  return centers[nearest].astype(values.dtype)
+
+
+def bin_array(array: np.ndarray, axis: Optional[int],
+              index_bitwidth: int) -> np.ndarray:
+  """Bins an int8 array to 2**index_bitwidth values per slice along axis.
+
+  If axis is None, the whole array shares one set of values, matching the
+  single value table compress.py creates for per-tensor quantization.
+  """
+  num_bins = 2**index_bitwidth
+  if axis is None:
+    return _bin_slice(array, num_bins)
+
+  slices = [_bin_slice(s, num_bins) for s in np.moveaxis(array, axis, 0)]
+  return np.moveaxis(np.stack(slices, axis=0), 0, axis)
+
+
+def _quantization_axis(tensor: model_facade._Tensor) -> Optional[int]:
+  """Returns the axis compress.py will build value tables along."""
+  q = tensor.quantization
+  if q is None or q.scale is None or len(q.scale) <= 1:
+    return None
+  return q.quantizedDimension
+
+
+def _is_binned_operator(operator: model_facade._Operator) -> bool:
+  opcode = operator.opcode
+  builtin = max(opcode.builtinCode, opcode.deprecatedBuiltinCode)
+  if builtin in _BINNED_BUILTIN_OPERATORS:
+    return True
+  if builtin == tflite.BuiltinOperator.CUSTOM and opcode.customCode:
+    custom = opcode.customCode
+    if isinstance(custom, bytes):
+      custom = custom.decode("utf-8")
+    return custom in _BINNED_CUSTOM_OPERATORS
+  return False
+
+
+def bin_model(model_in: ByteString,
+              index_bitwidth: int = 4,
+              min_elements: int = 256) -> tuple[bytearray, list[spec.Tensor]]:
+  """Bins the filters of model_in for LUT compression.
+
+  Returns:
+    The binned model, and the compression spec listing the binned tensors, to
+    be passed to compress.compress().
+  """
+  model = model_facade.read(model_in)
+  specs = []
+
+  for subgraph in model.subgraphs:
+    binned = set()
+    for operator in subgraph.operators:
+      if not _is_binned_operator(operator):
+        continue
+      if len(operator.operator.inputs) <= _FILTER_INPUT_INDEX:
+        continue
+      index = operator.operator.inputs[_FILTER_INPUT_INDEX]
+      if index < 0 or index in binned:
+        continue
+
+      tensor = subgraph.tensors[index]
+      if tensor.dtype != np.dtype("<i1") or not tensor.data:
+        continue
+      array = tensor.array
+      if array.size < min_elements:
+        continue
+
+      axis = _quantization_axis(tensor)
+      tensor.buffer.data = bin_array(array, axis, index_bitwidth).tobytes()
+      binned.add(index)
+      specs.append(
+          spec.Tensor(subgraph=subgraph.index,
+                      tensor=index,
+                      compression=[
+                          spec.LookUpTableCompression(
+                              index_bitwidth=index_bitwidth)
+                      ]))
+
+  return model.compile(), specs
+
+
+def spec_to_yaml(specs: list[spec.Tensor]) -> str:
+  """Formats specs as a specfile accepted by spec.parse_yaml()."""
+  lines = ["tensors:", ""]
+  for s in specs:
+    bitwidth = s.compression[0].index_bitwidth
+    lines += [
+        f"  - subgraph: {s.subgraph}",
+        f"    tensor: {s.tensor}",
+        f"    compression:",
+        f"      - lut:",
+        f"          index_bitwidth: {bitwidth}",
+        "",
+    ]
+  return "\n".join(lines)
+
+
+def _fail_w_usage() -> int:
+  absl.app.usage()
+  return 1
+
+
+FLAGS = absl.flags.FLAGS
+absl.flags.DEFINE_string("input", None, help="quantized .tflite flatbuffer")
+absl.flags.DEFINE_string("output", None, help="binned .tflite flatbuffer")
+absl.flags.DEFINE_string("spec", None, help="specfile to write for compress.py")
+absl.flags.DEFINE_integer("index_bitwidth", 4, help="LUT index bitwidth")
+absl.flags.DEFINE_integer("min_elements",
+                          256,
+                          help="smallest filter to bin, in elements")
+
+
+def main(argv):
+  if len(argv) > 1:
+    # no positional arguments accepted
+    return _fail_w_usage()
+
+  if FLAGS.input is None or FLAGS.output is None or FLAGS.spec is None:
+    return _fail_w_usage()
+
+  with open(FLAGS.input, "rb") as in_file:
+    in_model = in_file.read()
+
+  binned, specs = bin_model(in_model, FLAGS.index_bitwidth,
+                            FLAGS.min_elements)
+
+  with open(FLAGS.output, "wb") as out_file:
+    out_file.write(binned)
+  with open(FLAGS.spec, "w") as spec_file:
+    spec_file.write(spec_to_yaml(specs))
+
+  return 0
+
+
+if __name__ == "__main__":
+  sys.modules['__main__'].__doc__ = USAGE  # for absl's use
+  absl.app.run(main)
@@ -0,0 +1,166 @@
+# Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import tensorflow as tf
+
+from tflite_micro.tensorflow.lite.python import schema_py_generated as tflite
+from tflite_micro.tensorflow.lite.micro.compression import lut_binning
+from tflite_micro.tensorflow.lite.micro.compression import model_facade
+from tflite_micro.tensorflow.lite.micro.compression import spec
+from tflite_micro.tensorflow.lite.micro.compression import test_models
+
+_FILTER = np.arange(-128, 128, dtype=np.int8).reshape(4, 64)
+_SMALL_FILTER = np.arange(-8, 24, dtype=np.int8).reshape(2, 16)
+
+TEST_MODEL = {
+    "operator_codes": {
+        0: {
+            "builtin_code": tflite.BuiltinOperator.FULLY_CONNECTED,
+        },
+    },
+    "metadata": {
+        0: {
+            "name": "metadata0",
+            "buffer": 0
+        },
+    },
+    "subgraphs": {
+        0: {
+            "operators": {
+                0: {
+                    "opcode_index": 0,
+                    "inputs": (
+                        0,
+                        1,
+                    ),
+                    "outputs": (2, ),
+                },
+                1: {
+                    "opcode_index": 0,
+                    "inputs": (
+                        2,
+                        3,
+                    ),
+                    "outputs": (4, ),
+                },
+            },
+            "tensors": {
+                0: {
+                    "shape": (1, 64),
+                    "type": tflite.TensorType.INT8,
+                    "buffer": 0,
+                },
+                1: {
+                    "shape": (4, 64),
+                    "type": tflite.TensorType.INT8,
+                    "buffer": 1,
+                    "quantization": {
+                        "quantized_dimension": 0,
+                        "scale": (1, 1, 1, 1),
+                        "zero_point": (0, 0, 0, 0),
+                    },
+                },
+                2: {
+                    "shape": (1, 4),
+                    "type": tflite.TensorType.INT8,
+                    "buffer": 0,
+                },
+                3: {
+                    "shape": (2, 16),
+                    "type": tflite.TensorType.INT8,
+                    "buffer": 2,
+                    "quantization": {
+                        "quantized_dimension": 0,
+                        "scale": (1, 1),
+                        "zero_point": (0, 0),
+                    },
+                },
+                4: {
+                    "shape": (1, 2),
+                    "type": tflite.TensorType.INT8,
+                    "buffer": 0,
+                },
+            },
+        },
+    },
+    "buffers": {
+        0: None,
+        1: _FILTER,
+        2: _SMALL_FILTER,
+    },
+}
+
+
+class BinArrayTest(tf.test.TestCase):
+
+  def test_few_values_unchanged(self):
+    array = np.array([[1, 1, 5, 5], [-3, 0, 0, 7]], dtype=np.int8)
+    binned = lut_binning.bin_array(array, axis=0, index_bitwidth=2)
+    self.assertAllEqual(binned, array)
+
+  def test_values_per_channel(self):
+    binned = lut_binning.bin_array(_FILTER, axis=0, index_bitwidth=2)
+    self.assertEqual(binned.dtype, np.int8)
+    self.assertAllEqual(binned.shape, _FILTER.shape)
+    for channel, original in zip(binned, _FILTER):
+      self.assertLessEqual(len(np.unique(channel)), 4)
+      # Each value moves to a center inside its own channel's range.
+      self.assertAllInRange(channel, original.min(), original.max())
+      # Evenly spread values are binned into evenly sized clusters.
+      self.assertLessEqual(np.abs(channel - original).max(), 8)
+
+  def test_values_per_tensor(self):
+    binned = lut_binning.bin_array(_FILTER, axis=None, index_bitwidth=3)
+    self.assertLessEqual(len(np.unique(binned)), 8)
+
+  def test_binning_is_idempotent(self):
+    binned = lut_binning.bin_array(_FILTER, axis=1, index_bitwidth=1)
+    self.assertAllEqual(lut_binning.bin_array(binned, 1, 1), binned)
+
+
+class BinModelTest(tf.test.TestCase):
+
+  @classmethod
+  def setUpClass(cls):
+    cls.flatbuffer = test_models.build(TEST_MODEL)
+    cls.binned, cls.specs = lut_binning.bin_model(cls.flatbuffer,
+                                                  index_bitwidth=4,
+                                                  min_elements=64)
+    cls.model = model_facade.read(cls.binned)
+
+  def test_spec_lists_large_filters(self):
+    self.assertEqual(self.specs, [
+        spec.Tensor(subgraph=0,
+                    tensor=1,
+                    compression=[spec.LookUpTableCompression(4)]),
+    ])
+
+  def test_large_filter_binned(self):
+    binned = self.model.subgraphs[0].tensors[1].array
+    for channel in binned:
+      self.assertLessEqual(len(np.unique(channel)), 16)
+    self.assertNotAllEqual(binned, _FILTER)
+
+  def test_small_filter_unchanged(self):
+    self.assertAllEqual(self.model.subgraphs[0].tensors[3].array,
+                        _SMALL_FILTER)
+
+  def test_spec_yaml_round_trip(self):
+    yaml = lut_binning.spec_to_yaml(self.specs)
+    self.assertEqual(spec.parse_yaml(yaml), self.specs)
+
+
+if __name__ == "__main__":
+  tf.test.main()
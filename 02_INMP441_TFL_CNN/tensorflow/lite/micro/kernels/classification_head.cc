@@ -0,0 +1,257 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/classification_head.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/simd.h"
+#include "tensorflow/lite/micro/kernels/softmax.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+/*
+ * The CLASSIFICATION_HEAD custom operator replaces the int8 SOFTMAX at the
+ * end of a classifier. It is created offline by
+ * replace_softmax_with_classification_head in tools/model_transforms_utils.py.
+ *
+ * The exponentials of a softmax do not change which class scores highest,
+ * and an application that only takes the argmax of the probabilities pays
+ * for them on every invocation. By default this operator computes no
+ * exponential: each output is the score of its class relative to the row
+ * maximum, 127 + x - max(x) saturated to int8. The top class scores 127, the
+ * order and the ties of the logits are kept down to 255 quantization steps
+ * below the maximum, and 127 minus the second largest score is the top-2
+ * margin in logit quantization steps (see ClassificationHeadTop2).
+ *
+ * With the 'probabilities' option set, the outputs are the probabilities of
+ * the replaced SOFTMAX, exactly those of reference_ops::Softmax. The
+ * exponential only depends on the difference between a score and its row
+ * maximum, one of 256 values for int8 scores, so it is tabulated at Prepare
+ * and each element costs a table lookup instead of a fixed-point exp.
+ *
+ * Input: the int8 logits, normalised over the last dimension.
+ * Output: int8, of the same shape. Probabilities have the quantization of
+ * the SOFTMAX output (scale 1/256, zero point -128). Scores have the scale of
+ * the input and the zero point 127, so that a dequantized score is the
+ * difference of its logit to the largest one; Prepare rejects any other
+ * output quantization.
+ */
+namespace tflite {
+
+// Indices into the init flexbuffer's vector.
+// The parameter's name is in the comment that follows.
+// Elements in the vectors are ordered alphabetically by parameter name.
+const int kClassificationHeadBetaIndex = 0;  // 'beta'
+const int kClassificationHeadProbabilitiesIndex = 1;  // 'probabilities'
+
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kOutputTensor = 0;
+
+// Same fixed-point formats as reference_ops::Softmax: Q5.26 scaled
+// differences and a Q12.19 sum of exponentials.
+constexpr int kScaledDiffIntegerBits = 5;
+constexpr int kAccumulationIntegerBits = 12;
+using FixedPointScaledDiff =
+    gemmlowp::FixedPoint<int32_t, kScaledDiffIntegerBits>;
+using FixedPointAccum = gemmlowp::FixedPoint<int32_t, kAccumulationIntegerBits>;
+using FixedPoint0 = gemmlowp::FixedPoint<int32_t, 0>;
+
+void* ClassificationHeadInit(TfLiteContext* context, const char* buffer,
+                             size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  OpDataClassificationHead* data = static_cast<OpDataClassificationHead*>(
+      context->AllocatePersistentBuffer(context,
+                                        sizeof(OpDataClassificationHead)));
+
+  data->has_options = buffer != nullptr && length > 0;
+  data->beta = 1.0f;
+  data->probabilities = false;
+  data->exp_lut = nullptr;
+  if (data->has_options) {
+    const uint8_t* buffer_t = reinterpret_cast<const uint8_t*>(buffer);
+    tflite::FlexbufferWrapper wrapper(buffer_t, length);
+    data->beta = wrapper.ElementAsFloat(kClassificationHeadBetaIndex);
+    data->probabilities =
+        wrapper.ElementAsBool(kClassificationHeadProbabilitiesIndex);
+  }
+  return data;
+}
+
+TfLiteStatus ClassificationHeadPrepare(TfLiteContext* context,
+                                       TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpDataClassificationHead* data =
+      static_cast<OpDataClassificationHead*>(node->user_data);
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+  TF_LITE_ENSURE(context, NumDimensions(input) >= 1);
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteInt8);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteInt8);
+  TF_LITE_ENSURE_EQ(context, NumElements(input), NumElements(output));
+
+  if (!data->probabilities) {
+    TF_LITE_ENSURE_EQ(context, output->params.zero_point, 127);
+    TF_LITE_ENSURE(context, output->params.scale == input->params.scale);
+  } else {
+    TfLiteSoftmaxParams params = {data->beta};
+    TF_LITE_ENSURE_OK(context, CalculateSoftmaxParams(context, input, output,
+                                                      &params, &data->softmax));
+
+    data->exp_lut = static_cast<int32_t*>(context->AllocatePersistentBuffer(
+        context, sizeof(int32_t) * kClassificationHeadLutSize));
+    TF_LITE_ENSURE(context, data->exp_lut != nullptr);
+    for (int d = 0; d < kClassificationHeadLutSize; ++d) {
+      const int32_t input_diff = -d;
+      if (input_diff < data->softmax.diff_min) {
+        data->exp_lut[d] = 0;
+        continue;
+      }
+      const int32_t input_diff_rescaled =
+          MultiplyByQuantizedMultiplierGreaterThanOne(
+              input_diff, data->softmax.input_multiplier,
+              data->softmax.input_left_shift);
+      data->exp_lut[d] =
+          exp_on_negative_values(
+              FixedPointScaledDiff::FromRaw(input_diff_rescaled))
+              .raw();
+    }
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+// Scores relative to the row maximum: 127 for the top class.
+void EvalScores(int outer_size, int depth, const int8_t* input_data,
+                int8_t* output_data) {
+  for (int i = 0; i < outer_size; ++i) {
+    const int8_t* input = input_data + i * depth;
+    int8_t* output = output_data + i * depth;
+    const int32_t max_in_row = simd::ReduceMaxInt8(input, depth);
+    for (int c = 0; c < depth; ++c) {
+      output[c] = static_cast<int8_t>(
+          std::max<int32_t>(127 + input[c] - max_in_row, -128));
+    }
+  }
+}
+
+// reference_ops::Softmax with the exponentials read from the table. Entries
+// below diff_min are 0, which leaves them out of the sum and gives them the
+// output -128, as in the reference kernel.
+void EvalProbabilities(const OpDataClassificationHead& data, int outer_size,
+                       int depth, const int8_t* input_data,
+                       int8_t* output_data) {
+  const int32_t* exp_lut = data.exp_lut;
+  for (int i = 0; i < outer_size; ++i) {
+    const int8_t* input = input_data + i * depth;
+    int8_t* output = output_data + i * depth;
+    const int32_t max_in_row = simd::ReduceMaxInt8(input, depth);
+
+    FixedPointAccum sum_of_exps = FixedPointAccum::Zero();
+    for (int c = 0; c < depth; ++c) {
+      const FixedPoint0 exp_in_0 =
+          FixedPoint0::FromRaw(exp_lut[max_in_row - input[c]]);
+      sum_of_exps = sum_of_exps +
+                    gemmlowp::Rescale<kAccumulationIntegerBits>(exp_in_0);
+    }
+
+    int num_bits_over_unit;
+    const FixedPoint0 shifted_scale = FixedPoint0::FromRaw(GetReciprocal(
+        sum_of_exps.raw(), kAccumulationIntegerBits, &num_bits_over_unit));
+    const int exponent = num_bits_over_unit + 31 - 8;
+
+    for (int c = 0; c < depth; ++c) {
+      const int32_t unsat_output = gemmlowp::RoundingDivideByPOT(
+          (shifted_scale *
+           FixedPoint0::FromRaw(exp_lut[max_in_row - input[c]]))
+              .raw(),
+          exponent);
+      output[c] = static_cast<int8_t>(
+          std::max(std::min(unsat_output - 128, int32_t{127}), int32_t{-128}));
+    }
+  }
+}
+
+TfLiteStatus ClassificationHeadEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data =
+      *(static_cast<const OpDataClassificationHead*>(node->user_data));
+
+  const RuntimeShape input_shape = tflite::micro::GetTensorShape(input);
+  const int trailing_dim = input_shape.DimensionsCount() - 1;
+  const int depth = input_shape.Dims(trailing_dim);
+  const int outer_size = input_shape.FlatSize() / depth;
+
+  // Types are checked in Prepare.
+  if (data.probabilities) {
+    EvalProbabilities(data, outer_size, depth,
+                      tflite::micro::GetTensorData<int8_t>(input),
+                      tflite::micro::GetTensorData<int8_t>(output));
+  } else {
+    EvalScores(outer_size, depth, tflite::micro::GetTensorData<int8_t>(input),
+               tflite::micro::GetTensorData<int8_t>(output));
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+int ClassificationHeadTop2(const int8_t* scores, int depth, int* margin) {
+  int best = 0;
+  int32_t second_score = -256;
+  for (int c = 1; c < depth; ++c) {
+    if (scores[c] > scores[best]) {
+      second_score = scores[best];
+      best = c;
+    } else if (scores[c] > second_score) {
+      second_score = scores[c];
+    }
+  }
+  // A single class has nothing to be confused with.
+  *margin = depth > 1 ? scores[best] - second_score : 255;
+  return best;
+}
+
+TFLMRegistration Register_CLASSIFICATION_HEAD() {
+  return tflite::micro::RegisterOp(ClassificationHeadInit,
+                                   ClassificationHeadPrepare,
+                                   ClassificationHeadEval);
+}
+
+}  // namespace tflite
@@ -0,0 +1,58 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_CLASSIFICATION_HEAD_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_CLASSIFICATION_HEAD_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Indices into the init flexbuffer's vector.
+// The parameter's name is in the comment that follows.
+// Elements in the vectors are ordered alphabetically by parameter name.
+extern const int kClassificationHeadBetaIndex;  // 'beta'
+extern const int kClassificationHeadProbabilitiesIndex;  // 'probabilities'
+
+// Number of entries of the exponential table: one per difference between an
+// int8 score and the maximum of its row.
+constexpr int kClassificationHeadLutSize = 256;
+
+struct OpDataClassificationHead {
+  bool has_options;
+  float beta;
+  // Set if the operator computes the softmax probabilities, rather than the
+  // scores relative to the row maximum.
+  bool probabilities;
+
+  // Probabilities only: parameters of the replaced SOFTMAX and the
+  // exponential of every difference to the row maximum, as a Q0.31 raw
+  // value, 0 below diff_min.
+  SoftmaxParams softmax;
+  int32_t* exp_lut;
+};
+
+// Returns the index of the largest of the depth scores, the first one on a
+// tie, and sets *margin to its distance to the second largest score. With
+// the scores of CLASSIFICATION_HEAD in its default mode, the margin is the
+// difference of the two largest logits in quantization steps of the output.
+int ClassificationHeadTop2(const int8_t* scores, int depth, int* margin);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_CLASSIFICATION_HEAD_H_
@@ -0,0 +1,37 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// This file is generated. See:
+// third_party/tensorflow/lite/micro/kernels/test_data_generation/README.md
+
+#include "tensorflow/lite/micro/kernels/classification_head_flexbuffers_generated_data.h"
+
+const int g_gen_data_size_classification_head_scores = 49;
+const unsigned char g_gen_data_classification_head_scores[] = {
+    0x62, 0x65, 0x74, 0x61, 0x00, 0x70, 0x72, 0x6f, 0x62, 0x61, 0x62, 0x69,
+    0x6c, 0x69, 0x74, 0x69, 0x65, 0x73, 0x00, 0x02, 0x14, 0x10, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x6a, 0x0a, 0x26,
+    0x01,
+};
+
+const int g_gen_data_size_classification_head_probabilities = 49;
+const unsigned char g_gen_data_classification_head_probabilities[] = {
+    0x62, 0x65, 0x74, 0x61, 0x00, 0x70, 0x72, 0x6f, 0x62, 0x61, 0x62, 0x69,
+    0x6c, 0x69, 0x74, 0x69, 0x65, 0x73, 0x00, 0x02, 0x14, 0x10, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x3f, 0x01, 0x00, 0x00, 0x00, 0x0e, 0x6a, 0x0a, 0x26,
+    0x01,
+};
@@ -0,0 +1,174 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/classification_head.h"
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/kernels/classification_head_flexbuffers_generated_data.h"
+#include "tensorflow/lite/micro/kernels/kernel_runner.h"
+#include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/test_helpers.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace tflite {
+namespace testing {
+namespace {
+
+constexpr int kMaxElements = 64;
+
+// Quantization of the output of an int8 SOFTMAX.
+constexpr float kOutputScale = 1.0f / 256;
+constexpr int kOutputZeroPoint = -128;
+
+// Zero point of the output in the default, scores mode, whose scale is the
+// input scale.
+constexpr int kScoresZeroPoint = 127;
+
+// Runs CLASSIFICATION_HEAD with the given init data on input_data and returns
+// the status of Prepare. Invoke only runs if Prepare succeeds.
+TfLiteStatus InvokeClassificationHead(int* dims_data, const int8_t* input_data,
+                                      float input_scale,
+                                      const unsigned char* init_data,
+                                      int init_size, float output_scale,
+                                      int output_zero_point,
+                                      int8_t* output_data) {
+  TfLiteIntArray* dims = IntArrayFromInts(dims_data);
+  TfLiteTensor tensors[] = {
+      CreateQuantizedTensor(input_data, dims, input_scale, 0),
+      CreateQuantizedTensor(output_data, dims, output_scale,
+                            output_zero_point),
+  };
+  int inputs_data[] = {1, 0};
+  int outputs_data[] = {1, 1};
+  micro::KernelRunner runner(Register_CLASSIFICATION_HEAD(), tensors, 2,
+                             IntArrayFromInts(inputs_data),
+                             IntArrayFromInts(outputs_data),
+                             /*builtin_data=*/nullptr);
+  const TfLiteStatus status = runner.InitAndPrepare(
+      reinterpret_cast<const char*>(init_data), init_size);
+  if (status == kTfLiteOk) {
+    TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, runner.Invoke());
+  }
+  return status;
+}
+
+// Checks that CLASSIFICATION_HEAD with the 'probabilities' option is
+// bit-exact with SOFTMAX for the same beta.
+void TestProbabilitiesMatchSoftmax(int* dims_data, const int8_t* input_data,
+                                   float input_scale, float beta) {
+  TfLiteIntArray* dims = IntArrayFromInts(dims_data);
+  const int element_count = ElementCount(*dims);
+  TF_LITE_MICRO_EXPECT_LE(element_count, kMaxElements);
+
+  int8_t expected[kMaxElements];
+  TfLiteTensor tensors[] = {
+      CreateQuantizedTensor(input_data, dims, input_scale, 0),
+      CreateQuantizedTensor(expected, dims, kOutputScale, kOutputZeroPoint),
+  };
+  int inputs_data[] = {1, 0};
+  int outputs_data[] = {1, 1};
+  TfLiteSoftmaxParams params = {beta};
+  micro::KernelRunner runner(Register_SOFTMAX(), tensors, 2,
+                             IntArrayFromInts(inputs_data),
+                             IntArrayFromInts(outputs_data), &params);
+  TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, runner.InitAndPrepare());
+  TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, runner.Invoke());
+
+  int8_t output[kMaxElements];
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk,
+      InvokeClassificationHead(
+          dims_data, input_data, input_scale,
+          g_gen_data_classification_head_probabilities,
+          g_gen_data_size_classification_head_probabilities, kOutputScale,
+          kOutputZeroPoint, output));
+  for (int i = 0; i < element_count; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(expected[i], output[i]);
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace tflite
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(ScoresAreRelativeToRowMaximum) {
+  int dims[] = {2, 3, 4};
+  // A clear winner, a tie for the top class, and a row spanning the int8
+  // range, whose smallest score saturates.
+  const int8_t input[] = {10, -20, 33, 5, 7, 7, -1, 6, -128, 127, 0, -1};
+  const int8_t expected[] = {104, 74, 127, 99, 127, 127, 119, 126,
+                             -128, 127, 0, -1};
+  int8_t output[12];
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk,
+      tflite::testing::InvokeClassificationHead(
+          dims, input, 0.1f, g_gen_data_classification_head_scores,
+          g_gen_data_size_classification_head_scores, 0.1f,
+          tflite::testing::kScoresZeroPoint, output));
+  for (int i = 0; i < 12; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(expected[i], output[i]);
+  }
+
+  int margin;
+  TF_LITE_MICRO_EXPECT_EQ(2,
+                          tflite::ClassificationHeadTop2(output, 4, &margin));
+  TF_LITE_MICRO_EXPECT_EQ(23, margin);
+  // The first of the tied classes wins, with no margin.
+  TF_LITE_MICRO_EXPECT_EQ(
+      0, tflite::ClassificationHeadTop2(output + 4, 4, &margin));
+  TF_LITE_MICRO_EXPECT_EQ(0, margin);
+  TF_LITE_MICRO_EXPECT_EQ(
+      1, tflite::ClassificationHeadTop2(output + 8, 4, &margin));
+  TF_LITE_MICRO_EXPECT_EQ(127, margin);
+}
+
+TF_LITE_MICRO_TEST(ScoresRejectSoftmaxQuantization) {
+  int dims[] = {2, 1, 4};
+  const int8_t input[] = {10, -20, 33, 5};
+  int8_t output[4];
+  // Scores dequantized with the SOFTMAX quantization would read as
+  // probabilities.
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteError,
+      tflite::testing::InvokeClassificationHead(
+          dims, input, 0.1f, g_gen_data_classification_head_scores,
+          g_gen_data_size_classification_head_scores,
+          tflite::testing::kOutputScale, tflite::testing::kOutputZeroPoint,
+          output));
+}
+
+TF_LITE_MICRO_TEST(ProbabilitiesMatchSoftmax) {
+  int dims[] = {2, 4, 4};
+  // Includes a row of equal logits and a row whose smallest logits fall
+  // below diff_min.
+  const int8_t input[] = {10, -20,  33, 5,    7,  7,  7,   7,
+                          -128, 127, 0, -1, 100, 90, -50, 101};
+  tflite::testing::TestProbabilitiesMatchSoftmax(dims, input, 0.1f, 0.5f);
+  tflite::testing::TestProbabilitiesMatchSoftmax(dims, input, 0.02f, 0.5f);
+}
+
+TF_LITE_MICRO_TEST(ProbabilitiesMatchSoftmaxLongRow) {
+  int dims[] = {2, 1, 37};
+  int8_t input[37];
+  for (int i = 0; i < 37; ++i) {
+    input[i] = static_cast<int8_t>((i * 71) % 256 - 128);
+  }
+  tflite::testing::TestProbabilitiesMatchSoftmax(dims, input, 0.05f, 0.5f);
+}
+
+TF_LITE_MICRO_TESTS_END
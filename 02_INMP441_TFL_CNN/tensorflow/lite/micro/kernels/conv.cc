@@ -20,13 +20,46 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/portable_tensor_utils.h"
 #include "tensorflow/lite/kernels/internal/reference/conv.h"
 #include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/conv_gemm.h"
+#include "tensorflow/lite/micro/kernels/conv_winograd.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
 namespace {
 
+// ConvPrepare followed by the selection of the constant filter kernels, with
+// or without ConvWinograd.
+TfLiteStatus ConvPrepareKernels(TfLiteContext* context, TfLiteNode* node,
+                                bool winograd) {
+  TF_LITE_ENSURE_OK(context, ConvPrepare(context, node));
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kConvOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+  const auto& params =
+      *(static_cast<const TfLiteConvParams*>(node->builtin_data));
+  auto* data = static_cast<OpDataConv*>(node->user_data);
+  const TfLiteStatus status =
+      winograd ? ConvPrepareWinogradKernel(context, node, params,
+                                           GetTensorShape(output), data)
+               : ConvPrepareConstantFilterKernel(context, node, params,
+                                                 GetTensorShape(output), data);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return status;
+}
+
+TfLiteStatus ConvPrepareReference(TfLiteContext* context, TfLiteNode* node) {
+  return ConvPrepareKernels(context, node, /*winograd=*/false);
+}
+
+TfLiteStatus ConvPrepareWinograd(TfLiteContext* context, TfLiteNode* node) {
+  return ConvPrepareKernels(context, node, /*winograd=*/true);
+}
+
 TfLiteStatus ConvEval(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kConvInputTensor);
@@ -58,22 +91,47 @@ TfLiteStatus ConvEval(TfLiteContext* context, TfLiteNode* node) {
 
   switch (input->type) {  // Already know in/out types are same.
     case kTfLiteFloat32: {
-      tflite::reference_ops::Conv(
-          ConvParamsFloat(params, data), tflite::micro::GetTensorShape(input),
-          tflite::micro::GetTensorData<float>(input),
-          tflite::micro::GetTensorShape(filter),
+      if (data.winograd_filter != nullptr) {
+        ConvWinograd(
+            ConvParamsFloat(params, data), tflite::micro::GetTensorShape(input),
+            tflite::micro::GetTensorData<float>(input),
+            tflite::micro::GetTensorShape(filter), data.winograd_filter,
 #ifdef USE_TFLM_COMPRESSION
-          tflite::micro::GetTensorData<float>(micro_context, filter,
-                                              weights_comp_td,
-                                              data.weights_scratch_index),
-          tflite::micro::GetTensorShape(bias),
-          tflite::micro::GetOptionalTensorData<float>(
-              micro_context, bias, bias_comp_td, data.bias_scratch_index),
+            tflite::micro::GetOptionalTensorData<float>(
+                micro_context, bias, bias_comp_td, data.bias_scratch_index),
 #else   // USE_TFLM_COMPRESSION
-          tflite::micro::GetTensorData<float>(filter),
-          tflite::micro::GetTensorShape(bias),
-          tflite::micro::GetOptionalTensorData<float>(bias),
+            tflite::micro::GetOptionalTensorData<float>(bias),
 #endif  // USE_TFLM_COMPRESSION
+            tflite::micro::GetTensorShape(output),
+            tflite::micro::GetTensorData<float>(output),
+            context->GetScratchBuffer(context, data.winograd_scratch_index));
+        break;
+      }
+#ifdef USE_TFLM_COMPRESSION
+      const float* filter_data = tflite::micro::GetTensorData<float>(
+          micro_context, filter, weights_comp_td, data.weights_scratch_index);
+      const float* bias_data = tflite::micro::GetOptionalTensorData<float>(
+          micro_context, bias, bias_comp_td, data.bias_scratch_index);
+#else   // USE_TFLM_COMPRESSION
+      const float* filter_data = tflite::micro::GetTensorData<float>(filter);
+      const float* bias_data =
+          tflite::micro::GetOptionalTensorData<float>(bias);
+#endif  // USE_TFLM_COMPRESSION
+      if (data.im2col_scratch_index != -1) {
+        ConvGemm(ConvParamsFloat(params, data),
+                 tflite::micro::GetTensorShape(input),
+                 tflite::micro::GetTensorData<float>(input),
+                 tflite::micro::GetTensorShape(filter), filter_data, bias_data,
+                 tflite::micro::GetTensorShape(output),
+                 tflite::micro::GetTensorData<float>(output),
+                 context->GetScratchBuffer(context, data.im2col_scratch_index));
+        break;
+      }
+      tflite::reference_ops::Conv(
+          ConvParamsFloat(params, data), tflite::micro::GetTensorShape(input),
+          tflite::micro::GetTensorData<float>(input),
+          tflite::micro::GetTensorShape(filter), filter_data,
+          tflite::micro::GetTensorShape(bias), bias_data,
           tflite::micro::GetTensorShape(output),
           tflite::micro::GetTensorData<float>(output),
           tflite::micro::GetTensorShape(nullptr), nullptr);
@@ -151,22 +209,49 @@ TfLiteStatus ConvEval(TfLiteContext* context, TfLiteNode* node) {
           break;
         }
         case kTfLiteInt8: {
+          // The small filter and GEMM kernels fold the bias in at Prepare.
+#ifdef USE_TFLM_COMPRESSION
+          const int8_t* filter_data = tflite::micro::GetTensorData<int8_t>(
+              micro_context, filter, weights_comp_td,
+              data.weights_scratch_index);
+#else   // USE_TFLM_COMPRESSION
+          const int8_t* filter_data =
+              tflite::micro::GetTensorData<int8_t>(filter);
+#endif  // USE_TFLM_COMPRESSION
+          if (data.small_filter_channels != nullptr) {
+            ConvPerChannelSmallFilter(
+                ConvParamsQuantized(params, data), data.small_filter_channels,
+                tflite::micro::GetTensorShape(input),
+                tflite::micro::GetTensorData<int8_t>(input),
+                tflite::micro::GetTensorShape(filter), filter_data,
+                tflite::micro::GetTensorShape(output),
+                tflite::micro::GetTensorData<int8_t>(output));
+            break;
+          }
+          if (data.im2col_scratch_index != -1) {
+            ConvPerChannelGemm(
+                ConvParamsQuantized(params, data),
+                data.per_channel_output_multiplier,
+                data.per_channel_output_shift, data.gemm_accumulator_init,
+                tflite::micro::GetTensorShape(input),
+                tflite::micro::GetTensorData<int8_t>(input),
+                tflite::micro::GetTensorShape(filter), filter_data,
+                tflite::micro::GetTensorShape(output),
+                tflite::micro::GetTensorData<int8_t>(output),
+                context->GetScratchBuffer(context, data.im2col_scratch_index));
+            break;
+          }
           reference_integer_ops::ConvPerChannel(
               ConvParamsQuantized(params, data),
               data.per_channel_output_multiplier, data.per_channel_output_shift,
               tflite::micro::GetTensorShape(input),
               tflite::micro::GetTensorData<int8_t>(input),
-              tflite::micro::GetTensorShape(filter),
-#ifdef USE_TFLM_COMPRESSION
-              tflite::micro::GetTensorData<int8_t>(micro_context, filter,
-                                                   weights_comp_td,
-                                                   data.weights_scratch_index),
+              tflite::micro::GetTensorShape(filter), filter_data,
               tflite::micro::GetTensorShape(bias),
+#ifdef USE_TFLM_COMPRESSION
               tflite::micro::GetOptionalTensorData<int32_t>(
                   micro_context, bias, bias_comp_td, data.bias_scratch_index),
 #else   // USE_TFLM_COMPRESSION
-              tflite::micro::GetTensorData<int8_t>(filter),
-              tflite::micro::GetTensorShape(bias),
               tflite::micro::GetOptionalTensorData<int32_t>(bias),
 #endif  // USE_TFLM_COMPRESSION
               tflite::micro::GetTensorShape(output),
@@ -191,7 +276,11 @@ TfLiteStatus ConvEval(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace
 
 TFLMRegistration Register_CONV_2D() {
-  return tflite::micro::RegisterOp(ConvInit, ConvPrepare, ConvEval);
+  return tflite::micro::RegisterOp(ConvInit, ConvPrepareReference, ConvEval);
+}
+
+TFLMRegistration Register_CONV_2D_WINOGRAD() {
+  return tflite::micro::RegisterOp(ConvInit, ConvPrepareWinograd, ConvEval);
 }
 
 }  // namespace tflite
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/conv_small_filter.h"
 #include "tensorflow/lite/micro/micro_common.h"
 
 namespace tflite {
@@ -50,6 +51,23 @@ struct OpDataConv {
   // tensor is of n-bit precision that cannot be easily processed by kernels.
   int filter_buffer_index;
 
+  // Per output channel constants of ConvPerChannelSmallFilter. Set by the
+  // reference kernel's Prepare when the int8 convolution qualifies for it,
+  // nullptr otherwise.
+  ConvSmallFilterChannel* small_filter_channels;
+
+  // Scratch buffer of the im2col tiles of ConvPerChannelGemm and ConvGemm, -1
+  // when the reference kernel's Prepare did not select them. The int8 kernel
+  // also starts each output channel from gemm_accumulator_init.
+  int im2col_scratch_index;
+  int32_t* gemm_accumulator_init;
+
+  // Transformed filter and scratch buffer of ConvWinograd, set by the Prepare
+  // of Register_CONV_2D_WINOGRAD for float 3x3 stride 1 convolutions,
+  // nullptr and -1 otherwise.
+  float* winograd_filter;
+  int winograd_scratch_index;
+
 #ifdef USE_TFLM_COMPRESSION
 
   // scratch buffers for compressed tensors
@@ -86,11 +104,53 @@ void* ConvInit(TfLiteContext* context, const char* buffer, size_t length);
 
 TfLiteStatus ConvPrepare(TfLiteContext* context, TfLiteNode* node);
 
+// ConvPrepare for nodes whose options are not stored as TfLiteConvParams in
+// builtin_data, such as fused custom operators.
+TfLiteStatus ConvPrepare(TfLiteContext* context, TfLiteNode* node,
+                         const TfLiteConvParams& params, OpDataConv* data);
+
+// Selects a kernel for convolutions with a constant filter, after
+// ConvPrepare: ConvPerChannelSmallFilter for int8 convolutions with a small
+// filter window, otherwise ConvPerChannelGemm or ConvGemm for deep int8 and
+// float inputs. Their per channel constants are computed here once, from the
+// filter and bias data, and the im2col tile is requested from the arena.
+// output_shape is the shape of the convolution output.
+TfLiteStatus ConvPrepareConstantFilterKernel(TfLiteContext* context,
+                                             TfLiteNode* node,
+                                             const TfLiteConvParams& params,
+                                             const RuntimeShape& output_shape,
+                                             OpDataConv* data);
+
+// ConvPrepareConstantFilterKernel that selects ConvWinograd for float
+// convolutions with a constant 3x3 filter and stride 1, and transforms the
+// filter into a persistent buffer.
+TfLiteStatus ConvPrepareWinogradKernel(TfLiteContext* context,
+                                       TfLiteNode* node,
+                                       const TfLiteConvParams& params,
+                                       const RuntimeShape& output_shape,
+                                       OpDataConv* data);
+
 // This is the most generic TFLMRegistration. The actual supported types
 // may still be target dependent. The only requirement is that every
 // implementation (reference or optimized) must define this function.
 TFLMRegistration Register_CONV_2D();
 
+// The optimized kernel directories replace conv.cc and fall back to their
+// own CONV_2D.
+#if defined(ARC_MLI) || defined(CEVA) || defined(CMSIS_NN) || defined(XTENSA)
+inline TFLMRegistration Register_CONV_2D_WINOGRAD() {
+  return Register_CONV_2D();
+}
+#else
+// Returns a TFLMRegistration struct for the reference kernel variant that
+// computes float 3x3 stride 1 convolutions with ConvWinograd
+// (conv_winograd.h). Opt-in: its results differ from the reference kernel by
+// float rounding, and the transformed filter takes 16/9 of the filter size in
+// the arena. Other convolutions run as with Register_CONV_2D.
+TFLMRegistration Register_CONV_2D_WINOGRAD();
+#endif  // defined(ARC_MLI) || defined(CEVA) || defined(CMSIS_NN) ||
+        // defined(XTENSA)
+
 #if defined(XTENSA)
 // Returns a TFLMRegistration struct for kernel variant that only supports
 // int8 activations and int8 weights and always calls the reference
@@ -16,9 +16,12 @@ limitations under the License.
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/c_api_types.h"
 #include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/padding.h"
 #include "tensorflow/lite/micro/kernels/conv.h"
+#include "tensorflow/lite/micro/kernels/conv_gemm.h"
+#include "tensorflow/lite/micro/kernels/conv_winograd.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -140,9 +143,14 @@ TfLiteStatus ConvPrepare(TfLiteContext* context, TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
   TFLITE_DCHECK(node->builtin_data != nullptr);
 
-  OpDataConv* data = static_cast<OpDataConv*>(node->user_data);
   const auto& params =
       *(static_cast<const TfLiteConvParams*>(node->builtin_data));
+  return ConvPrepare(context, node, params,
+                     static_cast<OpDataConv*>(node->user_data));
+}
+
+TfLiteStatus ConvPrepare(TfLiteContext* context, TfLiteNode* node,
+                         const TfLiteConvParams& params, OpDataConv* data) {
   MicroContext* micro_context = GetMicroContext(context);
 
   TfLiteTensor* output =
@@ -232,4 +240,159 @@ TfLiteStatus ConvPrepare(TfLiteContext* context, TfLiteNode* node) {
   micro_context->DeallocateTempTfLiteTensor(output);
   return kTfLiteOk;
 }
+
+TfLiteStatus ConvPrepareConstantFilterKernel(TfLiteContext* context,
+                                             TfLiteNode* node,
+                                             const TfLiteConvParams& params,
+                                             const RuntimeShape& output_shape,
+                                             OpDataConv* data) {
+  data->small_filter_channels = nullptr;
+  data->im2col_scratch_index = -1;
+  data->gemm_accumulator_init = nullptr;
+  data->winograd_filter = nullptr;
+  data->winograd_scratch_index = -1;
+
+  MicroContext* micro_context = GetMicroContext(context);
+
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kConvInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* filter =
+      micro_context->AllocateTempInputTensor(node, kConvWeightsTensor);
+  TF_LITE_ENSURE(context, filter != nullptr);
+  TfLiteTensor* bias =
+      micro_context->AllocateTempInputTensor(node, kConvBiasTensor);
+
+  const ConvParams op_params = ConvParamsQuantized(params, *data);
+  const bool is_int8 =
+      input->type == kTfLiteInt8 && filter->type == kTfLiteInt8 &&
+      (bias == nullptr || bias->type == kTfLiteInt32);
+  const bool is_float =
+      input->type == kTfLiteFloat32 && filter->type == kTfLiteFloat32 &&
+      (bias == nullptr || bias->type == kTfLiteFloat32);
+  // Compressed weights are decompressed here for the persistent data of the
+  // kernels, and into the decompression memory at Eval for the filter reads.
+  const bool constant_weights = IsConstantTensor(filter) &&
+                                (bias == nullptr || IsConstantTensor(bias));
+  const bool use_small_filter =
+      is_int8 && constant_weights &&
+      ConvSmallFilterSupported(op_params, GetTensorShape(input),
+                               GetTensorShape(filter), output_shape);
+  const bool use_gemm =
+      !use_small_filter && (is_int8 || is_float) && constant_weights &&
+      ConvGemmSupported(GetTensorShape(input), GetTensorShape(filter),
+                        output_shape) &&
+      ConvGemmPreferred(GetTensorShape(input));
+
+  const bool prepare_int8_weights = use_small_filter || (use_gemm && is_int8);
+  const int8_t* filter_data = nullptr;
+  const int32_t* bias_data = nullptr;
+  if (prepare_int8_weights) {
+    filter_data = static_cast<const int8_t*>(micro::GetPrepareTensorData(
+        micro_context, node, kConvWeightsTensor, filter));
+    TF_LITE_ENSURE(context, filter_data != nullptr);
+    bias_data = static_cast<const int32_t*>(micro::GetPrepareTensorData(
+        micro_context, node, kConvBiasTensor, bias));
+    TF_LITE_ENSURE(context, bias == nullptr || bias_data != nullptr);
+  }
+
+  if (use_small_filter) {
+    const int num_channels = filter->dims->data[kConvQuantizedDimension];
+    data->small_filter_channels =
+        static_cast<ConvSmallFilterChannel*>(context->AllocatePersistentBuffer(
+            context, num_channels * sizeof(ConvSmallFilterChannel)));
+    TF_LITE_ENSURE(context, data->small_filter_channels != nullptr);
+    ConvSmallFilterPrepareChannels(
+        op_params, data->per_channel_output_multiplier,
+        data->per_channel_output_shift, GetTensorShape(filter), filter_data,
+        bias_data, data->small_filter_channels);
+  }
+
+  if (use_gemm) {
+    const size_t element_size = is_int8 ? sizeof(int8_t) : sizeof(float);
+    TF_LITE_ENSURE_OK(
+        context, context->RequestScratchBufferInArena(
+                     context,
+                     ConvGemmScratchSize(GetTensorShape(filter), output_shape,
+                                         element_size),
+                     &data->im2col_scratch_index));
+  }
+  if (use_gemm && is_int8) {
+    const int num_channels = filter->dims->data[kConvQuantizedDimension];
+    data->gemm_accumulator_init =
+        static_cast<int32_t*>(context->AllocatePersistentBuffer(
+            context, num_channels * sizeof(int32_t)));
+    TF_LITE_ENSURE(context, data->gemm_accumulator_init != nullptr);
+    ConvGemmPrepareAccumulators(op_params, GetTensorShape(filter), filter_data,
+                                bias_data, data->gemm_accumulator_init);
+  }
+
+  if (prepare_int8_weights) {
+    micro::ReleasePrepareTensorData(micro_context, bias, bias_data);
+    micro::ReleasePrepareTensorData(micro_context, filter, filter_data);
+  }
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  if (bias != nullptr) {
+    micro_context->DeallocateTempTfLiteTensor(bias);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus ConvPrepareWinogradKernel(TfLiteContext* context,
+                                       TfLiteNode* node,
+                                       const TfLiteConvParams& params,
+                                       const RuntimeShape& output_shape,
+                                       OpDataConv* data) {
+  MicroContext* micro_context = GetMicroContext(context);
+
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kConvInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* filter =
+      micro_context->AllocateTempInputTensor(node, kConvWeightsTensor);
+  TF_LITE_ENSURE(context, filter != nullptr);
+  TfLiteTensor* bias =
+      micro_context->AllocateTempInputTensor(node, kConvBiasTensor);
+
+  const bool use_winograd =
+      input->type == kTfLiteFloat32 && filter->type == kTfLiteFloat32 &&
+      IsConstantTensor(filter) &&
+      ConvWinogradSupported(ConvParamsFloat(params, *data),
+                            GetTensorShape(input), GetTensorShape(filter),
+                            output_shape);
+
+  TfLiteStatus status = kTfLiteOk;
+  if (use_winograd) {
+    data->small_filter_channels = nullptr;
+    data->im2col_scratch_index = -1;
+    data->gemm_accumulator_init = nullptr;
+    data->winograd_filter = static_cast<float*>(context->AllocatePersistentBuffer(
+        context, ConvWinogradFilterSize(GetTensorShape(filter))));
+    TF_LITE_ENSURE(context, data->winograd_filter != nullptr);
+    const float* filter_data = static_cast<const float*>(
+        micro::GetPrepareTensorData(micro_context, node, kConvWeightsTensor,
+                                    filter));
+    TF_LITE_ENSURE(context, filter_data != nullptr);
+    ConvWinogradTransformFilter(GetTensorShape(filter), filter_data,
+                                data->winograd_filter);
+    micro::ReleasePrepareTensorData(micro_context, filter, filter_data);
+    status = context->RequestScratchBufferInArena(
+        context, ConvWinogradScratchSize(GetTensorShape(filter)),
+        &data->winograd_scratch_index);
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  if (bias != nullptr) {
+    micro_context->DeallocateTempTfLiteTensor(bias);
+  }
+  TF_LITE_ENSURE_OK(context, status);
+  if (use_winograd) {
+    return kTfLiteOk;
+  }
+  return ConvPrepareConstantFilterKernel(context, node, params, output_shape,
+                                         data);
+}
+
 }  // namespace tflite
@@ -0,0 +1,342 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/conv_gemm.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/simd.h"
+
+namespace tflite {
+namespace {
+
+// Output pixels per block and output channels per block of the GEMM loops.
+constexpr int kPixelBlock = 2;
+constexpr int kChannelBlock = 4;
+
+struct ConvGemmArgs {
+  int input_height;
+  int input_width;
+  int input_depth;
+  int filter_height;
+  int filter_width;
+  int patch_size;
+  int output_height;
+  int output_width;
+  int output_depth;
+  int stride_height;
+  int stride_width;
+  int dilation_height;
+  int dilation_width;
+  int pad_height;
+  int pad_width;
+};
+
+ConvGemmArgs MakeArgs(const ConvParams& params, const RuntimeShape& input_shape,
+                      const RuntimeShape& filter_shape,
+                      const RuntimeShape& output_shape) {
+  ConvGemmArgs args;
+  args.input_height = input_shape.Dims(1);
+  args.input_width = input_shape.Dims(2);
+  args.input_depth = input_shape.Dims(3);
+  args.filter_height = filter_shape.Dims(1);
+  args.filter_width = filter_shape.Dims(2);
+  args.patch_size = args.filter_height * args.filter_width * args.input_depth;
+  args.output_height = output_shape.Dims(1);
+  args.output_width = output_shape.Dims(2);
+  args.output_depth = MatchingDim(filter_shape, 0, output_shape, 3);
+  args.stride_height = params.stride_height;
+  args.stride_width = params.stride_width;
+  args.dilation_height = params.dilation_height_factor;
+  args.dilation_width = params.dilation_width_factor;
+  args.pad_height = params.padding_values.height;
+  args.pad_width = params.padding_values.width;
+  return args;
+}
+
+int PatchSize(const RuntimeShape& filter_shape) {
+  return filter_shape.Dims(1) * filter_shape.Dims(2) * filter_shape.Dims(3);
+}
+
+// Output pixels per im2col tile: as many pixel blocks as fit into
+// kConvGemmIm2colTileBytes, at least one, and no more than the output has.
+int TilePixels(const RuntimeShape& filter_shape,
+               const RuntimeShape& output_shape, size_t element_size) {
+  const int row_bytes =
+      PatchSize(filter_shape) * static_cast<int>(element_size);
+  const int output_pixels =
+      output_shape.Dims(0) * output_shape.Dims(1) * output_shape.Dims(2);
+  int pixels = kConvGemmIm2colTileBytes / row_bytes;
+  pixels = std::max(kPixelBlock, pixels - pixels % kPixelBlock);
+  return std::min(pixels, output_pixels);
+}
+
+// Copies the filter windows of output pixels [first_pixel, first_pixel +
+// pixel_count) into rows of args.patch_size values. Taps in the padding are
+// set to pad_value.
+template <typename T>
+void Im2col(const ConvGemmArgs& args, const T* input_data, int first_pixel,
+            int pixel_count, T pad_value, T* rows) {
+  const int output_image_size = args.output_height * args.output_width;
+  const int input_batch_size =
+      args.input_height * args.input_width * args.input_depth;
+  for (int pixel = first_pixel; pixel < first_pixel + pixel_count; ++pixel) {
+    const int batch = pixel / output_image_size;
+    const int out_y = (pixel % output_image_size) / args.output_width;
+    const int out_x = pixel % args.output_width;
+    const int in_y_origin = out_y * args.stride_height - args.pad_height;
+    const int in_x_origin = out_x * args.stride_width - args.pad_width;
+    const T* input = input_data + batch * input_batch_size;
+    for (int filter_y = 0; filter_y < args.filter_height; ++filter_y) {
+      const int in_y = in_y_origin + args.dilation_height * filter_y;
+      for (int filter_x = 0; filter_x < args.filter_width; ++filter_x) {
+        const int in_x = in_x_origin + args.dilation_width * filter_x;
+        if (in_y >= 0 && in_y < args.input_height && in_x >= 0 &&
+            in_x < args.input_width) {
+          std::memcpy(rows,
+                      input + (in_y * args.input_width + in_x) *
+                                  args.input_depth,
+                      args.input_depth * sizeof(T));
+        } else {
+          std::fill(rows, rows + args.input_depth, pad_value);
+        }
+        rows += args.input_depth;
+      }
+    }
+  }
+}
+
+// Multiplies pixel_count im2col rows with the int8 filter rows and writes
+// pixel_count output pixels. The padding taps were filled with the input zero
+// point, so they add input_offset * filter, which accumulator_init cancels
+// together with the input_offset term of every real tap.
+void GemmInt8(const ConvParams& params, const int32_t* output_multiplier,
+              const int32_t* output_shift, const int32_t* accumulator_init,
+              const ConvGemmArgs& args, const int8_t* rows, int pixel_count,
+              const int8_t* filter_data, int8_t* output) {
+  const int patch_size = args.patch_size;
+  const int output_depth = args.output_depth;
+  const int32_t output_offset = params.output_offset;
+  const int32_t activation_min = params.quantized_activation_min;
+  const int32_t activation_max = params.quantized_activation_max;
+  for (int pixel = 0; pixel < pixel_count; pixel += kPixelBlock) {
+    // A single last pixel is computed twice and written once.
+    const bool pair = pixel + 1 < pixel_count;
+    const int8_t* row0 = rows + pixel * patch_size;
+    const int8_t* row1 = pair ? row0 + patch_size : row0;
+    int8_t* output0 = output + pixel * output_depth;
+    int out_channel = 0;
+    for (; out_channel + kChannelBlock <= output_depth;
+         out_channel += kChannelBlock) {
+      int32_t acc[kPixelBlock][kChannelBlock];
+      for (int c = 0; c < kChannelBlock; ++c) {
+        acc[0][c] = accumulator_init[out_channel + c];
+        acc[1][c] = accumulator_init[out_channel + c];
+      }
+      simd::DotProduct2x4Int8(row0, row1,
+                              filter_data + out_channel * patch_size,
+                              patch_size, patch_size, acc[0], acc[1]);
+      for (int p = 0; p < (pair ? 2 : 1); ++p) {
+        simd::RequantizePerChannelInt32(
+            acc[p], kChannelBlock, output_multiplier + out_channel,
+            output_shift + out_channel, output_offset, activation_min,
+            activation_max, output0 + p * output_depth + out_channel);
+      }
+    }
+    for (; out_channel < output_depth; ++out_channel) {
+      const int8_t* filter = filter_data + out_channel * patch_size;
+      int32_t acc[kPixelBlock];
+      acc[0] = accumulator_init[out_channel] +
+               simd::DotProductInt8(row0, filter, patch_size);
+      acc[1] = accumulator_init[out_channel] +
+               simd::DotProductInt8(row1, filter, patch_size);
+      for (int p = 0; p < (pair ? 2 : 1); ++p) {
+        simd::RequantizePerChannelInt32(
+            &acc[p], 1, output_multiplier + out_channel,
+            output_shift + out_channel, output_offset, activation_min,
+            activation_max, output0 + p * output_depth + out_channel);
+      }
+    }
+  }
+}
+
+inline float Activate(const ConvParams& params, float total,
+                      const float* bias_data, int out_channel) {
+  const float bias_value = bias_data != nullptr ? bias_data[out_channel] : 0.0f;
+  return ActivationFunctionWithMinMax(total + bias_value,
+                                      params.float_activation_min,
+                                      params.float_activation_max);
+}
+
+// Float counterpart of GemmInt8. The padding taps are zero.
+void GemmFloat(const ConvParams& params, const float* bias_data,
+               const ConvGemmArgs& args, const float* rows, int pixel_count,
+               const float* filter_data, float* output) {
+  const int patch_size = args.patch_size;
+  const int output_depth = args.output_depth;
+  for (int pixel = 0; pixel < pixel_count; pixel += kPixelBlock) {
+    const bool pair = pixel + 1 < pixel_count;
+    const float* row0 = rows + pixel * patch_size;
+    const float* row1 = pair ? row0 + patch_size : row0;
+    float* output0 = output + pixel * output_depth;
+    int out_channel = 0;
+    for (; out_channel + kChannelBlock <= output_depth;
+         out_channel += kChannelBlock) {
+      const float* filter0 = filter_data + out_channel * patch_size;
+      const float* filter1 = filter0 + patch_size;
+      const float* filter2 = filter1 + patch_size;
+      const float* filter3 = filter2 + patch_size;
+      float acc[kPixelBlock][kChannelBlock] = {};
+      for (int i = 0; i < patch_size; ++i) {
+        const float in0 = row0[i];
+        const float in1 = row1[i];
+        acc[0][0] += in0 * filter0[i];
+        acc[0][1] += in0 * filter1[i];
+        acc[0][2] += in0 * filter2[i];
+        acc[0][3] += in0 * filter3[i];
+        acc[1][0] += in1 * filter0[i];
+        acc[1][1] += in1 * filter1[i];
+        acc[1][2] += in1 * filter2[i];
+        acc[1][3] += in1 * filter3[i];
+      }
+      for (int p = 0; p < (pair ? 2 : 1); ++p) {
+        for (int c = 0; c < kChannelBlock; ++c) {
+          output0[p * output_depth + out_channel + c] =
+              Activate(params, acc[p][c], bias_data, out_channel + c);
+        }
+      }
+    }
+    for (; out_channel < output_depth; ++out_channel) {
+      const float* filter = filter_data + out_channel * patch_size;
+      float acc0 = 0.0f;
+      float acc1 = 0.0f;
+      for (int i = 0; i < patch_size; ++i) {
+        acc0 += row0[i] * filter[i];
+        acc1 += row1[i] * filter[i];
+      }
+      output0[out_channel] = Activate(params, acc0, bias_data, out_channel);
+      if (pair) {
+        output0[output_depth + out_channel] =
+            Activate(params, acc1, bias_data, out_channel);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool ConvGemmSupported(const RuntimeShape& input_shape,
+                       const RuntimeShape& filter_shape,
+                       const RuntimeShape& output_shape) {
+  if (input_shape.DimensionsCount() != 4 ||
+      filter_shape.DimensionsCount() != 4 ||
+      output_shape.DimensionsCount() != 4) {
+    return false;
+  }
+  // Grouped convolutions are left to the reference kernels.
+  return filter_shape.Dims(3) == input_shape.Dims(3);
+}
+
+bool ConvGemmPreferred(const RuntimeShape& input_shape) {
+  return input_shape.Dims(3) >= kConvGemmMinInputDepth;
+}
+
+size_t ConvGemmScratchSize(const RuntimeShape& filter_shape,
+                           const RuntimeShape& output_shape,
+                           size_t element_size) {
+  return static_cast<size_t>(
+             TilePixels(filter_shape, output_shape, element_size)) *
+         PatchSize(filter_shape) * element_size;
+}
+
+void ConvGemmPrepareAccumulators(const ConvParams& params,
+                                 const RuntimeShape& filter_shape,
+                                 const int8_t* filter_data,
+                                 const int32_t* bias_data,
+                                 int32_t* accumulator_init) {
+  const int output_depth = filter_shape.Dims(0);
+  const int patch_size = PatchSize(filter_shape);
+  for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+    const int8_t* filter = filter_data + out_channel * patch_size;
+    int32_t filter_sum = 0;
+    for (int i = 0; i < patch_size; ++i) {
+      filter_sum += filter[i];
+    }
+    const int32_t bias = bias_data != nullptr ? bias_data[out_channel] : 0;
+    accumulator_init[out_channel] = bias + params.input_offset * filter_sum;
+  }
+}
+
+void ConvPerChannelGemm(const ConvParams& params,
+                        const int32_t* output_multiplier,
+                        const int32_t* output_shift,
+                        const int32_t* accumulator_init,
+                        const RuntimeShape& input_shape,
+                        const int8_t* input_data,
+                        const RuntimeShape& filter_shape,
+                        const int8_t* filter_data,
+                        const RuntimeShape& output_shape, int8_t* output_data,
+                        void* scratch) {
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK(ConvGemmSupported(input_shape, filter_shape, output_shape));
+  const ConvGemmArgs args =
+      MakeArgs(params, input_shape, filter_shape, output_shape);
+  const int output_pixels =
+      MatchingDim(input_shape, 0, output_shape, 0) * args.output_height *
+      args.output_width;
+  const int tile_pixels =
+      TilePixels(filter_shape, output_shape, sizeof(int8_t));
+  // (input_zero_point + input_offset) * filter is zero, as for the taps the
+  // reference kernel skips.
+  const int8_t pad_value = static_cast<int8_t>(-params.input_offset);
+  int8_t* rows = static_cast<int8_t*>(scratch);
+
+  for (int pixel = 0; pixel < output_pixels; pixel += tile_pixels) {
+    const int pixel_count = std::min(tile_pixels, output_pixels - pixel);
+    Im2col(args, input_data, pixel, pixel_count, pad_value, rows);
+    GemmInt8(params, output_multiplier, output_shift, accumulator_init, args,
+             rows, pixel_count, filter_data,
+             output_data + pixel * args.output_depth);
+  }
+}
+
+void ConvGemm(const ConvParams& params, const RuntimeShape& input_shape,
+              const float* input_data, const RuntimeShape& filter_shape,
+              const float* filter_data, const float* bias_data,
+              const RuntimeShape& output_shape, float* output_data,
+              void* scratch) {
+  TFLITE_DCHECK(ConvGemmSupported(input_shape, filter_shape, output_shape));
+  const ConvGemmArgs args =
+      MakeArgs(params, input_shape, filter_shape, output_shape);
+  const int output_pixels =
+      MatchingDim(input_shape, 0, output_shape, 0) * args.output_height *
+      args.output_width;
+  const int tile_pixels = TilePixels(filter_shape, output_shape, sizeof(float));
+  float* rows = static_cast<float*>(scratch);
+
+  for (int pixel = 0; pixel < output_pixels; pixel += tile_pixels) {
+    const int pixel_count = std::min(tile_pixels, output_pixels - pixel);
+    Im2col(args, input_data, pixel, pixel_count, 0.0f, rows);
+    GemmFloat(params, bias_data, args, rows, pixel_count, filter_data,
+              output_data + pixel * args.output_depth);
+  }
+}
+
+}  // namespace tflite
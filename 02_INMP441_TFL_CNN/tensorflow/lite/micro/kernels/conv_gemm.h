@@ -0,0 +1,95 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_CONV_GEMM_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_CONV_GEMM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Convolution as im2col followed by a blocked matrix multiplication, for
+// layers with many input channels such as the 3x3x16 layers of a spectrogram
+// CNN. The output pixels are processed in tiles. The filter windows of a tile
+// are copied into a scratch buffer, one row of
+// filter_height * filter_width * input_depth values per pixel, which is then
+// multiplied with the filter, whose OHWI layout already stores each output
+// channel as such a row. Every inner loop computes two pixels by four output
+// channels; the int8 loops are simd::DotProduct2x4Int8.
+//
+// ConvPerChannelGemm produces exactly the same output as
+// reference_integer_ops::ConvPerChannel. ConvGemm adds the products in the
+// same (y, x, channel) order as reference_ops::Conv.
+
+// Size of the im2col tile, which stays in internal RAM (and in the L1 data
+// cache on targets that have one) next to the filter rows. Every pixel block
+// reads all filter rows, so larger tiles only batch more copies: on the
+// INMP441 CNN a 4 KB tile is no faster, but raises the arena head by 4 KB.
+// A tile holds at least one pixel block.
+constexpr int kConvGemmIm2colTileBytes = 1024;
+
+// The reference kernels are kept for shallower inputs, where copying the
+// windows costs more than the blocking saves.
+constexpr int kConvGemmMinInputDepth = 4;
+
+// Returns true if the GEMM kernels support a convolution with these shapes:
+// 4D tensors and no grouping.
+bool ConvGemmSupported(const RuntimeShape& input_shape,
+                       const RuntimeShape& filter_shape,
+                       const RuntimeShape& output_shape);
+
+// Returns true if a supported convolution is expected to run faster with the
+// GEMM kernels than with the reference kernels.
+bool ConvGemmPreferred(const RuntimeShape& input_shape);
+
+// Bytes of scratch memory the kernels need for elements of element_size
+// bytes (sizeof(int8_t) or sizeof(float)).
+size_t ConvGemmScratchSize(const RuntimeShape& filter_shape,
+                           const RuntimeShape& output_shape,
+                           size_t element_size);
+
+// Fills accumulator_init[0 .. output_depth) with
+// bias + input_offset * sum(filter), the start value of each output channel
+// of ConvPerChannelGemm. bias_data may be null.
+void ConvGemmPrepareAccumulators(const ConvParams& params,
+                                 const RuntimeShape& filter_shape,
+                                 const int8_t* filter_data,
+                                 const int32_t* bias_data,
+                                 int32_t* accumulator_init);
+
+void ConvPerChannelGemm(const ConvParams& params,
+                        const int32_t* output_multiplier,
+                        const int32_t* output_shift,
+                        const int32_t* accumulator_init,
+                        const RuntimeShape& input_shape,
+                        const int8_t* input_data,
+                        const RuntimeShape& filter_shape,
+                        const int8_t* filter_data,
+                        const RuntimeShape& output_shape, int8_t* output_data,
+                        void* scratch);
+
+// bias_data may be null.
+void ConvGemm(const ConvParams& params, const RuntimeShape& input_shape,
+              const float* input_data, const RuntimeShape& filter_shape,
+              const float* filter_data, const float* bias_data,
+              const RuntimeShape& output_shape, float* output_data,
+              void* scratch);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_CONV_GEMM_H_
@@ -0,0 +1,429 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/conv_max_pool.h"
+
+#include <algorithm>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/reference/conv.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
+#include "tensorflow/lite/kernels/internal/reference/pooling.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/kernels/padding.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/conv_gemm.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/pooling_simd.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+/*
+ * The CONV_2D_MAX_POOL_2D custom operator is a CONV_2D followed by a
+ * MAX_POOL_2D that reads nothing but the convolution output. It is created
+ * offline by fuse_conv_max_pool in tools/model_transforms_utils.py.
+ *
+ * The unfused pair keeps the whole convolution output in the arena, although
+ * pooling reduces it right away: a 2x2 pool discards three quarters of it.
+ * This operator instead computes, for each row of pooled output, the
+ * convolution rows under that row's pooling windows into a scratch band, and
+ * pools the band into the output. The band holds pool_filter_height rows of
+ * the convolution output.
+ *
+ * The rows are computed with the kernels CONV_2D selects for the same
+ * convolution, on a view of the input that starts at the first input row they
+ * read, and pooled with the kernels MAX_POOL_2D uses, so the output is
+ * exactly that of the unfused pair. When the pooling windows overlap in
+ * height, the shared convolution rows are computed once per window.
+ *
+ * Inputs: input, filter and optional bias, as for CONV_2D.
+ * Output: the output of MAX_POOL_2D, which shares the quantization of the
+ * convolution output.
+ * Supported types: int8 input with int8 filter, and float32.
+ */
+namespace tflite {
+
+// Indices into the init flexbuffer's vector.
+// The parameter's name is in the comment that follows.
+// Elements in the vectors are ordered alphabetically by parameter name.
+const int kConvMaxPoolActivationIndex = 0;  // 'activation'
+const int kConvMaxPoolDilationHFactorIndex = 1;  // 'dilation_h_factor'
+const int kConvMaxPoolDilationWFactorIndex = 2;  // 'dilation_w_factor'
+const int kConvMaxPoolPaddingIndex = 3;  // 'padding'
+const int kConvMaxPoolPoolActivationIndex = 4;  // 'pool_activation'
+const int kConvMaxPoolPoolFilterHeightIndex = 5;  // 'pool_filter_height'
+const int kConvMaxPoolPoolFilterWidthIndex = 6;  // 'pool_filter_width'
+const int kConvMaxPoolPoolPaddingIndex = 7;  // 'pool_padding'
+const int kConvMaxPoolPoolStrideHIndex = 8;  // 'pool_stride_h'
+const int kConvMaxPoolPoolStrideWIndex = 9;  // 'pool_stride_w'
+const int kConvMaxPoolStrideHIndex = 10;  // 'stride_h'
+const int kConvMaxPoolStrideWIndex = 11;  // 'stride_w'
+
+namespace {
+
+// Padding of the schema: SAME = 0, VALID = 1.
+TfLitePadding ConvertPadding(int32_t padding) {
+  switch (padding) {
+    case 0:
+      return kTfLitePaddingSame;
+    case 1:
+      return kTfLitePaddingValid;
+    default:
+      return kTfLitePaddingUnknown;
+  }
+}
+
+// ActivationFunctionType of the schema, whose values match
+// TfLiteFusedActivation up to TANH and SIGN_BIT.
+TfLiteFusedActivation ConvertActivation(int32_t activation) {
+  switch (activation) {
+    case 1:
+      return kTfLiteActRelu;
+    case 2:
+      return kTfLiteActReluN1To1;
+    case 3:
+      return kTfLiteActRelu6;
+    case 4:
+      return kTfLiteActTanh;
+    case 5:
+      return kTfLiteActSignBit;
+    default:
+      return kTfLiteActNone;
+  }
+}
+
+RuntimeShape NhwcShape(int batches, int height, int width, int depth) {
+  const int32_t dims[] = {batches, height, width, depth};
+  return RuntimeShape(4, dims);
+}
+
+void* ConvMaxPoolInit(TfLiteContext* context, const char* buffer,
+                      size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  OpDataConvMaxPool* data = static_cast<OpDataConvMaxPool*>(
+      context->AllocatePersistentBuffer(context, sizeof(OpDataConvMaxPool)));
+
+  data->has_options = buffer != nullptr && length > 0;
+  if (data->has_options) {
+    const uint8_t* buffer_t = reinterpret_cast<const uint8_t*>(buffer);
+    tflite::FlexbufferWrapper wrapper(buffer_t, length);
+
+    TfLiteConvParams& conv = data->conv_params;
+    conv.padding =
+        ConvertPadding(wrapper.ElementAsInt32(kConvMaxPoolPaddingIndex));
+    conv.stride_width = wrapper.ElementAsInt32(kConvMaxPoolStrideWIndex);
+    conv.stride_height = wrapper.ElementAsInt32(kConvMaxPoolStrideHIndex);
+    conv.dilation_width_factor =
+        wrapper.ElementAsInt32(kConvMaxPoolDilationWFactorIndex);
+    conv.dilation_height_factor =
+        wrapper.ElementAsInt32(kConvMaxPoolDilationHFactorIndex);
+    conv.activation =
+        ConvertActivation(wrapper.ElementAsInt32(kConvMaxPoolActivationIndex));
+    conv.quantized_bias_type = kTfLiteNoType;
+
+    TfLitePoolParams& pool = data->pool_params;
+    pool.padding =
+        ConvertPadding(wrapper.ElementAsInt32(kConvMaxPoolPoolPaddingIndex));
+    pool.stride_width = wrapper.ElementAsInt32(kConvMaxPoolPoolStrideWIndex);
+    pool.stride_height = wrapper.ElementAsInt32(kConvMaxPoolPoolStrideHIndex);
+    pool.filter_width =
+        wrapper.ElementAsInt32(kConvMaxPoolPoolFilterWidthIndex);
+    pool.filter_height =
+        wrapper.ElementAsInt32(kConvMaxPoolPoolFilterHeightIndex);
+    pool.activation = ConvertActivation(
+        wrapper.ElementAsInt32(kConvMaxPoolPoolActivationIndex));
+  }
+  return data;
+}
+
+TfLiteStatus ConvMaxPoolPrepare(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpDataConvMaxPool* data = static_cast<OpDataConvMaxPool*>(node->user_data);
+  TF_LITE_ENSURE_MSG(context, data->has_options,
+                     "CONV_2D_MAX_POOL_2D needs its custom options.");
+  const TfLiteConvParams& conv_params = data->conv_params;
+  const TfLitePoolParams& pool_params = data->pool_params;
+  TF_LITE_ENSURE(context, conv_params.padding != kTfLitePaddingUnknown &&
+                              pool_params.padding != kTfLitePaddingUnknown);
+  TF_LITE_ENSURE(context, pool_params.stride_height > 0 &&
+                              pool_params.stride_width > 0 &&
+                              pool_params.filter_height > 0 &&
+                              pool_params.filter_width > 0);
+
+  TF_LITE_ENSURE_OK(context,
+                    ConvPrepare(context, node, conv_params, &data->conv));
+
+  MicroContext* micro_context = GetMicroContext(context);
+
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kConvInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* filter =
+      micro_context->AllocateTempInputTensor(node, kConvWeightsTensor);
+  TF_LITE_ENSURE(context, filter != nullptr);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kConvOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+
+  TF_LITE_ENSURE_MSG(
+      context,
+      (input->type == kTfLiteFloat32 && filter->type == kTfLiteFloat32) ||
+          (input->type == kTfLiteInt8 && filter->type == kTfLiteInt8),
+      "CONV_2D_MAX_POOL_2D supports int8 and float32 convolutions.");
+  TF_LITE_ENSURE_EQ(context, NumDimensions(input), 4);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(output), 4);
+
+  const int batches = SizeOfDimension(input, 0);
+  const int output_depth = SizeOfDimension(filter, 0);
+  ComputePaddingHeightWidth(
+      conv_params.stride_height, conv_params.stride_width,
+      conv_params.dilation_height_factor, conv_params.dilation_width_factor,
+      SizeOfDimension(input, 1), SizeOfDimension(input, 2),
+      SizeOfDimension(filter, 1), SizeOfDimension(filter, 2),
+      conv_params.padding, &data->conv_output_height,
+      &data->conv_output_width);
+
+  int pool_output_height, pool_output_width;
+  data->pool_padding = ComputePaddingHeightWidth(
+      pool_params.stride_height, pool_params.stride_width,
+      /*dilation_rate_height=*/1, /*dilation_rate_width=*/1,
+      data->conv_output_height, data->conv_output_width,
+      pool_params.filter_height, pool_params.filter_width, pool_params.padding,
+      &pool_output_height, &pool_output_width);
+  TF_LITE_ENSURE_EQ(context, SizeOfDimension(output, 0), batches);
+  TF_LITE_ENSURE_EQ(context, SizeOfDimension(output, 1), pool_output_height);
+  TF_LITE_ENSURE_EQ(context, SizeOfDimension(output, 2), pool_output_width);
+  TF_LITE_ENSURE_EQ(context, SizeOfDimension(output, 3), output_depth);
+
+  const RuntimeShape conv_output_shape =
+      NhwcShape(batches, data->conv_output_height, data->conv_output_width,
+                output_depth);
+  TF_LITE_ENSURE_OK(context, ConvPrepareConstantFilterKernel(
+                                 context, node, conv_params,
+                                 conv_output_shape, &data->conv));
+
+  if (input->type == kTfLiteFloat32) {
+    CalculateActivationRange(pool_params.activation,
+                             &data->pool_activation_min_f32,
+                             &data->pool_activation_max_f32);
+  } else {
+    TF_LITE_ENSURE_OK(context, CalculateActivationRangeQuantized(
+                                   context, pool_params.activation, output,
+                                   &data->pool_activation_min,
+                                   &data->pool_activation_max));
+  }
+
+  const int band_height =
+      std::min(pool_params.filter_height, data->conv_output_height);
+  TF_LITE_ENSURE_OK(
+      context, context->RequestScratchBufferInArena(
+                   context,
+                   band_height * data->conv_output_width * output_depth *
+                       TfLiteTypeGetSize(input->type),
+                   &data->band_scratch_index));
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+// Computes the convolution rows of band_shape with the kernel selected in
+// Prepare. input_shape and input_data start at the first input row they read.
+void ConvRows(TfLiteContext* context, const OpDataConv& data,
+              const ConvParams& params, const RuntimeShape& input_shape,
+              const int8_t* input_data, const RuntimeShape& filter_shape,
+              const int8_t* filter_data, const RuntimeShape& bias_shape,
+              const int32_t* bias_data, const RuntimeShape& band_shape,
+              int8_t* band_data) {
+  if (data.small_filter_channels != nullptr) {
+    ConvPerChannelSmallFilter(params, data.small_filter_channels, input_shape,
+                              input_data, filter_shape, filter_data,
+                              band_shape, band_data);
+  } else if (data.im2col_scratch_index != -1) {
+    ConvPerChannelGemm(
+        params, data.per_channel_output_multiplier,
+        data.per_channel_output_shift, data.gemm_accumulator_init,
+        input_shape, input_data, filter_shape, filter_data, band_shape,
+        band_data,
+        context->GetScratchBuffer(context, data.im2col_scratch_index));
+  } else {
+    reference_integer_ops::ConvPerChannel(
+        params, data.per_channel_output_multiplier,
+        data.per_channel_output_shift, input_shape, input_data, filter_shape,
+        filter_data, bias_shape, bias_data, band_shape, band_data);
+  }
+}
+
+void ConvRows(TfLiteContext* context, const OpDataConv& data,
+              const ConvParams& params, const RuntimeShape& input_shape,
+              const float* input_data, const RuntimeShape& filter_shape,
+              const float* filter_data, const RuntimeShape& bias_shape,
+              const float* bias_data, const RuntimeShape& band_shape,
+              float* band_data) {
+  if (data.im2col_scratch_index != -1) {
+    ConvGemm(params, input_shape, input_data, filter_shape, filter_data,
+             bias_data, band_shape, band_data,
+             context->GetScratchBuffer(context, data.im2col_scratch_index));
+  } else {
+    reference_ops::Conv(params, input_shape, input_data, filter_shape,
+                        filter_data, bias_shape, bias_data, band_shape,
+                        band_data, RuntimeShape(), nullptr);
+  }
+}
+
+void MaxPoolRow(const PoolParams& params, const RuntimeShape& band_shape,
+                const int8_t* band_data, const RuntimeShape& output_shape,
+                int8_t* output_data) {
+  MaxPoolSimd(params, band_shape, band_data, output_shape, output_data);
+}
+
+void MaxPoolRow(const PoolParams& params, const RuntimeShape& band_shape,
+                const float* band_data, const RuntimeShape& output_shape,
+                float* output_data) {
+  reference_ops::MaxPool(params, band_shape, band_data, output_shape,
+                         output_data);
+}
+
+template <typename T, typename BiasT>
+void EvalConvMaxPool(TfLiteContext* context, TfLiteNode* node,
+                     const OpDataConvMaxPool& data,
+                     const ConvParams& conv_params,
+                     const TfLiteEvalTensor* input,
+                     const TfLiteEvalTensor* filter,
+                     const TfLiteEvalTensor* bias, TfLiteEvalTensor* output) {
+  const RuntimeShape input_shape = tflite::micro::GetTensorShape(input);
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const RuntimeShape bias_shape = tflite::micro::GetTensorShape(bias);
+  const RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
+  const T* input_data = tflite::micro::GetTensorData<T>(input);
+#ifdef USE_TFLM_COMPRESSION
+  // Compressed weights are decompressed once for all the bands.
+  MicroContext* micro_context = GetMicroContext(context);
+  const T* filter_data = tflite::micro::GetTensorData<T>(
+      micro_context, filter,
+      micro_context->GetTensorCompressionData(node, kConvWeightsTensor),
+      data.conv.weights_scratch_index);
+  const BiasT* bias_data = tflite::micro::GetOptionalTensorData<BiasT>(
+      micro_context, bias,
+      micro_context->GetTensorCompressionData(node, kConvBiasTensor),
+      data.conv.bias_scratch_index);
+#else   // USE_TFLM_COMPRESSION
+  const T* filter_data = tflite::micro::GetTensorData<T>(filter);
+  const BiasT* bias_data = tflite::micro::GetOptionalTensorData<BiasT>(bias);
+#endif  // USE_TFLM_COMPRESSION
+  T* output_data = tflite::micro::GetTensorData<T>(output);
+  T* band_data = static_cast<T*>(
+      context->GetScratchBuffer(context, data.band_scratch_index));
+
+  const int batches = input_shape.Dims(0);
+  const int input_height = input_shape.Dims(1);
+  const int input_row_size = input_shape.Dims(2) * input_shape.Dims(3);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int depth = output_shape.Dims(3);
+  const TfLiteConvParams& conv = data.conv_params;
+  const TfLitePoolParams& pool = data.pool_params;
+
+  PoolParams pool_params;
+  pool_params.stride_height = pool.stride_height;
+  pool_params.stride_width = pool.stride_width;
+  pool_params.filter_height = pool.filter_height;
+  pool_params.filter_width = pool.filter_width;
+  pool_params.padding_values.width = data.pool_padding.width;
+  pool_params.quantized_activation_min = data.pool_activation_min;
+  pool_params.quantized_activation_max = data.pool_activation_max;
+  pool_params.float_activation_min = data.pool_activation_min_f32;
+  pool_params.float_activation_max = data.pool_activation_max_f32;
+  const RuntimeShape output_row_shape = NhwcShape(1, 1, output_width, depth);
+
+  ConvParams band_params = conv_params;
+  for (int batch = 0; batch < batches; ++batch) {
+    const T* batch_input = input_data + batch * input_height * input_row_size;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      // Convolution rows [band_begin, band_end) under this pooling row.
+      const int window_y =
+          out_y * pool.stride_height - data.pool_padding.height;
+      const int band_begin = std::max(window_y, 0);
+      const int band_end =
+          std::min(window_y + pool.filter_height, data.conv_output_height);
+
+      // The first input row the band reads, clamped to the input: the rows
+      // above it become the band's top padding.
+      const int input_y = band_begin * conv.stride_height -
+                          conv_params.padding_values.height;
+      const int input_begin = std::max(input_y, 0);
+      band_params.padding_values.height = input_begin - input_y;
+      const RuntimeShape band_input_shape =
+          NhwcShape(1, input_height - input_begin, input_shape.Dims(2),
+                    input_shape.Dims(3));
+      const RuntimeShape band_shape =
+          NhwcShape(1, band_end - band_begin, data.conv_output_width, depth);
+      ConvRows(context, data.conv, band_params, band_input_shape,
+               batch_input + input_begin * input_row_size, filter_shape,
+               filter_data, bias_shape, bias_data, band_shape, band_data);
+
+      pool_params.padding_values.height = band_begin - window_y;
+      MaxPoolRow(pool_params, band_shape, band_data, output_row_shape,
+                 output_data +
+                     (batch * output_height + out_y) * output_width * depth);
+    }
+  }
+}
+
+TfLiteStatus ConvMaxPoolEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data = *(static_cast<const OpDataConvMaxPool*>(node->user_data));
+
+  switch (input->type) {  // Filter and output types are checked in Prepare.
+    case kTfLiteFloat32:
+      EvalConvMaxPool<float, float>(
+          context, node, data, ConvParamsFloat(data.conv_params, data.conv),
+          input, filter, bias, output);
+      break;
+    case kTfLiteInt8:
+      EvalConvMaxPool<int8_t, int32_t>(
+          context, node, data,
+          ConvParamsQuantized(data.conv_params, data.conv), input, filter,
+          bias, output);
+      break;
+    default:
+      MicroPrintf("Type %s (%d) not supported.", TfLiteTypeGetName(input->type),
+                  input->type);
+      return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration Register_CONV_2D_MAX_POOL_2D() {
+  return tflite::micro::RegisterOp(ConvMaxPoolInit, ConvMaxPoolPrepare,
+                                   ConvMaxPoolEval);
+}
+
+}  // namespace tflite
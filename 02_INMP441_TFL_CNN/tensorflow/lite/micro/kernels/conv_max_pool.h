@@ -0,0 +1,65 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_CONV_MAX_POOL_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_CONV_MAX_POOL_H_
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/kernels/conv.h"
+
+namespace tflite {
+
+// Indices into the init flexbuffer's vector.
+// The parameter's name is in the comment that follows.
+// Elements in the vectors are ordered alphabetically by parameter name.
+// The values are those of the Conv2DOptions and Pool2DOptions of the fused
+// operators, with the Padding and ActivationFunctionType enums of the schema.
+extern const int kConvMaxPoolActivationIndex;  // 'activation'
+extern const int kConvMaxPoolDilationHFactorIndex;  // 'dilation_h_factor'
+extern const int kConvMaxPoolDilationWFactorIndex;  // 'dilation_w_factor'
+extern const int kConvMaxPoolPaddingIndex;  // 'padding'
+extern const int kConvMaxPoolPoolActivationIndex;  // 'pool_activation'
+extern const int kConvMaxPoolPoolFilterHeightIndex;  // 'pool_filter_height'
+extern const int kConvMaxPoolPoolFilterWidthIndex;  // 'pool_filter_width'
+extern const int kConvMaxPoolPoolPaddingIndex;  // 'pool_padding'
+extern const int kConvMaxPoolPoolStrideHIndex;  // 'pool_stride_h'
+extern const int kConvMaxPoolPoolStrideWIndex;  // 'pool_stride_w'
+extern const int kConvMaxPoolStrideHIndex;  // 'stride_h'
+extern const int kConvMaxPoolStrideWIndex;  // 'stride_w'
+
+struct OpDataConvMaxPool {
+  OpDataConv conv;
+  TfLiteConvParams conv_params;
+  TfLitePoolParams pool_params;
+  bool has_options;
+
+  // Size of the convolution output, which is never stored in full.
+  int conv_output_height;
+  int conv_output_width;
+
+  TfLitePaddingValues pool_padding;
+  int32_t pool_activation_min;
+  int32_t pool_activation_max;
+  float pool_activation_min_f32;
+  float pool_activation_max_f32;
+
+  // Scratch buffer holding the convolution rows of one pooling window.
+  int band_scratch_index;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_CONV_MAX_POOL_H_
@@ -0,0 +1,63 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// This file is generated. See:
+// third_party/tensorflow/lite/micro/kernels/test_data_generation/README.md
+
+#include "tensorflow/lite/micro/kernels/conv_max_pool_flexbuffers_generated_data.h"
+
+const int g_gen_data_size_conv_max_pool_same_relu = 210;
+const unsigned char g_gen_data_conv_max_pool_same_relu[] = {
+    0x61, 0x63, 0x74, 0x69, 0x76, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x00, 0x64,
+    0x69, 0x6c, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x68, 0x5f, 0x66, 0x61,
+    0x63, 0x74, 0x6f, 0x72, 0x00, 0x64, 0x69, 0x6c, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x5f, 0x77, 0x5f, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x00, 0x70,
+    0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f,
+    0x61, 0x63, 0x74, 0x69, 0x76, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x00, 0x70,
+    0x6f, 0x6f, 0x6c, 0x5f, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x5f, 0x68,
+    0x65, 0x69, 0x67, 0x68, 0x74, 0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x66,
+    0x69, 0x6c, 0x74, 0x65, 0x72, 0x5f, 0x77, 0x69, 0x64, 0x74, 0x68, 0x00,
+    0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67,
+    0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x73, 0x74, 0x72, 0x69, 0x64, 0x65,
+    0x5f, 0x68, 0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x73, 0x74, 0x72, 0x69,
+    0x64, 0x65, 0x5f, 0x77, 0x00, 0x73, 0x74, 0x72, 0x69, 0x64, 0x65, 0x5f,
+    0x68, 0x00, 0x73, 0x74, 0x72, 0x69, 0x64, 0x65, 0x5f, 0x77, 0x00, 0x0c,
+    0xa8, 0x9e, 0x8d, 0x7c, 0x75, 0x66, 0x54, 0x43, 0x37, 0x2a, 0x1d, 0x15,
+    0x0c, 0x01, 0x0c, 0x01, 0x01, 0x01, 0x00, 0x00, 0x02, 0x02, 0x00, 0x02,
+    0x02, 0x01, 0x01, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x18, 0x24, 0x01,
+};
+
+const int g_gen_data_size_conv_max_pool_valid_overlap = 210;
+const unsigned char g_gen_data_conv_max_pool_valid_overlap[] = {
+    0x61, 0x63, 0x74, 0x69, 0x76, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x00, 0x64,
+    0x69, 0x6c, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x68, 0x5f, 0x66, 0x61,
+    0x63, 0x74, 0x6f, 0x72, 0x00, 0x64, 0x69, 0x6c, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x5f, 0x77, 0x5f, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x00, 0x70,
+    0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f,
+    0x61, 0x63, 0x74, 0x69, 0x76, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x00, 0x70,
+    0x6f, 0x6f, 0x6c, 0x5f, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x5f, 0x68,
+    0x65, 0x69, 0x67, 0x68, 0x74, 0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x66,
+    0x69, 0x6c, 0x74, 0x65, 0x72, 0x5f, 0x77, 0x69, 0x64, 0x74, 0x68, 0x00,
+    0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67,
+    0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x73, 0x74, 0x72, 0x69, 0x64, 0x65,
+    0x5f, 0x68, 0x00, 0x70, 0x6f, 0x6f, 0x6c, 0x5f, 0x73, 0x74, 0x72, 0x69,
+    0x64, 0x65, 0x5f, 0x77, 0x00, 0x73, 0x74, 0x72, 0x69, 0x64, 0x65, 0x5f,
+    0x68, 0x00, 0x73, 0x74, 0x72, 0x69, 0x64, 0x65, 0x5f, 0x77, 0x00, 0x0c,
+    0xa8, 0x9e, 0x8d, 0x7c, 0x75, 0x66, 0x54, 0x43, 0x37, 0x2a, 0x1d, 0x15,
+    0x0c, 0x01, 0x0c, 0x00, 0x01, 0x01, 0x01, 0x03, 0x03, 0x03, 0x01, 0x02,
+    0x02, 0x02, 0x02, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x18, 0x24, 0x01,
+};
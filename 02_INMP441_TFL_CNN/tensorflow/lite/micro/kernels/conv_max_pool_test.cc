@@ -0,0 +1,348 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/kernels/conv_max_pool_flexbuffers_generated_data.h"
+#include "tensorflow/lite/micro/kernels/kernel_runner.h"
+#include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/test_helpers.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace tflite {
+namespace testing {
+namespace {
+
+constexpr int kMaxChannels = 16;
+
+// Options of g_gen_data_conv_max_pool_same_relu.
+const TfLiteConvParams kSameReluConvParams = {
+    kTfLitePaddingSame,  // padding
+    1,                   // stride_width
+    1,                   // stride_height
+    kTfLiteActRelu,      // activation
+    1,                   // dilation_width_factor
+    1,                   // dilation_height_factor
+    kTfLiteNoType        // quantized_bias_type
+};
+const TfLitePoolParams kSameReluPoolParams = {
+    kTfLitePaddingSame,  // padding
+    2,                   // stride_width
+    2,                   // stride_height
+    2,                   // filter_width
+    2,                   // filter_height
+    kTfLiteActNone,      // activation
+    {{0, 0, 0, 0}},      // computed
+};
+
+// Options of g_gen_data_conv_max_pool_valid_overlap.
+const TfLiteConvParams kValidOverlapConvParams = {
+    kTfLitePaddingValid,  // padding
+    2,                    // stride_width
+    2,                    // stride_height
+    kTfLiteActNone,       // activation
+    1,                    // dilation_width_factor
+    1,                    // dilation_height_factor
+    kTfLiteNoType         // quantized_bias_type
+};
+const TfLitePoolParams kValidOverlapPoolParams = {
+    kTfLitePaddingValid,  // padding
+    2,                    // stride_width
+    2,                    // stride_height
+    3,                    // filter_width
+    3,                    // filter_height
+    kTfLiteActRelu6,      // activation
+    {{0, 0, 0, 0}},       // computed
+};
+
+// Runs CONV_2D and MAX_POOL_2D on tensors[0..3] and tensors[3..4], and
+// CONV_2D_MAX_POOL_2D on tensors[0..2] and tensors[5]. Marks the filter and
+// bias as constant first if constant_weights is set.
+void InvokeUnfusedAndFused(TfLiteTensor* tensors, bool constant_weights,
+                           const TfLiteConvParams& conv_params,
+                           const TfLitePoolParams& pool_params,
+                           const unsigned char* init_data, int init_size) {
+  if (constant_weights) {
+    tensors[1].allocation_type = kTfLiteMmapRo;
+    tensors[2].allocation_type = kTfLiteMmapRo;
+  }
+
+  TfLiteConvParams conv_builtin_data = conv_params;
+  int conv_inputs_data[] = {3, 0, 1, 2};
+  int conv_outputs_data[] = {1, 3};
+  micro::KernelRunner conv_runner(
+      Register_CONV_2D(), tensors, 4, IntArrayFromInts(conv_inputs_data),
+      IntArrayFromInts(conv_outputs_data), &conv_builtin_data);
+  TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, conv_runner.InitAndPrepare());
+  TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, conv_runner.Invoke());
+
+  TfLitePoolParams pool_builtin_data = pool_params;
+  int pool_inputs_data[] = {1, 3};
+  int pool_outputs_data[] = {1, 4};
+  micro::KernelRunner pool_runner(
+      Register_MAX_POOL_2D(), tensors, 5, IntArrayFromInts(pool_inputs_data),
+      IntArrayFromInts(pool_outputs_data), &pool_builtin_data);
+  TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, pool_runner.InitAndPrepare());
+  TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, pool_runner.Invoke());
+
+  int fused_inputs_data[] = {3, 0, 1, 2};
+  int fused_outputs_data[] = {1, 5};
+  micro::KernelRunner fused_runner(
+      Register_CONV_2D_MAX_POOL_2D(), tensors, 6,
+      IntArrayFromInts(fused_inputs_data), IntArrayFromInts(fused_outputs_data),
+      /*builtin_data=*/nullptr);
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk, fused_runner.InitAndPrepare(
+                     reinterpret_cast<const char*>(init_data), init_size));
+  TF_LITE_MICRO_EXPECT_EQ(kTfLiteOk, fused_runner.Invoke());
+}
+
+// Checks that CONV_2D_MAX_POOL_2D is bit-exact with CONV_2D followed by
+// MAX_POOL_2D for an int8 convolution. filter_scales holds one scale per
+// output channel. The data is generated from the element indices.
+void TestConvMaxPoolInt8MatchesUnfused(
+    int* input_dims_data, int* filter_dims_data, int* conv_output_dims_data,
+    int* output_dims_data, bool constant_weights,
+    const TfLiteConvParams& conv_params, const TfLitePoolParams& pool_params,
+    const unsigned char* init_data, int init_size, int8_t* input_data,
+    int8_t* filter_data, int8_t* conv_output, int8_t* reference_output,
+    int8_t* output) {
+  TfLiteIntArray* input_dims = IntArrayFromInts(input_dims_data);
+  TfLiteIntArray* filter_dims = IntArrayFromInts(filter_dims_data);
+  TfLiteIntArray* conv_output_dims = IntArrayFromInts(conv_output_dims_data);
+  TfLiteIntArray* output_dims = IntArrayFromInts(output_dims_data);
+  const int output_channels = filter_dims->data[0];
+  TF_LITE_MICRO_EXPECT_LE(output_channels, kMaxChannels);
+
+  for (int i = 0; i < ElementCount(*input_dims); ++i) {
+    input_data[i] = static_cast<int8_t>((i * 37) % 256 - 128);
+  }
+  for (int i = 0; i < ElementCount(*filter_dims); ++i) {
+    filter_data[i] = static_cast<int8_t>((i * 53) % 255 - 127);
+  }
+  int32_t bias_data[kMaxChannels];
+  const float input_scale = 0.05f;
+  const int input_zero_point = 5;
+  const float output_scale = 0.1f;
+  const int output_zero_point = -20;
+
+  float input_scales[] = {1, input_scale};
+  int input_zero_points[] = {1, input_zero_point};
+  TfLiteAffineQuantization input_quant = {FloatArrayFromFloats(input_scales),
+                                          IntArrayFromInts(input_zero_points),
+                                          0};
+  float filter_scales[kMaxChannels + 1] = {};
+  float bias_scales[kMaxChannels + 1] = {};
+  int zero_points[kMaxChannels + 1] = {};
+  filter_scales[0] = output_channels;
+  bias_scales[0] = output_channels;
+  zero_points[0] = output_channels;
+  for (int i = 0; i < output_channels; ++i) {
+    filter_scales[i + 1] = 0.0002f * (i + 1);
+    bias_scales[i + 1] = input_scale * filter_scales[i + 1];
+    bias_data[i] = (i * 997) % 4000 - 2000;
+  }
+  TfLiteAffineQuantization filter_quant = {
+      FloatArrayFromFloats(filter_scales), IntArrayFromInts(zero_points), 0};
+  TfLiteAffineQuantization bias_quant = {FloatArrayFromFloats(bias_scales),
+                                         IntArrayFromInts(zero_points), 0};
+  float output_scales[] = {1, output_scale};
+  int output_zero_points[] = {1, output_zero_point};
+  TfLiteAffineQuantization output_quant = {FloatArrayFromFloats(output_scales),
+                                           IntArrayFromInts(output_zero_points),
+                                           0};
+  int bias_shape[] = {1, output_channels};
+
+  constexpr int tensors_size = 6;
+  TfLiteTensor tensors[tensors_size] = {
+      CreateTensor(input_data, input_dims),
+      CreateTensor(filter_data, filter_dims),
+      CreateTensor(bias_data, IntArrayFromInts(bias_shape)),
+      CreateTensor(conv_output, conv_output_dims),
+      CreateTensor(reference_output, output_dims),
+      CreateTensor(output, output_dims),
+  };
+  tensors[0].params = {input_scale, input_zero_point};
+  tensors[0].quantization = {kTfLiteAffineQuantization, &input_quant};
+  tensors[1].quantization = {kTfLiteAffineQuantization, &filter_quant};
+  tensors[2].quantization = {kTfLiteAffineQuantization, &bias_quant};
+  for (int i = 3; i < tensors_size; ++i) {
+    tensors[i].params = {output_scale, output_zero_point};
+    tensors[i].quantization = {kTfLiteAffineQuantization, &output_quant};
+  }
+
+  InvokeUnfusedAndFused(tensors, constant_weights, conv_params, pool_params,
+                        init_data, init_size);
+
+  for (int i = 0; i < ElementCount(*output_dims); ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(reference_output[i], output[i]);
+  }
+}
+
+// Float counterpart of TestConvMaxPoolInt8MatchesUnfused. Both operators use
+// the same convolution kernel, so the outputs are bit-exact too.
+void TestConvMaxPoolFloatMatchesUnfused(
+    int* input_dims_data, int* filter_dims_data, int* conv_output_dims_data,
+    int* output_dims_data, bool constant_weights,
+    const TfLiteConvParams& conv_params, const TfLitePoolParams& pool_params,
+    const unsigned char* init_data, int init_size, float* input_data,
+    float* filter_data, float* conv_output, float* reference_output,
+    float* output) {
+  TfLiteIntArray* input_dims = IntArrayFromInts(input_dims_data);
+  TfLiteIntArray* filter_dims = IntArrayFromInts(filter_dims_data);
+  TfLiteIntArray* conv_output_dims = IntArrayFromInts(conv_output_dims_data);
+  TfLiteIntArray* output_dims = IntArrayFromInts(output_dims_data);
+  const int output_channels = filter_dims->data[0];
+  TF_LITE_MICRO_EXPECT_LE(output_channels, kMaxChannels);
+
+  for (int i = 0; i < ElementCount(*input_dims); ++i) {
+    input_data[i] = ((i * 37) % 256 - 128) / 64.0f;
+  }
+  for (int i = 0; i < ElementCount(*filter_dims); ++i) {
+    filter_data[i] = ((i * 53) % 255 - 127) / 512.0f;
+  }
+  float bias_data[kMaxChannels];
+  for (int i = 0; i < output_channels; ++i) {
+    bias_data[i] = ((i * 997) % 4000 - 2000) / 1000.0f;
+  }
+  int bias_shape[] = {1, output_channels};
+
+  constexpr int tensors_size = 6;
+  TfLiteTensor tensors[tensors_size] = {
+      CreateTensor(input_data, input_dims),
+      CreateTensor(filter_data, filter_dims),
+      CreateTensor(bias_data, IntArrayFromInts(bias_shape)),
+      CreateTensor(conv_output, conv_output_dims),
+      CreateTensor(reference_output, output_dims),
+      CreateTensor(output, output_dims),
+  };
+
+  InvokeUnfusedAndFused(tensors, constant_weights, conv_params, pool_params,
+                        init_data, init_size);
+
+  for (int i = 0; i < ElementCount(*output_dims); ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(reference_output[i], output[i]);
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace tflite
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+// The first layer of the INMP441 speech CNN, on an odd sized spectrogram patch
+// whose last pooling row and column only cover one convolution row or column.
+// The constant filter selects ConvPerChannelSmallFilter.
+TF_LITE_MICRO_TEST(Int8SmallFilterSameReluPool2x2MatchesUnfused) {
+  int input_shape[] = {4, 1, 11, 9, 1};
+  int filter_shape[] = {4, 16, 3, 3, 1};
+  int conv_output_shape[] = {4, 1, 11, 9, 16};
+  int output_shape[] = {4, 1, 6, 5, 16};
+  int8_t input[11 * 9];
+  int8_t filter[16 * 3 * 3];
+  int8_t conv_output[11 * 9 * 16];
+  int8_t reference_output[6 * 5 * 16];
+  int8_t output[6 * 5 * 16];
+  tflite::testing::TestConvMaxPoolInt8MatchesUnfused(
+      input_shape, filter_shape, conv_output_shape, output_shape,
+      /*constant_weights=*/true, tflite::testing::kSameReluConvParams,
+      tflite::testing::kSameReluPoolParams,
+      g_gen_data_conv_max_pool_same_relu,
+      g_gen_data_size_conv_max_pool_same_relu, input, filter, conv_output,
+      reference_output, output);
+}
+
+// The third layer's shapes, 16 to 8 channels, which select ConvPerChannelGemm.
+TF_LITE_MICRO_TEST(Int8GemmSameReluPool2x2MatchesUnfused) {
+  int input_shape[] = {4, 1, 9, 7, 16};
+  int filter_shape[] = {4, 8, 3, 3, 16};
+  int conv_output_shape[] = {4, 1, 9, 7, 8};
+  int output_shape[] = {4, 1, 5, 4, 8};
+  int8_t input[9 * 7 * 16];
+  int8_t filter[8 * 3 * 3 * 16];
+  int8_t conv_output[9 * 7 * 8];
+  int8_t reference_output[5 * 4 * 8];
+  int8_t output[5 * 4 * 8];
+  tflite::testing::TestConvMaxPoolInt8MatchesUnfused(
+      input_shape, filter_shape, conv_output_shape, output_shape,
+      /*constant_weights=*/true, tflite::testing::kSameReluConvParams,
+      tflite::testing::kSameReluPoolParams,
+      g_gen_data_conv_max_pool_same_relu,
+      g_gen_data_size_conv_max_pool_same_relu, input, filter, conv_output,
+      reference_output, output);
+}
+
+// Non-constant weights use reference_integer_ops::ConvPerChannel. A strided
+// 'valid' convolution with overlapping pooling windows, a pool activation and
+// two batches.
+TF_LITE_MICRO_TEST(Int8ReferenceValidOverlappingPoolMatchesUnfused) {
+  int input_shape[] = {4, 2, 13, 11, 3};
+  int filter_shape[] = {4, 4, 3, 3, 3};
+  int conv_output_shape[] = {4, 2, 6, 5, 4};
+  int output_shape[] = {4, 2, 2, 2, 4};
+  int8_t input[2 * 13 * 11 * 3];
+  int8_t filter[4 * 3 * 3 * 3];
+  int8_t conv_output[2 * 6 * 5 * 4];
+  int8_t reference_output[2 * 2 * 2 * 4];
+  int8_t output[2 * 2 * 2 * 4];
+  tflite::testing::TestConvMaxPoolInt8MatchesUnfused(
+      input_shape, filter_shape, conv_output_shape, output_shape,
+      /*constant_weights=*/false, tflite::testing::kValidOverlapConvParams,
+      tflite::testing::kValidOverlapPoolParams,
+      g_gen_data_conv_max_pool_valid_overlap,
+      g_gen_data_size_conv_max_pool_valid_overlap, input, filter, conv_output,
+      reference_output, output);
+}
+
+TF_LITE_MICRO_TEST(FloatGemmSameReluPool2x2MatchesUnfused) {
+  int input_shape[] = {4, 1, 9, 7, 16};
+  int filter_shape[] = {4, 6, 3, 3, 16};
+  int conv_output_shape[] = {4, 1, 9, 7, 6};
+  int output_shape[] = {4, 1, 5, 4, 6};
+  float input[9 * 7 * 16];
+  float filter[6 * 3 * 3 * 16];
+  float conv_output[9 * 7 * 6];
+  float reference_output[5 * 4 * 6];
+  float output[5 * 4 * 6];
+  tflite::testing::TestConvMaxPoolFloatMatchesUnfused(
+      input_shape, filter_shape, conv_output_shape, output_shape,
+      /*constant_weights=*/true, tflite::testing::kSameReluConvParams,
+      tflite::testing::kSameReluPoolParams,
+      g_gen_data_conv_max_pool_same_relu,
+      g_gen_data_size_conv_max_pool_same_relu, input, filter, conv_output,
+      reference_output, output);
+}
+
+TF_LITE_MICRO_TEST(FloatReferenceValidOverlappingPoolMatchesUnfused) {
+  int input_shape[] = {4, 2, 13, 11, 3};
+  int filter_shape[] = {4, 4, 3, 3, 3};
+  int conv_output_shape[] = {4, 2, 6, 5, 4};
+  int output_shape[] = {4, 2, 2, 2, 4};
+  float input[2 * 13 * 11 * 3];
+  float filter[4 * 3 * 3 * 3];
+  float conv_output[2 * 6 * 5 * 4];
+  float reference_output[2 * 2 * 2 * 4];
+  float output[2 * 2 * 2 * 4];
+  tflite::testing::TestConvMaxPoolFloatMatchesUnfused(
+      input_shape, filter_shape, conv_output_shape, output_shape,
+      /*constant_weights=*/false, tflite::testing::kValidOverlapConvParams,
+      tflite::testing::kValidOverlapPoolParams,
+      g_gen_data_conv_max_pool_valid_overlap,
+      g_gen_data_size_conv_max_pool_valid_overlap, input, filter, conv_output,
+      reference_output, output);
+}
+
+TF_LITE_MICRO_TESTS_END
@@ -0,0 +1,295 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/conv_small_filter.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+namespace {
+
+struct SmallFilterArgs {
+  int input_height;
+  int input_width;
+  int input_depth;
+  int filter_height;
+  int filter_width;
+  int patch_size;
+  int output_depth;
+  int32_t input_offset;
+  int32_t output_offset;
+  int32_t output_activation_min;
+  int32_t output_activation_max;
+  const ConvSmallFilterChannel* channels;
+  const int8_t* filter_data;
+};
+
+// Computes the range [*begin, *end) of output coordinates along one axis whose
+// filter window [out * stride - pad, out * stride - pad + filter_size) lies
+// inside [0, input_size).
+void InteriorRange(int input_size, int filter_size, int stride, int pad,
+                   int output_size, int* begin, int* end) {
+  *begin = std::min(output_size, (pad + stride - 1) / stride);
+  const int last_origin = input_size - filter_size + pad;
+  *end = last_origin < 0 ? 0 : std::min(output_size, last_origin / stride + 1);
+  *end = std::max(*begin, *end);
+}
+
+inline int8_t Requantize(const SmallFilterArgs& args,
+                         const ConvSmallFilterChannel& channel, int32_t acc) {
+  acc = MultiplyByQuantizedMultiplier(acc, channel.output_multiplier,
+                                      channel.output_shift);
+  acc += args.output_offset;
+  acc = std::max(acc, args.output_activation_min);
+  acc = std::min(acc, args.output_activation_max);
+  return static_cast<int8_t>(acc);
+}
+
+// Evaluates all output channels of one pixel whose filter window crosses the
+// input edge. Taps in the padding are omitted, as in the reference kernel.
+void BorderPixel(const SmallFilterArgs& args, const int8_t* input,
+                 int in_y_origin, int in_x_origin, int8_t* output) {
+  const int filter_y_begin = std::max(0, -in_y_origin);
+  const int filter_y_end =
+      std::min(args.filter_height, args.input_height - in_y_origin);
+  const int filter_x_begin = std::max(0, -in_x_origin);
+  const int filter_x_end =
+      std::min(args.filter_width, args.input_width - in_x_origin);
+
+  for (int out_channel = 0; out_channel < args.output_depth; ++out_channel) {
+    const int8_t* filter = args.filter_data + out_channel * args.patch_size;
+    int32_t acc = args.channels[out_channel].border_bias;
+    for (int filter_y = filter_y_begin; filter_y < filter_y_end; ++filter_y) {
+      for (int filter_x = filter_x_begin; filter_x < filter_x_end;
+           ++filter_x) {
+        const int8_t* in =
+            input + ((in_y_origin + filter_y) * args.input_width +
+                     in_x_origin + filter_x) *
+                        args.input_depth;
+        const int8_t* f =
+            filter + (filter_y * args.filter_width + filter_x) *
+                         args.input_depth;
+        for (int in_channel = 0; in_channel < args.input_depth;
+             ++in_channel) {
+          acc += f[in_channel] * (in[in_channel] + args.input_offset);
+        }
+      }
+    }
+    output[out_channel] = Requantize(args, args.channels[out_channel], acc);
+  }
+}
+
+// Copies the filter window at (in_y, in_x) in filter (y, x, channel) order.
+inline void GatherPatch(const SmallFilterArgs& args, const int8_t* input,
+                        int in_y, int in_x, int16_t* patch) {
+  const int row_size = args.filter_width * args.input_depth;
+  for (int filter_y = 0; filter_y < args.filter_height; ++filter_y) {
+    const int8_t* in =
+        input + ((in_y + filter_y) * args.input_width + in_x) * args.input_depth;
+    for (int i = 0; i < row_size; ++i) {
+      *patch++ = in[i];
+    }
+  }
+}
+
+// Evaluates all output channels of two interior pixels. The 2x2 block of
+// accumulators lets every filter and input value loaded in the inner loop be
+// used twice. A single pixel is handled by passing it as both pixels.
+void InteriorPixelPair(const SmallFilterArgs& args, const int16_t* patch0,
+                       const int16_t* patch1, int8_t* output0,
+                       int8_t* output1) {
+  const int patch_size = args.patch_size;
+  int out_channel = 0;
+  for (; out_channel + 1 < args.output_depth; out_channel += 2) {
+    const ConvSmallFilterChannel& channel0 = args.channels[out_channel];
+    const ConvSmallFilterChannel& channel1 = args.channels[out_channel + 1];
+    const int8_t* filter0 = args.filter_data + out_channel * patch_size;
+    const int8_t* filter1 = filter0 + patch_size;
+    int32_t acc00 = channel0.interior_bias;
+    int32_t acc01 = channel0.interior_bias;
+    int32_t acc10 = channel1.interior_bias;
+    int32_t acc11 = channel1.interior_bias;
+    for (int i = 0; i < patch_size; ++i) {
+      const int32_t in0 = patch0[i];
+      const int32_t in1 = patch1[i];
+      const int32_t f0 = filter0[i];
+      const int32_t f1 = filter1[i];
+      acc00 += f0 * in0;
+      acc01 += f0 * in1;
+      acc10 += f1 * in0;
+      acc11 += f1 * in1;
+    }
+    output0[out_channel] = Requantize(args, channel0, acc00);
+    output1[out_channel] = Requantize(args, channel0, acc01);
+    output0[out_channel + 1] = Requantize(args, channel1, acc10);
+    output1[out_channel + 1] = Requantize(args, channel1, acc11);
+  }
+  if (out_channel < args.output_depth) {
+    const ConvSmallFilterChannel& channel = args.channels[out_channel];
+    const int8_t* filter = args.filter_data + out_channel * patch_size;
+    int32_t acc0 = channel.interior_bias;
+    int32_t acc1 = channel.interior_bias;
+    for (int i = 0; i < patch_size; ++i) {
+      const int32_t f = filter[i];
+      acc0 += f * patch0[i];
+      acc1 += f * patch1[i];
+    }
+    output0[out_channel] = Requantize(args, channel, acc0);
+    output1[out_channel] = Requantize(args, channel, acc1);
+  }
+}
+
+}  // namespace
+
+bool ConvSmallFilterSupported(const ConvParams& params,
+                              const RuntimeShape& input_shape,
+                              const RuntimeShape& filter_shape,
+                              const RuntimeShape& output_shape) {
+  if (input_shape.DimensionsCount() != 4 ||
+      filter_shape.DimensionsCount() != 4 ||
+      output_shape.DimensionsCount() != 4) {
+    return false;
+  }
+  if (params.dilation_height_factor != 1 ||
+      params.dilation_width_factor != 1) {
+    return false;
+  }
+  // Grouped convolutions are left to the reference kernel.
+  if (filter_shape.Dims(3) != input_shape.Dims(3)) {
+    return false;
+  }
+  return filter_shape.Dims(1) * filter_shape.Dims(2) * filter_shape.Dims(3) <=
+         kConvSmallFilterMaxPatchSize;
+}
+
+void ConvSmallFilterPrepareChannels(const ConvParams& params,
+                                    const int32_t* output_multiplier,
+                                    const int32_t* output_shift,
+                                    const RuntimeShape& filter_shape,
+                                    const int8_t* filter_data,
+                                    const int32_t* bias_data,
+                                    ConvSmallFilterChannel* channels) {
+  const int output_depth = filter_shape.Dims(0);
+  const int patch_size =
+      filter_shape.Dims(1) * filter_shape.Dims(2) * filter_shape.Dims(3);
+  for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+    const int8_t* filter = filter_data + out_channel * patch_size;
+    int32_t filter_sum = 0;
+    for (int i = 0; i < patch_size; ++i) {
+      filter_sum += filter[i];
+    }
+    const int32_t bias = bias_data != nullptr ? bias_data[out_channel] : 0;
+    ConvSmallFilterChannel& channel = channels[out_channel];
+    channel.interior_bias = bias + params.input_offset * filter_sum;
+    channel.border_bias = bias;
+    channel.output_multiplier = output_multiplier[out_channel];
+    channel.output_shift = output_shift[out_channel];
+  }
+}
+
+void ConvPerChannelSmallFilter(const ConvParams& params,
+                               const ConvSmallFilterChannel* channels,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& filter_shape,
+                               const int8_t* filter_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data) {
+  const int stride_width = params.stride_width;
+  const int stride_height = params.stride_height;
+  const int pad_width = params.padding_values.width;
+  const int pad_height = params.padding_values.height;
+
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK(
+      ConvSmallFilterSupported(params, input_shape, filter_shape, output_shape));
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+
+  SmallFilterArgs args;
+  args.input_height = input_shape.Dims(1);
+  args.input_width = input_shape.Dims(2);
+  args.input_depth = input_shape.Dims(3);
+  args.filter_height = filter_shape.Dims(1);
+  args.filter_width = filter_shape.Dims(2);
+  args.patch_size = args.filter_height * args.filter_width * args.input_depth;
+  args.output_depth = MatchingDim(filter_shape, 0, output_shape, 3);
+  args.input_offset = params.input_offset;
+  args.output_offset = params.output_offset;
+  args.output_activation_min = params.quantized_activation_min;
+  args.output_activation_max = params.quantized_activation_max;
+  args.channels = channels;
+  args.filter_data = filter_data;
+
+  int interior_y_begin, interior_y_end;
+  InteriorRange(args.input_height, args.filter_height, stride_height,
+                pad_height, output_height, &interior_y_begin, &interior_y_end);
+  int interior_x_begin, interior_x_end;
+  InteriorRange(args.input_width, args.filter_width, stride_width, pad_width,
+                output_width, &interior_x_begin, &interior_x_end);
+
+  const int input_batch_size =
+      args.input_height * args.input_width * args.input_depth;
+  const int output_row_size = output_width * args.output_depth;
+  int16_t patch0[kConvSmallFilterMaxPatchSize];
+  int16_t patch1[kConvSmallFilterMaxPatchSize];
+
+  for (int batch = 0; batch < batches; ++batch) {
+    const int8_t* input = input_data + batch * input_batch_size;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      const int in_y_origin = (out_y * stride_height) - pad_height;
+      int8_t* output =
+          output_data + (batch * output_height + out_y) * output_row_size;
+      const bool interior_row =
+          out_y >= interior_y_begin && out_y < interior_y_end;
+      const int row_x_begin = interior_row ? interior_x_begin : output_width;
+      const int row_x_end = interior_row ? interior_x_end : output_width;
+
+      int out_x = 0;
+      for (; out_x < row_x_begin; ++out_x) {
+        BorderPixel(args, input, in_y_origin, out_x * stride_width - pad_width,
+                    output + out_x * args.output_depth);
+      }
+      for (; out_x + 1 < row_x_end; out_x += 2) {
+        const int in_x_origin = out_x * stride_width - pad_width;
+        GatherPatch(args, input, in_y_origin, in_x_origin, patch0);
+        GatherPatch(args, input, in_y_origin, in_x_origin + stride_width,
+                    patch1);
+        InteriorPixelPair(args, patch0, patch1,
+                          output + out_x * args.output_depth,
+                          output + (out_x + 1) * args.output_depth);
+      }
+      if (out_x < row_x_end) {
+        GatherPatch(args, input, in_y_origin, out_x * stride_width - pad_width,
+                    patch0);
+        int8_t* pixel_output = output + out_x * args.output_depth;
+        InteriorPixelPair(args, patch0, patch0, pixel_output, pixel_output);
+        ++out_x;
+      }
+      for (; out_x < output_width; ++out_x) {
+        BorderPixel(args, input, in_y_origin, out_x * stride_width - pad_width,
+                    output + out_x * args.output_depth);
+      }
+    }
+  }
+}
+
+}  // namespace tflite
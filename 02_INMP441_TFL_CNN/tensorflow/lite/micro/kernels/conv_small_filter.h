@@ -0,0 +1,82 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_CONV_SMALL_FILTER_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_CONV_SMALL_FILTER_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Int8 convolution for filters with a small receptive field
+// (filter_height * filter_width * input_depth), such as the 3x3x1 first layer
+// of a spectrogram CNN. It produces exactly the same output as
+// reference_integer_ops::ConvPerChannel, but
+//  - splits the output into an interior, where the whole filter window lies
+//    inside the input and no bounds checks are needed, and a border, which is
+//    evaluated like the reference kernel,
+//  - computes two output pixels by two output channels per inner loop so that
+//    each loaded input and filter value is used twice,
+//  - starts interior accumulators from a per-channel constant that already
+//    contains the bias and the input zero point contribution.
+
+// Largest filter_height * filter_width * input_depth handled by the kernel.
+constexpr int kConvSmallFilterMaxPatchSize = 32;
+
+// Per output channel constants, computed once in Prepare by
+// ConvSmallFilterPrepareChannels.
+struct ConvSmallFilterChannel {
+  // bias + input_offset * sum(filter). Accumulator start value for output
+  // pixels whose filter window lies entirely inside the input.
+  int32_t interior_bias;
+  // Accumulator start value for border pixels, where the taps that fall into
+  // the padding are skipped.
+  int32_t border_bias;
+  int32_t output_multiplier;
+  int32_t output_shift;
+};
+
+// Returns true if ConvPerChannelSmallFilter supports a convolution with these
+// parameters and shapes: no dilation, no grouping and a filter window of at
+// most kConvSmallFilterMaxPatchSize values.
+bool ConvSmallFilterSupported(const ConvParams& params,
+                              const RuntimeShape& input_shape,
+                              const RuntimeShape& filter_shape,
+                              const RuntimeShape& output_shape);
+
+// Fills channels[0 .. output_depth) from the constant filter and bias tensors.
+// bias_data may be null.
+void ConvSmallFilterPrepareChannels(const ConvParams& params,
+                                    const int32_t* output_multiplier,
+                                    const int32_t* output_shift,
+                                    const RuntimeShape& filter_shape,
+                                    const int8_t* filter_data,
+                                    const int32_t* bias_data,
+                                    ConvSmallFilterChannel* channels);
+
+void ConvPerChannelSmallFilter(const ConvParams& params,
+                               const ConvSmallFilterChannel* channels,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& filter_shape,
+                               const int8_t* filter_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_CONV_SMALL_FILTER_H_
@@ -130,6 +130,45 @@ static TfLiteConvParams common_conv_params_q1 = {
     kTfLiteNoType         // quantized_bias_type
 };
 
+// Compressed 3x3 filter over 4 input channels, which the reference CONV_2D
+// runs on the GEMM kernel: the filter is decompressed at Prepare for the
+// accumulators, and at Eval for the multiplies.
+static int kInputShapeGemm[] = {4, 1, 3, 4, 4};
+static const float kInputDataGemm[] = {
+    2,  1,  1,  2,  0,  1,  2,  -1, -2, -1, -1, 2,  2,  -2, 0,  2,
+    -2, 1,  -2, 0,  2,  -1, -1, -1, 1,  -1, 2,  0,  0,  0,  0,  0,
+    0,  2,  2,  1,  1,  1,  -1, 2,  0,  -1, 2,  -2, 2,  1,  -2, -2,
+};
+constexpr size_t kInputElementsGemm =
+    std::extent<decltype(kInputDataGemm)>::value;
+
+constexpr int kNumChannelsGemm = 2;
+static int kFilterShapeGemm[] = {4, 2, 3, 3, 4};
+// 3-bit indices into the value table of each output channel.
+alignas(16) constexpr uint8_t kBinQuantFilterDataGemm[] = {
+    0x40, 0x28, 0xA4, 0x8D, 0x22, 0x89, 0x80, 0x08, 0xE1,
+    0x65, 0x07, 0x18, 0x46, 0x40, 0x9B, 0x48, 0x22, 0x02,
+    0x49, 0x34, 0x52, 0x01, 0x14, 0x40, 0x2C, 0x94, 0xCA,
+};
+constexpr float kBinQuantFilterValueTableGemm[] = {
+    -2, -1, 0, 1, 2, 0, 0, 0, -1, -0.5, 0.5, 1.5, 0, 0, 0, 0,
+};
+constexpr size_t kBinQuantFilterValueTableElementsGemm =
+    std::extent<decltype(kBinQuantFilterValueTableGemm)>::value;
+constexpr int kBinQuantFilterBitWidthGemm = 3;
+
+static int kBiasShapeGemm[] = {1, 2};
+static const float kBiasDataGemm[] = {1, -2};
+constexpr size_t kBiasElementsGemm =
+    std::extent<decltype(kBiasDataGemm)>::value;
+alignas(16) constexpr uint8_t kBinQuantBiasDataGemm[] = {0x00};
+constexpr int kBinQuantBiasBitWidthGemm = 1;
+
+static int kOutputShapeGemm[] = {4, 1, 1, 2, 2};
+static const float kGoldenDataGemm[] = {8, -4, -14, 3};
+constexpr int kOutputElementsGemm =
+    std::extent<decltype(kGoldenDataGemm)>::value;
+
 #endif  // USE_TFLM_COMPRESSION
 
 static TfLiteConvParams common_conv_params = {
@@ -142,6 +181,134 @@ static TfLiteConvParams common_conv_params = {
     kTfLiteNoType         // quantized_bias_type
 };
 
+constexpr int kConstantFilterMaxChannels = 16;
+
+// Runs an int8 convolution twice: with non-constant filter and bias tensors,
+// which always use reference_integer_ops::ConvPerChannel, and with constant
+// ones, which let Prepare select ConvPerChannelSmallFilter or
+// ConvPerChannelGemm. The two outputs must be bit-exact. filter_scales holds
+// one scale per output channel.
+void TestConvInt8ConstantFilterMatchesReference(
+    int* input_dims_data, const int8_t* input_data, float input_scale,
+    int input_zero_point, int* filter_dims_data, const int8_t* filter_data,
+    const float* filter_scales, const int32_t* bias_data,
+    int* output_dims_data, float output_scale, int output_zero_point,
+    const TfLiteConvParams* conv_params, int8_t* reference_output,
+    int8_t* output) {
+  TfLiteIntArray* input_dims = IntArrayFromInts(input_dims_data);
+  TfLiteIntArray* filter_dims = IntArrayFromInts(filter_dims_data);
+  TfLiteIntArray* output_dims = IntArrayFromInts(output_dims_data);
+  const int output_channels = filter_dims->data[0];
+  const int output_dims_count = ElementCount(*output_dims);
+  TF_LITE_MICRO_EXPECT_LE(output_channels, kConstantFilterMaxChannels);
+
+  float input_scales[] = {1, input_scale};
+  int input_zero_points[] = {1, input_zero_point};
+  TfLiteAffineQuantization input_quant = {FloatArrayFromFloats(input_scales),
+                                          IntArrayFromInts(input_zero_points),
+                                          0};
+  TfLiteTensor input_tensor = CreateTensor(input_data, input_dims);
+  input_tensor.params = {input_scale, input_zero_point};
+  input_tensor.quantization = {kTfLiteAffineQuantization, &input_quant};
+
+  float channel_scales[kConstantFilterMaxChannels + 1] = {};
+  float bias_scales[kConstantFilterMaxChannels + 1] = {};
+  int zero_points[kConstantFilterMaxChannels + 1] = {};
+  channel_scales[0] = output_channels;
+  bias_scales[0] = output_channels;
+  zero_points[0] = output_channels;
+  for (int i = 0; i < output_channels; ++i) {
+    channel_scales[i + 1] = filter_scales[i];
+    bias_scales[i + 1] = input_scale * filter_scales[i];
+  }
+
+  TfLiteAffineQuantization filter_quant = {
+      FloatArrayFromFloats(channel_scales), IntArrayFromInts(zero_points), 0};
+  TfLiteTensor filter_tensor = CreateTensor(filter_data, filter_dims);
+  filter_tensor.quantization = {kTfLiteAffineQuantization, &filter_quant};
+
+  int bias_shape[] = {1, output_channels};
+  TfLiteAffineQuantization bias_quant = {FloatArrayFromFloats(bias_scales),
+                                         IntArrayFromInts(zero_points), 0};
+  TfLiteTensor bias_tensor =
+      CreateTensor(bias_data, IntArrayFromInts(bias_shape));
+  bias_tensor.quantization = {kTfLiteAffineQuantization, &bias_quant};
+
+  float output_scales[] = {1, output_scale};
+  int output_zero_points[] = {1, output_zero_point};
+  TfLiteAffineQuantization output_quant = {FloatArrayFromFloats(output_scales),
+                                           IntArrayFromInts(output_zero_points),
+                                           0};
+  TfLiteTensor output_tensor = CreateTensor(reference_output, output_dims);
+  output_tensor.params = {output_scale, output_zero_point};
+  output_tensor.quantization = {kTfLiteAffineQuantization, &output_quant};
+
+  constexpr int tensors_size = 4;
+  TfLiteTensor tensors[tensors_size] = {
+      input_tensor,
+      filter_tensor,
+      bias_tensor,
+      output_tensor,
+  };
+
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk, InvokeConv(tensors, tensors_size, output_dims_count,
+                            conv_params, Register_CONV_2D(), reference_output));
+
+  tensors[kConvWeightsTensor].allocation_type = kTfLiteMmapRo;
+  tensors[kConvBiasTensor].allocation_type = kTfLiteMmapRo;
+  // kConvOutputTensor indexes the node outputs; the output is the last entry
+  // of the tensors array.
+  tensors[tensors_size - 1].data.int8 = output;
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk, InvokeConv(tensors, tensors_size, output_dims_count,
+                            conv_params, Register_CONV_2D(), output));
+
+  for (int i = 0; i < output_dims_count; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(reference_output[i], output[i]);
+  }
+}
+
+// Float counterpart of TestConvInt8ConstantFilterMatchesReference: the constant
+// filter and bias let the Prepare of registration select ConvGemm or
+// ConvWinograd instead of reference_ops::Conv. ConvGemm adds the products in
+// the same order, so its outputs only differ if the compiler contracts the two
+// kernels' multiply-adds differently; ConvWinograd rounds differently.
+void TestConvFloatConstantFilterMatchesReference(
+    int* input_dims_data, const float* input_data, int* filter_dims_data,
+    const float* filter_data, const float* bias_data, int* output_dims_data,
+    const TfLiteConvParams* conv_params, const TFLMRegistration& registration,
+    float tolerance, float* reference_output, float* output) {
+  TfLiteIntArray* input_dims = IntArrayFromInts(input_dims_data);
+  TfLiteIntArray* filter_dims = IntArrayFromInts(filter_dims_data);
+  TfLiteIntArray* output_dims = IntArrayFromInts(output_dims_data);
+  const int output_dims_count = ElementCount(*output_dims);
+  int bias_shape[] = {1, filter_dims->data[0]};
+
+  constexpr int tensors_size = 4;
+  TfLiteTensor tensors[tensors_size] = {
+      CreateTensor(input_data, input_dims),
+      CreateTensor(filter_data, filter_dims),
+      CreateTensor(bias_data, IntArrayFromInts(bias_shape)),
+      CreateTensor(reference_output, output_dims),
+  };
+
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk, InvokeConv(tensors, tensors_size, output_dims_count,
+                            conv_params, Register_CONV_2D(), reference_output));
+
+  tensors[kConvWeightsTensor].allocation_type = kTfLiteMmapRo;
+  tensors[kConvBiasTensor].allocation_type = kTfLiteMmapRo;
+  tensors[tensors_size - 1].data.f = output;
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk, InvokeConv(tensors, tensors_size, output_dims_count,
+                            conv_params, registration, output));
+
+  for (int i = 0; i < output_dims_count; ++i) {
+    TF_LITE_MICRO_EXPECT_NEAR(reference_output[i], output[i], tolerance);
+  }
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace tflite
@@ -265,6 +432,63 @@ TF_LITE_MICRO_TEST(SimpleTestQuantizedPerChannelCompressed) {
           &filter_comp_info, &bias_comp_info));
 }
 
+TF_LITE_MICRO_TEST(GemmTestQuantizedPerChannelCompressed) {
+  const float input_scale = 0.5f;
+  const float output_scale = 0.5f;
+  const int input_zero_point = 0;
+  const int output_zero_point = 0;
+  constexpr float filter_scales[] = {tflite::testing::kNumChannelsGemm, 1.0f,
+                                     0.5f};
+  constexpr int filter_zero_points[] = {tflite::testing::kNumChannelsGemm, 0,
+                                        0};
+  // bias scales and zero points will be computed
+  float bias_scales[std::extent<decltype(filter_scales)>::value] = {};
+  int bias_zero_points[std::extent<decltype(filter_scales)>::value] = {};
+
+  int8_t input_quantized[tflite::testing::kInputElementsGemm];
+  int8_t
+      filter_quantized[tflite::testing::kBinQuantFilterValueTableElementsGemm];
+  int32_t bias_quantized[tflite::testing::kBiasElementsGemm];
+  int8_t golden_quantized[tflite::testing::kOutputElementsGemm];
+  int8_t output_quantized[tflite::testing::kOutputElementsGemm];
+
+  tflite::testing::TestCompressionQuantizedInfo<int8_t> filter_comp_info = {};
+  tflite::testing::TestCompressionQuantizedInfo<int32_t> bias_comp_info = {};
+
+  filter_comp_info.scheme = tflite::CompressionScheme::kBinQuant;
+  filter_comp_info.value_table = filter_quantized;
+  filter_comp_info.value_table_stride =
+      tflite::testing::kBinQuantFilterValueTableElementsGemm /
+      tflite::testing::kNumChannelsGemm;
+  filter_comp_info.bit_width = tflite::testing::kBinQuantFilterBitWidthGemm;
+  filter_comp_info.compressed = tflite::testing::kBinQuantFilterDataGemm;
+  filter_comp_info.data = tflite::testing::kBinQuantFilterValueTableGemm;
+  filter_comp_info.dims_data = tflite::testing::kFilterShapeGemm;
+  filter_comp_info.scales = filter_scales;
+  filter_comp_info.zero_points = filter_zero_points;
+
+  bias_comp_info.scheme = tflite::CompressionScheme::kBinQuant;
+  bias_comp_info.value_table = bias_quantized;
+  bias_comp_info.value_table_stride =
+      tflite::testing::kBiasElementsGemm / tflite::testing::kNumChannelsGemm;
+  bias_comp_info.bit_width = tflite::testing::kBinQuantBiasBitWidthGemm;
+  bias_comp_info.compressed = tflite::testing::kBinQuantBiasDataGemm;
+  bias_comp_info.data = tflite::testing::kBiasDataGemm;
+  bias_comp_info.dims_data = tflite::testing::kBiasShapeGemm;
+  bias_comp_info.scales = bias_scales;
+  bias_comp_info.zero_points = bias_zero_points;
+
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk,
+      tflite::testing::TestConvQuantizedPerChannelCompressed(
+          tflite::testing::kInputShapeGemm, tflite::testing::kInputDataGemm,
+          input_quantized, input_scale, input_zero_point,
+          tflite::testing::kOutputShapeGemm, tflite::testing::kGoldenDataGemm,
+          golden_quantized, output_quantized, output_scale, output_zero_point,
+          &tflite::testing::common_conv_params_q1, tflite::Register_CONV_2D(),
+          &filter_comp_info, &bias_comp_info));
+}
+
 #endif  // USE_TFLM_COMPRESSION
 
 TF_LITE_MICRO_TEST(SimpleTestFloat) {
@@ -1486,4 +1710,318 @@ TF_LITE_MICRO_TEST(Int8Filter8x3x3x3PerChannelScaleRelu6ShouldMatchGolden) {
                           1.0 /* tolerance */));
 }
 
+// The first layer of the INMP441 speech CNN: 3x3 filter, stride 1, 'same'
+// padding, one input channel and 16 output channels, on a small image.
+TF_LITE_MICRO_TEST(Int8Filter16x3x3x1SmallFilterMatchesReference) {
+  constexpr int kInputHeight = 9;
+  constexpr int kInputWidth = 7;
+  constexpr int kOutDepth = 16;
+  constexpr int kInputElements = kInputHeight * kInputWidth;
+  constexpr int kFilterElements = kOutDepth * 3 * 3;
+  constexpr int kOutputElements = kInputElements * kOutDepth;
+
+  int8_t input_data[kInputElements];
+  for (int i = 0; i < kInputElements; ++i) {
+    input_data[i] = static_cast<int8_t>((i * 37) % 256 - 128);
+  }
+  int8_t filter_data[kFilterElements];
+  for (int i = 0; i < kFilterElements; ++i) {
+    filter_data[i] = static_cast<int8_t>((i * 53) % 255 - 127);
+  }
+  float filter_scales[kOutDepth];
+  int32_t bias_data[kOutDepth];
+  for (int i = 0; i < kOutDepth; ++i) {
+    filter_scales[i] = 0.001f * (i + 1);
+    bias_data[i] = (i * 997) % 4000 - 2000;
+  }
+
+  int input_shape[] = {4, 1, kInputHeight, kInputWidth, 1};
+  int filter_shape[] = {4, kOutDepth, 3, 3, 1};
+  int output_shape[] = {4, 1, kInputHeight, kInputWidth, kOutDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingSame;
+  conv_params.stride_width = 1;
+  conv_params.stride_height = 1;
+  conv_params.activation = kTfLiteActRelu;
+
+  int8_t reference_output[kOutputElements];
+  int8_t output[kOutputElements];
+  tflite::testing::TestConvInt8ConstantFilterMatchesReference(
+      input_shape, input_data, 0.05f, -3, filter_shape, filter_data,
+      filter_scales, bias_data, output_shape, 0.1f, -128, &conv_params,
+      reference_output, output);
+}
+
+TF_LITE_MICRO_TEST(Int8Filter8x3x3x3SmallFilterStride2MatchesReference) {
+  using tflite::kConvBiasQuantized8;
+  using tflite::kConvFilter8x3x3x3;
+  using tflite::kConvInput1x32x32x3;
+
+  constexpr int kOutDepth = 8;
+  const float filter_scales[kOutDepth] = {
+      2.18926089e-05, 0.00453596329,  0.000504297379, 0.00184638216,
+      0.00596635276,  0.000199135626, 0.0047677448,   0.00193942268};
+
+  int input_shape[] = {4, 1, 32, 32, 3};
+  int filter_shape[] = {4, kOutDepth, 3, 3, 3};
+  int output_shape[] = {4, 1, 16, 16, kOutDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingSame;
+  conv_params.activation = kTfLiteActRelu6;
+
+  int8_t reference_output[1 * 16 * 16 * kOutDepth];
+  int8_t output[1 * 16 * 16 * kOutDepth];
+  tflite::testing::TestConvInt8ConstantFilterMatchesReference(
+      input_shape, kConvInput1x32x32x3, 0.00784313772f, -1, filter_shape,
+      kConvFilter8x3x3x3, filter_scales, kConvBiasQuantized8, output_shape,
+      0.0235294122f, -128, &conv_params, reference_output, output);
+}
+
+// The second layer of the INMP441 speech CNN: 16 input channels select the
+// im2col + GEMM kernel. The odd output width leaves a single pixel in the last
+// pixel block.
+TF_LITE_MICRO_TEST(Int8Filter16x3x3x16GemmMatchesReference) {
+  constexpr int kInputHeight = 6;
+  constexpr int kInputWidth = 5;
+  constexpr int kDepth = 16;
+  constexpr int kInputElements = kInputHeight * kInputWidth * kDepth;
+  constexpr int kFilterElements = kDepth * 3 * 3 * kDepth;
+  constexpr int kOutputElements = kInputElements;
+
+  int8_t input_data[kInputElements];
+  for (int i = 0; i < kInputElements; ++i) {
+    input_data[i] = static_cast<int8_t>((i * 37) % 256 - 128);
+  }
+  int8_t filter_data[kFilterElements];
+  for (int i = 0; i < kFilterElements; ++i) {
+    filter_data[i] = static_cast<int8_t>((i * 53) % 255 - 127);
+  }
+  float filter_scales[kDepth];
+  int32_t bias_data[kDepth];
+  for (int i = 0; i < kDepth; ++i) {
+    filter_scales[i] = 0.0002f * (i + 1);
+    bias_data[i] = (i * 997) % 4000 - 2000;
+  }
+
+  int input_shape[] = {4, 1, kInputHeight, kInputWidth, kDepth};
+  int filter_shape[] = {4, kDepth, 3, 3, kDepth};
+  int output_shape[] = {4, 1, kInputHeight, kInputWidth, kDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingSame;
+  conv_params.stride_width = 1;
+  conv_params.stride_height = 1;
+  conv_params.activation = kTfLiteActRelu;
+
+  int8_t reference_output[kOutputElements];
+  int8_t output[kOutputElements];
+  tflite::testing::TestConvInt8ConstantFilterMatchesReference(
+      input_shape, input_data, 0.05f, 5, filter_shape, filter_data,
+      filter_scales, bias_data, output_shape, 0.1f, -128, &conv_params,
+      reference_output, output);
+}
+
+// The third layer's channel counts with six output channels, which leaves a
+// channel tail after the blocks of four, and stride 2.
+TF_LITE_MICRO_TEST(Int8Filter6x3x3x16GemmStride2MatchesReference) {
+  constexpr int kInputHeight = 7;
+  constexpr int kInputWidth = 6;
+  constexpr int kInDepth = 16;
+  constexpr int kOutDepth = 6;
+  constexpr int kInputElements = kInputHeight * kInputWidth * kInDepth;
+  constexpr int kFilterElements = kOutDepth * 3 * 3 * kInDepth;
+  constexpr int kOutputElements = 4 * 3 * kOutDepth;
+
+  int8_t input_data[kInputElements];
+  for (int i = 0; i < kInputElements; ++i) {
+    input_data[i] = static_cast<int8_t>((i * 29 + 7) % 256 - 128);
+  }
+  int8_t filter_data[kFilterElements];
+  for (int i = 0; i < kFilterElements; ++i) {
+    filter_data[i] = static_cast<int8_t>((i * 71) % 255 - 127);
+  }
+  float filter_scales[kOutDepth];
+  int32_t bias_data[kOutDepth];
+  for (int i = 0; i < kOutDepth; ++i) {
+    filter_scales[i] = 0.0003f * (i + 2);
+    bias_data[i] = (i * 1301) % 3000 - 1500;
+  }
+
+  int input_shape[] = {4, 1, kInputHeight, kInputWidth, kInDepth};
+  int filter_shape[] = {4, kOutDepth, 3, 3, kInDepth};
+  int output_shape[] = {4, 1, 4, 3, kOutDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingSame;
+  conv_params.activation = kTfLiteActNone;
+
+  int8_t reference_output[kOutputElements];
+  int8_t output[kOutputElements];
+  tflite::testing::TestConvInt8ConstantFilterMatchesReference(
+      input_shape, input_data, 0.05f, -3, filter_shape, filter_data,
+      filter_scales, bias_data, output_shape, 0.2f, 10, &conv_params,
+      reference_output, output);
+}
+
+TF_LITE_MICRO_TEST(FloatFilter6x3x3x16GemmMatchesReference) {
+  constexpr int kInputHeight = 5;
+  constexpr int kInputWidth = 7;
+  constexpr int kInDepth = 16;
+  constexpr int kOutDepth = 6;
+  constexpr int kInputElements = kInputHeight * kInputWidth * kInDepth;
+  constexpr int kFilterElements = kOutDepth * 3 * 3 * kInDepth;
+  constexpr int kOutputElements = kInputHeight * kInputWidth * kOutDepth;
+
+  float input_data[kInputElements];
+  for (int i = 0; i < kInputElements; ++i) {
+    input_data[i] = ((i * 37) % 200 - 100) * 0.01f;
+  }
+  float filter_data[kFilterElements];
+  for (int i = 0; i < kFilterElements; ++i) {
+    filter_data[i] = ((i * 53) % 101 - 50) * 0.002f;
+  }
+  float bias_data[kOutDepth];
+  for (int i = 0; i < kOutDepth; ++i) {
+    bias_data[i] = (i - 3) * 0.25f;
+  }
+
+  int input_shape[] = {4, 1, kInputHeight, kInputWidth, kInDepth};
+  int filter_shape[] = {4, kOutDepth, 3, 3, kInDepth};
+  int output_shape[] = {4, 1, kInputHeight, kInputWidth, kOutDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingSame;
+  conv_params.stride_width = 1;
+  conv_params.stride_height = 1;
+  conv_params.activation = kTfLiteActRelu6;
+
+  float reference_output[kOutputElements];
+  float output[kOutputElements];
+  tflite::testing::TestConvFloatConstantFilterMatchesReference(
+      input_shape, input_data, filter_shape, filter_data, bias_data,
+      output_shape, &conv_params, tflite::Register_CONV_2D(), 1e-5f,
+      reference_output, output);
+}
+
+// The GEMM case through Register_CONV_2D_WINOGRAD. The odd output size leaves
+// partial 2x2 tiles on the last row and column, and six output channels leave
+// a tail after the blocks of four.
+TF_LITE_MICRO_TEST(FloatFilter6x3x3x16WinogradMatchesReference) {
+  constexpr int kInputHeight = 5;
+  constexpr int kInputWidth = 7;
+  constexpr int kInDepth = 16;
+  constexpr int kOutDepth = 6;
+  constexpr int kInputElements = kInputHeight * kInputWidth * kInDepth;
+  constexpr int kFilterElements = kOutDepth * 3 * 3 * kInDepth;
+  constexpr int kOutputElements = kInputHeight * kInputWidth * kOutDepth;
+
+  float input_data[kInputElements];
+  for (int i = 0; i < kInputElements; ++i) {
+    input_data[i] = ((i * 37) % 200 - 100) * 0.01f;
+  }
+  float filter_data[kFilterElements];
+  for (int i = 0; i < kFilterElements; ++i) {
+    filter_data[i] = ((i * 53) % 101 - 50) * 0.002f;
+  }
+  float bias_data[kOutDepth];
+  for (int i = 0; i < kOutDepth; ++i) {
+    bias_data[i] = (i - 3) * 0.25f;
+  }
+
+  int input_shape[] = {4, 1, kInputHeight, kInputWidth, kInDepth};
+  int filter_shape[] = {4, kOutDepth, 3, 3, kInDepth};
+  int output_shape[] = {4, 1, kInputHeight, kInputWidth, kOutDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingSame;
+  conv_params.stride_width = 1;
+  conv_params.stride_height = 1;
+  conv_params.activation = kTfLiteActRelu6;
+
+  float reference_output[kOutputElements];
+  float output[kOutputElements];
+  tflite::testing::TestConvFloatConstantFilterMatchesReference(
+      input_shape, input_data, filter_shape, filter_data, bias_data,
+      output_shape, &conv_params, tflite::Register_CONV_2D_WINOGRAD(), 1e-4f,
+      reference_output, output);
+}
+
+// The first layer of the INMP441 speech CNN, one input channel, with 'valid'
+// padding and two images.
+TF_LITE_MICRO_TEST(FloatFilter16x3x3x1WinogradValidMatchesReference) {
+  constexpr int kBatches = 2;
+  constexpr int kInputHeight = 9;
+  constexpr int kInputWidth = 6;
+  constexpr int kOutDepth = 16;
+  constexpr int kInputElements = kBatches * kInputHeight * kInputWidth;
+  constexpr int kFilterElements = kOutDepth * 3 * 3;
+  constexpr int kOutputElements =
+      kBatches * (kInputHeight - 2) * (kInputWidth - 2) * kOutDepth;
+
+  float input_data[kInputElements];
+  for (int i = 0; i < kInputElements; ++i) {
+    input_data[i] = ((i * 29) % 97) * 0.05f - 2.0f;
+  }
+  float filter_data[kFilterElements];
+  for (int i = 0; i < kFilterElements; ++i) {
+    filter_data[i] = ((i * 53) % 101 - 50) * 0.01f;
+  }
+  float bias_data[kOutDepth];
+  for (int i = 0; i < kOutDepth; ++i) {
+    bias_data[i] = (i - 8) * 0.1f;
+  }
+
+  int input_shape[] = {4, kBatches, kInputHeight, kInputWidth, 1};
+  int filter_shape[] = {4, kOutDepth, 3, 3, 1};
+  int output_shape[] = {4, kBatches, kInputHeight - 2, kInputWidth - 2,
+                        kOutDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingValid;
+  conv_params.stride_width = 1;
+  conv_params.stride_height = 1;
+  conv_params.activation = kTfLiteActRelu;
+
+  float reference_output[kOutputElements];
+  float output[kOutputElements];
+  tflite::testing::TestConvFloatConstantFilterMatchesReference(
+      input_shape, input_data, filter_shape, filter_data, bias_data,
+      output_shape, &conv_params, tflite::Register_CONV_2D_WINOGRAD(), 1e-4f,
+      reference_output, output);
+}
+
+// Stride 2 is not supported by ConvWinograd, so the Winograd registration
+// falls back to ConvGemm.
+TF_LITE_MICRO_TEST(FloatFilter6x3x3x16WinogradStride2FallsBack) {
+  constexpr int kInputHeight = 7;
+  constexpr int kInputWidth = 6;
+  constexpr int kInDepth = 16;
+  constexpr int kOutDepth = 6;
+  constexpr int kInputElements = kInputHeight * kInputWidth * kInDepth;
+  constexpr int kFilterElements = kOutDepth * 3 * 3 * kInDepth;
+  constexpr int kOutputElements = 4 * 3 * kOutDepth;
+
+  float input_data[kInputElements];
+  for (int i = 0; i < kInputElements; ++i) {
+    input_data[i] = ((i * 41) % 150 - 75) * 0.02f;
+  }
+  float filter_data[kFilterElements];
+  for (int i = 0; i < kFilterElements; ++i) {
+    filter_data[i] = ((i * 71) % 101 - 50) * 0.002f;
+  }
+  float bias_data[kOutDepth];
+  for (int i = 0; i < kOutDepth; ++i) {
+    bias_data[i] = (i - 2) * 0.5f;
+  }
+
+  int input_shape[] = {4, 1, kInputHeight, kInputWidth, kInDepth};
+  int filter_shape[] = {4, kOutDepth, 3, 3, kInDepth};
+  int output_shape[] = {4, 1, 4, 3, kOutDepth};
+  TfLiteConvParams conv_params{tflite::testing::common_conv_params};
+  conv_params.padding = kTfLitePaddingSame;
+  conv_params.activation = kTfLiteActNone;
+
+  float reference_output[kOutputElements];
+  float output[kOutputElements];
+  tflite::testing::TestConvFloatConstantFilterMatchesReference(
+      input_shape, input_data, filter_shape, filter_data, bias_data,
+      output_shape, &conv_params, tflite::Register_CONV_2D_WINOGRAD(), 1e-5f,
+      reference_output, output);
+}
+
 TF_LITE_MICRO_TESTS_END
@@ -0,0 +1,254 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/conv_winograd.h"
+
+#include <cstddef>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kFilterSize = 3;
+constexpr int kTileSize = 2;
+constexpr int kPatchSize = kTileSize + kFilterSize - 1;
+constexpr int kPatchElements = kPatchSize * kPatchSize;
+// Output channels summed together, in registers.
+constexpr int kChannelBlock = 4;
+
+// u = G g G^T for one 3x3 filter g, read with the given element stride.
+void TransformFilter3x3(const float* g, int stride, float* u) {
+  float t[kPatchSize][kFilterSize];
+  for (int x = 0; x < kFilterSize; ++x) {
+    const float g0 = g[(0 * kFilterSize + x) * stride];
+    const float g1 = g[(1 * kFilterSize + x) * stride];
+    const float g2 = g[(2 * kFilterSize + x) * stride];
+    t[0][x] = g0;
+    t[1][x] = 0.5f * (g0 + g1 + g2);
+    t[2][x] = 0.5f * (g0 - g1 + g2);
+    t[3][x] = g2;
+  }
+  for (int y = 0; y < kPatchSize; ++y) {
+    u[y * kPatchSize + 0] = t[y][0];
+    u[y * kPatchSize + 1] = 0.5f * (t[y][0] + t[y][1] + t[y][2]);
+    u[y * kPatchSize + 2] = 0.5f * (t[y][0] - t[y][1] + t[y][2]);
+    u[y * kPatchSize + 3] = t[y][2];
+  }
+}
+
+// v = B^T d B for one 4x4 input patch d, stored row-major.
+void TransformPatch(const float* d, float* v) {
+  float t[kPatchElements];
+  for (int x = 0; x < kPatchSize; ++x) {
+    const float d0 = d[0 * kPatchSize + x];
+    const float d1 = d[1 * kPatchSize + x];
+    const float d2 = d[2 * kPatchSize + x];
+    const float d3 = d[3 * kPatchSize + x];
+    t[0 * kPatchSize + x] = d0 - d2;
+    t[1 * kPatchSize + x] = d1 + d2;
+    t[2 * kPatchSize + x] = d2 - d1;
+    t[3 * kPatchSize + x] = d1 - d3;
+  }
+  for (int y = 0; y < kPatchSize; ++y) {
+    const float* row = t + y * kPatchSize;
+    v[y * kPatchSize + 0] = row[0] - row[2];
+    v[y * kPatchSize + 1] = row[1] + row[2];
+    v[y * kPatchSize + 2] = row[2] - row[1];
+    v[y * kPatchSize + 3] = row[1] - row[3];
+  }
+}
+
+}  // namespace
+
+bool ConvWinogradSupported(const ConvParams& params,
+                           const RuntimeShape& input_shape,
+                           const RuntimeShape& filter_shape,
+                           const RuntimeShape& output_shape) {
+  return input_shape.DimensionsCount() == 4 &&
+         filter_shape.DimensionsCount() == 4 &&
+         output_shape.DimensionsCount() == 4 &&
+         filter_shape.Dims(1) == kFilterSize &&
+         filter_shape.Dims(2) == kFilterSize &&
+         filter_shape.Dims(3) == input_shape.Dims(3) &&
+         filter_shape.Dims(0) == output_shape.Dims(3) &&
+         params.stride_height == 1 && params.stride_width == 1 &&
+         params.dilation_height_factor == 1 &&
+         params.dilation_width_factor == 1;
+}
+
+size_t ConvWinogradFilterSize(const RuntimeShape& filter_shape) {
+  return kPatchElements * filter_shape.Dims(0) * filter_shape.Dims(3) *
+         sizeof(float);
+}
+
+size_t ConvWinogradScratchSize(const RuntimeShape& filter_shape) {
+  return kPatchElements * (filter_shape.Dims(3) + filter_shape.Dims(0)) *
+         sizeof(float);
+}
+
+void ConvWinogradTransformFilter(const RuntimeShape& filter_shape,
+                                 const float* filter_data,
+                                 float* transformed_filter) {
+  const int output_depth = filter_shape.Dims(0);
+  const int input_depth = filter_shape.Dims(3);
+  // Stored as [element][input channel][output channel], so that each
+  // transformed input value is multiplied with consecutive values.
+  for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+    for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+      float u[kPatchElements];
+      TransformFilter3x3(filter_data + Offset(filter_shape, out_channel, 0, 0,
+                                              in_channel),
+                         input_depth, u);
+      for (int element = 0; element < kPatchElements; ++element) {
+        transformed_filter[(element * input_depth + in_channel) *
+                               output_depth +
+                           out_channel] = u[element];
+      }
+    }
+  }
+}
+
+void ConvWinograd(const ConvParams& params, const RuntimeShape& input_shape,
+                  const float* input_data, const RuntimeShape& filter_shape,
+                  const float* transformed_filter, const float* bias_data,
+                  const RuntimeShape& output_shape, float* output_data,
+                  void* scratch) {
+  TFLITE_DCHECK(ConvWinogradSupported(params, input_shape, filter_shape,
+                                      output_shape));
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int input_depth = input_shape.Dims(3);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int output_depth = output_shape.Dims(3);
+  const int pad_height = params.padding_values.height;
+  const int pad_width = params.padding_values.width;
+  const float activation_min = params.float_activation_min;
+  const float activation_max = params.float_activation_max;
+
+  // Transformed patches of the current tile, [element][input channel], and
+  // their products with the filter summed over the input channels,
+  // [element][output channel].
+  float* v = static_cast<float*>(scratch);
+  float* m = v + kPatchElements * input_depth;
+
+  for (int batch = 0; batch < batches; ++batch) {
+    for (int out_y = 0; out_y < output_height; out_y += kTileSize) {
+      for (int out_x = 0; out_x < output_width; out_x += kTileSize) {
+        // Input pixels of the 4x4 patch, nullptr in the padding.
+        const float* pixels[kPatchElements];
+        for (int y = 0; y < kPatchSize; ++y) {
+          const int in_y = out_y - pad_height + y;
+          for (int x = 0; x < kPatchSize; ++x) {
+            const int in_x = out_x - pad_width + x;
+            const bool inside = in_y >= 0 && in_y < input_height &&
+                                in_x >= 0 && in_x < input_width;
+            pixels[y * kPatchSize + x] =
+                inside ? input_data + Offset(input_shape, batch, in_y, in_x, 0)
+                       : nullptr;
+          }
+        }
+
+        for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+          float d[kPatchElements];
+          float patch[kPatchElements];
+          for (int element = 0; element < kPatchElements; ++element) {
+            d[element] = pixels[element] != nullptr
+                             ? pixels[element][in_channel]
+                             : 0.0f;
+          }
+          TransformPatch(d, patch);
+          for (int element = 0; element < kPatchElements; ++element) {
+            v[element * input_depth + in_channel] = patch[element];
+          }
+        }
+
+        for (int element = 0; element < kPatchElements; ++element) {
+          const float* ve = v + element * input_depth;
+          const float* ue = transformed_filter + element * input_depth *
+                                                     output_depth;
+          float* me = m + element * output_depth;
+          int out_channel = 0;
+          for (; out_channel + kChannelBlock <= output_depth;
+               out_channel += kChannelBlock) {
+            const float* u = ue + out_channel;
+            float sum0 = 0.0f;
+            float sum1 = 0.0f;
+            float sum2 = 0.0f;
+            float sum3 = 0.0f;
+            for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+              const float value = ve[in_channel];
+              sum0 += value * u[0];
+              sum1 += value * u[1];
+              sum2 += value * u[2];
+              sum3 += value * u[3];
+              u += output_depth;
+            }
+            me[out_channel + 0] = sum0;
+            me[out_channel + 1] = sum1;
+            me[out_channel + 2] = sum2;
+            me[out_channel + 3] = sum3;
+          }
+          for (; out_channel < output_depth; ++out_channel) {
+            float sum = 0.0f;
+            for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+              sum += ve[in_channel] *
+                     ue[in_channel * output_depth + out_channel];
+            }
+            me[out_channel] = sum;
+          }
+        }
+
+        const int tile_height = output_height - out_y < kTileSize
+                                    ? output_height - out_y
+                                    : kTileSize;
+        const int tile_width =
+            output_width - out_x < kTileSize ? output_width - out_x : kTileSize;
+        for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+          // y = A^T m A.
+          float t[kTileSize][kPatchSize];
+          for (int x = 0; x < kPatchSize; ++x) {
+            const float m0 = m[(0 * kPatchSize + x) * output_depth +
+                               out_channel];
+            const float m1 = m[(1 * kPatchSize + x) * output_depth +
+                               out_channel];
+            const float m2 = m[(2 * kPatchSize + x) * output_depth +
+                               out_channel];
+            const float m3 = m[(3 * kPatchSize + x) * output_depth +
+                               out_channel];
+            t[0][x] = m0 + m1 + m2;
+            t[1][x] = m1 - m2 - m3;
+          }
+          const float bias = bias_data != nullptr ? bias_data[out_channel] : 0;
+          for (int y = 0; y < tile_height; ++y) {
+            const float result[kTileSize] = {t[y][0] + t[y][1] + t[y][2],
+                                             t[y][1] - t[y][2] - t[y][3]};
+            for (int x = 0; x < tile_width; ++x) {
+              output_data[Offset(output_shape, batch, out_y + y, out_x + x,
+                                 out_channel)] =
+                  ActivationFunctionWithMinMax(result[x] + bias,
+                                               activation_min, activation_max);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace tflite
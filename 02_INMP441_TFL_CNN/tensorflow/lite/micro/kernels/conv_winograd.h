@@ -0,0 +1,66 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_CONV_WINOGRAD_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_CONV_WINOGRAD_H_
+
+#include <cstddef>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Winograd F(2x2, 3x3) float convolution for 3x3 filters with stride 1. The
+// output is computed in 2x2 tiles: each 4x4 input patch is transformed
+// (V = B^T d B, additions only), multiplied elementwise with the transformed
+// filter (U = G g G^T) and summed over the input channels, and the 4x4 result
+// is transformed back to 2x2 outputs (Y = A^T M A). A tile costs 16
+// multiplications per input and output channel instead of 36, 2.25x fewer.
+//
+// The filter is transformed once, at Prepare, into a persistent buffer of
+// 16 * output_depth * input_depth floats, 16/9 of the filter size. The
+// results differ from reference_ops::Conv by float rounding only.
+
+// Returns true if ConvWinograd supports a convolution with these parameters
+// and shapes: 4D tensors, a 3x3 filter, stride 1, no dilation and no
+// grouping.
+bool ConvWinogradSupported(const ConvParams& params,
+                           const RuntimeShape& input_shape,
+                           const RuntimeShape& filter_shape,
+                           const RuntimeShape& output_shape);
+
+// Bytes of the transformed filter.
+size_t ConvWinogradFilterSize(const RuntimeShape& filter_shape);
+
+// Bytes of scratch memory ConvWinograd needs: the transformed input patches
+// of one tile.
+size_t ConvWinogradScratchSize(const RuntimeShape& filter_shape);
+
+// Fills transformed_filter, ConvWinogradFilterSize bytes, from the OHWI
+// filter_data.
+void ConvWinogradTransformFilter(const RuntimeShape& filter_shape,
+                                 const float* filter_data,
+                                 float* transformed_filter);
+
+// bias_data may be null.
+void ConvWinograd(const ConvParams& params, const RuntimeShape& input_shape,
+                  const float* input_data, const RuntimeShape& filter_shape,
+                  const float* transformed_filter, const float* bias_data,
+                  const RuntimeShape& output_shape, float* output_data,
+                  void* scratch);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_CONV_WINOGRAD_H_
@@ -21,6 +21,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/reference/depthwiseconv_float.h"
 #include "tensorflow/lite/kernels/internal/reference/integer_ops/depthwise_conv.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/depthwise_conv_simd.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -109,24 +110,42 @@ TfLiteStatus DepthwiseConvEval(TfLiteContext* context, TfLiteNode* node) {
           break;
         }
         case kTfLiteInt8: {
-          reference_integer_ops::DepthwiseConvPerChannel(
-              DepthwiseConvParamsQuantized(params, data),
-              data.per_channel_output_multiplier, data.per_channel_output_shift,
-              tflite::micro::GetTensorShape(input),
-              tflite::micro::GetTensorData<int8_t>(input),
-              tflite::micro::GetTensorShape(filter),
+          const DepthwiseParams op_params =
+              DepthwiseConvParamsQuantized(params, data);
 #ifdef USE_TFLM_COMPRESSION
-              tflite::micro::GetTensorData<int8_t>(micro_context, filter,
-                                                   filter_comp_td,
-                                                   data.weights_scratch_index),
-              tflite::micro::GetTensorShape(bias),
+          const int8_t* filter_data = tflite::micro::GetTensorData<int8_t>(
+              micro_context, filter, filter_comp_td,
+              data.weights_scratch_index);
+          const int32_t* bias_data =
               tflite::micro::GetOptionalTensorData<int32_t>(
-                  micro_context, bias, bias_comp_td, data.bias_scratch_index),
+                  micro_context, bias, bias_comp_td, data.bias_scratch_index);
 #else   // USE_TFLM_COMPRESSION
-              tflite::micro::GetTensorData<int8_t>(filter),
-              tflite::micro::GetTensorShape(bias),
-              tflite::micro::GetOptionalTensorData<int32_t>(bias),
+          const int8_t* filter_data =
+              tflite::micro::GetTensorData<int8_t>(filter);
+          const int32_t* bias_data =
+              tflite::micro::GetOptionalTensorData<int32_t>(bias);
 #endif  // USE_TFLM_COMPRESSION
+          if (DepthwiseConvSimdSupported(
+                  op_params, tflite::micro::GetTensorShape(input),
+                  tflite::micro::GetTensorShape(filter),
+                  tflite::micro::GetTensorShape(output))) {
+            DepthwiseConvPerChannelSimd(
+                op_params, data.per_channel_output_multiplier,
+                data.per_channel_output_shift,
+                tflite::micro::GetTensorShape(input),
+                tflite::micro::GetTensorData<int8_t>(input),
+                tflite::micro::GetTensorShape(filter), filter_data, bias_data,
+                tflite::micro::GetTensorShape(output),
+                tflite::micro::GetTensorData<int8_t>(output));
+            break;
+          }
+          reference_integer_ops::DepthwiseConvPerChannel(
+              op_params, data.per_channel_output_multiplier,
+              data.per_channel_output_shift,
+              tflite::micro::GetTensorShape(input),
+              tflite::micro::GetTensorData<int8_t>(input),
+              tflite::micro::GetTensorShape(filter), filter_data,
+              tflite::micro::GetTensorShape(bias), bias_data,
               tflite::micro::GetTensorShape(output),
               tflite::micro::GetTensorData<int8_t>(output));
           break;
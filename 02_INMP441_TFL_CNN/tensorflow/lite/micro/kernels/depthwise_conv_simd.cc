@@ -0,0 +1,132 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/depthwise_conv_simd.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/simd.h"
+
+namespace tflite {
+
+bool DepthwiseConvSimdSupported(const DepthwiseParams& params,
+                                const RuntimeShape& input_shape,
+                                const RuntimeShape& filter_shape,
+                                const RuntimeShape& output_shape) {
+  if (input_shape.DimensionsCount() != 4 ||
+      filter_shape.DimensionsCount() != 4 ||
+      output_shape.DimensionsCount() != 4) {
+    return false;
+  }
+  return params.depth_multiplier == 1 &&
+         filter_shape.Dims(3) == input_shape.Dims(3);
+}
+
+void DepthwiseConvPerChannelSimd(
+    const DepthwiseParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const int8_t* filter_data, const int32_t* bias_data,
+    const RuntimeShape& output_shape, int8_t* output_data) {
+  const int stride_width = params.stride_width;
+  const int stride_height = params.stride_height;
+  const int dilation_width = params.dilation_width_factor;
+  const int dilation_height = params.dilation_height_factor;
+  const int pad_width = params.padding_values.width;
+  const int pad_height = params.padding_values.height;
+  const int32_t input_offset = params.input_offset;
+
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK(DepthwiseConvSimdSupported(params, input_shape, filter_shape,
+                                           output_shape));
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int depth = MatchingDim(filter_shape, 3, output_shape, 3);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+
+  // 3x3 windows that lie entirely inside the input take all nine taps in one
+  // simd::MultiplyAccumulate3x3Int8 call.
+  const bool filter_3x3 = filter_height == 3 && filter_width == 3 &&
+                          dilation_height == 1 && dilation_width == 1;
+
+  int32_t acc[kDepthwiseConvSimdChannelBlock];
+  for (int batch = 0; batch < batches; ++batch) {
+    const int8_t* input =
+        input_data + batch * input_height * input_width * depth;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      const int in_y_origin = (out_y * stride_height) - pad_height;
+      const bool rows_inside =
+          in_y_origin >= 0 && in_y_origin + 3 <= input_height;
+      for (int out_x = 0; out_x < output_width; ++out_x) {
+        const int in_x_origin = (out_x * stride_width) - pad_width;
+        const bool window_3x3_inside = filter_3x3 && rows_inside &&
+                                       in_x_origin >= 0 &&
+                                       in_x_origin + 3 <= input_width;
+        int8_t* output =
+            output_data +
+            ((batch * output_height + out_y) * output_width + out_x) * depth;
+        for (int channel = 0; channel < depth;
+             channel += kDepthwiseConvSimdChannelBlock) {
+          const int channels =
+              std::min(kDepthwiseConvSimdChannelBlock, depth - channel);
+          for (int c = 0; c < channels; ++c) {
+            acc[c] = bias_data != nullptr ? bias_data[channel + c] : 0;
+          }
+          if (window_3x3_inside) {
+            simd::MultiplyAccumulate3x3Int8(
+                input + (in_y_origin * input_width + in_x_origin) * depth +
+                    channel,
+                depth, input_width * depth, input_offset,
+                filter_data + channel, depth, channels, acc);
+          } else {
+            for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
+              const int in_y = in_y_origin + dilation_height * filter_y;
+              if (in_y < 0 || in_y >= input_height) {
+                continue;
+              }
+              for (int filter_x = 0; filter_x < filter_width; ++filter_x) {
+                const int in_x = in_x_origin + dilation_width * filter_x;
+                if (in_x < 0 || in_x >= input_width) {
+                  continue;
+                }
+                simd::MultiplyAccumulateInt8(
+                    input + (in_y * input_width + in_x) * depth + channel,
+                    input_offset,
+                    filter_data +
+                        (filter_y * filter_width + filter_x) * depth + channel,
+                    channels, acc);
+              }
+            }
+          }
+          simd::RequantizePerChannelInt32(
+              acc, channels, output_multiplier + channel,
+              output_shift + channel, params.output_offset,
+              params.quantized_activation_min,
+              params.quantized_activation_max, output + channel);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,60 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_DEPTHWISE_CONV_SIMD_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_DEPTHWISE_CONV_SIMD_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Int8 depthwise convolution with depth multiplier 1, vectorised across
+// channels. In NHWC every filter tap of an output pixel is a contiguous run
+// of input channels multiplied with a contiguous run of filter values, so
+// each tap is one simd::MultiplyAccumulateInt8 over a block of channels, and
+// each block is requantized with simd::RequantizePerChannelInt32. The
+// reference kernel instead walks the filter window once per channel.
+//
+// Undilated 3x3 filters, as in depthwise-separable (DS-CNN) blocks, take the
+// nine taps of every window that lies inside the input in one
+// simd::MultiplyAccumulate3x3Int8 call, with no bounds checks and with the
+// accumulators in registers. Only the border pixels walk the taps one by one.
+//
+// The output is exactly the same as reference_integer_ops::
+// DepthwiseConvPerChannel: taps in the padding are skipped, as there.
+
+// Channels accumulated at once, which bounds the stack use of the kernel.
+constexpr int kDepthwiseConvSimdChannelBlock = 64;
+
+// Returns true if DepthwiseConvPerChannelSimd supports a depthwise convolution
+// with these parameters and shapes: 4D tensors and a depth multiplier of 1.
+bool DepthwiseConvSimdSupported(const DepthwiseParams& params,
+                                const RuntimeShape& input_shape,
+                                const RuntimeShape& filter_shape,
+                                const RuntimeShape& output_shape);
+
+// bias_data may be null.
+void DepthwiseConvPerChannelSimd(
+    const DepthwiseParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const int8_t* filter_data, const int32_t* bias_data,
+    const RuntimeShape& output_shape, int8_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_DEPTHWISE_CONV_SIMD_H_
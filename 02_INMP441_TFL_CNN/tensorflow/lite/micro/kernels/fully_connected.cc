@@ -20,6 +20,9 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/portable_tensor_utils.h"
 #include "tensorflow/lite/kernels/internal/reference/fully_connected.h"
 #include "tensorflow/lite/kernels/internal/reference/integer_ops/fully_connected.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/fully_connected_packed.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -33,6 +36,58 @@ void* FullyConnectedInit(TfLiteContext* context, const char* buffer,
                                            sizeof(OpDataFullyConnected));
 }
 
+// Packs the weights of int8 layers whose weights and bias are constant, so
+// that Eval can use FullyConnectedPacked. Other layers keep the reference
+// kernels.
+TfLiteStatus PreparePackedFilter(TfLiteContext* context, TfLiteNode* node,
+                                 const TfLiteTensor* input,
+                                 const TfLiteTensor* filter,
+                                 const TfLiteTensor* bias,
+                                 const TfLiteTensor* output,
+                                 OpDataFullyConnected* data) {
+  data->packed_filter = nullptr;
+  data->packed_accumulator_init = nullptr;
+
+  const bool constant_weights = IsConstantTensor(filter) &&
+                                (bias == nullptr || IsConstantTensor(bias));
+  if (input->type != kTfLiteInt8 || filter->type != kTfLiteInt8 ||
+      (bias != nullptr && bias->type != kTfLiteInt32) ||
+      data->filter_zero_point != 0 || !constant_weights) {
+    return kTfLiteOk;
+  }
+
+  const RuntimeShape filter_shape = GetTensorShape(filter);
+  const RuntimeShape output_shape = GetTensorShape(output);
+  const int output_depth =
+      output_shape.Dims(output_shape.DimensionsCount() - 1);
+  const int accum_depth =
+      filter_shape.Dims(filter_shape.DimensionsCount() - 1);
+  data->packed_filter = static_cast<int8_t*>(context->AllocatePersistentBuffer(
+      context, FullyConnectedPackedFilterSize(output_depth, accum_depth)));
+  TF_LITE_ENSURE(context, data->packed_filter != nullptr);
+  data->packed_accumulator_init =
+      static_cast<int32_t*>(context->AllocatePersistentBuffer(
+          context, FullyConnectedPackedAccumulatorSize(output_depth)));
+  TF_LITE_ENSURE(context, data->packed_accumulator_init != nullptr);
+
+  // Compressed weights are decompressed once, into the packed copy.
+  MicroContext* micro_context = GetMicroContext(context);
+  const int8_t* filter_data =
+      static_cast<const int8_t*>(micro::GetPrepareTensorData(
+          micro_context, node, kFullyConnectedWeightsTensor, filter));
+  TF_LITE_ENSURE(context, filter_data != nullptr);
+  const int32_t* bias_data =
+      static_cast<const int32_t*>(micro::GetPrepareTensorData(
+          micro_context, node, kFullyConnectedBiasTensor, bias));
+  TF_LITE_ENSURE(context, bias == nullptr || bias_data != nullptr);
+  FullyConnectedPackFilter(-data->input_zero_point, output_depth, accum_depth,
+                           filter_data, bias_data, data->packed_filter,
+                           data->packed_accumulator_init);
+  micro::ReleasePrepareTensorData(micro_context, bias, bias_data);
+  micro::ReleasePrepareTensorData(micro_context, filter, filter_data);
+  return kTfLiteOk;
+}
+
 TfLiteStatus FullyConnectedPrepare(TfLiteContext* context, TfLiteNode* node) {
   MicroContext* micro_context = GetMicroContext(context);
 
@@ -79,20 +134,29 @@ TfLiteStatus FullyConnectedPrepare(TfLiteContext* context, TfLiteNode* node) {
                                  context, params->activation, input->type,
                                  input, filter, bias, output, data));
 
+  TF_LITE_ENSURE_OK(context, PreparePackedFilter(context, node, input, filter,
+                                                 bias, output, data));
+
 #ifdef USE_TFLM_COMPRESSION
 
   // Compression scratch buffers.
-  // These will only be allocated if the tensor is compressed.
+  // These will only be allocated if the tensor is compressed, and Eval reads
+  // it rather than the packed filter.
   if (micro_context->IsTensorCompressed(node, kFullyConnectedWeightsTensor) &&
       filter->type == kTfLiteInt4) {
     MicroPrintf("Compression not supported with INT4 tensors");
     return kTfLiteError;
   }
-  data->weights_scratch_index =
-      micro_context->AllocateDecompressionScratchBuffer(
-          node, kFullyConnectedWeightsTensor);
-  data->bias_scratch_index = micro_context->AllocateDecompressionScratchBuffer(
-      node, kFullyConnectedBiasTensor);
+  data->weights_scratch_index = -1;
+  data->bias_scratch_index = -1;
+  if (data->packed_filter == nullptr) {
+    data->weights_scratch_index =
+        micro_context->AllocateDecompressionScratchBuffer(
+            node, kFullyConnectedWeightsTensor);
+    data->bias_scratch_index =
+        micro_context->AllocateDecompressionScratchBuffer(
+            node, kFullyConnectedBiasTensor);
+  }
 
 #endif  // USE_TFLM_COMPRESSION
 
@@ -181,6 +245,20 @@ TfLiteStatus FullyConnectedEval(TfLiteContext* context, TfLiteNode* node) {
           break;
         }
         case kTfLiteInt8: {
+          if (data.packed_filter != nullptr) {
+            FullyConnectedPacked(
+                FullyConnectedParamsQuantized(data),
+                data.is_per_channel ? data.per_channel_output_multiplier
+                                    : nullptr,
+                data.is_per_channel ? data.per_channel_output_shift : nullptr,
+                data.packed_filter, data.packed_accumulator_init,
+                tflite::micro::GetTensorShape(input),
+                tflite::micro::GetTensorData<int8_t>(input),
+                tflite::micro::GetTensorShape(filter),
+                tflite::micro::GetTensorShape(output),
+                tflite::micro::GetTensorData<int8_t>(output));
+            break;
+          }
           data.is_per_channel
               ? tflite::reference_integer_ops::FullyConnectedPerChannel(
                     FullyConnectedParamsQuantized(data),
@@ -49,6 +49,12 @@ struct OpDataFullyConnected {
   int32_t* per_channel_output_multiplier;
   int32_t* per_channel_output_shift;
   bool is_per_channel;
+
+  // Weights packed by FullyConnectedPackFilter and the start value of each
+  // accumulator, for int8 layers with constant weights. Null when the
+  // reference kernels are used.
+  int8_t* packed_filter;
+  int32_t* packed_accumulator_init;
 #endif
 
 #ifdef USE_TFLM_COMPRESSION
@@ -0,0 +1,129 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/fully_connected_packed.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/simd.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kRows = kFullyConnectedPackedRows;
+
+int BlockCount(int output_depth) { return (output_depth + kRows - 1) / kRows; }
+
+static_assert(kRows == 4, "Blocks run through simd::DotProduct1x4Int8Interleaved.");
+
+}  // namespace
+
+size_t FullyConnectedPackedFilterSize(int output_depth, int accum_depth) {
+  return static_cast<size_t>(BlockCount(output_depth)) * kRows * accum_depth *
+         sizeof(int8_t);
+}
+
+size_t FullyConnectedPackedAccumulatorSize(int output_depth) {
+  return static_cast<size_t>(BlockCount(output_depth)) * kRows *
+         sizeof(int32_t);
+}
+
+void FullyConnectedPackFilter(int32_t input_offset, int output_depth,
+                              int accum_depth, const int8_t* filter_data,
+                              const int32_t* bias_data, int8_t* packed_filter,
+                              int32_t* accumulator_init) {
+  const int block_count = BlockCount(output_depth);
+  for (int out_c = 0; out_c < block_count * kRows; ++out_c) {
+    const int block = out_c / kRows;
+    const int row = out_c % kRows;
+    // Element d of the block's row r is at packed[d * kRows + r].
+    int8_t* packed = packed_filter + block * kRows * accum_depth + row;
+    if (out_c >= output_depth) {
+      for (int d = 0; d < accum_depth; ++d) {
+        packed[d * kRows] = 0;
+      }
+      accumulator_init[out_c] = 0;
+      continue;
+    }
+    const int8_t* filter_row = filter_data + out_c * accum_depth;
+    int32_t filter_sum = 0;
+    for (int d = 0; d < accum_depth; ++d) {
+      packed[d * kRows] = filter_row[d];
+      filter_sum += filter_row[d];
+    }
+    accumulator_init[out_c] =
+        (bias_data != nullptr ? bias_data[out_c] : 0) +
+        input_offset * filter_sum;
+  }
+}
+
+void FullyConnectedPacked(const FullyConnectedParams& params,
+                          const int32_t* output_multiplier,
+                          const int32_t* output_shift,
+                          const int8_t* packed_filter,
+                          const int32_t* accumulator_init,
+                          const RuntimeShape& input_shape,
+                          const int8_t* input_data,
+                          const RuntimeShape& filter_shape,
+                          const RuntimeShape& output_shape,
+                          int8_t* output_data) {
+  const int32_t output_offset = params.output_offset;
+  const int32_t output_activation_min = params.quantized_activation_min;
+  const int32_t output_activation_max = params.quantized_activation_max;
+  TFLITE_DCHECK_GE(filter_shape.DimensionsCount(), 2);
+  TFLITE_DCHECK_GE(output_shape.DimensionsCount(), 1);
+  TFLITE_DCHECK_LE(output_activation_min, output_activation_max);
+  TFLITE_DCHECK_EQ(params.weights_offset, 0);
+
+  const int filter_dim_count = filter_shape.DimensionsCount();
+  const int output_dim_count = output_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dim_count - 1);
+  const int output_depth = output_shape.Dims(output_dim_count - 1);
+  TFLITE_DCHECK_LE(output_depth, filter_shape.Dims(filter_dim_count - 2));
+  const int accum_depth = filter_shape.Dims(filter_dim_count - 1);
+  const int block_count = BlockCount(output_depth);
+
+  for (int b = 0; b < batches; ++b) {
+    const int8_t* input = input_data + b * accum_depth;
+    int8_t* output = output_data + b * output_depth;
+    for (int block = 0; block < block_count; ++block) {
+      int32_t acc[kRows];
+      std::memcpy(acc, accumulator_init + block * kRows, sizeof(acc));
+      simd::DotProduct1x4Int8Interleaved(
+          input, packed_filter + block * kRows * accum_depth, accum_depth,
+          acc);
+
+      const int first = block * kRows;
+      const int rows = std::min(kRows, output_depth - first);
+      if (output_multiplier != nullptr) {
+        simd::RequantizePerChannelInt32(
+            acc, rows, output_multiplier + first, output_shift + first,
+            output_offset, output_activation_min, output_activation_max,
+            output + first);
+      } else {
+        simd::RequantizeInt32(acc, rows, params.output_multiplier,
+                              params.output_shift, output_offset,
+                              output_activation_min, output_activation_max,
+                              output + first);
+      }
+    }
+  }
+}
+
+}  // namespace tflite
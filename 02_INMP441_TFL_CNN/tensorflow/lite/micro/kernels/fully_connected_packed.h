@@ -0,0 +1,77 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_FULLY_CONNECTED_PACKED_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_FULLY_CONNECTED_PACKED_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// int8 fully connected layer on weights packed once in Prepare. The weight
+// rows are interleaved in blocks of kFullyConnectedPackedRows output
+// channels, element by element, and a last, partial block is padded with
+// zero rows. Every block runs through simd::DotProduct1x4Int8Interleaved:
+// the weights are read in one sequential pass, and each input value is
+// loaded once per block and feeds the accumulators of all its channels.
+//
+// Every accumulator starts from bias + input_offset * sum(weights), so the
+// inner loop only multiplies raw int8 values. The result is bit-exact with
+// reference_integer_ops::FullyConnected and FullyConnectedPerChannel for
+// symmetric weights (zero point 0), which is what the quantization spec
+// requires for int8 weights.
+//
+// The packed weights take as much memory as the weights themselves, in the
+// arena instead of flash: 10 KB for the Flatten -> Dense(16) layer of the
+// INMP441 speech CNN.
+constexpr int kFullyConnectedPackedRows = 4;
+
+// Bytes of the packed weights of a layer with output_depth channels of
+// accum_depth elements.
+size_t FullyConnectedPackedFilterSize(int output_depth, int accum_depth);
+
+// Bytes of the accumulator start values of a layer with output_depth
+// channels.
+size_t FullyConnectedPackedAccumulatorSize(int output_depth);
+
+// Interleaves the first output_depth rows of filter_data, which holds
+// accum_depth weights per row, into packed_filter, and fills
+// accumulator_init with bias + input_offset * sum(weights) for each
+// channel. bias_data may be null.
+void FullyConnectedPackFilter(int32_t input_offset, int output_depth,
+                              int accum_depth, const int8_t* filter_data,
+                              const int32_t* bias_data, int8_t* packed_filter,
+                              int32_t* accumulator_init);
+
+// Per-tensor quantization uses params.output_multiplier and
+// params.output_shift when output_multiplier and output_shift are null,
+// otherwise they hold one value per output channel.
+void FullyConnectedPacked(const FullyConnectedParams& params,
+                          const int32_t* output_multiplier,
+                          const int32_t* output_shift,
+                          const int8_t* packed_filter,
+                          const int32_t* accumulator_init,
+                          const RuntimeShape& input_shape,
+                          const int8_t* input_data,
+                          const RuntimeShape& filter_shape,
+                          const RuntimeShape& output_shape,
+                          int8_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_FULLY_CONNECTED_PACKED_H_
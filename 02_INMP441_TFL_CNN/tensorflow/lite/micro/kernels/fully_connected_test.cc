@@ -567,6 +567,108 @@ TfLiteStatus TestFullyConnectedQuantizedPerChannel(
       output_dims_count, golden_quantized, output_data);
 }
 
+#if !defined(HEXAGON) && !defined(XTENSA)
+
+constexpr int kPackedMaxOutputs = 16;
+
+TfLiteStatus InvokeFullyConnectedInt8(TfLiteTensor* tensors, int tensors_size,
+                                      TfLiteFusedActivation activation) {
+  TfLiteFullyConnectedParams builtin_data = {
+      activation, kTfLiteFullyConnectedWeightsFormatDefault, false, false,
+      kTfLiteNoType};
+  int inputs_array_data[] = {3, 0, 1, 2};
+  int outputs_array_data[] = {1, 3};
+  TfLiteIntArray* inputs_array = IntArrayFromInts(inputs_array_data);
+  TfLiteIntArray* outputs_array = IntArrayFromInts(outputs_array_data);
+
+  const TFLMRegistration registration = Register_FULLY_CONNECTED();
+  micro::KernelRunner runner(registration, tensors, tensors_size, inputs_array,
+                             outputs_array,
+                             reinterpret_cast<void*>(&builtin_data));
+  TfLiteStatus status = runner.InitAndPrepare();
+  if (status != kTfLiteOk) {
+    return status;
+  }
+  return runner.Invoke();
+}
+
+// Runs an int8 fully connected layer twice: with non-constant weights and
+// bias, which use the reference kernels, and with constant ones, which let
+// Prepare pack the weights for FullyConnectedPacked. The two outputs must be
+// bit-exact. weights_scales holds one scale per output channel, or a single
+// scale for per-tensor quantization.
+void TestFullyConnectedPackedMatchesReference(
+    int* input_dims_data, const int8_t* input_data, float input_scale,
+    int input_zero_point, int* weights_dims_data, const int8_t* weights_data,
+    const float* weights_scales, int weights_scales_count,
+    const int32_t* bias_data, int* output_dims_data, float output_scale,
+    int output_zero_point, TfLiteFusedActivation activation,
+    int8_t* reference_output, int8_t* output) {
+  TfLiteIntArray* input_dims = IntArrayFromInts(input_dims_data);
+  TfLiteIntArray* weights_dims = IntArrayFromInts(weights_dims_data);
+  TfLiteIntArray* output_dims = IntArrayFromInts(output_dims_data);
+  const int output_depth = weights_dims->data[0];
+  const int output_dims_count = ElementCount(*output_dims);
+  TF_LITE_MICRO_EXPECT_LE(weights_scales_count, kPackedMaxOutputs);
+
+  float channel_scales[kPackedMaxOutputs + 1] = {};
+  float bias_scales[kPackedMaxOutputs + 1] = {};
+  int zero_points[kPackedMaxOutputs + 1] = {};
+  channel_scales[0] = weights_scales_count;
+  bias_scales[0] = weights_scales_count;
+  zero_points[0] = weights_scales_count;
+  for (int i = 0; i < weights_scales_count; ++i) {
+    channel_scales[i + 1] = weights_scales[i];
+    bias_scales[i + 1] = input_scale * weights_scales[i];
+  }
+
+  TfLiteAffineQuantization weights_quant = {
+      FloatArrayFromFloats(channel_scales), IntArrayFromInts(zero_points), 0};
+  TfLiteTensor weights_tensor = CreateTensor(weights_data, weights_dims);
+  weights_tensor.params = {weights_scales[0], 0};
+  weights_tensor.quantization = {kTfLiteAffineQuantization, &weights_quant};
+
+  int bias_shape[] = {1, output_depth};
+  TfLiteAffineQuantization bias_quant = {FloatArrayFromFloats(bias_scales),
+                                         IntArrayFromInts(zero_points), 0};
+  TfLiteTensor bias_tensor =
+      CreateTensor(bias_data, IntArrayFromInts(bias_shape));
+  bias_tensor.params = {input_scale * weights_scales[0], 0};
+  bias_tensor.quantization = {kTfLiteAffineQuantization, &bias_quant};
+
+  constexpr int tensors_size = 4;
+  TfLiteTensor tensors[tensors_size] = {
+      CreateQuantizedTensor(input_data, input_dims, input_scale,
+                            input_zero_point),
+      weights_tensor,
+      bias_tensor,
+      CreateQuantizedTensor(reference_output, output_dims, output_scale,
+                            output_zero_point),
+  };
+
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk, InvokeFullyConnectedInt8(tensors, tensors_size, activation));
+
+  tensors[kFullyConnectedWeightsTensor].allocation_type = kTfLiteMmapRo;
+  tensors[kFullyConnectedBiasTensor].allocation_type = kTfLiteMmapRo;
+  tensors[tensors_size - 1].data.int8 = output;
+  TF_LITE_MICRO_EXPECT_EQ(
+      kTfLiteOk, InvokeFullyConnectedInt8(tensors, tensors_size, activation));
+
+  for (int i = 0; i < output_dims_count; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(reference_output[i], output[i]);
+  }
+}
+
+// Fills data with a deterministic pattern covering the whole int8 range.
+void FillInt8Pattern(int8_t* data, int size, int step) {
+  for (int i = 0; i < size; ++i) {
+    data[i] = static_cast<int8_t>((i * step) % 256 - 128);
+  }
+}
+
+#endif  // !defined(HEXAGON) && !defined(XTENSA)
+
 }  // namespace
 }  // namespace testing
 }  // namespace tflite
@@ -1049,4 +1151,68 @@ TF_LITE_MICRO_TEST(SimpleTestQuantizedInt4Weights) {
 }
 #endif  // !defined(HEXAGON)
 
+#if !defined(HEXAGON) && !defined(XTENSA)
+
+// Two batches of 37 inputs into 10 outputs: the last block of four packed
+// weight rows is only half used and the input length is odd.
+TF_LITE_MICRO_TEST(PackedInt8PerTensorMatchesReference) {
+  constexpr int kBatches = 2;
+  constexpr int kAccumDepth = 37;
+  constexpr int kOutputDepth = 10;
+  int input_shape[] = {2, kBatches, kAccumDepth};
+  int weights_shape[] = {2, kOutputDepth, kAccumDepth};
+  int output_shape[] = {2, kBatches, kOutputDepth};
+
+  int8_t input_data[kBatches * kAccumDepth];
+  int8_t weights_data[kOutputDepth * kAccumDepth];
+  tflite::testing::FillInt8Pattern(input_data, kBatches * kAccumDepth, 29);
+  tflite::testing::FillInt8Pattern(weights_data, kOutputDepth * kAccumDepth,
+                                   53);
+  int32_t bias_data[kOutputDepth];
+  for (int i = 0; i < kOutputDepth; ++i) {
+    bias_data[i] = (i - 4) * 1500;
+  }
+  const float weights_scales[] = {0.004f};
+
+  int8_t reference_output[kBatches * kOutputDepth];
+  int8_t output[kBatches * kOutputDepth];
+  tflite::testing::TestFullyConnectedPackedMatchesReference(
+      input_shape, input_data, 0.05f, -3, weights_shape, weights_data,
+      weights_scales, 1, bias_data, output_shape, 0.4f, 5, kTfLiteActNone,
+      reference_output, output);
+}
+
+// Per-channel weights and a fused ReLU into 16 outputs, like the
+// Flatten -> Dense(16) layer of the INMP441 speech CNN. The input is half as
+// long as that layer's 624 values so that the packed weights fit into the
+// KernelRunner arena.
+TF_LITE_MICRO_TEST(PackedInt8PerChannel312x16MatchesReference) {
+  constexpr int kAccumDepth = 312;
+  constexpr int kOutputDepth = 16;
+  int input_shape[] = {2, 1, kAccumDepth};
+  int weights_shape[] = {2, kOutputDepth, kAccumDepth};
+  int output_shape[] = {2, 1, kOutputDepth};
+
+  int8_t input_data[kAccumDepth];
+  int8_t weights_data[kOutputDepth * kAccumDepth];
+  tflite::testing::FillInt8Pattern(input_data, kAccumDepth, 7);
+  tflite::testing::FillInt8Pattern(weights_data, kOutputDepth * kAccumDepth,
+                                   31);
+  int32_t bias_data[kOutputDepth];
+  float weights_scales[kOutputDepth];
+  for (int i = 0; i < kOutputDepth; ++i) {
+    bias_data[i] = (i % 5 - 2) * 4000;
+    weights_scales[i] = 0.001f * (1 + i % 3);
+  }
+
+  int8_t reference_output[kOutputDepth];
+  int8_t output[kOutputDepth];
+  tflite::testing::TestFullyConnectedPackedMatchesReference(
+      input_shape, input_data, 0.02f, -128, weights_shape, weights_data,
+      weights_scales, kOutputDepth, bias_data, output_shape, 0.25f, -128,
+      kTfLiteActRelu, reference_output, output);
+}
+
+#endif  // !defined(HEXAGON) && !defined(XTENSA)
+
 TF_LITE_MICRO_TESTS_END
@@ -285,5 +285,39 @@ TfLiteEvalTensor MakeUnpackedInt4Tensor(TfLiteContext* context,
   return new_tensor;
 }
 
+const void* GetPrepareTensorData(MicroContext* micro_context,
+                                 const TfLiteNode* node, int tensor_idx,
+                                 const TfLiteTensor* tensor) {
+  if (tensor == nullptr) {
+    return nullptr;
+  }
+#ifdef USE_TFLM_COMPRESSION
+  const CompressionTensorData* compression_data =
+      micro_context->GetTensorCompressionData(node, tensor_idx);
+  if (compression_data != nullptr) {
+    const TfLiteEvalTensor* eval_tensor =
+        micro_context->GetEvalTensor(node->inputs->data[tensor_idx]);
+    uint8_t* buffer = micro_context->AllocateTempBuffer(
+        EvalTensorBytes(eval_tensor), MicroArenaBufferAlignment());
+    if (buffer == nullptr) {
+      return nullptr;
+    }
+    return micro_context->DecompressTensorToBuffer(*eval_tensor,
+                                                   *compression_data, buffer);
+  }
+#endif  // USE_TFLM_COMPRESSION
+  return tensor->data.data;
+}
+
+void ReleasePrepareTensorData(MicroContext* micro_context,
+                              const TfLiteTensor* tensor, const void* data) {
+#ifdef USE_TFLM_COMPRESSION
+  if (tensor != nullptr && data != nullptr && data != tensor->data.data) {
+    micro_context->DeallocateTempBuffer(
+        static_cast<uint8_t*>(const_cast<void*>(data)));
+  }
+#endif  // USE_TFLM_COMPRESSION
+}
+
 }  // namespace micro
 }  // namespace tflite
@@ -195,6 +195,21 @@ TfLiteStatus CopySubgraphOutputsToOpOutputs(TfLiteContext* context,
 TfLiteEvalTensor MakeUnpackedInt4Tensor(TfLiteContext* context,
                                         int scratch_buffer_index,
                                         const TfLiteEvalTensor* tensor);
+
+// Returns the data of the constant input tensor_idx of node during Prepare, for
+// kernels that transform their weights once. tensor is the TfLiteTensor from
+// AllocateTempInputTensor, nullptr for a missing optional input. A compressed
+// tensor is decompressed into a temp buffer, which must be freed with
+// ReleasePrepareTensorData before Prepare returns. Returns nullptr if tensor
+// is nullptr or the temp buffer cannot be allocated.
+const void* GetPrepareTensorData(MicroContext* micro_context,
+                                 const TfLiteNode* node, int tensor_idx,
+                                 const TfLiteTensor* tensor);
+
+// Frees the temp buffer GetPrepareTensorData returned for tensor, if any.
+void ReleasePrepareTensorData(MicroContext* micro_context,
+                              const TfLiteTensor* tensor, const void* data);
+
 }  // namespace micro
 }  // namespace tflite
 
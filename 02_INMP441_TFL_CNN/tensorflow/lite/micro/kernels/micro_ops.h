@@ -49,8 +49,10 @@ TFLMRegistration Register_CAST();
 TFLMRegistration Register_CEIL();
 // TODO(b/160234179): Change custom OPs to also return by value.
 TFLMRegistration* Register_CIRCULAR_BUFFER();
+TFLMRegistration Register_CLASSIFICATION_HEAD();
 TFLMRegistration Register_CONCATENATION();
 TFLMRegistration Register_CONV_2D();
+TFLMRegistration Register_CONV_2D_MAX_POOL_2D();
 TFLMRegistration Register_COS();
 TFLMRegistration Register_CUMSUM();
 TFLMRegistration Register_DECODE();
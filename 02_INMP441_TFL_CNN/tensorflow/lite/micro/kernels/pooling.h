@@ -27,6 +27,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/padding.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/kernels/pooling_simd.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -50,6 +51,52 @@ TfLiteStatus CalculateOpDataPooling(const TfLiteContext* context,
 
 TfLiteStatus PoolingPrepare(TfLiteContext* context, TfLiteNode* node);
 
+// int8 pooling runs the channel-vectorised kernels of pooling_simd.h, the
+// 2x2/stride-2 ones where they apply, int16 pooling the reference kernels.
+inline void AveragePoolQuantized(const PoolParams& params,
+                                 const RuntimeShape& input_shape,
+                                 const int8_t* input_data,
+                                 const RuntimeShape& output_shape,
+                                 int8_t* output_data) {
+  if (Pool2x2Stride2Supported(params, input_shape, output_shape)) {
+    AveragePool2x2Stride2Simd(params, input_shape, input_data, output_shape,
+                              output_data);
+    return;
+  }
+  AveragePoolSimd(params, input_shape, input_data, output_shape, output_data);
+}
+
+inline void AveragePoolQuantized(const PoolParams& params,
+                                 const RuntimeShape& input_shape,
+                                 const int16_t* input_data,
+                                 const RuntimeShape& output_shape,
+                                 int16_t* output_data) {
+  reference_integer_ops::AveragePool(params, input_shape, input_data,
+                                     output_shape, output_data);
+}
+
+inline void MaxPoolQuantized(const PoolParams& params,
+                             const RuntimeShape& input_shape,
+                             const int8_t* input_data,
+                             const RuntimeShape& output_shape,
+                             int8_t* output_data) {
+  if (Pool2x2Stride2Supported(params, input_shape, output_shape)) {
+    MaxPool2x2Stride2Simd(params, input_shape, input_data, output_shape,
+                          output_data);
+    return;
+  }
+  MaxPoolSimd(params, input_shape, input_data, output_shape, output_data);
+}
+
+inline void MaxPoolQuantized(const PoolParams& params,
+                             const RuntimeShape& input_shape,
+                             const int16_t* input_data,
+                             const RuntimeShape& output_shape,
+                             int16_t* output_data) {
+  reference_integer_ops::MaxPool(params, input_shape, input_data,
+                                 output_shape, output_data);
+}
+
 void AveragePoolingEvalFloat(const TfLiteContext* context,
                              const TfLiteNode* node,
                              const TfLitePoolParams* params,
@@ -75,11 +122,10 @@ void AveragePoolingEvalQuantized(TfLiteContext* context, const TfLiteNode* node,
   op_params.quantized_activation_min = data->activation_min;
   op_params.quantized_activation_max = data->activation_max;
 
-  reference_integer_ops::AveragePool(op_params,
-                                     tflite::micro::GetTensorShape(input),
-                                     tflite::micro::GetTensorData<T>(input),
-                                     tflite::micro::GetTensorShape(output),
-                                     tflite::micro::GetTensorData<T>(output));
+  AveragePoolQuantized(op_params, tflite::micro::GetTensorShape(input),
+                       tflite::micro::GetTensorData<T>(input),
+                       tflite::micro::GetTensorShape(output),
+                       tflite::micro::GetTensorData<T>(output));
 }
 
 void MaxPoolingEvalFloat(TfLiteContext* context, TfLiteNode* node,
@@ -105,11 +151,10 @@ void MaxPoolingEvalQuantized(TfLiteContext* context, TfLiteNode* node,
   op_params.quantized_activation_min = data->activation_min;
   op_params.quantized_activation_max = data->activation_max;
 
-  reference_integer_ops::MaxPool(op_params,
-                                 tflite::micro::GetTensorShape(input),
-                                 tflite::micro::GetTensorData<T>(input),
-                                 tflite::micro::GetTensorShape(output),
-                                 tflite::micro::GetTensorData<T>(output));
+  MaxPoolQuantized(op_params, tflite::micro::GetTensorShape(input),
+                   tflite::micro::GetTensorData<T>(input),
+                   tflite::micro::GetTensorShape(output),
+                   tflite::micro::GetTensorData<T>(output));
 }
 
 #if defined(CMSIS_NN) || defined(XTENSA)
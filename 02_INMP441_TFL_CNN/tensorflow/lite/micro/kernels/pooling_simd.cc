@@ -0,0 +1,259 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/pooling_simd.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/simd.h"
+
+namespace tflite {
+namespace {
+
+// Range of input coordinates [*begin, *end) covered by the window of output
+// coordinate out along one axis.
+inline void WindowRange(int out, int stride, int pad, int filter_size,
+                        int input_size, int* begin, int* end) {
+  const int origin = out * stride - pad;
+  *begin = std::max(0, origin);
+  *end = std::min(input_size, origin + filter_size);
+}
+
+// Runs window(top_left, top_right, bottom_left, bottom_right, output) for
+// every output pixel of a pooling accepted by Pool2x2Stride2Supported. Each
+// pointer addresses depth channels.
+template <typename Window>
+void Pool2x2Stride2(const RuntimeShape& input_shape, const int8_t* input_data,
+                    const RuntimeShape& output_shape, int8_t* output_data,
+                    const Window& window) {
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int depth = MatchingDim(input_shape, 3, output_shape, 3);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int row_size = input_width * depth;
+  // Output columns whose window lies entirely inside the input.
+  const int full_columns = std::min(output_width, input_width / 2);
+
+  int8_t* output = output_data;
+  for (int batch = 0; batch < batches; ++batch) {
+    const int8_t* input = input_data + batch * input_height * row_size;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      const int in_y = 2 * out_y;
+      const int8_t* top = input + in_y * row_size;
+      const int8_t* bottom = in_y + 1 < input_height ? top + row_size : top;
+      for (int out_x = 0; out_x < full_columns; ++out_x) {
+        window(top, top + depth, bottom, bottom + depth, output);
+        top += 2 * depth;
+        bottom += 2 * depth;
+        output += depth;
+      }
+      // The last column of an odd input width.
+      if (full_columns < output_width) {
+        window(top, top, bottom, bottom, output);
+        output += depth;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool Pool2x2Stride2Supported(const PoolParams& params,
+                             const RuntimeShape& input_shape,
+                             const RuntimeShape& output_shape) {
+  return input_shape.DimensionsCount() == 4 &&
+         output_shape.DimensionsCount() == 4 && params.filter_height == 2 &&
+         params.filter_width == 2 && params.stride_height == 2 &&
+         params.stride_width == 2 && params.padding_values.height == 0 &&
+         params.padding_values.width == 0 &&
+         2 * output_shape.Dims(1) <= input_shape.Dims(1) + 1 &&
+         2 * output_shape.Dims(2) <= input_shape.Dims(2) + 1;
+}
+
+void MaxPool2x2Stride2Simd(const PoolParams& params,
+                           const RuntimeShape& input_shape,
+                           const int8_t* input_data,
+                           const RuntimeShape& output_shape,
+                           int8_t* output_data) {
+  TFLITE_DCHECK(Pool2x2Stride2Supported(params, input_shape, output_shape));
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK_GE(params.quantized_activation_min,
+                   std::numeric_limits<int8_t>::min());
+  TFLITE_DCHECK_LE(params.quantized_activation_max,
+                   std::numeric_limits<int8_t>::max());
+  const int depth = MatchingDim(input_shape, 3, output_shape, 3);
+  const int8_t activation_min =
+      static_cast<int8_t>(params.quantized_activation_min);
+  const int8_t activation_max =
+      static_cast<int8_t>(params.quantized_activation_max);
+  Pool2x2Stride2(input_shape, input_data, output_shape, output_data,
+                 [=](const int8_t* a, const int8_t* b, const int8_t* c,
+                     const int8_t* d, int8_t* output) {
+                   simd::Max4Int8(a, b, c, d, depth, activation_min,
+                                  activation_max, output);
+                 });
+}
+
+void AveragePool2x2Stride2Simd(const PoolParams& params,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data) {
+  TFLITE_DCHECK(Pool2x2Stride2Supported(params, input_shape, output_shape));
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK_GE(params.quantized_activation_min,
+                   std::numeric_limits<int8_t>::min());
+  TFLITE_DCHECK_LE(params.quantized_activation_max,
+                   std::numeric_limits<int8_t>::max());
+  const int depth = MatchingDim(input_shape, 3, output_shape, 3);
+  const int8_t activation_min =
+      static_cast<int8_t>(params.quantized_activation_min);
+  const int8_t activation_max =
+      static_cast<int8_t>(params.quantized_activation_max);
+  // A short window repeats its pixels to four: the sum of {a, a, b, b} is
+  // twice that of {a, b} and rounds to the same average.
+  Pool2x2Stride2(input_shape, input_data, output_shape, output_data,
+                 [=](const int8_t* a, const int8_t* b, const int8_t* c,
+                     const int8_t* d, int8_t* output) {
+                   simd::Average4Int8(a, b, c, d, depth, activation_min,
+                                      activation_max, output);
+                 });
+}
+
+void MaxPoolSimd(const PoolParams& params, const RuntimeShape& input_shape,
+                 const int8_t* input_data, const RuntimeShape& output_shape,
+                 int8_t* output_data) {
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK_GE(params.quantized_activation_min,
+                   std::numeric_limits<int8_t>::min());
+  TFLITE_DCHECK_LE(params.quantized_activation_max,
+                   std::numeric_limits<int8_t>::max());
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int depth = MatchingDim(input_shape, 3, output_shape, 3);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int8_t activation_min =
+      static_cast<int8_t>(params.quantized_activation_min);
+  const int8_t activation_max =
+      static_cast<int8_t>(params.quantized_activation_max);
+
+  for (int batch = 0; batch < batches; ++batch) {
+    const int8_t* input =
+        input_data + batch * input_height * input_width * depth;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      int in_y_begin, in_y_end;
+      WindowRange(out_y, params.stride_height, params.padding_values.height,
+                  params.filter_height, input_height, &in_y_begin, &in_y_end);
+      for (int out_x = 0; out_x < output_width; ++out_x) {
+        int in_x_begin, in_x_end;
+        WindowRange(out_x, params.stride_width, params.padding_values.width,
+                    params.filter_width, input_width, &in_x_begin, &in_x_end);
+        int8_t* output =
+            output_data +
+            ((batch * output_height + out_y) * output_width + out_x) * depth;
+        // Starting from the activation minimum applies it for free.
+        std::memset(output, activation_min, depth);
+        for (int in_y = in_y_begin; in_y < in_y_end; ++in_y) {
+          for (int in_x = in_x_begin; in_x < in_x_end; ++in_x) {
+            simd::MaxInt8(input + (in_y * input_width + in_x) * depth, depth,
+                          output);
+          }
+        }
+        if (activation_max < std::numeric_limits<int8_t>::max()) {
+          for (int c = 0; c < depth; ++c) {
+            output[c] = std::min(output[c], activation_max);
+          }
+        }
+      }
+    }
+  }
+}
+
+bool AveragePoolSimd(const PoolParams& params, const RuntimeShape& input_shape,
+                     const int8_t* input_data,
+                     const RuntimeShape& output_shape, int8_t* output_data) {
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int depth = MatchingDim(input_shape, 3, output_shape, 3);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+
+  int32_t acc[kAveragePoolSimdChannelBlock];
+  for (int batch = 0; batch < batches; ++batch) {
+    const int8_t* input =
+        input_data + batch * input_height * input_width * depth;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      int in_y_begin, in_y_end;
+      WindowRange(out_y, params.stride_height, params.padding_values.height,
+                  params.filter_height, input_height, &in_y_begin, &in_y_end);
+      for (int out_x = 0; out_x < output_width; ++out_x) {
+        int in_x_begin, in_x_end;
+        WindowRange(out_x, params.stride_width, params.padding_values.width,
+                    params.filter_width, input_width, &in_x_begin, &in_x_end);
+        const int filter_count =
+            std::max(0, in_y_end - in_y_begin) *
+            std::max(0, in_x_end - in_x_begin);
+        if (filter_count == 0) return false;
+        int8_t* output =
+            output_data +
+            ((batch * output_height + out_y) * output_width + out_x) * depth;
+        for (int channel = 0; channel < depth;
+             channel += kAveragePoolSimdChannelBlock) {
+          const int channels =
+              std::min(kAveragePoolSimdChannelBlock, depth - channel);
+          std::fill(acc, acc + channels, 0);
+          for (int in_y = in_y_begin; in_y < in_y_end; ++in_y) {
+            for (int in_x = in_x_begin; in_x < in_x_end; ++in_x) {
+              simd::AccumulateInt8(
+                  input + (in_y * input_width + in_x) * depth + channel,
+                  channels, acc);
+            }
+          }
+          for (int c = 0; c < channels; ++c) {
+            // Round to the closest integer value, as the reference does.
+            int32_t average =
+                acc[c] > 0 ? (acc[c] + filter_count / 2) / filter_count
+                           : (acc[c] - filter_count / 2) / filter_count;
+            average = std::max(average, params.quantized_activation_min);
+            average = std::min(average, params.quantized_activation_max);
+            output[channel + c] = static_cast<int8_t>(average);
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace tflite
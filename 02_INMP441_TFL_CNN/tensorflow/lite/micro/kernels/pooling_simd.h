@@ -0,0 +1,79 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_POOLING_SIMD_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_POOLING_SIMD_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Int8 max and average pooling vectorised across channels. The window of an
+// output pixel is clamped to the input once, not once per channel as in the
+// reference kernels, and every window tap is a contiguous run of channels
+// folded in with simd::MaxInt8 or simd::AccumulateInt8.
+//
+// Both produce exactly the same output as reference_integer_ops::MaxPool and
+// reference_integer_ops::AveragePool.
+
+// Channels averaged at once, which bounds the stack use of AveragePoolSimd.
+constexpr int kAveragePoolSimdChannelBlock = 64;
+
+void MaxPoolSimd(const PoolParams& params, const RuntimeShape& input_shape,
+                 const int8_t* input_data, const RuntimeShape& output_shape,
+                 int8_t* output_data);
+
+// Returns false, like the reference kernel, if a pooling window lies
+// entirely in the padding.
+bool AveragePoolSimd(const PoolParams& params, const RuntimeShape& input_shape,
+                     const int8_t* input_data,
+                     const RuntimeShape& output_shape, int8_t* output_data);
+
+// Int8 max and average pooling specialised for 2x2 windows with stride 2, the
+// pooling layers of the INMP441 CNN. Each output row streams over the two
+// input rows it covers, and each output pixel is one simd::Max4Int8 or
+// simd::Average4Int8 call over its four input pixels, with no window bounds
+// to compute. 'same' padding of such a window never pads before the first row
+// or column, so for odd input sizes only the last output row and column are
+// short. They pool their single input row or column with itself, which gives
+// the same max, and the same rounded average, as the reference kernels.
+//
+// Both produce exactly the same output as reference_integer_ops::MaxPool and
+// reference_integer_ops::AveragePool.
+
+// Returns true if params and the shapes describe such a pooling: a 2x2
+// filter, stride 2, no padding before the input and every window at least
+// partly inside it.
+bool Pool2x2Stride2Supported(const PoolParams& params,
+                             const RuntimeShape& input_shape,
+                             const RuntimeShape& output_shape);
+
+void MaxPool2x2Stride2Simd(const PoolParams& params,
+                           const RuntimeShape& input_shape,
+                           const int8_t* input_data,
+                           const RuntimeShape& output_shape,
+                           int8_t* output_data);
+
+void AveragePool2x2Stride2Simd(const PoolParams& params,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_POOLING_SIMD_H_
@@ -614,6 +614,56 @@ TF_LITE_MICRO_TEST(MaxPoolTestInt8ActRelu6) {
       output_data);
 }
 
+// 2x2/stride-2 pooling with 'same' padding over an odd input: the last output
+// row and column pool a single input row and column.
+TF_LITE_MICRO_TEST(MaxPoolTestInt8PaddingSameStride2OddInput) {
+  int input_shape[] = {4, 1, 3, 5, 2};
+  const int8_t input_values[] = {-3, 12, 7,  -20, 5,   4,  -8,  9,  30, -1,
+                                 10, -6, 2,  15,  -50, 3,  11,  0,  -7, 22,
+                                 -1, 8,  40, -2,  6,   -9, -30, 17, 13, 5};
+  const int filter_width = 2;
+  const int filter_height = 2;
+  const int stride_width = 2;
+  const int stride_height = 2;
+  const int8_t golden[] = {10, 15, 11, 9, 30, 22, 40, 8, 6, 17, 13, 5};
+  int output_shape[] = {4, 1, 2, 3, 2};
+  int8_t output_data[12];
+
+  const float input_scale = 1.0;
+  const int input_zero_point = 0;
+  const float output_scale = 1.0;
+  const int output_zero_point = 0;
+  tflite::testing::TestMaxPoolQuantized(
+      input_shape, input_values, input_scale, input_zero_point, filter_height,
+      filter_width, stride_height, stride_width, golden, output_shape,
+      output_scale, output_zero_point, kTfLitePaddingSame, kTfLiteActNone,
+      output_data);
+}
+
+TF_LITE_MICRO_TEST(AveragePoolTestInt8PaddingSameStride2OddInputRelu) {
+  int input_shape[] = {4, 1, 3, 5, 2};
+  const int8_t input_values[] = {-3, 12, 7,  -20, 5,   4,  -8,  9,  30, -1,
+                                 10, -6, 2,  15,  -50, 3,  11,  0,  -7, 22,
+                                 -1, 8,  40, -2,  6,   -9, -30, 17, 13, 5};
+  const int filter_width = 2;
+  const int filter_height = 2;
+  const int stride_width = 2;
+  const int stride_height = 2;
+  const int8_t golden[] = {4, 0, 0, 4, 12, 11, 20, 3, 0, 4, 13, 5};
+  int output_shape[] = {4, 1, 2, 3, 2};
+  int8_t output_data[12];
+
+  const float input_scale = 1.0;
+  const int input_zero_point = 0;
+  const float output_scale = 1.0;
+  const int output_zero_point = 0;
+  tflite::testing::TestAveragePoolQuantized(
+      input_shape, input_values, input_scale, input_zero_point, filter_height,
+      filter_width, stride_height, stride_width, golden, output_shape,
+      output_scale, output_zero_point, kTfLitePaddingSame, kTfLiteActRelu,
+      output_data);
+}
+
 TF_LITE_MICRO_TEST(SimpleMaxPoolTestInt16ActNone) {
   int input_shape[] = {4, 1, 2, 4, 1};
   const int16_t input_values1[] = {0, 6, 2, 4, 3, 2, 10, 7};
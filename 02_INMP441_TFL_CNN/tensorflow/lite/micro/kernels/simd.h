@@ -0,0 +1,780 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_SIMD_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_SIMD_H_
+
+// Small set of int8 vector primitives shared by the int8 kernels of the
+// reference op set (conv, depthwise conv, pooling, fully connected, softmax).
+// Each primitive has a portable scalar version and, where the compiler
+// targets it, an x86 version:
+//
+//  - AVX2 (-mavx2): 16 int8 values per step, per-lane shifts for
+//    per-channel requantization.
+//  - SSE4.1 (-msse4.1): 8 int8 values per step. Per-channel requantization
+//    uses the scalar code, since SSE4.1 has no per-lane shifts.
+//  - Scalar: everything else, including the Xtensa LX6/LX7 cores of the
+//    ESP32 family. Their GCC toolchain exposes no vector intrinsics for these
+//    cores (HiFi and Vision DSP configurations have their own kernels in
+//    kernels/xtensa), so the scalar loops are written to keep their
+//    accumulators in registers and let the compiler emit MULA/MUL16S.
+//
+// Defining TF_LITE_MICRO_SIMD_SCALAR selects the scalar versions on any
+// target, which is how host builds compare the backends.
+//
+// All primitives produce exactly the same results on every backend: integer
+// sums are exact (or wrap identically) in any order, and requantization
+// reproduces MultiplyByQuantizedMultiplier bit by bit.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+
+#if !defined(TF_LITE_MICRO_SIMD_SCALAR) && defined(__AVX2__)
+#define TF_LITE_MICRO_SIMD_AVX2 1
+#define TF_LITE_MICRO_SIMD_SSE4_1 1
+#include <immintrin.h>
+#elif !defined(TF_LITE_MICRO_SIMD_SCALAR) && defined(__SSE4_1__)
+#define TF_LITE_MICRO_SIMD_SSE4_1 1
+#include <smmintrin.h>
+#endif
+
+namespace tflite {
+namespace simd {
+
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+constexpr char kBackendName[] = "avx2";
+#elif defined(TF_LITE_MICRO_SIMD_SSE4_1)
+constexpr char kBackendName[] = "sse4.1";
+#else
+constexpr char kBackendName[] = "scalar";
+#endif
+
+namespace internal {
+
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1)
+
+inline __m128i LoadInt8x8(const int8_t* data) {
+  return _mm_cvtepi8_epi16(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data)));
+}
+
+inline int32_t HorizontalSum(__m128i v) {
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Sums of a0 .. a3, one per lane.
+inline __m128i HorizontalSum4(__m128i a0, __m128i a1, __m128i a2, __m128i a3) {
+  return _mm_hadd_epi32(_mm_hadd_epi32(a0, a1), _mm_hadd_epi32(a2, a3));
+}
+
+#endif  // defined(TF_LITE_MICRO_SIMD_SSE4_1)
+
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+
+inline __m256i LoadInt8x16(const int8_t* data) {
+  return _mm256_cvtepi8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+}
+
+inline __m128i Fold(__m256i v) {
+  return _mm_add_epi32(_mm256_castsi256_si128(v),
+                       _mm256_extracti128_si256(v, 1));
+}
+
+#endif  // defined(TF_LITE_MICRO_SIMD_AVX2)
+
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1) && !TFLITE_SINGLE_ROUNDING
+
+// gemmlowp::SaturatingRoundingDoublingHighMul on four lanes, for
+// multipliers >= 0. The 64-bit products are rounded as
+// (a * b + 2^30) >> 31, which is what the scalar nudge computes; only bits
+// 31..62 are kept, so a logical shift does. The one saturating case,
+// a == b == INT32_MIN, needs a negative multiplier.
+inline __m128i DoublingHighMul(__m128i a, __m128i b) {
+  const __m128i round = _mm_set1_epi64x(int64_t{1} << 30);
+  const __m128i even =
+      _mm_srli_epi64(_mm_add_epi64(_mm_mul_epi32(a, b), round), 31);
+  const __m128i odd = _mm_srli_epi64(
+      _mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32),
+                                  _mm_srli_epi64(b, 32)),
+                    round),
+      31);
+  return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+}
+
+// gemmlowp::RoundingDivideByPOT on four lanes with one exponent.
+inline __m128i RoundingDivideByPOT(__m128i x, int exponent) {
+  const __m128i count = _mm_cvtsi32_si128(exponent);
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i mask = _mm_set1_epi32(static_cast<int32_t>(
+      (static_cast<uint32_t>(1) << exponent) - 1));
+  const __m128i remainder = _mm_and_si128(x, mask);
+  const __m128i threshold = _mm_add_epi32(
+      _mm_srli_epi32(mask, 1),
+      _mm_and_si128(_mm_cmplt_epi32(x, _mm_setzero_si128()), one));
+  return _mm_add_epi32(
+      _mm_sra_epi32(x, count),
+      _mm_and_si128(_mm_cmpgt_epi32(remainder, threshold), one));
+}
+
+// MultiplyByQuantizedMultiplier on four lanes with one multiplier and shift.
+inline __m128i MultiplyByQuantizedMultiplierX4(__m128i x, int32_t multiplier,
+                                               int shift) {
+  const int left_shift = shift > 0 ? shift : 0;
+  const int right_shift = shift > 0 ? 0 : -shift;
+  x = _mm_sll_epi32(x, _mm_cvtsi32_si128(left_shift));
+  x = DoublingHighMul(x, _mm_set1_epi32(multiplier));
+  return RoundingDivideByPOT(x, right_shift);
+}
+
+// Adds output_offset to eight scaled values and narrows them to int8 with
+// saturating arithmetic, then applies the activation range. Clamping the
+// exact int32 sum to an int8 range gives the same result, as long as the
+// offset and the range are within int8.
+inline void StoreInt8x8(__m128i lo, __m128i hi, __m128i output_offset,
+                        __m128i activation_min, __m128i activation_max,
+                        int8_t* output) {
+  __m128i v = _mm_adds_epi16(_mm_packs_epi32(lo, hi), output_offset);
+  v = _mm_packs_epi16(v, v);
+  v = _mm_min_epi8(_mm_max_epi8(v, activation_min), activation_max);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(output), v);
+}
+
+#endif  // defined(TF_LITE_MICRO_SIMD_SSE4_1) && !TFLITE_SINGLE_ROUNDING
+
+#if defined(TF_LITE_MICRO_SIMD_AVX2) && !TFLITE_SINGLE_ROUNDING
+
+// RoundingDivideByPOT with one exponent per lane.
+inline __m128i RoundingDivideByPOT(__m128i x, __m128i exponent) {
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i mask = _mm_sub_epi32(_mm_sllv_epi32(one, exponent), one);
+  const __m128i remainder = _mm_and_si128(x, mask);
+  const __m128i threshold = _mm_add_epi32(
+      _mm_srli_epi32(mask, 1),
+      _mm_and_si128(_mm_cmplt_epi32(x, _mm_setzero_si128()), one));
+  return _mm_add_epi32(
+      _mm_srav_epi32(x, exponent),
+      _mm_and_si128(_mm_cmpgt_epi32(remainder, threshold), one));
+}
+
+// MultiplyByQuantizedMultiplier on four lanes, each with its own multiplier
+// and shift.
+inline __m128i MultiplyByQuantizedMultiplierX4(__m128i x,
+                                               const int32_t* multiplier,
+                                               const int32_t* shift) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i shifts =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(shift));
+  x = _mm_sllv_epi32(x, _mm_max_epi32(shifts, zero));
+  x = DoublingHighMul(
+      x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(multiplier)));
+  return RoundingDivideByPOT(x, _mm_max_epi32(_mm_sub_epi32(zero, shifts), zero));
+}
+
+#endif  // defined(TF_LITE_MICRO_SIMD_AVX2) && !TFLITE_SINGLE_ROUNDING
+
+inline int8_t Requantize(int32_t acc, int32_t multiplier, int32_t shift,
+                         int32_t output_offset, int32_t activation_min,
+                         int32_t activation_max) {
+  acc = tflite::MultiplyByQuantizedMultiplier(acc, multiplier, shift);
+  acc += output_offset;
+  acc = std::max(acc, activation_min);
+  acc = std::min(acc, activation_max);
+  return static_cast<int8_t>(acc);
+}
+
+}  // namespace internal
+
+// Returns the sum of a[i] * b[i] over i in [0, n).
+inline int32_t DotProductInt8(const int8_t* a, const int8_t* b, int n) {
+  int i = 0;
+  int32_t sum = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  __m256i acc = _mm256_setzero_si256();
+  for (; i + 16 <= n; i += 16) {
+    acc = _mm256_add_epi32(
+        acc, _mm256_madd_epi16(internal::LoadInt8x16(a + i),
+                               internal::LoadInt8x16(b + i)));
+  }
+  sum = internal::HorizontalSum(internal::Fold(acc));
+#elif defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  __m128i acc = _mm_setzero_si128();
+  for (; i + 8 <= n; i += 8) {
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(internal::LoadInt8x8(a + i),
+                                            internal::LoadInt8x8(b + i)));
+  }
+  sum = internal::HorizontalSum(acc);
+#endif
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+// Adds the dot products of x[0 .. n) with the four rows
+// w[r * w_stride .. r * w_stride + n) to acc[0 .. 4).
+inline void DotProduct1x4Int8(const int8_t* x, const int8_t* w, int w_stride,
+                              int n, int32_t* acc) {
+  const int8_t* w0 = w;
+  const int8_t* w1 = w0 + w_stride;
+  const int8_t* w2 = w1 + w_stride;
+  const int8_t* w3 = w2 + w_stride;
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  __m256i acc2 = _mm256_setzero_si256();
+  __m256i acc3 = _mm256_setzero_si256();
+  for (; i + 16 <= n; i += 16) {
+    const __m256i xv = internal::LoadInt8x16(x + i);
+    acc0 = _mm256_add_epi32(
+        acc0, _mm256_madd_epi16(xv, internal::LoadInt8x16(w0 + i)));
+    acc1 = _mm256_add_epi32(
+        acc1, _mm256_madd_epi16(xv, internal::LoadInt8x16(w1 + i)));
+    acc2 = _mm256_add_epi32(
+        acc2, _mm256_madd_epi16(xv, internal::LoadInt8x16(w2 + i)));
+    acc3 = _mm256_add_epi32(
+        acc3, _mm256_madd_epi16(xv, internal::LoadInt8x16(w3 + i)));
+  }
+  const __m128i sums = internal::HorizontalSum4(
+      internal::Fold(acc0), internal::Fold(acc1), internal::Fold(acc2),
+      internal::Fold(acc3));
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(acc),
+      _mm_add_epi32(sums, _mm_loadu_si128(reinterpret_cast<__m128i*>(acc))));
+#elif defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  __m128i acc0 = _mm_setzero_si128();
+  __m128i acc1 = _mm_setzero_si128();
+  __m128i acc2 = _mm_setzero_si128();
+  __m128i acc3 = _mm_setzero_si128();
+  for (; i + 8 <= n; i += 8) {
+    const __m128i xv = internal::LoadInt8x8(x + i);
+    acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(xv, internal::LoadInt8x8(w0 + i)));
+    acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(xv, internal::LoadInt8x8(w1 + i)));
+    acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(xv, internal::LoadInt8x8(w2 + i)));
+    acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(xv, internal::LoadInt8x8(w3 + i)));
+  }
+  const __m128i sums = internal::HorizontalSum4(acc0, acc1, acc2, acc3);
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(acc),
+      _mm_add_epi32(sums, _mm_loadu_si128(reinterpret_cast<__m128i*>(acc))));
+#endif
+  int32_t sum0 = acc[0];
+  int32_t sum1 = acc[1];
+  int32_t sum2 = acc[2];
+  int32_t sum3 = acc[3];
+  for (; i < n; ++i) {
+    const int32_t xi = x[i];
+    sum0 += w0[i] * xi;
+    sum1 += w1[i] * xi;
+    sum2 += w2[i] * xi;
+    sum3 += w3[i] * xi;
+  }
+  acc[0] = sum0;
+  acc[1] = sum1;
+  acc[2] = sum2;
+  acc[3] = sum3;
+}
+
+// DotProduct1x4Int8 for two inputs x0 and x1 at once, adding to acc0 and
+// acc1. Every weight loaded is used twice.
+inline void DotProduct2x4Int8(const int8_t* x0, const int8_t* x1,
+                              const int8_t* w, int w_stride, int n,
+                              int32_t* acc0, int32_t* acc1) {
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  // Registers, not loads, bound the vector loops, so the two inputs are
+  // simply processed one after the other.
+  DotProduct1x4Int8(x0, w, w_stride, n, acc0);
+  DotProduct1x4Int8(x1, w, w_stride, n, acc1);
+#else
+  const int8_t* w0 = w;
+  const int8_t* w1 = w0 + w_stride;
+  const int8_t* w2 = w1 + w_stride;
+  const int8_t* w3 = w2 + w_stride;
+  int32_t sum00 = acc0[0], sum01 = acc0[1], sum02 = acc0[2], sum03 = acc0[3];
+  int32_t sum10 = acc1[0], sum11 = acc1[1], sum12 = acc1[2], sum13 = acc1[3];
+  for (int i = 0; i < n; ++i) {
+    const int32_t in0 = x0[i];
+    const int32_t in1 = x1[i];
+    const int32_t f0 = w0[i];
+    const int32_t f1 = w1[i];
+    const int32_t f2 = w2[i];
+    const int32_t f3 = w3[i];
+    sum00 += in0 * f0;
+    sum01 += in0 * f1;
+    sum02 += in0 * f2;
+    sum03 += in0 * f3;
+    sum10 += in1 * f0;
+    sum11 += in1 * f1;
+    sum12 += in1 * f2;
+    sum13 += in1 * f3;
+  }
+  acc0[0] = sum00;
+  acc0[1] = sum01;
+  acc0[2] = sum02;
+  acc0[3] = sum03;
+  acc1[0] = sum10;
+  acc1[1] = sum11;
+  acc1[2] = sum12;
+  acc1[3] = sum13;
+#endif
+}
+
+// DotProduct1x4Int8 on four rows stored interleaved: w[i * 4 + r] is
+// element i of row r, so the weights are read in one sequential pass.
+inline void DotProduct1x4Int8Interleaved(const int8_t* x, const int8_t* w,
+                                         int n, int32_t* acc) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  // Pairs the weights of elements i, i + 1 for each row, as _madd_epi16
+  // expects: {w[i][0], w[i + 1][0], w[i][1], w[i + 1][1], ...}.
+  const __m128i pair_rows = _mm_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9,
+                                          13, 10, 14, 11, 15);
+  const __m256i pair_inputs = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+  __m256i sums = _mm256_setzero_si256();
+  for (; i + 4 <= n; i += 4) {
+    int32_t x4;
+    std::memcpy(&x4, x + i, sizeof(x4));
+    const __m256i xv = _mm256_permutevar8x32_epi32(
+        _mm256_cvtepi8_epi16(_mm_cvtsi32_si128(x4)), pair_inputs);
+    const __m256i wv = _mm256_cvtepi8_epi16(_mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i * 4)),
+        pair_rows));
+    sums = _mm256_add_epi32(sums, _mm256_madd_epi16(xv, wv));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(acc),
+                   _mm_add_epi32(internal::Fold(sums),
+                                 _mm_loadu_si128(
+                                     reinterpret_cast<__m128i*>(acc))));
+#elif defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  const __m128i pair_rows = _mm_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, -1, -1, -1,
+                                          -1, -1, -1, -1, -1);
+  __m128i sums = _mm_setzero_si128();
+  for (; i + 2 <= n; i += 2) {
+    const __m128i xv = _mm_set1_epi32(
+        static_cast<int32_t>(static_cast<uint16_t>(x[i]) |
+                             (static_cast<uint32_t>(x[i + 1]) << 16)));
+    const __m128i wv = _mm_cvtepi8_epi16(_mm_shuffle_epi8(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(w + i * 4)),
+        pair_rows));
+    sums = _mm_add_epi32(sums, _mm_madd_epi16(xv, wv));
+  }
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(acc),
+      _mm_add_epi32(sums, _mm_loadu_si128(reinterpret_cast<__m128i*>(acc))));
+#endif
+  int32_t sum0 = acc[0];
+  int32_t sum1 = acc[1];
+  int32_t sum2 = acc[2];
+  int32_t sum3 = acc[3];
+  for (const int8_t* wi = w + i * 4; i < n; ++i, wi += 4) {
+    const int32_t xi = x[i];
+    sum0 += wi[0] * xi;
+    sum1 += wi[1] * xi;
+    sum2 += wi[2] * xi;
+    sum3 += wi[3] * xi;
+  }
+  acc[0] = sum0;
+  acc[1] = sum1;
+  acc[2] = sum2;
+  acc[3] = sum3;
+}
+
+// acc[i] += (x[i] + x_offset) * w[i] for i in [0, n). x_offset must be in
+// [-127, 128] (a negated int8 zero point), which keeps every product
+// within int16.
+inline void MultiplyAccumulateInt8(const int8_t* x, int32_t x_offset,
+                                   const int8_t* w, int n, int32_t* acc) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  const __m256i offset = _mm256_set1_epi16(static_cast<int16_t>(x_offset));
+  for (; i + 16 <= n; i += 16) {
+    const __m256i products = _mm256_mullo_epi16(
+        _mm256_add_epi16(internal::LoadInt8x16(x + i), offset),
+        internal::LoadInt8x16(w + i));
+    __m256i* acc_lo = reinterpret_cast<__m256i*>(acc + i);
+    __m256i* acc_hi = reinterpret_cast<__m256i*>(acc + i + 8);
+    _mm256_storeu_si256(
+        acc_lo, _mm256_add_epi32(
+                    _mm256_loadu_si256(acc_lo),
+                    _mm256_cvtepi16_epi32(_mm256_castsi256_si128(products))));
+    _mm256_storeu_si256(
+        acc_hi, _mm256_add_epi32(_mm256_loadu_si256(acc_hi),
+                                 _mm256_cvtepi16_epi32(
+                                     _mm256_extracti128_si256(products, 1))));
+  }
+#elif defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  const __m128i offset = _mm_set1_epi16(static_cast<int16_t>(x_offset));
+  for (; i + 8 <= n; i += 8) {
+    const __m128i products =
+        _mm_mullo_epi16(_mm_add_epi16(internal::LoadInt8x8(x + i), offset),
+                        internal::LoadInt8x8(w + i));
+    __m128i* acc_lo = reinterpret_cast<__m128i*>(acc + i);
+    __m128i* acc_hi = reinterpret_cast<__m128i*>(acc + i + 4);
+    _mm_storeu_si128(acc_lo, _mm_add_epi32(_mm_loadu_si128(acc_lo),
+                                           _mm_cvtepi16_epi32(products)));
+    _mm_storeu_si128(
+        acc_hi, _mm_add_epi32(_mm_loadu_si128(acc_hi),
+                              _mm_cvtepi16_epi32(_mm_srli_si128(products, 8))));
+  }
+#endif
+  for (; i < n; ++i) {
+    acc[i] += (x[i] + x_offset) * w[i];
+  }
+}
+
+// MultiplyAccumulateInt8 over the nine taps of a 3x3 window:
+// acc[i] += sum over ky, kx in [0, 3) of
+//   (x[ky * x_row_stride + kx * x_column_stride + i] + x_offset) *
+//   w[(3 * ky + kx) * w_tap_stride + i]
+// for i in [0, n). The accumulators of each block of values stay in
+// registers for all nine taps.
+inline void MultiplyAccumulate3x3Int8(const int8_t* x, int x_column_stride,
+                                      int x_row_stride, int32_t x_offset,
+                                      const int8_t* w, int w_tap_stride, int n,
+                                      int32_t* acc) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  const __m256i offset = _mm256_set1_epi16(static_cast<int16_t>(x_offset));
+  for (; i + 16 <= n; i += 16) {
+    __m256i* acc_lo_ptr = reinterpret_cast<__m256i*>(acc + i);
+    __m256i* acc_hi_ptr = reinterpret_cast<__m256i*>(acc + i + 8);
+    __m256i acc_lo = _mm256_loadu_si256(acc_lo_ptr);
+    __m256i acc_hi = _mm256_loadu_si256(acc_hi_ptr);
+    for (int ky = 0; ky < 3; ++ky) {
+      const int8_t* x_row = x + ky * x_row_stride + i;
+      const int8_t* w_row = w + 3 * ky * w_tap_stride + i;
+      for (int kx = 0; kx < 3; ++kx) {
+        const __m256i products = _mm256_mullo_epi16(
+            _mm256_add_epi16(
+                internal::LoadInt8x16(x_row + kx * x_column_stride), offset),
+            internal::LoadInt8x16(w_row + kx * w_tap_stride));
+        acc_lo = _mm256_add_epi32(
+            acc_lo, _mm256_cvtepi16_epi32(_mm256_castsi256_si128(products)));
+        acc_hi = _mm256_add_epi32(
+            acc_hi,
+            _mm256_cvtepi16_epi32(_mm256_extracti128_si256(products, 1)));
+      }
+    }
+    _mm256_storeu_si256(acc_lo_ptr, acc_lo);
+    _mm256_storeu_si256(acc_hi_ptr, acc_hi);
+  }
+#elif defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  const __m128i offset = _mm_set1_epi16(static_cast<int16_t>(x_offset));
+  for (; i + 8 <= n; i += 8) {
+    __m128i* acc_lo_ptr = reinterpret_cast<__m128i*>(acc + i);
+    __m128i* acc_hi_ptr = reinterpret_cast<__m128i*>(acc + i + 4);
+    __m128i acc_lo = _mm_loadu_si128(acc_lo_ptr);
+    __m128i acc_hi = _mm_loadu_si128(acc_hi_ptr);
+    for (int ky = 0; ky < 3; ++ky) {
+      const int8_t* x_row = x + ky * x_row_stride + i;
+      const int8_t* w_row = w + 3 * ky * w_tap_stride + i;
+      for (int kx = 0; kx < 3; ++kx) {
+        const __m128i products = _mm_mullo_epi16(
+            _mm_add_epi16(internal::LoadInt8x8(x_row + kx * x_column_stride),
+                          offset),
+            internal::LoadInt8x8(w_row + kx * w_tap_stride));
+        acc_lo = _mm_add_epi32(acc_lo, _mm_cvtepi16_epi32(products));
+        acc_hi = _mm_add_epi32(
+            acc_hi, _mm_cvtepi16_epi32(_mm_srli_si128(products, 8)));
+      }
+    }
+    _mm_storeu_si128(acc_lo_ptr, acc_lo);
+    _mm_storeu_si128(acc_hi_ptr, acc_hi);
+  }
+#endif
+  for (; i < n; ++i) {
+    int32_t sum = acc[i];
+    for (int ky = 0; ky < 3; ++ky) {
+      const int8_t* x_row = x + ky * x_row_stride + i;
+      const int8_t* w_row = w + 3 * ky * w_tap_stride + i;
+      sum += (x_row[0] + x_offset) * w_row[0] +
+             (x_row[x_column_stride] + x_offset) * w_row[w_tap_stride] +
+             (x_row[2 * x_column_stride] + x_offset) *
+                 w_row[2 * w_tap_stride];
+    }
+    acc[i] = sum;
+  }
+}
+
+// acc[i] += x[i] for i in [0, n).
+inline void AccumulateInt8(const int8_t* x, int n, int32_t* acc) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  for (; i + 8 <= n; i += 8) {
+    __m256i* a = reinterpret_cast<__m256i*>(acc + i);
+    _mm256_storeu_si256(
+        a, _mm256_add_epi32(
+               _mm256_loadu_si256(a),
+               _mm256_cvtepi8_epi32(_mm_loadl_epi64(
+                   reinterpret_cast<const __m128i*>(x + i)))));
+  }
+#elif defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  for (; i + 4 <= n; i += 4) {
+    int32_t packed;
+    std::memcpy(&packed, x + i, sizeof(packed));
+    __m128i* a = reinterpret_cast<__m128i*>(acc + i);
+    _mm_storeu_si128(a, _mm_add_epi32(_mm_loadu_si128(a),
+                                      _mm_cvtepi8_epi32(
+                                          _mm_cvtsi32_si128(packed))));
+  }
+#endif
+  for (; i < n; ++i) {
+    acc[i] += x[i];
+  }
+}
+
+// max[i] = std::max(max[i], x[i]) for i in [0, n).
+inline void MaxInt8(const int8_t* x, int n, int8_t* max) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  for (; i + 32 <= n; i += 32) {
+    __m256i* m = reinterpret_cast<__m256i*>(max + i);
+    _mm256_storeu_si256(
+        m, _mm256_max_epi8(_mm256_loadu_si256(m),
+                           _mm256_loadu_si256(
+                               reinterpret_cast<const __m256i*>(x + i))));
+  }
+#endif
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  for (; i + 16 <= n; i += 16) {
+    __m128i* m = reinterpret_cast<__m128i*>(max + i);
+    _mm_storeu_si128(
+        m, _mm_max_epi8(_mm_loadu_si128(m),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i))));
+  }
+#endif
+  for (; i < n; ++i) {
+    max[i] = std::max(max[i], x[i]);
+  }
+}
+
+// output[i] = clamp(a[i] + b[i], -128, 127) for i in [0, n). output may
+// alias a or b.
+inline void SaturatingAddInt8(const int8_t* a, const int8_t* b, int n,
+                              int8_t* output) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  for (; i + 32 <= n; i += 32) {
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output + i),
+        _mm256_adds_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))));
+  }
+#endif
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  for (; i + 16 <= n; i += 16) {
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output + i),
+        _mm_adds_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+  }
+#endif
+  for (; i < n; ++i) {
+    const int32_t sum = static_cast<int32_t>(a[i]) + b[i];
+    output[i] = static_cast<int8_t>(std::min<int32_t>(
+        std::max<int32_t>(sum, std::numeric_limits<int8_t>::lowest()),
+        std::numeric_limits<int8_t>::max()));
+  }
+}
+
+// Returns the largest of x[0 .. n), or -128 if n is 0.
+inline int8_t ReduceMaxInt8(const int8_t* x, int n) {
+  int i = 0;
+  int8_t result = std::numeric_limits<int8_t>::lowest();
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  if (n >= 16) {
+    __m128i m = _mm_set1_epi8(std::numeric_limits<int8_t>::lowest());
+    for (; i + 16 <= n; i += 16) {
+      m = _mm_max_epi8(
+          m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+    }
+    m = _mm_max_epi8(m, _mm_srli_si128(m, 8));
+    m = _mm_max_epi8(m, _mm_srli_si128(m, 4));
+    m = _mm_max_epi8(m, _mm_srli_si128(m, 2));
+    m = _mm_max_epi8(m, _mm_srli_si128(m, 1));
+    result = static_cast<int8_t>(_mm_cvtsi128_si32(m));
+  }
+#endif
+  for (; i < n; ++i) {
+    result = std::max(result, x[i]);
+  }
+  return result;
+}
+
+// output[i] = clamp(max(a[i], b[i], c[i], d[i]), activation_min,
+//                   activation_max)
+// for i in [0, n): a 2x2 max pooling window over n channels.
+inline void Max4Int8(const int8_t* a, const int8_t* b, const int8_t* c,
+                     const int8_t* d, int n, int8_t activation_min,
+                     int8_t activation_max, int8_t* output) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2)
+  const __m256i min256 = _mm256_set1_epi8(activation_min);
+  const __m256i max256 = _mm256_set1_epi8(activation_max);
+  for (; i + 32 <= n; i += 32) {
+    const __m256i top = _mm256_max_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    const __m256i bottom = _mm256_max_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output + i),
+        _mm256_min_epi8(_mm256_max_epi8(_mm256_max_epi8(top, bottom), min256),
+                        max256));
+  }
+#endif
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  const __m128i min128 = _mm_set1_epi8(activation_min);
+  const __m128i max128 = _mm_set1_epi8(activation_max);
+  for (; i + 16 <= n; i += 16) {
+    const __m128i top =
+        _mm_max_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    const __m128i bottom =
+        _mm_max_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i)),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output + i),
+        _mm_min_epi8(_mm_max_epi8(_mm_max_epi8(top, bottom), min128), max128));
+  }
+#endif
+  for (; i < n; ++i) {
+    const int8_t m = std::max(std::max(a[i], b[i]), std::max(c[i], d[i]));
+    output[i] = std::min(std::max(m, activation_min), activation_max);
+  }
+}
+
+// output[i] = clamp(round((a[i] + b[i] + c[i] + d[i]) / 4), activation_min,
+//                   activation_max)
+// for i in [0, n): a 2x2 average pooling window over n channels, rounded half
+// away from zero like reference_integer_ops::AveragePool.
+inline void Average4Int8(const int8_t* a, const int8_t* b, const int8_t* c,
+                         const int8_t* d, int n, int8_t activation_min,
+                         int8_t activation_max, int8_t* output) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1)
+  // The sums fit in int16. round(s / 4) is sign(s) * ((|s| + 2) >> 2).
+  const __m128i two = _mm_set1_epi16(2);
+  const __m128i min128 = _mm_set1_epi8(activation_min);
+  const __m128i max128 = _mm_set1_epi8(activation_max);
+  for (; i + 16 <= n; i += 16) {
+    __m128i averages[2];
+    for (int half = 0; half < 2; ++half) {
+      const int j = i + 8 * half;
+      const __m128i sum = _mm_add_epi16(
+          _mm_add_epi16(internal::LoadInt8x8(a + j),
+                        internal::LoadInt8x8(b + j)),
+          _mm_add_epi16(internal::LoadInt8x8(c + j),
+                        internal::LoadInt8x8(d + j)));
+      averages[half] = _mm_sign_epi16(
+          _mm_srli_epi16(_mm_add_epi16(_mm_abs_epi16(sum), two), 2), sum);
+    }
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output + i),
+        _mm_min_epi8(
+            _mm_max_epi8(_mm_packs_epi16(averages[0], averages[1]), min128),
+            max128));
+  }
+#endif
+  for (; i < n; ++i) {
+    const int32_t sum = a[i] + b[i] + c[i] + d[i];
+    const int32_t magnitude = ((sum < 0 ? -sum : sum) + 2) >> 2;
+    const int32_t average = sum < 0 ? -magnitude : magnitude;
+    output[i] = static_cast<int8_t>(
+        std::min<int32_t>(std::max<int32_t>(average, activation_min),
+                          activation_max));
+  }
+}
+
+// output[i] = clamp(MultiplyByQuantizedMultiplier(acc[i], multiplier, shift)
+//                   + output_offset, activation_min, activation_max)
+// for i in [0, n). output_offset, activation_min and activation_max must lie
+// in the int8 range.
+inline void RequantizeInt32(const int32_t* acc, int n, int32_t multiplier,
+                            int32_t shift, int32_t output_offset,
+                            int32_t activation_min, int32_t activation_max,
+                            int8_t* output) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_SSE4_1) && !TFLITE_SINGLE_ROUNDING
+  const __m128i offset = _mm_set1_epi16(static_cast<int16_t>(output_offset));
+  const __m128i min = _mm_set1_epi8(static_cast<int8_t>(activation_min));
+  const __m128i max = _mm_set1_epi8(static_cast<int8_t>(activation_max));
+  for (; i + 8 <= n; i += 8) {
+    const __m128i lo = internal::MultiplyByQuantizedMultiplierX4(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i)),
+        multiplier, shift);
+    const __m128i hi = internal::MultiplyByQuantizedMultiplierX4(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i + 4)),
+        multiplier, shift);
+    internal::StoreInt8x8(lo, hi, offset, min, max, output + i);
+  }
+#endif
+  for (; i < n; ++i) {
+    output[i] = internal::Requantize(acc[i], multiplier, shift, output_offset,
+                                     activation_min, activation_max);
+  }
+}
+
+// RequantizeInt32 with one multiplier and shift per element.
+inline void RequantizePerChannelInt32(const int32_t* acc, int n,
+                                      const int32_t* multiplier,
+                                      const int32_t* shift,
+                                      int32_t output_offset,
+                                      int32_t activation_min,
+                                      int32_t activation_max, int8_t* output) {
+  int i = 0;
+#if defined(TF_LITE_MICRO_SIMD_AVX2) && !TFLITE_SINGLE_ROUNDING
+  const __m128i offset = _mm_set1_epi16(static_cast<int16_t>(output_offset));
+  const __m128i min = _mm_set1_epi8(static_cast<int8_t>(activation_min));
+  const __m128i max = _mm_set1_epi8(static_cast<int8_t>(activation_max));
+  for (; i + 8 <= n; i += 8) {
+    const __m128i lo = internal::MultiplyByQuantizedMultiplierX4(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i)),
+        multiplier + i, shift + i);
+    const __m128i hi = internal::MultiplyByQuantizedMultiplierX4(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i + 4)),
+        multiplier + i + 4, shift + i + 4);
+    internal::StoreInt8x8(lo, hi, offset, min, max, output + i);
+  }
+  if (i + 4 <= n) {
+    const __m128i lo = internal::MultiplyByQuantizedMultiplierX4(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i)),
+        multiplier + i, shift + i);
+    int8_t packed[8];
+    internal::StoreInt8x8(lo, lo, offset, min, max, packed);
+    std::memcpy(output + i, packed, 4);
+    i += 4;
+  }
+#endif
+  for (; i < n; ++i) {
+    output[i] = internal::Requantize(acc[i], multiplier[i], shift[i],
+                                     output_offset, activation_min,
+                                     activation_max);
+  }
+}
+
+}  // namespace simd
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_SIMD_H_
@@ -0,0 +1,288 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/simd.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace tflite {
+namespace testing {
+namespace {
+
+// Longest vector the tests use: covers the AVX2 (32 values), SSE4.1
+// (16 values) and scalar tail loops.
+constexpr int kMaxLength = 75;
+constexpr int kLengths[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 75};
+
+// Deterministic pseudo-random int8 data, including the extreme values.
+class Int8Source {
+ public:
+  explicit Int8Source(uint32_t seed) : state_(seed) {}
+
+  int32_t NextInt32() {
+    state_ = state_ * 1664525u + 1013904223u;
+    return static_cast<int32_t>(state_);
+  }
+
+  int8_t Next() { return static_cast<int8_t>(NextInt32() >> 24); }
+
+  void Fill(int8_t* data, int n) {
+    for (int i = 0; i < n; ++i) {
+      data[i] = Next();
+    }
+    if (n > 1) {
+      data[0] = -128;
+      data[n - 1] = 127;
+    }
+  }
+
+ private:
+  uint32_t state_;
+};
+
+void TestDotProducts(int n) {
+  Int8Source source(n + 1);
+  int8_t x0[kMaxLength];
+  int8_t x1[kMaxLength];
+  // Four rows with a stride larger than n, like a packed weight block.
+  const int stride = n + 3;
+  int8_t w[4 * (kMaxLength + 3)];
+  source.Fill(x0, n);
+  source.Fill(x1, n);
+  source.Fill(w, 4 * stride);
+
+  int32_t expected0[4];
+  int32_t expected1[4];
+  for (int r = 0; r < 4; ++r) {
+    expected0[r] = r;
+    expected1[r] = -r;
+    for (int i = 0; i < n; ++i) {
+      expected0[r] += x0[i] * w[r * stride + i];
+      expected1[r] += x1[i] * w[r * stride + i];
+    }
+  }
+
+  TF_LITE_MICRO_EXPECT_EQ(expected0[0], simd::DotProductInt8(x0, w, n));
+
+  int32_t acc[4] = {0, 1, 2, 3};
+  simd::DotProduct1x4Int8(x0, w, stride, n, acc);
+  for (int r = 0; r < 4; ++r) {
+    TF_LITE_MICRO_EXPECT_EQ(expected0[r], acc[r]);
+  }
+
+  // The same rows interleaved, element by element.
+  int8_t interleaved[4 * kMaxLength];
+  for (int i = 0; i < n; ++i) {
+    for (int r = 0; r < 4; ++r) {
+      interleaved[i * 4 + r] = w[r * stride + i];
+    }
+  }
+  int32_t acc_interleaved[4] = {0, 1, 2, 3};
+  simd::DotProduct1x4Int8Interleaved(x0, interleaved, n, acc_interleaved);
+  for (int r = 0; r < 4; ++r) {
+    TF_LITE_MICRO_EXPECT_EQ(expected0[r], acc_interleaved[r]);
+  }
+
+  int32_t acc0[4] = {0, 1, 2, 3};
+  int32_t acc1[4] = {0, -1, -2, -3};
+  simd::DotProduct2x4Int8(x0, x1, w, stride, n, acc0, acc1);
+  for (int r = 0; r < 4; ++r) {
+    TF_LITE_MICRO_EXPECT_EQ(expected0[r], acc0[r]);
+    TF_LITE_MICRO_EXPECT_EQ(expected1[r], acc1[r]);
+  }
+}
+
+void TestElementwise(int n) {
+  Int8Source source(n + 100);
+  int8_t x[kMaxLength];
+  int8_t w[kMaxLength];
+  source.Fill(x, n);
+  source.Fill(w, n);
+
+  // The extreme offsets a negated int8 zero point can give.
+  for (const int32_t x_offset : {-127, 0, 5, 128}) {
+    int32_t acc[kMaxLength];
+    int32_t expected[kMaxLength];
+    for (int i = 0; i < n; ++i) {
+      acc[i] = source.NextInt32() >> 8;
+      expected[i] = acc[i] + (x[i] + x_offset) * w[i];
+    }
+    simd::MultiplyAccumulateInt8(x, x_offset, w, n, acc);
+    for (int i = 0; i < n; ++i) {
+      TF_LITE_MICRO_EXPECT_EQ(expected[i], acc[i]);
+    }
+  }
+
+  // A 3x3 window of n channels in an interleaved 4-pixel wide image, with one
+  // padding value after each pixel, against filter taps with a stride > n.
+  {
+    const int column_stride = n + 1;
+    const int row_stride = 4 * column_stride;
+    const int tap_stride = n + 2;
+    int8_t image[3 * 4 * (kMaxLength + 1)];
+    int8_t filter[9 * (kMaxLength + 2)];
+    source.Fill(image, 3 * row_stride);
+    source.Fill(filter, 9 * tap_stride);
+    for (const int32_t x_offset : {-127, 0, 128}) {
+      int32_t acc[kMaxLength];
+      int32_t expected[kMaxLength];
+      for (int i = 0; i < n; ++i) {
+        acc[i] = source.NextInt32() >> 8;
+        expected[i] = acc[i];
+        for (int tap = 0; tap < 9; ++tap) {
+          expected[i] +=
+              (image[(tap / 3) * row_stride + (tap % 3) * column_stride + i] +
+               x_offset) *
+              filter[tap * tap_stride + i];
+        }
+      }
+      simd::MultiplyAccumulate3x3Int8(image, column_stride, row_stride,
+                                      x_offset, filter, tap_stride, n, acc);
+      for (int i = 0; i < n; ++i) {
+        TF_LITE_MICRO_EXPECT_EQ(expected[i], acc[i]);
+      }
+    }
+  }
+
+  int32_t sums[kMaxLength];
+  for (int i = 0; i < n; ++i) {
+    sums[i] = i;
+  }
+  simd::AccumulateInt8(x, n, sums);
+  for (int i = 0; i < n; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(i + x[i], sums[i]);
+  }
+
+  int8_t max[kMaxLength];
+  for (int i = 0; i < n; ++i) {
+    max[i] = w[i];
+  }
+  simd::MaxInt8(x, n, max);
+  int8_t row_max = -128;
+  for (int i = 0; i < n; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(std::max(x[i], w[i]), max[i]);
+    row_max = std::max(row_max, w[i]);
+  }
+  TF_LITE_MICRO_EXPECT_EQ(row_max, simd::ReduceMaxInt8(w, n));
+
+  // Fill() starts both inputs at -128 and ends them at 127, so the first and
+  // the last sums saturate. The sum is written over x, which it may alias.
+  int8_t saturated[kMaxLength];
+  for (int i = 0; i < n; ++i) {
+    saturated[i] = x[i];
+  }
+  simd::SaturatingAddInt8(saturated, w, n, saturated);
+  for (int i = 0; i < n; ++i) {
+    const int32_t sum = x[i] + w[i];
+    TF_LITE_MICRO_EXPECT_EQ(std::min(std::max(sum, -128), 127), saturated[i]);
+  }
+
+  // A 2x2 window with a narrowed activation range, and the short window of
+  // the last row or column, whose two pixels are passed twice.
+  int8_t c[kMaxLength];
+  int8_t d[kMaxLength];
+  source.Fill(c, n);
+  source.Fill(d, n);
+  int8_t window[kMaxLength];
+  simd::Max4Int8(x, w, c, d, n, -100, 90, window);
+  for (int i = 0; i < n; ++i) {
+    const int8_t m = std::max(std::max(x[i], w[i]), std::max(c[i], d[i]));
+    TF_LITE_MICRO_EXPECT_EQ(std::min<int8_t>(std::max<int8_t>(m, -100), 90),
+                            window[i]);
+  }
+  simd::Average4Int8(x, w, c, d, n, -100, 90, window);
+  for (int i = 0; i < n; ++i) {
+    const int32_t sum = x[i] + w[i] + c[i] + d[i];
+    const int32_t average = sum > 0 ? (sum + 2) / 4 : (sum - 2) / 4;
+    TF_LITE_MICRO_EXPECT_EQ(std::min(std::max(average, -100), 90), window[i]);
+  }
+  simd::Average4Int8(x, w, x, w, n, -128, 127, window);
+  for (int i = 0; i < n; ++i) {
+    const int32_t sum = x[i] + w[i];
+    const int32_t average = sum > 0 ? (sum + 1) / 2 : (sum - 1) / 2;
+    TF_LITE_MICRO_EXPECT_EQ(average, window[i]);
+  }
+}
+
+void TestRequantize(int n, int32_t output_offset, int32_t activation_min,
+                    int32_t activation_max) {
+  Int8Source source(n + 200);
+  int32_t acc[kMaxLength];
+  int32_t multiplier[kMaxLength];
+  int32_t shift[kMaxLength];
+  for (int i = 0; i < n; ++i) {
+    // Mix of full range and typical accumulator magnitudes.
+    acc[i] = (i % 3 == 0) ? source.NextInt32() : source.NextInt32() >> 14;
+    multiplier[i] = (1 << 30) + ((source.NextInt32() >> 2) & ((1 << 30) - 1));
+    shift[i] = -1 - (i % 12);
+  }
+
+  int8_t output[kMaxLength];
+  simd::RequantizePerChannelInt32(acc, n, multiplier, shift, output_offset,
+                                  activation_min, activation_max, output);
+  for (int i = 0; i < n; ++i) {
+    const int32_t expected = std::min(
+        std::max(MultiplyByQuantizedMultiplier(acc[i], multiplier[i],
+                                               shift[i]) +
+                     output_offset,
+                 activation_min),
+        activation_max);
+    TF_LITE_MICRO_EXPECT_EQ(expected, output[i]);
+  }
+
+  simd::RequantizeInt32(acc, n, multiplier[0], shift[0] + 1, output_offset,
+                        activation_min, activation_max, output);
+  for (int i = 0; i < n; ++i) {
+    const int32_t expected = std::min(
+        std::max(MultiplyByQuantizedMultiplier(acc[i], multiplier[0],
+                                               shift[0] + 1) +
+                     output_offset,
+                 activation_min),
+        activation_max);
+    TF_LITE_MICRO_EXPECT_EQ(expected, output[i]);
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace tflite
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(DotProductsMatchScalarLoops) {
+  for (const int n : tflite::testing::kLengths) {
+    tflite::testing::TestDotProducts(n);
+  }
+}
+
+TF_LITE_MICRO_TEST(ElementwiseOpsMatchScalarLoops) {
+  for (const int n : tflite::testing::kLengths) {
+    tflite::testing::TestElementwise(n);
+  }
+}
+
+TF_LITE_MICRO_TEST(RequantizeMatchesMultiplyByQuantizedMultiplier) {
+  for (const int n : tflite::testing::kLengths) {
+    tflite::testing::TestRequantize(n, 0, -128, 127);
+    tflite::testing::TestRequantize(n, -128, -128, 127);
+    tflite::testing::TestRequantize(n, 127, -20, 100);
+  }
+}
+
+TF_LITE_MICRO_TESTS_END
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/softmax_simd.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -31,7 +32,20 @@ namespace {
 
 void SoftmaxQuantized(const TfLiteEvalTensor* input, TfLiteEvalTensor* output,
                       const SoftmaxParams& op_data) {
-  if (input->type == kTfLiteInt8) {
+  if (input->type == kTfLiteInt8 &&
+      SoftmaxSimdSupported(tflite::micro::GetTensorShape(input))) {
+    if (output->type == kTfLiteInt16) {
+      SoftmaxInt8Simd(op_data, tflite::micro::GetTensorShape(input),
+                      tflite::micro::GetTensorData<int8_t>(input),
+                      tflite::micro::GetTensorShape(output),
+                      tflite::micro::GetTensorData<int16_t>(output));
+    } else {
+      SoftmaxInt8Simd(op_data, tflite::micro::GetTensorShape(input),
+                      tflite::micro::GetTensorData<int8_t>(input),
+                      tflite::micro::GetTensorShape(output),
+                      tflite::micro::GetTensorData<int8_t>(output));
+    }
+  } else if (input->type == kTfLiteInt8) {
     if (output->type == kTfLiteInt16) {
       tflite::reference_ops::Softmax(
           op_data, tflite::micro::GetTensorShape(input),
@@ -0,0 +1,118 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/softmax_simd.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/simd.h"
+
+namespace tflite {
+namespace {
+
+// Same fixed-point formats as reference_ops::Softmax: Q5.26 scaled
+// differences and a Q12.19 sum of exponentials.
+constexpr int kScaledDiffIntegerBits = 5;
+constexpr int kAccumulationIntegerBits = 12;
+using FixedPointScaledDiff =
+    gemmlowp::FixedPoint<int32_t, kScaledDiffIntegerBits>;
+using FixedPointAccum = gemmlowp::FixedPoint<int32_t, kAccumulationIntegerBits>;
+using FixedPoint0 = gemmlowp::FixedPoint<int32_t, 0>;
+
+template <typename OutputT>
+void SoftmaxInt8Rows(const SoftmaxParams& params,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& output_shape, OutputT* output_data) {
+  const int trailing_dim = input_shape.DimensionsCount() - 1;
+  const int outer_size =
+      MatchingFlatSizeSkipDim(input_shape, trailing_dim, output_shape);
+  const int depth =
+      MatchingDim(input_shape, trailing_dim, output_shape, trailing_dim);
+  TFLITE_DCHECK_LE(depth, kSoftmaxSimdMaxDepth);
+
+  // Exponentials of the row, 0 for the elements below diff_min, which the
+  // reference kernel leaves out of the sum.
+  int32_t exps[kSoftmaxSimdMaxDepth];
+  for (int i = 0; i < outer_size; ++i) {
+    const int8_t* input = input_data + i * depth;
+    OutputT* output = output_data + i * depth;
+    const int32_t max_in_row = simd::ReduceMaxInt8(input, depth);
+
+    FixedPointAccum sum_of_exps = FixedPointAccum::Zero();
+    for (int c = 0; c < depth; ++c) {
+      const int32_t input_diff = static_cast<int32_t>(input[c]) - max_in_row;
+      if (input_diff < params.diff_min) {
+        exps[c] = 0;
+        continue;
+      }
+      const int32_t input_diff_rescaled =
+          MultiplyByQuantizedMultiplierGreaterThanOne(
+              input_diff, params.input_multiplier, params.input_left_shift);
+      const FixedPoint0 exp_in_0 = exp_on_negative_values(
+          FixedPointScaledDiff::FromRaw(input_diff_rescaled));
+      exps[c] = exp_in_0.raw();
+      sum_of_exps = sum_of_exps +
+                    gemmlowp::Rescale<kAccumulationIntegerBits>(exp_in_0);
+    }
+
+    int num_bits_over_unit;
+    const FixedPoint0 shifted_scale = FixedPoint0::FromRaw(GetReciprocal(
+        sum_of_exps.raw(), kAccumulationIntegerBits, &num_bits_over_unit));
+    const int exponent = num_bits_over_unit + 31 - (sizeof(OutputT) * 8);
+    TFLITE_CHECK(0 <= exponent && exponent <= 31);
+
+    for (int c = 0; c < depth; ++c) {
+      if (static_cast<int32_t>(input[c]) - max_in_row < params.diff_min) {
+        output[c] = std::numeric_limits<OutputT>::min();
+        continue;
+      }
+      const int32_t unsat_output = gemmlowp::RoundingDivideByPOT(
+          (shifted_scale * FixedPoint0::FromRaw(exps[c])).raw(), exponent);
+      const int32_t shifted_output =
+          unsat_output +
+          static_cast<int32_t>(std::numeric_limits<OutputT>::min());
+      output[c] = static_cast<OutputT>(std::max(
+          std::min(shifted_output,
+                   static_cast<int32_t>(std::numeric_limits<OutputT>::max())),
+          static_cast<int32_t>(std::numeric_limits<OutputT>::min())));
+    }
+  }
+}
+
+}  // namespace
+
+bool SoftmaxSimdSupported(const RuntimeShape& input_shape) {
+  return input_shape.DimensionsCount() >= 1 &&
+         input_shape.Dims(input_shape.DimensionsCount() - 1) <=
+             kSoftmaxSimdMaxDepth;
+}
+
+void SoftmaxInt8Simd(const SoftmaxParams& params,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& output_shape, int8_t* output_data) {
+  SoftmaxInt8Rows(params, input_shape, input_data, output_shape, output_data);
+}
+
+void SoftmaxInt8Simd(const SoftmaxParams& params,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& output_shape, int16_t* output_data) {
+  SoftmaxInt8Rows(params, input_shape, input_data, output_shape, output_data);
+}
+
+}  // namespace tflite
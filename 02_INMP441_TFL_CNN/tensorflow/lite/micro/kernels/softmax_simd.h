@@ -0,0 +1,47 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_SOFTMAX_SIMD_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_SOFTMAX_SIMD_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Int8 softmax for short rows such as the class scores of a classifier. The
+// row maximum is found with simd::ReduceMaxInt8, and the fixed-point
+// exponential of each element is evaluated once and kept on the stack for
+// the normalisation pass, which the reference kernel recomputes. The output
+// is exactly that of reference_ops::Softmax.
+
+// Longest row SoftmaxInt8Simd handles.
+constexpr int kSoftmaxSimdMaxDepth = 64;
+
+// Returns true if SoftmaxInt8Simd supports rows of this shape.
+bool SoftmaxSimdSupported(const RuntimeShape& input_shape);
+
+void SoftmaxInt8Simd(const SoftmaxParams& params,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& output_shape, int8_t* output_data);
+
+void SoftmaxInt8Simd(const SoftmaxParams& params,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& output_shape, int16_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_SOFTMAX_SIMD_H_
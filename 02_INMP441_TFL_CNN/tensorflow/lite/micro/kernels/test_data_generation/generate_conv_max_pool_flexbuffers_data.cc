@@ -0,0 +1,94 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "flatbuffers/flexbuffers.h"
+
+const char* license =
+    "/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.\n"
+    "Licensed under the Apache License, Version 2.0 (the \"License\");\n"
+    "you may not use this file except in compliance with the License.\n"
+    "You may obtain a copy of the License at\n\n"
+    "    http://www.apache.org/licenses/LICENSE-2.0\n\n"
+    "Unless required by applicable law or agreed to in writing, software\n"
+    "distributed under the License is distributed on an \"AS IS\" BASIS,\n"
+    "WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n"
+    "See the License for the specific language governing permissions and\n"
+    "limitations under the License.\n"
+    "======================================================================="
+    "=======*/\n";
+
+// Padding and ActivationFunctionType values of the schema.
+constexpr int kPaddingSame = 0;
+constexpr int kPaddingValid = 1;
+constexpr int kActivationNone = 0;
+constexpr int kActivationRelu = 1;
+constexpr int kActivationRelu6 = 3;
+
+void generate(const char* name, int padding, int stride, int activation,
+              int pool_padding, int pool_filter, int pool_stride,
+              int pool_activation) {
+  flexbuffers::Builder fbb;
+  fbb.Map([&]() {
+    fbb.Int("activation", activation);
+    fbb.Int("dilation_h_factor", 1);
+    fbb.Int("dilation_w_factor", 1);
+    fbb.Int("padding", padding);
+    fbb.Int("pool_activation", pool_activation);
+    fbb.Int("pool_filter_height", pool_filter);
+    fbb.Int("pool_filter_width", pool_filter);
+    fbb.Int("pool_padding", pool_padding);
+    fbb.Int("pool_stride_h", pool_stride);
+    fbb.Int("pool_stride_w", pool_stride);
+    fbb.Int("stride_h", stride);
+    fbb.Int("stride_w", stride);
+  });
+  fbb.Finish();
+
+  // fbb.GetBuffer returns std::Vector<uint8_t> but TfLite passes char arrays
+  // for the raw data, and so we reinterpret_cast.
+  const uint8_t* init_data =
+      reinterpret_cast<const uint8_t*>(fbb.GetBuffer().data());
+  size_t fbb_size = fbb.GetBuffer().size();
+
+  printf("const int g_gen_data_size_%s = %zu;\n", name, fbb_size);
+  printf("const unsigned char g_gen_data_%s[] = { ", name);
+  for (size_t i = 0; i < fbb_size; i++) {
+    printf("0x%02x, ", init_data[i]);
+  }
+  printf("};\n");
+}
+
+int main() {
+  printf("%s\n", license);
+  printf("// This file is generated. See:\n");
+  printf("// third_party/tensorflow/lite/micro/kernels/test_data_generation/");
+  printf("README.md\n");
+  printf("\n");
+  printf(
+      "#include \"third_party/tensorflow/lite/micro/kernels/"
+      "conv_max_pool_flexbuffers_generated_data.h\"");
+  printf("\n\n");
+  // Conv2D(relu) -> MaxPool2D(2, 2) with 'same' padding, as in the INMP441
+  // speech CNN.
+  generate("conv_max_pool_same_relu", kPaddingSame, /*stride=*/1,
+           kActivationRelu, kPaddingSame, /*pool_filter=*/2,
+           /*pool_stride=*/2, kActivationNone);
+  printf("\n");
+  // Strided 'valid' convolution followed by overlapping 3x3 / 2 windows and a
+  // pool activation.
+  generate("conv_max_pool_valid_overlap", kPaddingValid, /*stride=*/2,
+           kActivationNone, kPaddingValid, /*pool_filter=*/3,
+           /*pool_stride=*/2, kActivationRelu6);
+}
@@ -57,21 +57,21 @@ constexpr int kKeywordModelNodeAndRegistrationCount = 15;
 // Total size contributed by the keyword model excluding the
 // RecordingMicroAllocator's overhead
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kKeywordModelOnlyTotalSize = 14472;
+constexpr int kKeywordModelOnlyTotalSize = 19504;
 // Tail size contributed by the kdyword model excluding the
 // RecordingMicroAllocator's overhead
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kKeywordModelOnlyTailSize = 13800;
+constexpr int kKeywordModelOnlyTailSize = 18832;
 constexpr int kKeywordModelPersistentTfLiteTensorDataSize = 128;
 #else
 // Total size contributed by the keyword model excluding the
 // RecordingMicroAllocator's overhead.
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kKeywordModelOnlyTotalSize = 14936;
+constexpr int kKeywordModelOnlyTotalSize = 19968;
 // Tail size contributed by the keyword model excluding the
 // RecordingMicroAllocator's overhead
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kKeywordModelOnlyTailSize = 14264;
+constexpr int kKeywordModelOnlyTailSize = 19296;
 constexpr int kKeywordModelPersistentTfLiteTensorDataSize = 224;
 #endif
 constexpr int kKeywordModelHeadSize = 672;
@@ -79,16 +79,16 @@ constexpr int kKeywordModelTfLiteTensorVariableBufferDataSize = 10240;
 constexpr int kKeywordModelPersistentTfLiteTensorQuantizationData = 64;
 constexpr int kKeywordModelOpRuntimeDataSize = 148;
 
-constexpr int kTestConvModelArenaSize = 12 * 1024;
+constexpr int kTestConvModelArenaSize = 28 * 1024;
 uint8_t test_conv_tensor_arena[kTestConvModelArenaSize];
 
 constexpr int kTestConvModelTensorCount = 15;
 constexpr int kTestConvModelNodeAndRegistrationCount = 7;
 
 #if defined(USE_TFLM_COMPRESSION)
-constexpr int kKeywordModelPersistentBufferDataSize = 920;
+constexpr int kKeywordModelPersistentBufferDataSize = 5488;
 #else
-constexpr int kKeywordModelPersistentBufferDataSize = 840;
+constexpr int kKeywordModelPersistentBufferDataSize = 5408;
 #endif
 
 // NOTE: These values are measured on x86-64:
@@ -97,26 +97,26 @@ constexpr int kKeywordModelPersistentBufferDataSize = 840;
 // Total size contributed by the conv model excluding the
 // RecordingMicroAllocator's overhead
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kTestConvModelOnlyTotalSize = 9576;
+constexpr int kTestConvModelOnlyTotalSize = 25200;
 // Tail size contributed by the conv model excluding the
 // RecordingMicroAllocator's overhead
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kTestConvModelOnlyTailSize = 1832;
+constexpr int kTestConvModelOnlyTailSize = 16592;
 constexpr int kTestConvModelPersistentTfLiteTensorDataSize = 128;
-constexpr int kTestConvModelPersistentBufferDataSize = 748;
+constexpr int kTestConvModelPersistentBufferDataSize = 15044;
 #else
 // Total size contributed by the conv model excluding the
 // RecordingMicroAllocator's overhead
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kTestConvModelOnlyTotalSize = 9832;
+constexpr int kTestConvModelOnlyTotalSize = 25456;
 // Tail size contributed by the conv model excluding the
 // RecordingMicroAllocator's overhead
 // TODO(b/207157610): replace magic number that depends on OPs
-constexpr int kTestConvModelOnlyTailSize = 2088;
+constexpr int kTestConvModelOnlyTailSize = 16848;
 constexpr int kTestConvModelPersistentTfLiteTensorDataSize = 224;
-constexpr int kTestConvModelPersistentBufferDataSize = 740;
+constexpr int kTestConvModelPersistentBufferDataSize = 15036;
 #endif
-constexpr int kTestConvModelHeadSize = 7744;
+constexpr int kTestConvModelHeadSize = 8608;
 constexpr int kTestConvModelOpRuntimeDataSize = 136;
 constexpr int kTestConvModelPersistentTfLiteTensorQuantizationData = 0;
 
@@ -207,12 +207,15 @@ void ValidateModelAllocationThresholds(
       sizeof(tflite::NodeAndRegistration) *
           thresholds.node_and_registration_count);
 
-  // Ensure tail allocation recording is not missing any large chunks:
+  // Ensure tail allocation recording is not missing any large chunks. The
+  // persistent buffers hold the fully connected kernels' packed weights, which
+  // are as large as the weights themselves:
   size_t tail_est_length = sizeof(TfLiteEvalTensor) * thresholds.tensor_count +
                            thresholds.tensor_variable_buffer_data_size +
                            sizeof(tflite::NodeAndRegistration) *
                                thresholds.node_and_registration_count +
-                           thresholds.op_runtime_data_size;
+                           thresholds.op_runtime_data_size +
+                           thresholds.persistent_buffer_data;
   TF_LITE_MICRO_EXPECT_LE(thresholds.tail_alloc_size - tail_est_length,
                           kAllocationTailMiscCeiling);
 }
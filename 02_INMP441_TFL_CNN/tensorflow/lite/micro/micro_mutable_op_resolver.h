@@ -193,6 +193,14 @@ class MicroMutableOpResolver : public MicroOpResolver {
     return AddCustom("CIRCULAR_BUFFER", tflite::Register_CIRCULAR_BUFFER());
   }
 
+  // Int8 SOFTMAX replaced by replace_softmax_with_classification_head in
+  // tools/model_transforms_utils.py.
+  TfLiteStatus AddClassificationHead() {
+    const TFLMRegistration& registration =
+        tflite::Register_CLASSIFICATION_HEAD();
+    return AddCustom("CLASSIFICATION_HEAD", &registration);
+  }
+
   TfLiteStatus AddConcatenation(
       const TFLMRegistration& registration = Register_CONCATENATION()) {
     return AddBuiltin(BuiltinOperator_CONCATENATION, registration,
@@ -204,6 +212,14 @@ class MicroMutableOpResolver : public MicroOpResolver {
     return AddBuiltin(BuiltinOperator_CONV_2D, registration, ParseConv2D);
   }
 
+  // CONV_2D followed by MAX_POOL_2D, as fused by fuse_conv_max_pool in
+  // tools/model_transforms_utils.py.
+  TfLiteStatus AddConv2DMaxPool2D() {
+    const TFLMRegistration& registration =
+        tflite::Register_CONV_2D_MAX_POOL_2D();
+    return AddCustom("CONV_2D_MAX_POOL_2D", &registration);
+  }
+
   TfLiteStatus AddCos(const TFLMRegistration& registration = Register_COS()) {
     return AddBuiltin(BuiltinOperator_COS, registration, ParseCos);
   }
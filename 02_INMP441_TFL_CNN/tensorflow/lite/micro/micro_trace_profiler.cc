@@ -0,0 +1,231 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/micro/micro_trace_profiler.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "tensorflow/lite/kernels/internal/compatibility.h"
+#include "tensorflow/lite/micro/micro_time.h"
+
+namespace tflite {
+namespace {
+
+void WriteUint16(uint8_t* buffer, uint16_t value) {
+  buffer[0] = static_cast<uint8_t>(value & 0xFF);
+  buffer[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void WriteUint32(uint8_t* buffer, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    buffer[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+}  // namespace
+
+MicroTraceProfiler::MicroTraceProfiler()
+    : MicroTraceProfiler(&GetCurrentTimeTicks, tflite::ticks_per_second()) {}
+
+MicroTraceProfiler::MicroTraceProfiler(TickFunction tick_function,
+                                       uint32_t ticks_per_second)
+    : tick_function_(tick_function), ticks_per_second_(ticks_per_second) {
+  TFLITE_DCHECK(tick_function_ != nullptr);
+}
+
+uint32_t MicroTraceProfiler::BeginEvent(const char* tag) {
+  const uint32_t handle = depth_;
+  if (depth_ < kMaxDepth) {
+    OpenEvent& event = open_events_[depth_];
+    event.tag_id = InternTag(tag);
+    event.index = next_index_[depth_]++;
+    // Children of this event are numbered from zero.
+    next_index_[depth_ + 1] = 0;
+    event.start_ticks = tick_function_();
+  }
+  ++depth_;
+  return handle;
+}
+
+void MicroTraceProfiler::EndEvent(uint32_t event_handle) {
+  const uint32_t end_ticks = tick_function_();
+  if (event_handle >= static_cast<uint32_t>(depth_)) {
+    // The event was already closed together with an enclosing event.
+    return;
+  }
+  depth_ = static_cast<int>(event_handle);
+  if (event_handle >= static_cast<uint32_t>(kMaxDepth)) {
+    return;
+  }
+  const OpenEvent& event = open_events_[event_handle];
+  MicroTraceRecord record;
+  record.index = event.index;
+  record.tag_id = event.tag_id;
+  record.depth = static_cast<uint8_t>(event_handle);
+  record.ticks = end_ticks - event.start_ticks;
+  PushRecord(record);
+}
+
+void MicroTraceProfiler::BeginFrame() {
+  const uint32_t now = tick_function_();
+  if (frame_started_) {
+    MicroTraceRecord record;
+    record.index = next_index_[0];
+    record.tag_id = kFrameTagId;
+    record.depth = 0;
+    record.ticks = now - frame_start_ticks_;
+    PushRecord(record);
+  }
+  frame_started_ = true;
+  frame_start_ticks_ = now;
+  next_index_[0] = 0;
+  depth_ = 0;
+}
+
+void MicroTraceProfiler::ClearEvents() {
+  head_ = 0;
+  num_records_ = 0;
+  dropped_ = 0;
+}
+
+const MicroTraceRecord& MicroTraceProfiler::GetRecord(int i) const {
+  TFLITE_DCHECK(i >= 0 && i < num_records_);
+  int position = head_ - num_records_ + i;
+  if (position < 0) {
+    position += kMaxRecords;
+  }
+  return records_[position];
+}
+
+const char* MicroTraceProfiler::TagName(uint8_t tag_id) const {
+  if (tag_id == kFrameTagId) {
+    return "Frame";
+  }
+  if (tag_id == kOverflowTagId) {
+    return "Other";
+  }
+  return tag_id < num_tags_ ? tags_[tag_id] : nullptr;
+}
+
+size_t MicroTraceProfiler::Serialize(uint8_t* buffer, size_t buffer_size) {
+  constexpr size_t kChecksumSize = 1;
+  const bool has_pending_tags = num_tags_exported_ < num_tags_;
+  if (num_records_ == 0 && !has_pending_tags) {
+    return 0;
+  }
+  if (buffer_size <
+      kPacketHeaderSize + sizeof(MicroTraceRecord) + kChecksumSize) {
+    return 0;
+  }
+
+  size_t offset = kPacketHeaderSize;
+  const size_t limit = buffer_size - kChecksumSize;
+
+  // Tag definitions are sent before the records that reference them, so a
+  // decoder attached from the first packet never sees an unknown id.
+  uint8_t num_tags = 0;
+  while (num_tags_exported_ < num_tags_) {
+    const char* tag = tags_[num_tags_exported_];
+    size_t length = tag_lengths_[num_tags_exported_];
+    if (offset + 2 + length > limit) {
+      if (offset > kPacketHeaderSize) {
+        break;
+      }
+      // The tag alone does not fit in this buffer: truncate it rather than
+      // leave it, and every record after it, pending forever.
+      length = limit - offset - 2;
+    }
+    buffer[offset++] = static_cast<uint8_t>(num_tags_exported_);
+    buffer[offset++] = static_cast<uint8_t>(length);
+    memcpy(buffer + offset, tag, length);
+    offset += length;
+    ++num_tags_exported_;
+    ++num_tags;
+  }
+
+  uint16_t num_records = 0;
+  while (num_records_ > 0 && offset + sizeof(MicroTraceRecord) <= limit &&
+         num_records < UINT16_MAX) {
+    const MicroTraceRecord& record = GetRecord(0);
+    if (record.tag_id < kOverflowTagId &&
+        record.tag_id >= num_tags_exported_) {
+      // The definition of this tag did not fit, send it in the next packet.
+      break;
+    }
+    WriteUint16(buffer + offset, record.index);
+    buffer[offset + 2] = record.tag_id;
+    buffer[offset + 3] = record.depth;
+    WriteUint32(buffer + offset + 4, record.ticks);
+    offset += sizeof(MicroTraceRecord);
+    --num_records_;
+    ++num_records;
+  }
+  if (num_tags == 0 && num_records == 0) {
+    return 0;
+  }
+
+  buffer[0] = kTraceMagic0;
+  buffer[1] = kTraceMagic1;
+  buffer[2] = kTraceFormatVersion;
+  buffer[3] = num_tags;
+  WriteUint16(buffer + 4, num_records);
+  WriteUint16(buffer + 6,
+              static_cast<uint16_t>(dropped_ > UINT16_MAX ? UINT16_MAX
+                                                          : dropped_));
+  WriteUint32(buffer + 8, ticks_per_second_);
+  dropped_ = 0;
+
+  uint8_t checksum = 0;
+  for (size_t i = 2; i < offset; ++i) {
+    checksum += buffer[i];
+  }
+  buffer[offset++] = checksum;
+  return offset;
+}
+
+uint8_t MicroTraceProfiler::InternTag(const char* tag) {
+  // Operator names are string literals, so the pointer comparison hits for
+  // every invocation after the first one.
+  for (int i = 0; i < num_tags_; ++i) {
+    if (tags_[i] == tag) {
+      return static_cast<uint8_t>(i);
+    }
+  }
+  for (int i = 0; i < num_tags_; ++i) {
+    if (strcmp(tags_[i], tag) == 0) {
+      return static_cast<uint8_t>(i);
+    }
+  }
+  if (num_tags_ == kMaxTags) {
+    return kOverflowTagId;
+  }
+  const size_t length = strlen(tag);
+  tags_[num_tags_] = tag;
+  tag_lengths_[num_tags_] = static_cast<uint8_t>(
+      length > kMaxTagLength ? kMaxTagLength : length);
+  return static_cast<uint8_t>(num_tags_++);
+}
+
+void MicroTraceProfiler::PushRecord(const MicroTraceRecord& record) {
+  records_[head_] = record;
+  head_ = (head_ + 1) % kMaxRecords;
+  if (num_records_ == kMaxRecords) {
+    ++dropped_;
+  } else {
+    ++num_records_;
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,172 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_MICRO_TRACE_PROFILER_H_
+#define TENSORFLOW_LITE_MICRO_MICRO_TRACE_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/micro/compatibility.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+
+namespace tflite {
+
+// Compact record emitted for every completed event. Records are 8 bytes so
+// that a few hundred of them fit in a couple of kilobytes of RAM.
+struct MicroTraceRecord {
+  // Position of the event among its siblings. For events nested inside an
+  // Invoke() stage this is the operator index within the subgraph.
+  uint16_t index;
+  // Interned tag identifier, see MicroTraceProfiler::TagName().
+  uint8_t tag_id;
+  // Nesting depth of the event (0 for top level stages).
+  uint8_t depth;
+  // Duration of the event in ticks of the profiler clock.
+  uint32_t ticks;
+};
+
+// MicroTraceProfiler is an always-on, constant memory alternative to
+// MicroProfiler. Instead of keeping one slot per event and aborting once the
+// slots run out, completed events are written into a fixed ring of
+// MicroTraceRecord entries. The oldest records are overwritten when the ring is
+// not drained fast enough and the number of lost records is reported in the
+// next exported packet.
+//
+// Tags are interned into a small table so that each record stores a one byte
+// identifier instead of a pointer. Because the interpreter passes the same
+// string literal for every invocation of an operator, the lookup is a pointer
+// comparison in the common case. Exported tag names are truncated to
+// kMaxTagLength bytes, and further to the room of an empty packet when the
+// export buffer is smaller.
+//
+// Records are exported with Serialize() as self-delimiting binary packets that
+// can be written to any byte stream (UART, socket, file) and decoded on the
+// host with tensorflow/lite/micro/tools/trace_profiler_decode.py.
+//
+// Packet layout (little endian):
+//   uint8  magic[2]          0xA5 0x54
+//   uint8  version           kTraceFormatVersion
+//   uint8  num_tags          tag definitions that follow the header
+//   uint16 num_records       records that follow the tag definitions
+//   uint16 dropped           records lost to ring overflow (saturating)
+//   uint32 ticks_per_second  resolution of the profiler clock
+//   num_tags    x { uint8 id, uint8 length, char name[length] }
+//   num_records x MicroTraceRecord
+//   uint8  checksum          sum of all preceding bytes after the magic
+class MicroTraceProfiler : public MicroProfilerInterface {
+ public:
+  // Function returning the current value of the profiler clock.
+  typedef uint32_t (*TickFunction)();
+
+  static constexpr uint8_t kTraceMagic0 = 0xA5;
+  static constexpr uint8_t kTraceMagic1 = 0x54;
+  static constexpr uint8_t kTraceFormatVersion = 1;
+  static constexpr size_t kPacketHeaderSize = 12;
+  // Tag identifier of the synthetic records produced by BeginFrame().
+  static constexpr uint8_t kFrameTagId = 0xFF;
+  // Tag identifier used once the tag table is full.
+  static constexpr uint8_t kOverflowTagId = 0xFE;
+
+  // By default the profiler uses GetCurrentTimeTicks() and ticks_per_second()
+  // from micro_time.h. Platforms where those are not implemented (they return
+  // 0 by default) can pass a cycle counter and its frequency instead.
+  MicroTraceProfiler();
+  MicroTraceProfiler(TickFunction tick_function, uint32_t ticks_per_second);
+  virtual ~MicroTraceProfiler() = default;
+
+  // Marks the start of a new event and returns an event handle that can be used
+  // to mark the end of the event via EndEvent. The lifetime of the tag
+  // parameter must exceed that of the MicroTraceProfiler.
+  virtual uint32_t BeginEvent(const char* tag) override;
+
+  // Marks the end of an event associated with event_handle and appends its
+  // record to the ring. Events are expected to be properly nested (which is
+  // always the case with ScopedMicroProfiler); inner events that are still
+  // open when an outer event ends are discarded.
+  virtual void EndEvent(uint32_t event_handle) override;
+
+  // Starts a new top level frame (for example one iteration of the
+  // application loop). Emits a record tagged kFrameTagId whose ticks are the
+  // duration of the previous frame and restarts the sibling indices.
+  void BeginFrame();
+
+  // Discards all recorded events. Interned tags are kept.
+  void ClearEvents();
+
+  // Writes as many pending tag definitions and records as fit into buffer as
+  // one packet and removes them from the ring. Returns the number of bytes
+  // written, or 0 if there is nothing to export, the buffer is smaller than
+  // a packet with a single record, or the packet would hold neither a tag nor
+  // a record, so that a loop calling Serialize() until it returns 0 always
+  // ends.
+  size_t Serialize(uint8_t* buffer, size_t buffer_size);
+
+  // Number of records currently held in the ring.
+  int NumRecords() const { return num_records_; }
+
+  // Returns the i-th oldest record in the ring without removing it.
+  const MicroTraceRecord& GetRecord(int i) const;
+
+  // Number of records overwritten since the last Serialize() call.
+  uint32_t NumDropped() const { return dropped_; }
+
+  // Returns the tag interned under tag_id, or nullptr for unknown ids.
+  const char* TagName(uint8_t tag_id) const;
+
+  uint32_t ticks_per_second() const { return ticks_per_second_; }
+
+ private:
+  static constexpr int kMaxRecords = 256;
+  static constexpr int kMaxTags = 64;
+  static constexpr int kMaxDepth = 8;
+  // Operator and stage names are short; longer tags are truncated.
+  static constexpr int kMaxTagLength = 63;
+
+  struct OpenEvent {
+    uint32_t start_ticks;
+    uint16_t index;
+    uint8_t tag_id;
+  };
+
+  uint8_t InternTag(const char* tag);
+  void PushRecord(const MicroTraceRecord& record);
+
+  TickFunction tick_function_;
+  uint32_t ticks_per_second_;
+
+  MicroTraceRecord records_[kMaxRecords];
+  int head_ = 0;
+  int num_records_ = 0;
+  uint32_t dropped_ = 0;
+
+  const char* tags_[kMaxTags] = {};
+  // Exported length of each tag, at most kMaxTagLength.
+  uint8_t tag_lengths_[kMaxTags] = {};
+  int num_tags_ = 0;
+  int num_tags_exported_ = 0;
+
+  OpenEvent open_events_[kMaxDepth];
+  uint16_t next_index_[kMaxDepth + 1] = {};
+  int depth_ = 0;
+  uint32_t frame_start_ticks_ = 0;
+  bool frame_started_ = false;
+
+  TF_LITE_REMOVE_VIRTUAL_DELETE
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_MICRO_TRACE_PROFILER_H_
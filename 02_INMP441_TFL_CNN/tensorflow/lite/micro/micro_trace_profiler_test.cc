@@ -0,0 +1,195 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/micro_trace_profiler.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "tensorflow/lite/micro/micro_profiler.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace {
+
+// Deterministic clock: every read advances time by 10 ticks.
+uint32_t fake_ticks = 0;
+uint32_t FakeTicks() {
+  fake_ticks += 10;
+  return fake_ticks;
+}
+
+constexpr uint32_t kFakeTicksPerSecond = 1000;
+
+}  // namespace
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(TestNestedEventsRecordIndexAndDepth) {
+  fake_ticks = 0;
+  tflite::MicroTraceProfiler profiler(&FakeTicks, kFakeTicksPerSecond);
+
+  profiler.BeginFrame();
+  {
+    tflite::ScopedMicroProfiler stage("Invoke", &profiler);
+    { tflite::ScopedMicroProfiler op("CONV_2D", &profiler); }
+    { tflite::ScopedMicroProfiler op("MAX_POOL_2D", &profiler); }
+    { tflite::ScopedMicroProfiler op("CONV_2D", &profiler); }
+  }
+
+  // Records are appended when events end, so the enclosing stage comes last.
+  TF_LITE_MICRO_EXPECT_EQ(profiler.NumRecords(), 4);
+
+  const tflite::MicroTraceRecord& first_op = profiler.GetRecord(0);
+  TF_LITE_MICRO_EXPECT_EQ(first_op.index, 0);
+  TF_LITE_MICRO_EXPECT_EQ(first_op.depth, 1);
+  TF_LITE_MICRO_EXPECT_EQ(first_op.ticks, 10u);
+  TF_LITE_MICRO_EXPECT_EQ(
+      strcmp(profiler.TagName(first_op.tag_id), "CONV_2D"), 0);
+
+  const tflite::MicroTraceRecord& third_op = profiler.GetRecord(2);
+  TF_LITE_MICRO_EXPECT_EQ(third_op.index, 2);
+  // Same tag interned once.
+  TF_LITE_MICRO_EXPECT_EQ(third_op.tag_id, first_op.tag_id);
+
+  const tflite::MicroTraceRecord& stage = profiler.GetRecord(3);
+  TF_LITE_MICRO_EXPECT_EQ(stage.index, 0);
+  TF_LITE_MICRO_EXPECT_EQ(stage.depth, 0);
+  TF_LITE_MICRO_EXPECT_EQ(strcmp(profiler.TagName(stage.tag_id), "Invoke"), 0);
+  // Begin and end of three children plus the stage's own end read.
+  TF_LITE_MICRO_EXPECT_EQ(stage.ticks, 70u);
+}
+
+TF_LITE_MICRO_TEST(TestBeginFrameEmitsFrameRecord) {
+  fake_ticks = 0;
+  tflite::MicroTraceProfiler profiler(&FakeTicks, kFakeTicksPerSecond);
+
+  profiler.BeginFrame();
+  { tflite::ScopedMicroProfiler stage("Capture", &profiler); }
+  { tflite::ScopedMicroProfiler stage("Spectrogram", &profiler); }
+  profiler.BeginFrame();
+
+  TF_LITE_MICRO_EXPECT_EQ(profiler.NumRecords(), 3);
+  TF_LITE_MICRO_EXPECT_EQ(profiler.GetRecord(1).index, 1);
+  const tflite::MicroTraceRecord& frame = profiler.GetRecord(2);
+  TF_LITE_MICRO_EXPECT_EQ(frame.tag_id,
+                          tflite::MicroTraceProfiler::kFrameTagId);
+  TF_LITE_MICRO_EXPECT_EQ(frame.ticks, 50u);
+}
+
+TF_LITE_MICRO_TEST(TestRingOverwritesOldestRecords) {
+  fake_ticks = 0;
+  tflite::MicroTraceProfiler profiler(&FakeTicks, kFakeTicksPerSecond);
+
+  constexpr int kEvents = 300;
+  for (int i = 0; i < kEvents; ++i) {
+    tflite::ScopedMicroProfiler stage("Invoke", &profiler);
+  }
+
+  TF_LITE_MICRO_EXPECT_EQ(profiler.NumRecords(), 256);
+  TF_LITE_MICRO_EXPECT_EQ(profiler.NumDropped(), 44u);
+  // The oldest surviving record is the 45th event.
+  TF_LITE_MICRO_EXPECT_EQ(profiler.GetRecord(0).index, 44);
+}
+
+TF_LITE_MICRO_TEST(TestSerializePacketLayout) {
+  fake_ticks = 0;
+  tflite::MicroTraceProfiler profiler(&FakeTicks, kFakeTicksPerSecond);
+
+  { tflite::ScopedMicroProfiler stage("FFT", &profiler); }
+  { tflite::ScopedMicroProfiler stage("FFT", &profiler); }
+
+  uint8_t buffer[64];
+  size_t size = profiler.Serialize(buffer, sizeof(buffer));
+  // Header, one tag definition ("FFT"), two records and the checksum.
+  TF_LITE_MICRO_EXPECT_EQ(size, 12u + 5u + 16u + 1u);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[0], 0xA5);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[1], 0x54);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[3], 1);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[4], 2);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[8], kFakeTicksPerSecond & 0xFF);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[12], 0);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[13], 3);
+  TF_LITE_MICRO_EXPECT_EQ(memcmp(buffer + 14, "FFT", 3), 0);
+  // Second record: index 1, tag 0, depth 0, 10 ticks.
+  TF_LITE_MICRO_EXPECT_EQ(buffer[25], 1);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[29], 10);
+
+  uint8_t checksum = 0;
+  for (size_t i = 2; i < size - 1; ++i) {
+    checksum += buffer[i];
+  }
+  TF_LITE_MICRO_EXPECT_EQ(buffer[size - 1], checksum);
+
+  // Everything was drained and the tag is not sent again.
+  TF_LITE_MICRO_EXPECT_EQ(profiler.NumRecords(), 0);
+  TF_LITE_MICRO_EXPECT_EQ(profiler.Serialize(buffer, sizeof(buffer)), 0u);
+  { tflite::ScopedMicroProfiler stage("FFT", &profiler); }
+  TF_LITE_MICRO_EXPECT_EQ(profiler.Serialize(buffer, sizeof(buffer)),
+                          12u + 8u + 1u);
+}
+
+TF_LITE_MICRO_TEST(TestSerializeSplitsAcrossSmallBuffers) {
+  fake_ticks = 0;
+  tflite::MicroTraceProfiler profiler(&FakeTicks, kFakeTicksPerSecond);
+
+  for (int i = 0; i < 5; ++i) {
+    tflite::ScopedMicroProfiler stage("A", &profiler);
+  }
+
+  // Room for the header, the tag definition and two records.
+  uint8_t buffer[12 + 3 + 16 + 1];
+  TF_LITE_MICRO_EXPECT_EQ(profiler.Serialize(buffer, sizeof(buffer)),
+                          sizeof(buffer));
+  TF_LITE_MICRO_EXPECT_EQ(buffer[4], 2);
+  TF_LITE_MICRO_EXPECT_EQ(profiler.NumRecords(), 3);
+  TF_LITE_MICRO_EXPECT_EQ(profiler.Serialize(buffer, sizeof(buffer)),
+                          12u + 16u + 1u);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[3], 0);
+  TF_LITE_MICRO_EXPECT_EQ(profiler.NumRecords(), 1);
+}
+
+TF_LITE_MICRO_TEST(TestSerializeTruncatesLongTags) {
+  fake_ticks = 0;
+  tflite::MicroTraceProfiler profiler(&FakeTicks, kFakeTicksPerSecond);
+
+  char long_tag[300];
+  memset(long_tag, 'x', sizeof(long_tag) - 1);
+  long_tag[sizeof(long_tag) - 1] = '\0';
+  { tflite::ScopedMicroProfiler stage(long_tag, &profiler); }
+
+  // Interned tags are exported with at most 63 bytes.
+  uint8_t buffer[256];
+  TF_LITE_MICRO_EXPECT_EQ(profiler.Serialize(buffer, sizeof(buffer)),
+                          12u + 2u + 63u + 8u + 1u);
+  TF_LITE_MICRO_EXPECT_EQ(buffer[13], 63);
+
+  // In a buffer too small for it, the tag is cut to the free room and the
+  // record follows in the next packet.
+  tflite::MicroTraceProfiler small(&FakeTicks, kFakeTicksPerSecond);
+  { tflite::ScopedMicroProfiler stage(long_tag, &small); }
+  uint8_t small_buffer[12 + 8 + 1];
+  TF_LITE_MICRO_EXPECT_EQ(small.Serialize(small_buffer, sizeof(small_buffer)),
+                          sizeof(small_buffer));
+  TF_LITE_MICRO_EXPECT_EQ(small_buffer[3], 1);
+  TF_LITE_MICRO_EXPECT_EQ(small_buffer[13], 6);
+  TF_LITE_MICRO_EXPECT_EQ(small.Serialize(small_buffer, sizeof(small_buffer)),
+                          sizeof(small_buffer));
+  TF_LITE_MICRO_EXPECT_EQ(small_buffer[4], 1);
+  TF_LITE_MICRO_EXPECT_EQ(small.NumRecords(), 0);
+  TF_LITE_MICRO_EXPECT_EQ(small.Serialize(small_buffer, sizeof(small_buffer)),
+                          0u);
+}
+
+TF_LITE_MICRO_TESTS_END
@@ -20,11 +20,14 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <ios>
+#include <iterator>
 #include <memory>
 #include <random>
 #include <utility>
+#include <vector>
 
 #include "flatbuffers/flatbuffer_builder.h"
 #include "flatbuffers/util.h"
@@ -130,12 +133,10 @@ TfLiteStatus ConvertTensorType(TfLiteType type, TensorTypes& tensor_type) {
   return kTfLiteOk;
 }
 
-TfLiteStatus SetRandomInput(const uint32_t random_seed,
-                            const ModelT& unpacked_model,
+// Records the current contents of every model input tensor in output_data.
+TfLiteStatus StoreInputData(const ModelT& unpacked_model,
                             MicroInterpreter& interpreter,
                             ModelTestDataT& output_data) {
-  std::mt19937 eng(random_seed);
-  std::uniform_int_distribution<uint32_t> dist(0, 255);
   for (size_t i = 0; i < interpreter.inputs_size(); ++i) {
     TfLiteTensor* input = interpreter.input_tensor(i);
     std::unique_ptr<TensorDataT> test_data(new TensorDataT());
@@ -149,12 +150,8 @@ TfLiteStatus SetRandomInput(const uint32_t random_seed,
       test_data->shape.push_back(input->dims->data[x]);
     }
 
-    // Pre-populate input tensor with random values.
-    uint8_t* input_values = GetTensorData<uint8_t>(input);
-    for (size_t j = 0; j < input->bytes; ++j) {
-      input_values[j] = dist(eng);
-      test_data->data.push_back(input_values[j]);
-    }
+    const uint8_t* input_values = GetTensorData<uint8_t>(input);
+    test_data->data.assign(input_values, input_values + input->bytes);
     output_data.input_data.push_back(std::move(test_data));
   }
 
@@ -166,6 +163,86 @@ TfLiteStatus SetRandomInput(const uint32_t random_seed,
   return kTfLiteOk;
 }
 
+TfLiteStatus SetRandomInput(const uint32_t random_seed,
+                            const ModelT& unpacked_model,
+                            MicroInterpreter& interpreter,
+                            ModelTestDataT& output_data) {
+  std::mt19937 eng(random_seed);
+  std::uniform_int_distribution<uint32_t> dist(0, 255);
+  for (size_t i = 0; i < interpreter.inputs_size(); ++i) {
+    TfLiteTensor* input = interpreter.input_tensor(i);
+    // Pre-populate input tensor with random values.
+    uint8_t* input_values = GetTensorData<uint8_t>(input);
+    for (size_t j = 0; j < input->bytes; ++j) {
+      input_values[j] = dist(eng);
+    }
+  }
+  return StoreInputData(unpacked_model, interpreter, output_data);
+}
+
+// Returns the offset of the array data if contents is a .npy file, or 0 if it
+// holds raw tensor bytes.
+size_t NpyDataOffset(const std::vector<char>& contents) {
+  constexpr char kNpyMagic[] = "\x93NUMPY";
+  constexpr size_t kNpyMagicSize = sizeof(kNpyMagic) - 1;
+  if (contents.size() < kNpyMagicSize + 4 ||
+      memcmp(contents.data(), kNpyMagic, kNpyMagicSize) != 0) {
+    return 0;
+  }
+  const uint8_t* header = reinterpret_cast<const uint8_t*>(contents.data());
+  const uint8_t major_version = header[kNpyMagicSize];
+  if (major_version == 1) {
+    // Version 1.0 stores the header length as a uint16.
+    return kNpyMagicSize + 4 + (header[8] | (header[9] << 8));
+  }
+  if (contents.size() < kNpyMagicSize + 6) {
+    return contents.size();
+  }
+  return kNpyMagicSize + 6 +
+         (header[8] | (header[9] << 8) | (header[10] << 16) |
+          (static_cast<size_t>(header[11]) << 24));
+}
+
+// Pre-populates the input tensors with the contents of input_file_names, one
+// file per model input. Each file holds either the raw tensor bytes or a .npy
+// array whose data has exactly the size of the tensor (for example a
+// spectrogram computed by Python_INMP441/device_spectrogram.py). Unlike random
+// bytes, recorded inputs keep float models within the value range they were
+// trained on, which is what a golden comparison needs.
+TfLiteStatus SetFileInput(const std::vector<const char*>& input_file_names,
+                          const ModelT& unpacked_model,
+                          MicroInterpreter& interpreter,
+                          ModelTestDataT& output_data) {
+  if (input_file_names.size() != interpreter.inputs_size()) {
+    MicroPrintf("Model has %d inputs but %d input files were given",
+                static_cast<int>(interpreter.inputs_size()),
+                static_cast<int>(input_file_names.size()));
+    return kTfLiteError;
+  }
+  for (size_t i = 0; i < interpreter.inputs_size(); ++i) {
+    std::ifstream input_file(input_file_names[i], std::ios::binary);
+    if (!input_file.is_open()) {
+      MicroPrintf("could not open input file %s", input_file_names[i]);
+      return kTfLiteError;
+    }
+    std::vector<char> contents((std::istreambuf_iterator<char>(input_file)),
+                               std::istreambuf_iterator<char>());
+    const size_t offset = NpyDataOffset(contents);
+
+    TfLiteTensor* input = interpreter.input_tensor(i);
+    if (contents.size() < offset || contents.size() - offset != input->bytes) {
+      MicroPrintf("Input file %s has %d data bytes, input %d expects %d",
+                  input_file_names[i],
+                  static_cast<int>(contents.size() - offset),
+                  static_cast<int>(i), static_cast<int>(input->bytes));
+      return kTfLiteError;
+    }
+    memcpy(GetTensorData<uint8_t>(input), contents.data() + offset,
+           input->bytes);
+  }
+  return StoreInputData(unpacked_model, interpreter, output_data);
+}
+
 std::unique_ptr<char[]> ReadModelFile(const char* model_file_name) {
   std::ifstream model_file(model_file_name, std::ios::binary);
   if (!model_file.is_open()) {
@@ -248,7 +325,9 @@ bool WriteToFile(const char* output_file_name, ModelTestDataT& output_data) {
                   fbb.GetSize());
 }
 
-TfLiteStatus Invoke(const Model* model, ModelTestDataT& output_data) {
+TfLiteStatus Invoke(const Model* model,
+                    const std::vector<const char*>& input_file_names,
+                    ModelTestDataT& output_data) {
   const tflite::ModelT unpacked_model = *model->UnPack();
   alignas(16) static uint8_t tensor_arena[kTensorArenaSize];
 
@@ -274,8 +353,13 @@ TfLiteStatus Invoke(const Model* model, ModelTestDataT& output_data) {
   // return kTfLiteOk after the first invocation.
   uint32_t seed = kRandomSeed;
   while (true) {
-    TF_LITE_ENSURE_STATUS(
-        SetRandomInput(seed++, unpacked_model, interpreter, output_data));
+    if (input_file_names.empty()) {
+      TF_LITE_ENSURE_STATUS(
+          SetRandomInput(seed++, unpacked_model, interpreter, output_data));
+    } else {
+      TF_LITE_ENSURE_STATUS(SetFileInput(input_file_names, unpacked_model,
+                                         interpreter, output_data));
+    }
     TfLiteStatus status = interpreter.Invoke();
     if ((status != kTfLiteOk) && (static_cast<int>(status) != kTfLiteAbort)) {
       MicroPrintf("Model interpreter invocation failed: %d\n", status);
@@ -299,19 +383,23 @@ TfLiteStatus Invoke(const Model* model, ModelTestDataT& output_data) {
  using the tflite_model provided in the 1st arg :
    `bazel run tensorflow/lite/micro/tools:layer_by_layer_output_tool -- \
      </path/to/input_model.tflite>
-     </path/to/output.file_name>` */
+     </path/to/output.file_name>
+     [</path/to/input0.npy> ...]`
+ The optional trailing arguments provide the model inputs (raw tensor bytes or
+ .npy files, one per input). Random inputs are used when they are omitted. */
 
 int main(int argc, char** argv) {
-  if (argc < 2) {
+  if (argc < 3) {
     MicroPrintf("layer_by_layer: invalid usage!\n");
     MicroPrintf(
         "usage: layer_by_layer_output_tool  </path/to/input_model.tflite> "
-        "</path/to/output.file_name>");
+        "</path/to/output.file_name> [</path/to/input0.npy> ...]");
     return EXIT_FAILURE;
   }
 
   const char* model_file_name = argv[1];
   const char* output_file_name = argv[2];
+  const std::vector<const char*> input_file_names(argv + 3, argv + argc);
 
   const auto model_file_content = tflite::ReadModelFile(model_file_name);
 
@@ -324,7 +412,8 @@ int main(int argc, char** argv) {
 
   ModelTestDataT output_data;
 
-  TF_LITE_ENSURE_STATUS(tflite::Invoke(model, output_data));
+  TF_LITE_ENSURE_STATUS(
+      tflite::Invoke(model, input_file_names, output_data));
 
   if (!tflite::WriteToFile(output_file_name, output_data)) {
     MicroPrintf("Could not write to %s", output_file_name);
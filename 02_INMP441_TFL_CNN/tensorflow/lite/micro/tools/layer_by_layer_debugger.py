@@ -57,6 +57,33 @@ np.set_printoptions(threshold=sys.maxsize)
 #           a TfLite Model is Provided).It can be used to set the rng seed to a
 #           differen value then it's default value of 42.
 
+#   --input_data_files=</path/to/input0.npy>[,...]
+#           use recorded model inputs (one .npy per model input) instead of
+#           random data in the TfLite vs TFLM comparison.
+
+#   --error_stats
+#           report per layer error statistics (max difference in quantization
+#           steps, mismatching elements, RMSE and SNR) for every layer instead
+#           of stopping at the first layer that differs. The tool still fails
+#           if any layer differs by more than --max_quantized_diff steps.
+
+#   --keras_model=</path/to/model.h5>
+#           additionally compare every TFLM layer output (dequantized) with the
+#           activation of the matching layer of the float Keras model. Layers
+#           are matched by the Keras layer name recorded in the TfLite tensor
+#           names, or by order and output shape when the names differ. This
+#           comparison is informative: quantization error is expected here,
+#           only --min_keras_snr_db turns it into a check.
+
+# Example for the INMP441 keyword model, using a spectrogram computed the same
+# way as on the device:
+#   python3 Python_INMP441/device_spectrogram.py \
+#     "Python_INMP441/Dataset/1_One/ONE (1).wav" /tmp/one.npy
+#   bazel run tensorflow/lite/micro/tools:layer_by_layer_debugger -- \
+#     --input_tflite_file=tensorflow/lite/micro/models/inmp441_cnn.tflite \
+#     --input_data_files=/tmp/one.npy --error_stats \
+#     --keras_model=Python_INMP441/model_CNN.h5
+
 _INPUT_TFLITE_FILE = flags.DEFINE_string(
     "input_tflite_file",
     None,
@@ -87,6 +114,40 @@ _PRINT_PREVIEW = flags.DEFINE_bool(
 )
 
 
+_INPUT_DATA_FILES = flags.DEFINE_list(
+    "input_data_files",
+    None,
+    "Comma separated .npy files with the model inputs, used instead of random"
+    " data when no layer_by_layer_data_file is given.",
+)
+
+_ERROR_STATS = flags.DEFINE_bool(
+    "error_stats",
+    False,
+    "Report per layer error statistics for all layers instead of asserting on"
+    " the first mismatch.",
+)
+
+_MAX_QUANTIZED_DIFF = flags.DEFINE_float(
+    "max_quantized_diff",
+    0,
+    "Largest difference, in quantization steps of the output tensor, that is"
+    " accepted with --error_stats. The default requires bit exact outputs.",
+)
+
+_KERAS_MODEL = flags.DEFINE_string(
+    "keras_model",
+    None,
+    "Optional float Keras model (.h5) to compare the layer outputs with.",
+)
+
+_MIN_KERAS_SNR_DB = flags.DEFINE_float(
+    "min_keras_snr_db",
+    None,
+    "Fail if the SNR of any layer against the Keras model is lower than this.",
+)
+
+
 def numpy_from_tensor_type(tensor_type_idx):
   """Gives the equivalent numpy dtype based on TensorType class (schema) number."""
   tensor_type_idx_to_numpy = {
@@ -131,11 +192,165 @@ def numpy_from_tensor_type(tensor_type_idx):
   return tensor_type_idx_to_numpy.get(tensor_type_idx)
 
 
-def GenerateRandomInputTfLiteComparison(tflm_interpreter, tflite_interpreter,
-                                        model, rng_value):
+def QuantizationParams(model, subgraph_index, tensor_index):
+  """Returns the (scale, zero_point) of a per tensor quantized tensor.
+
+  Float tensors and per channel quantized tensors return (None, 0).
+  """
+  quantization = model.subgraphs[subgraph_index].tensors[
+      tensor_index].quantization
+  if (quantization is None or quantization.scale is None
+      or len(quantization.scale) != 1):
+    return None, 0
+  return float(quantization.scale[0]), int(quantization.zeroPoint[0])
+
+
+def Dequantize(values, scale, zero_point):
+  if scale is None:
+    return np.asarray(values, dtype=np.float64)
+  return (np.asarray(values, dtype=np.float64) - zero_point) * scale
+
+
+def ComputeErrorStats(actual, expected, scale, step_tolerance):
+  """Error statistics of actual against the reference expected.
+
+  Args:
+    actual: dequantized TFLM layer output.
+    expected: reference values with the same number of elements.
+    scale: quantization step of the layer output, or None for float tensors.
+    step_tolerance: elements that differ by more than this many quantization
+      steps are counted as mismatches.
+
+  Returns:
+    dict with max_abs_diff, max_quantized_diff (in quantization steps, equal to
+    max_abs_diff for float tensors), mismatch_fraction, rmse and snr_db.
+  """
+  actual = np.asarray(actual, dtype=np.float64).flatten()
+  expected = np.asarray(expected, dtype=np.float64).flatten()
+  diff = actual - expected
+  step = scale if scale else 1.0
+  max_abs_diff = float(np.max(np.abs(diff))) if diff.size else 0.0
+  signal_power = float(np.sum(expected**2))
+  noise_power = float(np.sum(diff**2))
+  if noise_power == 0:
+    snr_db = float("inf")
+  elif signal_power == 0:
+    snr_db = float("-inf")
+  else:
+    snr_db = float(10 * np.log10(signal_power / noise_power))
+  return {
+      "max_abs_diff": max_abs_diff,
+      # Rounded so that exact multiples of the step are not lost to float
+      # error in the dequantization.
+      "max_quantized_diff": round(max_abs_diff / step, 3),
+      "mismatch_fraction": (float(
+          np.count_nonzero(np.abs(diff) > step * step_tolerance + step * 1e-3))
+                            / diff.size if diff.size else 0.0),
+      "rmse": float(np.sqrt(np.mean(diff**2))) if diff.size else 0.0,
+      "snr_db": snr_db,
+  }
+
+
+def MapKerasLayers(model, layers):
+  """Maps output tensor indices of subgraph 0 to Keras layers.
+
+  Args:
+    model: tflite schema ModelT object.
+    layers: list of (name, output_shape_without_batch, is_model_output) tuples
+      describing the Keras layers in order.
+
+  Returns:
+    dict from tensor index to the position of the Keras layer in layers.
+  """
+  subgraph = model.subgraphs[0]
+  mapping = {}
+  output_layers = [i for i, layer in enumerate(layers) if layer[2]]
+  # The last Keras layer usually carries an activation (softmax) that TfLite
+  # runs as a separate operator, so model outputs map to model outputs.
+  for tensor_index, layer_index in zip(subgraph.outputs, output_layers):
+    mapping[tensor_index] = layer_index
+
+  names = {layer[0]: i for i, layer in enumerate(layers) if not layer[2]}
+  for operator in subgraph.operators:
+    for tensor_index in operator.outputs:
+      if tensor_index in mapping:
+        continue
+      # TfLite names fused tensors "<model>/<layer>/<op>;<model>/..." after the
+      # Keras layer that produced them.
+      name = subgraph.tensors[tensor_index].name
+      if isinstance(name, bytes):
+        name = name.decode("utf-8", errors="replace")
+      path = name.split(";")[0].split("/")
+      if len(path) > 1 and path[1] in names:
+        mapping[tensor_index] = names[path[1]]
+  if len(mapping) > len(output_layers):
+    return mapping
+
+  # The names do not match (for example the Keras model was rebuilt and its
+  # layers renumbered): walk both graphs in order and pair each operator with
+  # the next Keras layer of the same output shape. Operators without a Keras
+  # counterpart (QUANTIZE) and Keras layers without an operator (Dropout) are
+  # skipped.
+  layer_index = 0
+  for operator in subgraph.operators:
+    for tensor_index in operator.outputs:
+      if tensor_index in mapping:
+        continue
+      shape = tuple(subgraph.tensors[tensor_index].shape[1:])
+      for candidate in range(layer_index, len(layers)):
+        if not layers[candidate][2] and tuple(layers[candidate][1]) == shape:
+          mapping[tensor_index] = candidate
+          layer_index = candidate + 1
+          break
+  return mapping
+
+
+def KerasLayerOutputs(keras_model_path, model, input_arrays):
+  """Runs the Keras model and returns {tensor_index: (layer_name, output)}."""
+  keras_model = tf.keras.models.load_model(keras_model_path, compile=False)
+  output_names = {tensor.name.split("/")[0] for tensor in keras_model.outputs}
+  layers = [layer for layer in keras_model.layers
+            if not isinstance(layer, tf.keras.layers.InputLayer)]
+  probe = tf.keras.Model(inputs=keras_model.inputs,
+                         outputs=[layer.output for layer in layers])
+
+  inputs = []
+  for index, input_array in enumerate(input_arrays):
+    # Keras models take float inputs even if the converted model is int8.
+    scale, zero_point = QuantizationParams(model, 0,
+                                           model.subgraphs[0].inputs[index])
+    inputs.append(Dequantize(input_array, scale, zero_point).astype(np.float32))
+  outputs = probe(inputs if len(inputs) > 1 else inputs[0], training=False)
+  if not isinstance(outputs, (list, tuple)):
+    outputs = [outputs]
+
+  mapping = MapKerasLayers(
+      model,
+      [(layer.name, tuple(layer.output.shape[1:]), layer.name in output_names)
+       for layer in layers],
+  )
+  return {
+      tensor_index: (layers[layer_index].name,
+                     np.asarray(outputs[layer_index]))
+      for tensor_index, layer_index in mapping.items()
+  }
+
+
+def PrintErrorStats(title, rows):
+  print("\n" + title)
+  print("%5s %6s %-24s %12s %9s %12s %9s" %
+        ("layer", "tensor", "reference", "max_diff", "mismatch", "rmse",
+         "snr_db"))
+  for layer_number, tensor_index, reference, stats in rows:
+    print("%5d %6d %-24s %12.4g %8.2f%% %12.4g %9.2f" %
+          (layer_number, tensor_index, reference[:24],
+           stats["max_quantized_diff"], 100 * stats["mismatch_fraction"],
+           stats["rmse"], stats["snr_db"]))
+
+
+def BuildSubgraphInfo(model):
   subgraph_info = layer_schema_fb.ModelTestDataT()
   subgraph_info.subgraphData = []
-  rng_seed = np.random.default_rng(seed=rng_value)
 
   for subgraph_index, subgraph in enumerate(model.subgraphs):
     subgraph_data = layer_schema_fb.SubgraphDataT()
@@ -149,14 +364,38 @@ def GenerateRandomInputTfLiteComparison(tflm_interpreter, tflite_interpreter,
         tensor_data.tensorIndex = output
         subgraph_data.outputs.append(tensor_data)
     subgraph_info.subgraphData.append(subgraph_data)
+  return subgraph_info
+
 
+def SetInputDataFiles(tflm_interpreter, tflite_interpreter, model):
+  input_arrays = []
+  for index, input_tensor_index in enumerate(model.subgraphs[0].inputs):
+    input_tensor = model.subgraphs[0].tensors[input_tensor_index]
+    input_array = np.load(_INPUT_DATA_FILES.value[index])
+    input_array = np.reshape(
+        input_array.astype(numpy_from_tensor_type(input_tensor.type)),
+        input_tensor.shape)
+    tflm_interpreter.set_input(input_array, index)
+    tflite_interpreter.set_tensor(input_tensor_index, input_array)
+    input_arrays.append(input_array)
+  return (BuildSubgraphInfo(model), tflm_interpreter, tflite_interpreter,
+          input_arrays)
+
+
+def GenerateRandomInputTfLiteComparison(tflm_interpreter, tflite_interpreter,
+                                        model, rng_value):
+  subgraph_info = BuildSubgraphInfo(model)
+  rng_seed = np.random.default_rng(seed=rng_value)
+
+  input_arrays = []
   for index, input_tensor_index in enumerate(model.subgraphs[0].inputs):
     input_tensor = model.subgraphs[0].tensors[input_tensor_index]
     random_data = model_transforms_utils.generate_random_input_data(
         model, input_tensor, rng_seed)
     tflm_interpreter.set_input(random_data, index)
     tflite_interpreter.set_tensor(input_tensor_index, random_data)
-  return subgraph_info, tflm_interpreter, tflite_interpreter
+    input_arrays.append(random_data)
+  return subgraph_info, tflm_interpreter, tflite_interpreter, input_arrays
 
 
 def ReadDebugFile():
@@ -171,14 +410,16 @@ def ReadDebugFile():
 
 def SetDebugFileInterpreterInput(tflm_interpreter, tflite_interpreter,
                                  debug_obj):
+  input_arrays = []
   for inputs in debug_obj.inputData:
     input_array = np.frombuffer(bytearray(inputs.data),
                                 dtype=numpy_from_tensor_type(inputs.dtype))
     input_array = np.reshape(input_array, inputs.shape)
     tflm_interpreter.set_input(input_array, inputs.inputIndex)
     tflite_interpreter.set_tensor(inputs.tensorIndex, input_array)
+    input_arrays.append(input_array)
 
-  return tflm_interpreter, tflite_interpreter
+  return tflm_interpreter, tflite_interpreter, input_arrays
 
 
 def main(_) -> None:
@@ -203,21 +444,33 @@ def main(_) -> None:
 
   debug_obj = None
 
-  # Setting Inputs either randomly or using provided Debug File
+  # Setting Inputs either randomly, from recorded input files or using
+  # provided Debug File
   if _DEBUG_FILE.value == None:
-    debug_obj, tflm_interpreter, tflite_interpreter = (
-        GenerateRandomInputTfLiteComparison(tflm_interpreter,
-                                            tflite_interpreter, model,
-                                            _RNG.value))
+    if _INPUT_DATA_FILES.value:
+      debug_obj, tflm_interpreter, tflite_interpreter, input_arrays = (
+          SetInputDataFiles(tflm_interpreter, tflite_interpreter, model))
+    else:
+      debug_obj, tflm_interpreter, tflite_interpreter, input_arrays = (
+          GenerateRandomInputTfLiteComparison(tflm_interpreter,
+                                              tflite_interpreter, model,
+                                              _RNG.value))
     tflite_interpreter.invoke()
   else:
     debug_obj = ReadDebugFile()
-    tflm_interpreter, tflite_interpreter = SetDebugFileInterpreterInput(
-        tflm_interpreter, tflite_interpreter, debug_obj)
+    tflm_interpreter, tflite_interpreter, input_arrays = (
+        SetDebugFileInterpreterInput(tflm_interpreter, tflite_interpreter,
+                                     debug_obj))
 
   tflm_interpreter.invoke()
   comparison = ""
 
+  keras_outputs = {}
+  if _KERAS_MODEL.value:
+    keras_outputs = KerasLayerOutputs(_KERAS_MODEL.value, model, input_arrays)
+  error_rows = []
+  keras_rows = []
+
   for subgraph in debug_obj.subgraphData:
     for output in subgraph.outputs:
       tflm_ouput = tflm_interpreter.GetTensor(
@@ -257,10 +510,52 @@ def main(_) -> None:
             comparison_ouput[:_PRINT_PREVIEW.value],
         )
         print("--------------\n\n\n")
-      np.testing.assert_array_equal(tflm_ouput,
-                                    comparison_ouput,
-                                    err_msg=error_message,
-                                    verbose=True)
+
+      scale, zero_point = QuantizationParams(model, subgraph.subgraphIndex,
+                                             output.tensorIndex)
+      tflm_values = Dequantize(tflm_ouput, scale, zero_point)
+      if subgraph.subgraphIndex == 0 and output.tensorIndex in keras_outputs:
+        layer_name, keras_output = keras_outputs[output.tensorIndex]
+        keras_rows.append(
+            (output.layerNumber, output.tensorIndex, layer_name,
+             ComputeErrorStats(tflm_values, keras_output, scale, 1)))
+
+      if not _ERROR_STATS.value:
+        np.testing.assert_array_equal(tflm_ouput,
+                                      comparison_ouput,
+                                      err_msg=error_message,
+                                      verbose=True)
+        continue
+      error_rows.append(
+          (output.layerNumber, output.tensorIndex, comparison,
+           ComputeErrorStats(tflm_values,
+                             Dequantize(comparison_ouput, scale, zero_point),
+                             scale, _MAX_QUANTIZED_DIFF.value)))
+
+  failures = []
+  if _ERROR_STATS.value:
+    PrintErrorStats(
+        "TFLM vs {comparison} (max_diff in quantization steps):".format(
+            comparison=comparison), error_rows)
+    failures += [
+        "layer %d differs from %s by %g steps" %
+        (layer_number, comparison, stats["max_quantized_diff"])
+        for layer_number, _, _, stats in error_rows
+        if stats["max_quantized_diff"] > _MAX_QUANTIZED_DIFF.value
+    ]
+  if keras_rows:
+    PrintErrorStats(
+        "TFLM vs Keras (dequantized, max_diff in quantization steps, mismatch"
+        " = elements off by more than one step):", keras_rows)
+    if _MIN_KERAS_SNR_DB.value is not None:
+      failures += [
+          "layer %d (%s) SNR %.2f dB is below %.2f dB" %
+          (layer_number, layer_name, stats["snr_db"], _MIN_KERAS_SNR_DB.value)
+          for layer_number, _, layer_name, stats in keras_rows
+          if stats["snr_db"] < _MIN_KERAS_SNR_DB.value
+      ]
+  if failures:
+    raise AssertionError("\n".join(failures))
   print(
       "\n\nTFLM output matched {comparison} output for all Layers in the Model."
       .format(comparison=comparison))
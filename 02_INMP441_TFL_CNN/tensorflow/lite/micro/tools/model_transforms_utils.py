@@ -22,6 +22,7 @@ Transformation functions breakdown:
 go/tflm-flatbuffer-reduction-breakdown
 """
 
+from flatbuffers import flexbuffers
 import numpy as np
 
 from tflite_micro.tensorflow.lite.python import schema_py_generated as schema_fb
@@ -256,6 +257,211 @@ def clear_resource_variable_buffers(model):
   _remove_initialization_subgraph(model)
 
 
+# Custom code of the fused operator implemented in kernels/conv_max_pool.cc.
+CONV_MAX_POOL_CUSTOM_CODE = "CONV_2D_MAX_POOL_2D"
+
+
+def _builtin_code(model, op):
+  return schema_util.get_builtin_code_from_operator_code(
+      model.operatorCodes[op.opcodeIndex])
+
+
+def _custom_opcode_index(model, custom_code):
+  """Returns the index of the operator code of custom_code, adding it if needed."""
+  for i, opcode in enumerate(model.operatorCodes):
+    if (schema_util.get_builtin_code_from_operator_code(opcode)
+        == schema_fb.BuiltinOperator.CUSTOM
+        and opcode.customCode in (custom_code, custom_code.encode())):
+      return i
+  opcode = schema_fb.OperatorCodeT()
+  opcode.deprecatedBuiltinCode = schema_fb.BuiltinOperator.CUSTOM
+  opcode.builtinCode = schema_fb.BuiltinOperator.CUSTOM
+  opcode.customCode = custom_code
+  opcode.version = 1
+  model.operatorCodes.append(opcode)
+  return len(model.operatorCodes) - 1
+
+
+def _conv_max_pool_options(conv_options, pool_options):
+  """Returns the flexbuffer options of a CONV_2D_MAX_POOL_2D operator."""
+  builder = flexbuffers.Builder()
+  with builder.Map():
+    builder.Int("activation", conv_options.fusedActivationFunction)
+    builder.Int("dilation_h_factor", conv_options.dilationHFactor)
+    builder.Int("dilation_w_factor", conv_options.dilationWFactor)
+    builder.Int("padding", conv_options.padding)
+    builder.Int("pool_activation", pool_options.fusedActivationFunction)
+    builder.Int("pool_filter_height", pool_options.filterHeight)
+    builder.Int("pool_filter_width", pool_options.filterWidth)
+    builder.Int("pool_padding", pool_options.padding)
+    builder.Int("pool_stride_h", pool_options.strideH)
+    builder.Int("pool_stride_w", pool_options.strideW)
+    builder.Int("stride_h", conv_options.strideH)
+    builder.Int("stride_w", conv_options.strideW)
+  return builder.Finish()
+
+
+def _quantization_params(tensor):
+  """Returns the scales and zero points of tensor as lists."""
+  quantization = tensor.quantization
+  if quantization is None:
+    return [], []
+  scale = quantization.scale if quantization.scale is not None else []
+  zero_point = (quantization.zeroPoint
+                if quantization.zeroPoint is not None else [])
+  return list(scale), list(zero_point)
+
+
+def _remove_tensors(subgraph, removed):
+  """Removes the tensors with indices in removed and renumbers the rest."""
+  new_index = {}
+  tensors = []
+  for i, tensor in enumerate(subgraph.tensors):
+    if i not in removed:
+      new_index[i] = len(tensors)
+      tensors.append(tensor)
+  subgraph.tensors = tensors
+
+  def renumber(indices):
+    if indices is None:
+      return None
+    # -1 marks an omitted optional input.
+    return [new_index[i] if i >= 0 else i for i in indices]
+
+  subgraph.inputs = renumber(subgraph.inputs)
+  subgraph.outputs = renumber(subgraph.outputs)
+  for op in subgraph.operators:
+    op.inputs = renumber(op.inputs)
+    op.outputs = renumber(op.outputs)
+    op.intermediates = renumber(op.intermediates)
+
+
+def fuse_conv_max_pool(model):
+  """Fuses each CONV_2D whose output only feeds a MAX_POOL_2D into one CONV_2D_MAX_POOL_2D custom operator.
+
+  The fused operator writes the pooled output directly, so the full resolution
+  convolution output no longer needs space in the arena. It reads the same
+  input, filter and bias tensors as the CONV_2D, and its output is the
+  MAX_POOL_2D output. A pair is fused when the convolution output is read by
+  nothing else and is not a subgraph output, the convolution is int8 or
+  float32, and both tensors of the pooling share the same quantization. The
+  convolution output tensor is removed from the model: a tensor that no
+  operator references still gets a buffer from the memory planner.
+
+  The interpreter running the transformed model needs the operator,
+  registered with MicroMutableOpResolver::AddConv2DMaxPool2D().
+
+  Args:
+    model: The model to operate on, a schema_fb.ModelT object.
+  """
+  for subgraph in model.subgraphs:
+    readers = {}
+    for op in subgraph.operators:
+      for tensor_idx in op.inputs:
+        readers.setdefault(tensor_idx, []).append(op)
+
+    fused_pools = []
+    fused_tensors = set()
+    for op in subgraph.operators:
+      if _builtin_code(model, op) != schema_fb.BuiltinOperator.CONV_2D:
+        continue
+      conv_output_idx = op.outputs[0]
+      if (conv_output_idx in subgraph.outputs
+          or len(readers.get(conv_output_idx, [])) != 1):
+        continue
+      pool = readers[conv_output_idx][0]
+      if (_builtin_code(model, pool) != schema_fb.BuiltinOperator.MAX_POOL_2D
+          or pool.inputs[0] != conv_output_idx):
+        continue
+
+      input_tensor = subgraph.tensors[op.inputs[0]]
+      filter_tensor = subgraph.tensors[op.inputs[1]]
+      if not ((input_tensor.type == schema_fb.TensorType.INT8
+               and filter_tensor.type == schema_fb.TensorType.INT8) or
+              (input_tensor.type == schema_fb.TensorType.FLOAT32
+               and filter_tensor.type == schema_fb.TensorType.FLOAT32)):
+        continue
+      if (_quantization_params(subgraph.tensors[conv_output_idx]) !=
+          _quantization_params(subgraph.tensors[pool.outputs[0]])):
+        continue
+
+      options = _conv_max_pool_options(op.builtinOptions, pool.builtinOptions)
+      op.opcodeIndex = _custom_opcode_index(model, CONV_MAX_POOL_CUSTOM_CODE)
+      op.builtinOptionsType = schema_fb.BuiltinOptions.NONE
+      op.builtinOptions = None
+      op.customOptions = list(options)
+      op.customOptionsFormat = schema_fb.CustomOptionsFormat.FLEXBUFFERS
+      op.outputs = pool.outputs
+      fused_pools.append(pool)
+      fused_tensors.add(conv_output_idx)
+
+    subgraph.operators = [
+        op for op in subgraph.operators
+        if not any(op is pool for pool in fused_pools)
+    ]
+    if fused_tensors:
+      _remove_tensors(subgraph, fused_tensors)
+
+
+# Custom code of the operator implemented in kernels/classification_head.cc.
+CLASSIFICATION_HEAD_CUSTOM_CODE = "CLASSIFICATION_HEAD"
+
+
+def _classification_head_options(beta, probabilities):
+  """Returns the flexbuffer options of a CLASSIFICATION_HEAD operator."""
+  builder = flexbuffers.Builder()
+  with builder.Map():
+    builder.Float("beta", beta)
+    builder.Bool("probabilities", probabilities)
+  return builder.Finish()
+
+
+def replace_softmax_with_classification_head(model, probabilities=False):
+  """Replaces each int8 SOFTMAX producing a model output with a CLASSIFICATION_HEAD custom operator.
+
+  An application that only takes the argmax of a classifier's probabilities
+  does not need the exponentials of the softmax. By default the operator
+  outputs the int8 score of each class relative to the largest one, 127 for
+  the top class, which keeps the argmax and gives the top-2 margin in logit
+  quantization steps, but not the probabilities. With probabilities set, it
+  outputs the probabilities of the SOFTMAX, bit-exact, computed with a table
+  of exponentials built at Prepare, and the output keeps the quantization of
+  the SOFTMAX. The scores get the scale of the logits and the zero point 127
+  instead, so that a dequantized score is the difference of its logit to the
+  largest one, 0 for the top class.
+
+  The interpreter running the transformed model needs the operator,
+  registered with MicroMutableOpResolver::AddClassificationHead().
+
+  Args:
+    model: The model to operate on, a schema_fb.ModelT object.
+    probabilities: whether the operator computes the softmax probabilities.
+  """
+  for subgraph in model.subgraphs:
+    for op in subgraph.operators:
+      if _builtin_code(model, op) != schema_fb.BuiltinOperator.SOFTMAX:
+        continue
+      if (op.outputs[0] not in subgraph.outputs
+          or subgraph.tensors[op.inputs[0]].type != schema_fb.TensorType.INT8
+          or subgraph.tensors[op.outputs[0]].type !=
+          schema_fb.TensorType.INT8):
+        continue
+
+      beta = op.builtinOptions.beta if op.builtinOptions is not None else 1.0
+      options = _classification_head_options(beta, probabilities)
+      op.opcodeIndex = _custom_opcode_index(model,
+                                            CLASSIFICATION_HEAD_CUSTOM_CODE)
+      op.builtinOptionsType = schema_fb.BuiltinOptions.NONE
+      op.builtinOptions = None
+      op.customOptions = list(options)
+      op.customOptionsFormat = schema_fb.CustomOptionsFormat.FLEXBUFFERS
+      if not probabilities:
+        input_scale, _ = _quantization_params(subgraph.tensors[op.inputs[0]])
+        output_quantization = subgraph.tensors[op.outputs[0]].quantization
+        output_quantization.scale = input_scale[:1]
+        output_quantization.zeroPoint = [127]
+
+
 def _numpy_from_tensor_type(tensor_type_idx):
   """Gives the equivalent numpy dtype based on TensorType class (schema) number."""
   tensor_type_idx_to_numpy = {
@@ -47,6 +47,28 @@ _TEST_TRANSFORMED_MODELS = flags.DEFINE_bool(
     " asserting equivalent output.",
 )
 
+_FUSE_CONV_MAX_POOL = flags.DEFINE_bool(
+    "fuse_conv_max_pool",
+    False,
+    "optional config to fuse CONV_2D + MAX_POOL_2D pairs into the"
+    " CONV_2D_MAX_POOL_2D custom operator, which removes the full resolution"
+    " convolution output from the arena. The interpreter must register the"
+    " operator with MicroMutableOpResolver::AddConv2DMaxPool2D().",
+)
+
+_CLASSIFICATION_HEAD = flags.DEFINE_enum(
+    "classification_head",
+    None,
+    ["scores", "probabilities"],
+    "optional config to replace the int8 SOFTMAX producing a model output"
+    " with the CLASSIFICATION_HEAD custom operator. 'scores' outputs the"
+    " class scores relative to the top class, with no exponentials, which"
+    " keep the argmax but are not probabilities. 'probabilities' outputs the"
+    " softmax probabilities from a table of exponentials. The interpreter"
+    " must register the operator with"
+    " MicroMutableOpResolver::AddClassificationHead().",
+)
+
 _OUTPUT_MODEL_PATH = flags.DEFINE_string(
     "output_model_path",
     None,
@@ -65,6 +87,8 @@ def main(_) -> None:
       output_model_path,
       _SAVE_INTERMEDIATE_MODELS.value,
       _TEST_TRANSFORMED_MODELS.value,
+      fuse_conv_max_pool=_FUSE_CONV_MAX_POOL.value,
+      classification_head=_CLASSIFICATION_HEAD.value,
   )
 
 
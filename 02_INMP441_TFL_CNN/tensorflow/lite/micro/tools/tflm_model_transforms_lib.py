@@ -55,7 +55,8 @@ def check_models_equivalent(initial_model_path: str = None,
                             secondary_model_path: str = None,
                             test_vector_count: int = 1,
                             seed: int = 42,
-                            custom_op_registerers=[]):
+                            custom_op_registerers=[],
+                            compare_argmax: bool = False):
   """Checks that the two models are equivalent by testing that the same set of random inputs produce the same outputs using the TFLM interpreter.
 
   Note that this function does not test the correctness of the inference. It
@@ -69,6 +70,10 @@ def check_models_equivalent(initial_model_path: str = None,
       for equivalence.
     seed: optionally provide a custom seed value for random number generator
     custom_op_registerers: if your model makes use of custom ops
+    compare_argmax: only check that, along the last axis of each output, the
+      class ranked first by the secondary model has the largest output of the
+      initial model. For a secondary model that outputs class scores instead
+      of probabilities.
 
   Raises:
     AssertionError if outputs of TFLM invocations are not equal
@@ -102,10 +107,19 @@ def check_models_equivalent(initial_model_path: str = None,
     secondary_model_interpreter.invoke()
 
     for idx, _ in enumerate(initial_model_object.subgraphs[0].outputs):
-      np.testing.assert_array_equal(
-          initial_model_interpreter.get_output(idx),
-          secondary_model_interpreter.get_output(idx),
-      )
+      initial_output = initial_model_interpreter.get_output(idx)
+      secondary_output = secondary_model_interpreter.get_output(idx)
+      if compare_argmax:
+        # Ties between quantized probabilities may rank the classes
+        # differently, so the secondary argmax only has to be one of them.
+        top_class = np.argmax(secondary_output, axis=-1)
+        np.testing.assert_array_equal(
+            np.take_along_axis(initial_output,
+                               np.expand_dims(top_class, axis=-1), axis=-1),
+            np.max(initial_output, axis=-1, keepdims=True),
+        )
+      else:
+        np.testing.assert_array_equal(initial_output, secondary_output)
 
     initial_model_interpreter.reset()
     secondary_model_interpreter.reset()
@@ -149,6 +163,8 @@ def run_all_transformations(
     test_transformed_model=True,
     custom_save_dir=None,
     custom_op_registerers=[],
+    fuse_conv_max_pool=False,
+    classification_head=None,
 ):
   """Apply all current transform methods on an input .tflite file, and optionally save the models between methods.
 
@@ -160,6 +176,13 @@ def run_all_transformations(
       input/transformed models on random data
     custom_save_dir: optionally pass the directory path for saving files
     custom_op_registerers: if your model makes use of custom ops
+    fuse_conv_max_pool: whether to fuse CONV_2D + MAX_POOL_2D pairs into the
+      CONV_2D_MAX_POOL_2D custom operator. Testing the transformed model then
+      needs an interpreter that registers the operator.
+    classification_head: None, or "scores" or "probabilities" to replace the
+      int8 SOFTMAX producing a model output with the CLASSIFICATION_HEAD
+      custom operator in that mode. With "scores", the transformed model is
+      only tested for the same top class.
 
   Raises:
     AssertionError if outputs of TFLM invocations on input and transformed
@@ -192,6 +215,21 @@ def run_all_transformations(
       "string_stripped.tflite",
       "variable_shared_names_shortened.tflite",
   ]
+  if fuse_conv_max_pool:
+    transforms_list.append(model_transforms_utils.fuse_conv_max_pool)
+    transform_names.append("Fuse Conv2D + MaxPool2D")
+    intermediate_file_names.append("conv_max_pool_fused.tflite")
+  if classification_head is not None:
+    if classification_head not in ("scores", "probabilities"):
+      raise ValueError(
+          f"Unknown classification head mode: {classification_head}")
+    probabilities = classification_head == "probabilities"
+    transforms_list.append(lambda model: model_transforms_utils.
+                           replace_softmax_with_classification_head(
+                               model, probabilities=probabilities))
+    transform_names.append("Replace Softmax with Classification Head")
+    intermediate_file_names.append("classification_head.tflite")
+  compare_argmax = classification_head == "scores"
 
   for transform, name, file_name in zip(transforms_list, transform_names,
                                         intermediate_file_names):
@@ -207,6 +245,8 @@ def run_all_transformations(
           initial_model_path=pre_transform_model_path,
           secondary_model_path=output_path,
           custom_op_registerers=custom_op_registerers,
+          compare_argmax=(compare_argmax
+                          and file_name == "classification_head.tflite"),
       )
       pre_transform_model_path = output_path
 
@@ -219,6 +259,7 @@ def run_all_transformations(
         initial_model_path=input_path,
         secondary_model_path=transformed_model_path,
         custom_op_registerers=custom_op_registerers,
+        compare_argmax=compare_argmax,
     )
 
   log_size_difference(input_path, transformed_model_path)
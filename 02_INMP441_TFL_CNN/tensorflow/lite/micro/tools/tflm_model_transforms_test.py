@@ -20,12 +20,16 @@ check_models_equivalent() to assert results.
 import os
 
 from absl.testing import parameterized
+from flatbuffers import flexbuffers
 from tensorflow.python.platform import resource_loader
 from tensorflow.python.framework import test_util
 from tensorflow.python.platform import test
 
+from tflite_micro.tensorflow.lite.micro.tools import model_transforms_utils
 from tflite_micro.tensorflow.lite.micro.tools import tflm_model_transforms_lib
 from tflite_micro.tensorflow.lite.micro.examples.recipes import resource_variables_lib
+from tflite_micro.tensorflow.lite.python import schema_py_generated as schema_fb
+from tflite_micro.tensorflow.lite.python import schema_util
 from tflite_micro.tensorflow.lite.tools import flatbuffer_utils
 
 
@@ -79,6 +83,94 @@ class TflmModelTransformsTest(test_util.TensorFlowTestCase,
         test_vector_count=5,
     )
 
+  def test_fuse_conv_max_pool(self):
+    prefix_path = resource_loader.get_path_to_datafile("../models")
+    model = flatbuffer_utils.read_model(
+        os.path.join(prefix_path, "inmp441_cnn.tflite"))
+    subgraph = model.subgraphs[0]
+    tensor_count = len(subgraph.tensors)
+    input_tensor = subgraph.tensors[subgraph.inputs[0]]
+    output_tensor = subgraph.tensors[subgraph.outputs[0]]
+
+    model_transforms_utils.fuse_conv_max_pool(model)
+
+    # The three CONV_2D + MAX_POOL_2D blocks each became one fused operator
+    # writing the pooled tensor, and the convolution outputs are gone.
+    codes = []
+    for op in subgraph.operators:
+      opcode = model.operatorCodes[op.opcodeIndex]
+      if (schema_util.get_builtin_code_from_operator_code(opcode) ==
+          schema_fb.BuiltinOperator.CUSTOM):
+        codes.append(opcode.customCode.decode()
+                     if isinstance(opcode.customCode, bytes)
+                     else opcode.customCode)
+      else:
+        codes.append(schema_util.get_builtin_code_from_operator_code(opcode))
+    fused = model_transforms_utils.CONV_MAX_POOL_CUSTOM_CODE
+    self.assertEqual(codes, [
+        schema_fb.BuiltinOperator.QUANTIZE,
+        fused,
+        fused,
+        fused,
+        schema_fb.BuiltinOperator.RESHAPE,
+        schema_fb.BuiltinOperator.FULLY_CONNECTED,
+        schema_fb.BuiltinOperator.FULLY_CONNECTED,
+        schema_fb.BuiltinOperator.SOFTMAX,
+    ])
+    self.assertLen(subgraph.tensors, tensor_count - 3)
+    self.assertIs(subgraph.tensors[subgraph.inputs[0]], input_tensor)
+    self.assertIs(subgraph.tensors[subgraph.outputs[0]], output_tensor)
+    for op in subgraph.operators[1:4]:
+      self.assertEqual(op.customOptionsFormat,
+                       schema_fb.CustomOptionsFormat.FLEXBUFFERS)
+      self.assertLen(op.inputs, 3)
+      self.assertEqual(len(subgraph.tensors[op.outputs[0]].shape), 4)
+
+  def test_classification_head(self):
+    prefix_path = resource_loader.get_path_to_datafile("../models")
+    model_path = os.path.join(prefix_path, "inmp441_cnn.tflite")
+    for probabilities in (False, True):
+      model = flatbuffer_utils.read_model(model_path)
+      subgraph = model.subgraphs[0]
+      tensor_count = len(subgraph.tensors)
+      output_tensor = subgraph.tensors[subgraph.outputs[0]]
+      softmax_scale = list(output_tensor.quantization.scale)
+      softmax_zero_point = list(output_tensor.quantization.zeroPoint)
+
+      model_transforms_utils.replace_softmax_with_classification_head(
+          model, probabilities=probabilities)
+
+      # The final SOFTMAX became the custom operator, writing the same
+      # output tensor.
+      op = subgraph.operators[-1]
+      opcode = model.operatorCodes[op.opcodeIndex]
+      self.assertEqual(schema_util.get_builtin_code_from_operator_code(opcode),
+                       schema_fb.BuiltinOperator.CUSTOM)
+      self.assertEqual(model_transforms_utils.CLASSIFICATION_HEAD_CUSTOM_CODE,
+                       opcode.customCode.decode()
+                       if isinstance(opcode.customCode, bytes)
+                       else opcode.customCode)
+      self.assertEqual(op.customOptionsFormat,
+                       schema_fb.CustomOptionsFormat.FLEXBUFFERS)
+      self.assertEqual(flexbuffers.Loads(bytes(op.customOptions)), {
+          "beta": 1.0,
+          "probabilities": probabilities
+      })
+      self.assertLen(subgraph.tensors, tensor_count)
+      self.assertIs(subgraph.tensors[op.outputs[0]], output_tensor)
+      self.assertEqual(op.outputs, subgraph.outputs)
+      # Probabilities keep the SOFTMAX quantization, scores dequantize to
+      # the difference of their logit to the largest one.
+      if probabilities:
+        self.assertEqual(list(output_tensor.quantization.scale), softmax_scale)
+        self.assertEqual(list(output_tensor.quantization.zeroPoint),
+                         softmax_zero_point)
+      else:
+        logits = subgraph.tensors[op.inputs[0]]
+        self.assertEqual(list(output_tensor.quantization.scale),
+                         list(logits.quantization.scale))
+        self.assertEqual(list(output_tensor.quantization.zeroPoint), [127])
+
 
 if __name__ == "__main__":
   test.main()
@@ -0,0 +1,200 @@
+# Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""Decodes MicroTraceProfiler packets into per-stage latency histograms.
+
+The input is a raw byte capture of whatever stream the device wrote the
+packets to (for example the UART). Bytes that do not belong to a packet, such
+as log lines interleaved with the binary data, are skipped.
+
+Usage:
+  python3 trace_profiler_decode.py --trace_file=</path/to/capture.bin>
+
+Optional Flags:
+  --by_op_index
+          report every operator index separately (CONV_2D#0, CONV_2D#2, ...)
+          instead of aggregating all invocations of an operator type.
+  --json_output=</path/to/report.json>
+          also write the statistics in machine readable form.
+"""
+
+import json
+import math
+import struct
+
+from absl import app
+from absl import flags
+
+_TRACE_FILE = flags.DEFINE_string(
+    "trace_file", None, "Raw capture of the device output.", required=True)
+
+_BY_OP_INDEX = flags.DEFINE_bool(
+    "by_op_index", False,
+    "Keep operators with the same type but different index apart.")
+
+_JSON_OUTPUT = flags.DEFINE_string(
+    "json_output", None, "Optional path of a JSON report.")
+
+# Must match tensorflow/lite/micro/micro_trace_profiler.h.
+_MAGIC = b"\xA5\x54"
+_VERSION = 1
+_HEADER = struct.Struct("<2sBBHHI")
+_RECORD = struct.Struct("<HBBI")
+_FRAME_TAG_ID = 0xFF
+_OVERFLOW_TAG_ID = 0xFE
+
+
+class TraceDecoder:
+  """Incremental decoder for the MicroTraceProfiler packet stream."""
+
+  def __init__(self):
+    self.tags = {_FRAME_TAG_ID: "Frame", _OVERFLOW_TAG_ID: "Other"}
+    self.ticks_per_second = 0
+    self.dropped = 0
+    self.corrupted_packets = 0
+    self._pending = b""
+
+  def feed(self, data):
+    """Consumes bytes and yields (record, tag_name) tuples."""
+    self._pending += data
+    while True:
+      start = self._pending.find(_MAGIC)
+      if start < 0:
+        # Keep a trailing 0xA5 that may be the first half of the magic.
+        self._pending = self._pending[-1:]
+        return
+      buffer = self._pending[start:]
+      packet = self._parse_packet(buffer)
+      if packet is None:
+        # Incomplete packet, wait for more data.
+        self._pending = buffer
+        return
+      size, tags, records = packet
+      if size == 0:
+        # Checksum or version mismatch: resynchronise after this magic.
+        self.corrupted_packets += 1
+        self._pending = buffer[1:]
+        continue
+      self._pending = buffer[size:]
+      self.tags.update(tags)
+      for record in records:
+        yield record, self.tags.get(record[1], "tag%d" % record[1])
+
+  def _parse_packet(self, buffer):
+    if len(buffer) < _HEADER.size:
+      return None
+    _, version, num_tags, num_records, dropped, ticks_per_second = (
+        _HEADER.unpack_from(buffer))
+    if version != _VERSION:
+      return 0, None, None
+    offset = _HEADER.size
+    tags = {}
+    for _ in range(num_tags):
+      if len(buffer) < offset + 2:
+        return None
+      tag_id, length = buffer[offset], buffer[offset + 1]
+      if len(buffer) < offset + 2 + length:
+        return None
+      tags[tag_id] = buffer[offset + 2:offset + 2 + length].decode(
+          "ascii", errors="replace")
+      offset += 2 + length
+    end = offset + num_records * _RECORD.size
+    if len(buffer) < end + 1:
+      return None
+    if sum(buffer[2:end]) & 0xFF != buffer[end]:
+      return 0, None, None
+    records = [
+        _RECORD.unpack_from(buffer, offset + i * _RECORD.size)
+        for i in range(num_records)
+    ]
+    self.ticks_per_second = ticks_per_second
+    self.dropped += dropped
+    return end + 1, tags, records
+
+
+def _percentile(sorted_values, fraction):
+  index = min(len(sorted_values) - 1, int(fraction * len(sorted_values)))
+  return sorted_values[index]
+
+
+def _histogram(values_us):
+  """Returns power of two microsecond buckets as {upper_bound: count}."""
+  buckets = {}
+  for value in values_us:
+    bound = 1 << max(0, math.ceil(math.log2(max(value, 1))))
+    buckets[bound] = buckets.get(bound, 0) + 1
+  return dict(sorted(buckets.items()))
+
+
+def summarize(events, ticks_per_second):
+  """Computes latency statistics per event name."""
+  scale = 1e6 / ticks_per_second if ticks_per_second else 1.0
+  summary = {}
+  for name, ticks in events.items():
+    values = sorted(t * scale for t in ticks)
+    summary[name] = {
+        "count": len(values),
+        "mean_us": sum(values) / len(values),
+        "p50_us": _percentile(values, 0.5),
+        "p90_us": _percentile(values, 0.9),
+        "p99_us": _percentile(values, 0.99),
+        "max_us": values[-1],
+        "histogram_us": _histogram(values),
+    }
+  return summary
+
+
+def _print_summary(summary, ticks_per_second, dropped, corrupted):
+  unit = "us" if ticks_per_second else "ticks"
+  print("%-28s %7s %10s %10s %10s %10s" %
+        ("event", "count", "mean", "p50", "p99", "max") + " (%s)" % unit)
+  for name, stats in summary.items():
+    print("%-28s %7d %10.1f %10.1f %10.1f %10.1f" %
+          (name, stats["count"], stats["mean_us"], stats["p50_us"],
+           stats["p99_us"], stats["max_us"]))
+    peak = max(stats["histogram_us"].values())
+    for bound, count in stats["histogram_us"].items():
+      bar = "#" * max(1, round(40 * count / peak))
+      print("    <= %8d %s %s" % (bound, unit, bar + " " + str(count)))
+  print("dropped records: %d, corrupted packets: %d" % (dropped, corrupted))
+
+
+def main(_):
+  decoder = TraceDecoder()
+  events = {}
+  with open(_TRACE_FILE.value, "rb") as trace:
+    for (index, _, depth, ticks), tag in decoder.feed(trace.read()):
+      name = tag
+      if depth > 0 and _BY_OP_INDEX.value:
+        name += "#%d" % index
+      events.setdefault(name, []).append(ticks)
+
+  summary = summarize(events, decoder.ticks_per_second)
+  _print_summary(summary, decoder.ticks_per_second, decoder.dropped,
+                 decoder.corrupted_packets)
+  if _JSON_OUTPUT.value:
+    with open(_JSON_OUTPUT.value, "w") as report:
+      json.dump(
+          {
+              "ticks_per_second": decoder.ticks_per_second,
+              "dropped_records": decoder.dropped,
+              "corrupted_packets": decoder.corrupted_packets,
+              "events": summary,
+          },
+          report,
+          indent=2)
+
+
+if __name__ == "__main__":
+  app.run(main)
@@ -0,0 +1,440 @@
+"""
+Приёмник массового сбора датасета (режим BULK скетча 01_INMP441_collect_dataset).
+
+В режиме BULK устройство пишет звук непрерывно, выделяет фразы по энергии сигнала
+(01_INMP441_collect_dataset/Bulk_capture.h) и передаёт каждую фразу по TCP одним кадром:
+
+  смещение  размер  поле
+  0         4       "INMP"
+  4         1       версия протокола (1)
+  5         1       длина метки в байтах (не больше 32)
+  6         2       зарезервировано (0)
+  8         4       номер фразы в сеансе
+  12        4       частота дискретизации
+  16        4       кол-во отсчётов int16
+  20        4       CRC-32 (zlib.crc32) метки и отсчётов
+  24        ...     метка (имя папки датасета, например 0_Zero), затем отсчёты
+
+Все числа little-endian. Каждая фраза сохраняется в <dataset>/<метка>/ 16-битным моно WAV,
+таким же, как файлы, которые скачивает веб-страничка по кнопке DATASET. Кадр с неверной
+контрольной суммой пропускается, после испорченного заголовка приёмник ищет следующий "INMP"
+или "SMPL".
+
+По кнопке EXPORT устройство выгружает записи из хранилища во flash (Sample_store.h) в том же
+соединении: каждая запись - заголовок "SMPL" (32 байта: номер записи, время, кол-во отсчётов,
+уровень шума, усиление, частота, CRC-32), метка, дополненная нулями до 32 байт, и отсчёты.
+Записи сохраняются как <dataset>/<метка>/store_<номер>.wav, их описание дописывается в
+<dataset>/store_metadata.csv. Выгрузка начинается с запроса "EXPT", на который приёмник отвечает
+4 байтами - номером следующей нужной записи (хранится в <dataset>/.store_resume), поэтому
+оборванная выгрузка продолжается с места обрыва.
+
+В режиме признаков (список PCM / features на веб-страничке) вместо отсчётов фразы устройство
+передаёт её спектрограмму (Feature_frames.h) - кадр "FEAT": метка, номер, формат (1 - int16 log10
+энергии в Q12, 2 - минимум и диапазон int32 Q12, затем uint8 на значение), кол-во строк и столбцов,
+CRC-32. Спектрограмма сохраняется в <dataset>/<метка>/bulk_<сеанс>_<номер>.npy (float32, форма
+[99, 41, 1], как элемент X_spectrogram_train в INMP441-CNN-TFL.ipynb); load_feature_dataset()
+собирает их в массив [N, 99, 41, 1] и список меток. Спектрограмма посчитана алгоритмом устройства
+(см. device_spectrogram.py). Если запрошен и PCM, за кадром признаков следует обычный кадр фразы.
+
+Пример:
+  python3 dataset_receiver.py --dataset ./Dataset --port 5005
+"""
+
+import argparse
+import csv
+import os
+import re
+import socket
+import struct
+import time
+import wave
+import zlib
+from dataclasses import dataclass
+
+import numpy as np
+
+# Параметры должны совпадать с Bulk_capture.h.
+MAGIC = b'INMP'
+PROTOCOL_VERSION = 1
+HEADER = struct.Struct('<4sBBHIIII')                          # 24 байта.
+MAX_LABEL = 32
+MAX_SECONDS = 10                                              # Ограничение длины фразы.
+# Записи хранилища (Sample_store.h).
+STORE_MAGIC = b'SMPL'
+STORE_VERSION = 1
+STORE_HEADER = struct.Struct('<4sBBHIIIIHHI')                 # 32 байта.
+STORE_MAX_LABEL = 32
+STORE_RESUME_FILE = '.store_resume'
+EXPORT_REQUEST = b'EXPT'                                      # Запрос номера продолжения выгрузки.
+STORE_METADATA_FILE = 'store_metadata.csv'
+# Кадры признаков (Feature_frames.h).
+FEATURE_MAGIC = b'FEAT'
+FEATURE_VERSION = 1
+FEATURE_HEADER = struct.Struct('<4sBBBBIHHII')                # 24 байта.
+FEATURE_FORMAT_Q12, FEATURE_FORMAT_UINT8 = 1, 2
+FEATURE_FLAG_PCM = 1
+FEATURE_FRACTION_BITS = 12                                    # QUANT_FRACTION_BITS.
+FEATURE_UINT8_PREFIX = struct.Struct('<ii')                   # Минимум и диапазон в Q12.
+MAX_FEATURE_VALUES = 128 * 64
+LABEL_PATTERN = re.compile(r'^[0-9A-Za-z_-]+$')               # Метка - имя папки без путей.
+
+
+class FrameError(Exception):
+    """Кадр повреждён или не соответствует протоколу."""
+
+
+@dataclass
+class Frame:
+    label: str
+    sequence: int
+    sample_rate: int
+    pcm: bytes                                                # Отсчёты int16 little-endian.
+    stored: bool = False                                      # Запись хранилища (выгрузка EXPORT).
+    timestamp_ms: int = 0                                     # Описание записи хранилища.
+    noise_floor: float = 0.0
+    gain: float = 0.0
+
+
+@dataclass
+class FeatureFrame:
+    label: str
+    sequence: int
+    features: np.ndarray                                      # float32 [строки, столбцы, 1], log10 энергии.
+    format: int
+    with_pcm: bool = False
+
+
+def encode_features(label, sequence, features, fmt=FEATURE_FORMAT_Q12, with_pcm=False):
+    """Кадр признаков так, как его формирует feature_send() на устройстве.
+
+    features - массив [строки, столбцы] (или [строки, столбцы, 1]) log10 энергии.
+    """
+    features = np.asarray(features, dtype=np.float32)
+    rows, bins = features.shape[:2]
+    q12 = np.clip(np.rint(features.reshape(rows, bins) * (1 << FEATURE_FRACTION_BITS)),
+                  -32768, 32767).astype('<i2')
+    if fmt == FEATURE_FORMAT_Q12:
+        data = q12.tobytes()
+    else:
+        low = int(q12.min())
+        value_range = max(int(q12.max()) - low, 4)
+        scale_q24 = ((255 << 24) + value_range // 2) // value_range
+        values = np.minimum(((q12.astype(np.int64) - low) * scale_q24 + (1 << 23)) >> 24, 255)
+        data = FEATURE_UINT8_PREFIX.pack(low, value_range) + values.astype(np.uint8).tobytes()
+    label_bytes = label.encode('ascii')
+    crc = zlib.crc32(data, zlib.crc32(label_bytes))
+    header = FEATURE_HEADER.pack(FEATURE_MAGIC, FEATURE_VERSION, len(label_bytes), fmt,
+                                 FEATURE_FLAG_PCM if with_pcm else 0, sequence, rows, bins,
+                                 len(data), crc)
+    return header + label_bytes + data
+
+
+def decode_features(fmt, data, rows, bins):
+    """Данные кадра признаков -> float32 [строки, столбцы, 1] (log10 энергии)."""
+    unit = np.float32(1.0 / (1 << FEATURE_FRACTION_BITS))
+    if fmt == FEATURE_FORMAT_Q12:
+        if len(data) != rows * bins * 2:
+            raise FrameError(f'неверный размер признаков {len(data)}')
+        values = np.frombuffer(data, dtype='<i2').astype(np.float32) * unit
+    elif fmt == FEATURE_FORMAT_UINT8:
+        if len(data) != FEATURE_UINT8_PREFIX.size + rows * bins:
+            raise FrameError(f'неверный размер признаков {len(data)}')
+        low, value_range = FEATURE_UINT8_PREFIX.unpack_from(data)
+        quantized = np.frombuffer(data, dtype=np.uint8, offset=FEATURE_UINT8_PREFIX.size)
+        values = (low + quantized.astype(np.float32) * (value_range / 255.0)) * unit
+    else:
+        raise FrameError(f'неизвестный формат признаков {fmt}')
+    return values.astype(np.float32).reshape(rows, bins, 1)
+
+
+def encode_frame(label, sequence, pcm, sample_rate=16000):
+    """Кадр так, как его формирует bulk_frame_header() на устройстве."""
+    label_bytes = label.encode('ascii')
+    crc = zlib.crc32(pcm, zlib.crc32(label_bytes))
+    header = HEADER.pack(MAGIC, PROTOCOL_VERSION, len(label_bytes), 0, sequence,
+                         sample_rate, len(pcm) // 2, crc)
+    return header + label_bytes + pcm
+
+
+def encode_record(label, sequence, pcm, timestamp_ms=0, noise_floor=0.0, gain=32.0,
+                  sample_rate=16000):
+    """Запись хранилища так, как её хранит и выгружает store_append() на устройстве."""
+    label_bytes = label.encode('ascii')
+    crc = zlib.crc32(pcm, zlib.crc32(label_bytes))
+    header = STORE_HEADER.pack(STORE_MAGIC, STORE_VERSION, len(label_bytes), 0, sequence,
+                               timestamp_ms, len(pcm) // 2, round(noise_floor * 256),
+                               round(gain * 256), sample_rate, crc)
+    return header + label_bytes.ljust(STORE_MAX_LABEL, b'\0') + pcm
+
+
+def read_exactly(stream, size):
+    """Прочитать ровно size байт. Возвращает None, если поток закончился."""
+    data = b''
+    while len(data) < size:
+        chunk = stream.read(size - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+def read_frame(stream):
+    """Прочитать следующий кадр из потока (файловый объект, например socket.makefile('rb')).
+
+    Возвращает Frame, FeatureFrame, EXPORT_REQUEST (запрос выгрузки) или None в конце потока.
+    FrameError означает, что кадр пропущен:
+    следующий вызов продолжит чтение с начала следующего кадра.
+    """
+    # Поиск начала кадра: после потери синхронизации байты до "INMP", "SMPL" или "FEAT" пропускаются.
+    magic = read_exactly(stream, len(MAGIC))
+    if magic is None:
+        return None
+    while magic not in (MAGIC, STORE_MAGIC, FEATURE_MAGIC, EXPORT_REQUEST):
+        byte = stream.read(1)
+        if not byte:
+            return None
+        magic = magic[1:] + byte
+    if magic == STORE_MAGIC:
+        return read_record(stream)
+    if magic == FEATURE_MAGIC:
+        return read_features(stream)
+    if magic == EXPORT_REQUEST:
+        return EXPORT_REQUEST
+
+    rest = read_exactly(stream, HEADER.size - len(MAGIC))
+    if rest is None:
+        return None
+    _, version, label_size, _, sequence, sample_rate, count, crc = HEADER.unpack(magic + rest)
+    if version != PROTOCOL_VERSION:
+        raise FrameError(f'неизвестная версия протокола {version}')
+    if label_size == 0 or label_size > MAX_LABEL:
+        raise FrameError(f'неверная длина метки {label_size}')
+    if sample_rate == 0 or count > sample_rate * MAX_SECONDS:
+        raise FrameError(f'неверная длина фразы: {count} отсчётов при {sample_rate} Гц')
+
+    label_bytes = read_exactly(stream, label_size)
+    pcm = read_exactly(stream, count * 2)
+    if label_bytes is None or pcm is None:
+        return None
+    if zlib.crc32(pcm, zlib.crc32(label_bytes)) != crc:
+        raise FrameError(f'неверная контрольная сумма фразы {sequence}')
+    label = label_bytes.decode('ascii', errors='replace')
+    if not LABEL_PATTERN.match(label):
+        raise FrameError(f'недопустимая метка {label!r}')
+    return Frame(label, sequence, sample_rate, pcm)
+
+
+def read_record(stream):
+    """Прочитать запись хранилища после сигнатуры "SMPL" (см. read_frame)."""
+    rest = read_exactly(stream, STORE_HEADER.size - len(STORE_MAGIC))
+    if rest is None:
+        return None
+    (_, version, label_size, _, sequence, timestamp_ms, count, noise_floor, gain, sample_rate,
+     crc) = STORE_HEADER.unpack(STORE_MAGIC + rest)
+    if version != STORE_VERSION:
+        raise FrameError(f'неизвестная версия записи {version}')
+    if label_size == 0 or label_size > STORE_MAX_LABEL:
+        raise FrameError(f'неверная длина метки {label_size}')
+    if sample_rate == 0 or count > sample_rate * MAX_SECONDS:
+        raise FrameError(f'неверная длина записи: {count} отсчётов при {sample_rate} Гц')
+
+    label_block = read_exactly(stream, STORE_MAX_LABEL)
+    pcm = read_exactly(stream, count * 2)
+    if label_block is None or pcm is None:
+        return None
+    label_bytes = label_block[:label_size]
+    if zlib.crc32(pcm, zlib.crc32(label_bytes)) != crc:
+        raise FrameError(f'неверная контрольная сумма записи {sequence}')
+    label = label_bytes.decode('ascii', errors='replace')
+    if not LABEL_PATTERN.match(label):
+        raise FrameError(f'недопустимая метка {label!r}')
+    return Frame(label, sequence, sample_rate, pcm, stored=True, timestamp_ms=timestamp_ms,
+                 noise_floor=noise_floor / 256, gain=gain / 256)
+
+
+def read_features(stream):
+    """Прочитать кадр признаков после сигнатуры "FEAT" (см. read_frame)."""
+    rest = read_exactly(stream, FEATURE_HEADER.size - len(FEATURE_MAGIC))
+    if rest is None:
+        return None
+    (_, version, label_size, fmt, flags, sequence, rows, bins, size,
+     crc) = FEATURE_HEADER.unpack(FEATURE_MAGIC + rest)
+    if version != FEATURE_VERSION:
+        raise FrameError(f'неизвестная версия признаков {version}')
+    if label_size == 0 or label_size > MAX_LABEL:
+        raise FrameError(f'неверная длина метки {label_size}')
+    if rows * bins == 0 or rows * bins > MAX_FEATURE_VALUES or size > rows * bins * 2 + 8:
+        raise FrameError(f'неверный размер признаков: {rows} x {bins}, {size} байт')
+
+    label_bytes = read_exactly(stream, label_size)
+    data = read_exactly(stream, size)
+    if label_bytes is None or data is None:
+        return None
+    if zlib.crc32(data, zlib.crc32(label_bytes)) != crc:
+        raise FrameError(f'неверная контрольная сумма признаков {sequence}')
+    label = label_bytes.decode('ascii', errors='replace')
+    if not LABEL_PATTERN.match(label):
+        raise FrameError(f'недопустимая метка {label!r}')
+    return FeatureFrame(label, sequence, decode_features(fmt, data, rows, bins), fmt,
+                        with_pcm=bool(flags & FEATURE_FLAG_PCM))
+
+
+def write_features(dataset_dir, frame, session):
+    """Сохранить спектрограмму в <dataset_dir>/<метка>/bulk_<сеанс>_<номер>.npy и вернуть путь
+    (тот же номер, что у WAV фразы, если устройство передаёт и PCM)."""
+    label_dir = os.path.join(dataset_dir, frame.label)
+    os.makedirs(label_dir, exist_ok=True)
+    name = f'bulk_{session}_{frame.sequence:05d}'
+    path = os.path.join(label_dir, name + '.npy')
+    suffix = 1
+    while os.path.exists(path):
+        path = os.path.join(label_dir, f'{name}_{suffix}.npy')
+        suffix += 1
+    np.save(path, frame.features)
+    return path
+
+
+def load_feature_dataset(dataset_dir):
+    """Собрать сохранённые спектрограммы: (X [N, 99, 41, 1] float32, список меток),
+    как X_spectrogram_train и Y_train в INMP441-CNN-TFL.ipynb."""
+    features, labels = [], []
+    for label in sorted(os.listdir(dataset_dir)):
+        label_dir = os.path.join(dataset_dir, label)
+        if not os.path.isdir(label_dir):
+            continue
+        for file_name in sorted(f for f in os.listdir(label_dir) if f.endswith('.npy')):
+            features.append(np.load(os.path.join(label_dir, file_name)))
+            labels.append(label)
+    return np.array(features, dtype=np.float32), labels
+
+
+def write_wav(dataset_dir, frame, session):
+    """Сохранить фразу в <dataset_dir>/<метка>/bulk_<сеанс>_<номер>.wav (запись хранилища -
+    в store_<номер>.wav) и вернуть путь."""
+    label_dir = os.path.join(dataset_dir, frame.label)
+    os.makedirs(label_dir, exist_ok=True)
+    name = f'store_{frame.sequence:06d}' if frame.stored else f'bulk_{session}_{frame.sequence:05d}'
+    path = os.path.join(label_dir, name + '.wav')
+    suffix = 1
+    while os.path.exists(path):
+        path = os.path.join(label_dir, f'{name}_{suffix}.wav')
+        suffix += 1
+    with wave.open(path, 'wb') as wav:
+        wav.setnchannels(1)
+        wav.setsampwidth(2)
+        wav.setframerate(frame.sample_rate)
+        wav.writeframes(frame.pcm)
+    return path
+
+
+class DatasetReceiver:
+    """TCP-сервер, который сохраняет принятые фразы в папку датасета."""
+
+    def __init__(self, dataset_dir, host='0.0.0.0', port=5005, verbose=True):
+        self.dataset_dir = dataset_dir
+        self.verbose = verbose
+        self.server = socket.create_server((host, port))
+        self.port = self.server.getsockname()[1]
+        self.clips = 0                                        # Сохранённые фразы.
+        self.features = 0                                     # Сохранённые спектрограммы.
+        self.errors = 0                                       # Пропущенные кадры.
+        self.duplicates = 0                                   # Уже сохранённые записи хранилища.
+        self.paths = []
+        self.resume = self.load_resume()                      # Следующая нужная запись хранилища.
+
+    def load_resume(self):
+        try:
+            with open(os.path.join(self.dataset_dir, STORE_RESUME_FILE)) as f:
+                return int(f.read().strip() or 0)
+        except (FileNotFoundError, ValueError):
+            return 0
+
+    def save_record(self, frame, path):
+        """Дописать описание записи хранилища и запомнить, с какой записи продолжать выгрузку."""
+        metadata = os.path.join(self.dataset_dir, STORE_METADATA_FILE)
+        new_file = not os.path.exists(metadata)
+        with open(metadata, 'a', newline='') as f:
+            writer = csv.writer(f)
+            if new_file:
+                writer.writerow(['path', 'label', 'sequence', 'timestamp_ms', 'noise_floor', 'gain'])
+            writer.writerow([os.path.relpath(path, self.dataset_dir), frame.label, frame.sequence,
+                             frame.timestamp_ms, f'{frame.noise_floor:.2f}', f'{frame.gain:.2f}'])
+        self.resume = frame.sequence + 1
+        with open(os.path.join(self.dataset_dir, STORE_RESUME_FILE), 'w') as f:
+            f.write(f'{self.resume}\n')
+
+    def handle_connection(self, connection, address):
+        """Принимать кадры от устройства до закрытия соединения."""
+        session = time.strftime('%Y%m%d_%H%M%S')
+        if self.verbose:
+            print(f'Устройство {address[0]} подключено, сеанс {session}')
+        with connection, connection.makefile('rb') as stream:
+            while True:
+                try:
+                    frame = read_frame(stream)
+                except FrameError as error:
+                    self.errors += 1
+                    print(f'Кадр пропущен: {error}')
+                    continue
+                if frame is None:
+                    break
+                if frame is EXPORT_REQUEST:
+                    # Номер записи хранилища, с которой продолжить выгрузку.
+                    connection.sendall(struct.pack('<I', self.resume))
+                    continue
+                if isinstance(frame, FeatureFrame):
+                    path = write_features(self.dataset_dir, frame, session)
+                    self.features += 1
+                    self.paths.append(path)
+                    if self.verbose:
+                        print(f'{frame.sequence:5d} {frame.label:10s} -> {path}')
+                    continue
+                if frame.stored and frame.sequence < self.resume:
+                    self.duplicates += 1
+                    continue
+                path = write_wav(self.dataset_dir, frame, session)
+                if frame.stored:
+                    self.save_record(frame, path)
+                self.clips += 1
+                self.paths.append(path)
+                if self.verbose:
+                    print(f'{frame.sequence:5d} {frame.label:10s} -> {path}')
+        if self.verbose:
+            print(f'Устройство {address[0]} отключено: сохранено {self.clips} фраз и '
+                  f'{self.features} спектрограмм, пропущено {self.errors}')
+
+    def serve(self, max_connections=None):
+        """Обслуживать подключения по одному (max_connections=None - бесконечно)."""
+        served = 0
+        while max_connections is None or served < max_connections:
+            connection, address = self.server.accept()
+            self.handle_connection(connection, address)
+            served += 1
+
+    def close(self):
+        self.server.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--dataset', default='./Dataset', help='папка датасета с подпапками меток')
+    parser.add_argument('--host', default='0.0.0.0', help='адрес, на котором ждать устройство')
+    parser.add_argument('--port', type=int, default=5005, help='TCP-порт (как на веб-страничке)')
+    parser.add_argument('--connections', type=int, default=None,
+                        help='завершиться после стольких сеансов (по умолчанию - работать бесконечно)')
+    args = parser.parse_args()
+
+    receiver = DatasetReceiver(args.dataset, args.host, args.port)
+    print(f'Ожидание устройства на порту {receiver.port}, датасет: {args.dataset}')
+    try:
+        receiver.serve(args.connections)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        receiver.close()
+    print(f'Сохранено фраз: {receiver.clips}, спектрограмм: {receiver.features}, '
+          f'пропущено кадров: {receiver.errors}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,250 @@
+"""
+Проверка приёмника массового сбора датасета (dataset_receiver.py).
+
+Протокол проверяется на кадрах, собранных в Python. Петлевой тест заменяет ESP32
+программой 01_INMP441_collect_dataset/host/bulk_capture_loopback.cc: она проигрывает
+файлы Dataset как непрерывную запись через тот же Bulk_capture.h, что и скетч, а приёмник
+сохраняет вырезанные фразы во временную папку. Выгрузку хранилища (Sample_store.h) с обрывом
+и продолжением выполняет host/sample_store_test.cc, кадры признаков (Feature_frames.h) -
+host/feature_frames_test.cc. Петлевые тесты пропускаются, если нет g++.
+
+Пример:
+  python3 -m unittest dataset_receiver_test
+"""
+
+import glob
+import io
+import os
+import re
+import shutil
+import socket
+import subprocess
+import tempfile
+import threading
+import unittest
+import wave
+
+import numpy as np
+
+import dataset_receiver
+import device_spectrogram
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SKETCH_DIR = os.path.join(HERE, '..', '01_INMP441_collect_dataset')
+DATASET_DIR = os.path.join(HERE, 'Dataset')
+PCM = bytes(range(256)) * 8                                   # 1024 отсчёта.
+
+
+def synthetic_features():
+    """Спектрограмма Value() из host/feature_frames_test.cc, [99, 41, 1]."""
+    index = np.arange(99 * 41).reshape(99, 41, 1)
+    return (np.float32(-6.0) + np.float32(9.0) * ((index * 37 % 1000).astype(np.float32) /
+                                                   np.float32(1000.0))).astype(np.float32)
+
+
+class FrameTest(unittest.TestCase):
+
+    def test_round_trip(self):
+        stream = io.BytesIO(dataset_receiver.encode_frame('1_One', 7, PCM) +
+                            dataset_receiver.encode_frame('2_Two', 8, PCM[:64]))
+        first = dataset_receiver.read_frame(stream)
+        second = dataset_receiver.read_frame(stream)
+        self.assertEqual((first.label, first.sequence, first.sample_rate, first.pcm),
+                         ('1_One', 7, 16000, PCM))
+        self.assertEqual((second.label, second.sequence, second.pcm), ('2_Two', 8, PCM[:64]))
+        self.assertIsNone(dataset_receiver.read_frame(stream))
+
+    def test_bad_crc_skips_frame(self):
+        bad = bytearray(dataset_receiver.encode_frame('0_Zero', 0, PCM))
+        bad[-1] ^= 0xFF
+        stream = io.BytesIO(bytes(bad) + dataset_receiver.encode_frame('0_Zero', 1, PCM))
+        with self.assertRaises(dataset_receiver.FrameError):
+            dataset_receiver.read_frame(stream)
+        self.assertEqual(dataset_receiver.read_frame(stream).sequence, 1)
+
+    def test_resync_after_garbage(self):
+        stream = io.BytesIO(b'\x00INM\x01' + dataset_receiver.encode_frame('3_Three', 2, PCM))
+        self.assertEqual(dataset_receiver.read_frame(stream).label, '3_Three')
+
+    def test_label_must_be_folder_name(self):
+        stream = io.BytesIO(dataset_receiver.encode_frame('../x', 0, PCM))
+        with self.assertRaises(dataset_receiver.FrameError):
+            dataset_receiver.read_frame(stream)
+
+    def test_record_round_trip(self):
+        stream = io.BytesIO(b'garbage' + dataset_receiver.encode_record(
+            '4_Four', 12, PCM, timestamp_ms=5000, noise_floor=3.5, gain=32))
+        record = dataset_receiver.read_frame(stream)
+        self.assertEqual((record.label, record.sequence, record.pcm, record.stored),
+                         ('4_Four', 12, PCM, True))
+        self.assertEqual((record.timestamp_ms, record.noise_floor, record.gain), (5000, 3.5, 32.0))
+
+    def test_record_bad_crc(self):
+        bad = bytearray(dataset_receiver.encode_record('0_Zero', 0, PCM))
+        bad[-1] ^= 0xFF
+        with self.assertRaises(dataset_receiver.FrameError):
+            dataset_receiver.read_frame(io.BytesIO(bytes(bad)))
+
+    def test_features_round_trip(self):
+        wav = sorted(glob.glob(os.path.join(DATASET_DIR, '*', '*.wav')))[0]
+        spectrogram = device_spectrogram.get_spectrogram_device(device_spectrogram.read_wav(wav))
+        stream = io.BytesIO(
+            dataset_receiver.encode_features('1_One', 3, spectrogram) +
+            dataset_receiver.encode_features('1_One', 4, spectrogram,
+                                             dataset_receiver.FEATURE_FORMAT_UINT8, with_pcm=True) +
+            dataset_receiver.encode_frame('1_One', 4, PCM))
+        q12 = dataset_receiver.read_frame(stream)
+        uint8 = dataset_receiver.read_frame(stream)
+        self.assertEqual((q12.label, q12.sequence, q12.features.shape, q12.with_pcm),
+                         ('1_One', 3, (99, 41, 1), False))
+        self.assertLessEqual(np.abs(q12.features[..., 0] - spectrogram).max(), 0.5 / 4096 + 1e-6)
+        step = (spectrogram.max() - spectrogram.min()) / 255
+        self.assertTrue(uint8.with_pcm)
+        self.assertLessEqual(np.abs(uint8.features[..., 0] - spectrogram).max(), step / 2 + 1e-3)
+        self.assertEqual(dataset_receiver.read_frame(stream).pcm, PCM)
+
+    def test_features_bad_crc(self):
+        bad = bytearray(dataset_receiver.encode_features('0_Zero', 0, synthetic_features()))
+        bad[-1] ^= 0xFF
+        with self.assertRaises(dataset_receiver.FrameError):
+            dataset_receiver.read_frame(io.BytesIO(bytes(bad)))
+
+    def test_truncated_frame_is_end_of_stream(self):
+        frame = dataset_receiver.encode_frame('0_Zero', 0, PCM)
+        self.assertIsNone(dataset_receiver.read_frame(io.BytesIO(frame[:100])))
+
+
+class ReceiverTest(unittest.TestCase):
+
+    def setUp(self):
+        self.dataset = tempfile.mkdtemp()
+        self.receiver = dataset_receiver.DatasetReceiver(self.dataset, '127.0.0.1', 0,
+                                                         verbose=False)
+        self.thread = threading.Thread(target=self.receiver.serve, args=(1,))
+        self.thread.start()
+
+    def tearDown(self):
+        self.thread.join(timeout=60)
+        self.receiver.close()
+        shutil.rmtree(self.dataset)
+
+    def read_wav(self, path):
+        with wave.open(path, 'rb') as wav:
+            self.assertEqual((wav.getnchannels(), wav.getsampwidth(), wav.getframerate()),
+                             (1, 2, 16000))
+            return wav.readframes(wav.getnframes())
+
+    def test_saves_frames_by_label(self):
+        with socket.create_connection(('127.0.0.1', self.receiver.port)) as connection:
+            connection.sendall(dataset_receiver.encode_frame('0_Zero', 0, PCM) +
+                               dataset_receiver.encode_frame('1_One', 1, PCM))
+        self.thread.join(timeout=10)
+        self.assertEqual(self.receiver.clips, 2)
+        self.assertEqual(sorted(os.path.basename(os.path.dirname(p)) for p in self.receiver.paths),
+                         ['0_Zero', '1_One'])
+        self.assertEqual(self.read_wav(self.receiver.paths[0]), PCM)
+
+    @unittest.skipIf(shutil.which('g++') is None, 'нет g++ для сборки петлевой программы')
+    def test_loopback(self):
+        binary = os.path.join(self.dataset, 'bulk_capture_loopback')
+        subprocess.run(['g++', '-std=c++17', '-O2', '-I.', 'host/bulk_capture_loopback.cc',
+                        '-o', binary], cwd=SKETCH_DIR, check=True)
+        result = subprocess.run([binary, f'--port={self.receiver.port}',
+                                 f'--dataset={DATASET_DIR}'],
+                                capture_output=True, text=True, check=True, timeout=60)
+        self.thread.join(timeout=10)
+
+        clips, files = map(int, re.search(r'clips=(\d+) files=(\d+)', result.stdout).groups())
+        self.assertEqual(files, len(glob.glob(os.path.join(DATASET_DIR, '*', '*.wav'))))
+        self.assertEqual(clips, files)                        # Каждое слово - одна фраза.
+        self.assertEqual(self.receiver.clips, clips)
+        self.assertEqual(self.receiver.errors, 0)
+        for path in self.receiver.paths:
+            self.assertEqual(len(self.read_wav(path)), 16000 * 2)
+        # Фразы разложены по папкам меток так же, как исходные файлы.
+        for label in os.listdir(DATASET_DIR):
+            self.assertEqual(len(glob.glob(os.path.join(self.dataset, label, '*.wav'))),
+                             len(glob.glob(os.path.join(DATASET_DIR, label, '*.wav'))))
+
+
+    @unittest.skipIf(shutil.which('g++') is None, 'нет g++ для сборки программы')
+    def test_device_features(self):
+        binary = os.path.join(self.dataset, 'feature_frames_test')
+        subprocess.run(['g++', '-std=c++17', '-O2', '-I.', 'host/feature_frames_test.cc',
+                        '-o', binary], cwd=SKETCH_DIR, check=True)
+        subprocess.run([binary, f'--port={self.receiver.port}'], capture_output=True, text=True,
+                       check=True, timeout=60)
+        self.thread.join(timeout=10)
+        self.assertEqual((self.receiver.features, self.receiver.clips, self.receiver.errors),
+                         (2, 1, 0))
+        # Спектрограммы собираются в массив формы X_spectrogram_train.
+        x, labels = dataset_receiver.load_feature_dataset(self.dataset)
+        self.assertEqual((x.shape, x.dtype, labels), ((2, 99, 41, 1), np.float32, ['1_One'] * 2))
+        expected = synthetic_features()
+        errors = sorted(np.abs(features - expected).max() for features in x)
+        self.assertLessEqual(errors[0], 0.5 / 4096 + 1e-6)      # int16.
+        self.assertLessEqual(errors[1], 9.0 / 255 / 2 + 1e-3)   # uint8.
+        # PCM, запрошенный вместе с признаками, сохранён рядом под тем же номером.
+        wav = [p for p in self.receiver.paths if p.endswith('.wav')]
+        self.assertEqual(len(wav), 1)
+        self.assertTrue(os.path.exists(wav[0][:-len('.wav')] + '.npy'))
+
+
+class StoreExportTest(unittest.TestCase):
+
+    def setUp(self):
+        self.dataset = tempfile.mkdtemp()
+        self.receiver = dataset_receiver.DatasetReceiver(self.dataset, '127.0.0.1', 0,
+                                                         verbose=False)
+        self.thread = threading.Thread(target=self.receiver.serve, args=(2,))
+        self.thread.start()
+
+    def tearDown(self):
+        self.thread.join(timeout=60)
+        self.receiver.close()
+        shutil.rmtree(self.dataset)
+
+    def export(self, *records):
+        with socket.create_connection(('127.0.0.1', self.receiver.port)) as connection:
+            connection.sendall(dataset_receiver.EXPORT_REQUEST)
+            resume = int.from_bytes(connection.recv(4), 'little')
+            connection.sendall(b''.join(records))
+        return resume
+
+    def test_resume_skips_saved_records(self):
+        records = [dataset_receiver.encode_record('0_Zero', n, PCM, timestamp_ms=n) for n in range(4)]
+        self.assertEqual(self.export(*records[:2], records[2][:100]), 0)
+        self.assertEqual(self.export(*records), 2)
+        self.thread.join(timeout=10)
+        self.assertEqual((self.receiver.clips, self.receiver.duplicates, self.receiver.resume),
+                         (4, 2, 4))
+        with open(os.path.join(self.dataset, dataset_receiver.STORE_METADATA_FILE)) as f:
+            self.assertEqual(len(f.read().splitlines()), 5)
+        # Номер продолжения переживает перезапуск приёмника.
+        self.assertEqual(dataset_receiver.DatasetReceiver.load_resume(self.receiver), 4)
+
+    @unittest.skipIf(shutil.which('g++') is None, 'нет g++ для сборки петлевой программы')
+    def test_device_export(self):
+        binary = os.path.join(self.dataset, 'sample_store_test')
+        subprocess.run(['g++', '-std=c++17', '-O2', '-I.', 'host/sample_store_test.cc',
+                        '-o', binary], cwd=SKETCH_DIR, check=True)
+        result = subprocess.run([binary, f'--port={self.receiver.port}'],
+                                capture_output=True, text=True, check=True, timeout=60)
+        self.thread.join(timeout=10)
+
+        exported, stored = map(int, re.search(r'exported=(\d+) stored=(\d+)', result.stdout).groups())
+        self.assertEqual(exported, stored)
+        self.assertEqual(self.receiver.clips, stored)
+        # Оборванная запись отброшена по длине/CRC и получена заново во втором сеансе.
+        self.assertEqual(sorted(os.path.basename(p) for p in self.receiver.paths),
+                         [f'store_{n:06d}.wav' for n in range(stored)])
+        for path in self.receiver.paths:
+            self.assertEqual(len(self.read_wav(path)), 16000 * 2)
+
+    def read_wav(self, path):
+        with wave.open(path, 'rb') as wav:
+            return wav.readframes(wav.getnframes())
+
+
+if __name__ == '__main__':
+    unittest.main()
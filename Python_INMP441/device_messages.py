@@ -0,0 +1,116 @@
+"""
+Двоичный протокол сообщений между устройством и веб-страничкой (скетч 01_INMP441_collect_dataset).
+
+Формат описан в 01_INMP441_collect_dataset/Message_protocol.h. Каждое сообщение WebSocket
+содержит одно или несколько сообщений протокола подряд:
+
+  смещение  размер  поле
+  0         1       тип (MSG_*)
+  1         1       флаги (для MSG_CONTROL - ключ CTRL_*)
+  2         2       длина данных в байтах
+  4         ...     данные
+
+Все числа little-endian. Модуль позволяет разбирать сообщения устройства на компьютере
+(например, подключившись к ws://<ip>:81/) и формировать управляющие сообщения.
+
+Пример:
+  for message in decode_messages(data):
+      if message.type == MSG_STATS:
+          print(decode_stats(message))
+"""
+
+import struct
+from dataclasses import dataclass
+
+# Параметры должны совпадать с Message_protocol.h.
+HEADER = struct.Struct('<BBH')                                # 4 байта.
+MSG_CONTROL, MSG_JPEG, MSG_ROW, MSG_AUDIO, MSG_STATS = 1, 2, 3, 4, 5
+CTRL_DATASET, CTRL_BULK, CTRL_LIVE, CTRL_ACK, CTRL_EXPORT, CTRL_FEATURES = 1, 2, 3, 4, 5, 6
+CTRL_BULK_STATE, CTRL_BULK_COUNT, CTRL_STORE_COUNT, CTRL_EXPORT_STATE, CTRL_QUEUE = 16, 17, 18, 19, 20
+# Кадр аудиопотока (Audio_streaming.h).
+STREAM_FLAG_START, STREAM_FLAG_END = 1, 2
+STREAM_DECIMATION_SHIFT = 4
+
+
+class MessageError(Exception):
+    """Сообщение обрезано или не соответствует протоколу."""
+
+
+@dataclass
+class Message:
+    type: int
+    flags: int
+    payload: bytes
+
+
+@dataclass
+class Control:
+    key: int
+    value: int
+    strings: list
+
+
+@dataclass
+class Stats:
+    bytes_per_sec: int
+    max_latency_ms: int
+    dropped: int
+
+
+@dataclass
+class AudioFrame:
+    flags: int                                                # STREAM_FLAG_START / STREAM_FLAG_END.
+    decimation: int
+    sequence: int
+    offset: int                                               # Номер первого отсчёта от начала записи.
+    samples: bytes                                            # Отсчёты int16 little-endian.
+
+
+def decode_messages(data):
+    """Разобрать все сообщения протокола из одного сообщения WebSocket."""
+    messages = []
+    offset = 0
+    while offset < len(data):
+        if len(data) - offset < HEADER.size:
+            raise MessageError('обрезан заголовок сообщения')
+        message_type, flags, length = HEADER.unpack_from(data, offset)
+        start = offset + HEADER.size
+        if start + length > len(data):
+            raise MessageError(f'обрезано сообщение типа {message_type}')
+        messages.append(Message(message_type, flags, bytes(data[start:start + length])))
+        offset = start + length
+    return messages
+
+
+def decode_control(message):
+    """Ключ, значение и строки (для CTRL_BULK - метка и адрес приёмника, для CTRL_EXPORT - адрес) сообщения MSG_CONTROL."""
+    if message.type != MSG_CONTROL or len(message.payload) < 4:
+        raise MessageError('ожидалось сообщение MSG_CONTROL')
+    (value,) = struct.unpack_from('<i', message.payload)
+    tail = message.payload[4:]
+    strings = [s.decode('latin-1') for s in tail.split(b'\0')[:-1]] if tail else []
+    return Control(message.flags, value, strings)
+
+
+def decode_stats(message):
+    if message.type != MSG_STATS or len(message.payload) != 12:
+        raise MessageError('ожидалось сообщение MSG_STATS')
+    return Stats(*struct.unpack('<III', message.payload))
+
+
+def decode_audio(message):
+    if message.type != MSG_AUDIO or len(message.payload) < 8:
+        raise MessageError('ожидалось сообщение MSG_AUDIO')
+    sequence, offset = struct.unpack_from('<II', message.payload)
+    return AudioFrame(message.flags & 0x0F, message.flags >> STREAM_DECIMATION_SHIFT,
+                      sequence, offset, message.payload[8:])
+
+
+def encode_message(message_type, flags, payload):
+    return HEADER.pack(message_type, flags, len(payload)) + payload
+
+
+def encode_control(key, value, strings=()):
+    """Управляющее сообщение так, как его формирует send_control() на веб-страничке."""
+    payload = struct.pack('<i', value) + b''.join(s.encode('latin-1') + b'\0' for s in strings)
+    return encode_message(MSG_CONTROL, key, payload)
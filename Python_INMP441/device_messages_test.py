@@ -0,0 +1,102 @@
+"""
+Проверка разбора двоичного протокола сообщений (device_messages.py).
+
+Сообщения устройства формирует программа 01_INMP441_collect_dataset/host/message_protocol_dump.cc
+теми же функциями, что и скетч (Message_protocol.h, Audio_streaming.h); она же разбирает
+управляющие сообщения, сформированные в Python. Тесты с программой пропускаются, если нет g++.
+
+Пример:
+  python3 -m unittest device_messages_test
+"""
+
+import os
+import shutil
+import struct
+import subprocess
+import tempfile
+import unittest
+
+import device_messages as dm
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SKETCH_DIR = os.path.join(HERE, '..', '01_INMP441_collect_dataset')
+
+
+class DecodeTest(unittest.TestCase):
+
+    def test_several_messages(self):
+        data = dm.encode_control(dm.CTRL_BULK_COUNT, 3) + dm.encode_message(dm.MSG_ROW, 0, b'\x01\x02')
+        first, second = dm.decode_messages(data)
+        self.assertEqual(dm.decode_control(first), dm.Control(dm.CTRL_BULK_COUNT, 3, []))
+        self.assertEqual((second.type, second.payload), (dm.MSG_ROW, b'\x01\x02'))
+
+    def test_control_strings(self):
+        (message,) = dm.decode_messages(dm.encode_control(dm.CTRL_BULK, 1, ['0_Zero', '10.0.0.2:5005']))
+        self.assertEqual(dm.decode_control(message).strings, ['0_Zero', '10.0.0.2:5005'])
+
+    def test_truncated(self):
+        data = dm.encode_control(dm.CTRL_LIVE, 1)
+        for size in (2, len(data) - 1):
+            with self.assertRaises(dm.MessageError):
+                dm.decode_messages(data[:size])
+
+
+@unittest.skipIf(shutil.which('g++') is None, 'нет g++ для сборки программы')
+class DeviceTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.directory = tempfile.mkdtemp()
+        cls.binary = os.path.join(cls.directory, 'message_protocol_dump')
+        subprocess.run(['g++', '-std=c++17', '-O2', '-I.', 'host/message_protocol_dump.cc',
+                        '-o', cls.binary], cwd=SKETCH_DIR, check=True)
+        output = subprocess.run([cls.binary], capture_output=True, text=True, check=True).stdout
+        cls.messages = {}
+        for line in output.splitlines():
+            name, _, value = line.partition(' ')
+            if not name.startswith('overhead') and name != 'encoder':
+                cls.messages[name] = bytes.fromhex(value)
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.directory)
+
+    def decode_one(self, name):
+        (message,) = dm.decode_messages(self.messages[name])
+        return message
+
+    def test_control(self):
+        self.assertEqual(dm.decode_control(self.decode_one('control')),
+                         dm.Control(dm.CTRL_BULK_COUNT, 12345, []))
+        self.assertEqual(dm.decode_control(self.decode_one('negative')).value, -1)
+
+    def test_stats(self):
+        self.assertEqual(dm.decode_stats(self.decode_one('stats')), dm.Stats(32768, 17, 3))
+
+    def test_row(self):
+        message = self.decode_one('row')
+        self.assertEqual((message.type, message.payload), (dm.MSG_ROW, bytes(i * 6 for i in range(41))))
+
+    def test_audio(self):
+        samples = struct.pack('<8h', *(i * 100 - 12800 for i in range(8)))
+        frame = dm.decode_audio(self.decode_one('audio'))
+        self.assertEqual(frame, dm.AudioFrame(dm.STREAM_FLAG_START, 1, 0, 0, samples))
+        frame = dm.decode_audio(self.decode_one('decimated'))
+        self.assertEqual((frame.flags, frame.decimation, frame.sequence, frame.offset), (0, 2, 1, 8))
+        self.assertEqual(struct.unpack('<4h', frame.samples), (-12750, -12550, -12350, -12150))
+        frame = dm.decode_audio(self.decode_one('end'))
+        self.assertEqual((frame.flags, frame.offset, frame.samples), (dm.STREAM_FLAG_END, 16, b''))
+
+    def test_batch(self):
+        control, stats = dm.decode_messages(self.messages['batch'])
+        self.assertEqual((control.type, stats.type), (dm.MSG_CONTROL, dm.MSG_STATS))
+
+    def test_device_parses_python_control(self):
+        data = dm.encode_control(dm.CTRL_BULK, 1, ['3_Three', '192.168.1.5:5005'])
+        result = subprocess.run([self.binary, '--parse', data.hex()], capture_output=True, text=True,
+                                check=True).stdout.strip()
+        self.assertEqual(result, 'key=2 value=1 strings=3_Three|192.168.1.5:5005')
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,112 @@
+"""
+Построение спектрограммы так же, как это делает ESP32 (02_INMP441_TFL_CNN/Audio_processing.h).
+
+Ноутбук INMP441-CNN-TFL.ipynb строит спектрограмму средствами TensorFlow, а на устройстве
+она считается через KISS FFT. Этот скрипт повторяет алгоритм устройства на numpy
+(окно 320 точек, шаг 160, усреднение по 4 бинам, log10), чтобы на компьютере получить
+ровно те входные данные, которые модель видит на ESP32. Результат сохраняется в .npy
+в форме входного тензора модели [1, 99, 41, 1] (float32) и используется как эталонный
+вход для послойного сравнения (tensorflow/lite/micro/tools/layer_by_layer.cc и
+layer_by_layer_debugger.py).
+
+Пример:
+  python3 device_spectrogram.py "Dataset/1_One/ONE (1).wav" one_1.npy
+  python3 device_spectrogram.py --dataset ./Dataset --output_dir ./device_spectrograms
+"""
+
+import argparse
+import os
+import wave
+
+import numpy as np
+
+# Параметры должны совпадать с Audio_processing.h.
+FFT_N = 320                                                   # Размер окна FFT.
+FFT_STEP = 160                                                # Шаг между соседними окнами.
+POOLING_SIZE = 4                                              # Кол-во усредняемых частотных бинов.
+SPECTRUM_BINS = FFT_N // 2 + 1                                # 161 бин до усреднения.
+POOLED_BINS = (SPECTRUM_BINS + POOLING_SIZE - 1) // POOLING_SIZE  # 41 бин после усреднения.
+EPSILON = np.float32(1e-6)
+AUDIO_LENGTH = 16000                                          # Одна секунда при 16 kHz.
+
+
+def read_wav(file_path):
+    """Прочитать 16-битный моно WAV (формат, который сохраняет 01_INMP441_collect_dataset)."""
+    with wave.open(file_path, 'rb') as wav:
+        if wav.getsampwidth() != 2 or wav.getnchannels() != 1:
+            raise ValueError(f'{file_path}: ожидается 16-битный моно WAV')
+        pcm = np.frombuffer(wav.readframes(wav.getnframes()), dtype='<i2')
+    # Дополнить нулями или обрезать до одной секунды, как буфер wav_buffer на устройстве.
+    pcm16 = np.zeros(AUDIO_LENGTH, dtype=np.int16)
+    pcm16[:min(len(pcm), AUDIO_LENGTH)] = pcm[:AUDIO_LENGTH]
+    return pcm16
+
+
+def hamming_window():
+    """Коэффициенты окна из init_hamming_window()."""
+    i = np.arange(FFT_N, dtype=np.float32)
+    return (0.5 - 0.5 * np.cos(np.float32(2.0 * np.pi / FFT_N) * (i + 0.5))).astype(np.float32)
+
+
+def get_spectrogram_device(pcm16):
+    """Повторяет get_spectrogram(): возвращает спектрограмму [кадры, 41] (float32)."""
+    samples = pcm16.astype(np.float32)
+    # Нормализация: вычитаем среднее и делим на максимальное абсолютное отклонение.
+    mean = np.float32(samples.mean(dtype=np.float32))
+    max_val = np.float32(np.max(np.abs(samples - mean)))
+    if max_val < EPSILON:
+        max_val = np.float32(1.0)
+
+    frames = 1 + (len(samples) - FFT_N) // FFT_STEP
+    window = hamming_window()
+    spectrogram = np.zeros((frames, POOLED_BINS), dtype=np.float32)
+    for frame in range(frames):
+        start = frame * FFT_STEP
+        fft_in = (samples[start:start + FFT_N] - mean) / max_val * window
+        fft_out = np.fft.rfft(fft_in)
+        energy = (fft_out.real ** 2 + fft_out.imag ** 2).astype(np.float32)
+        # Усреднение групп по POOLING_SIZE бинов (последняя группа - один бин).
+        for b in range(POOLED_BINS):
+            group = energy[b * POOLING_SIZE:(b + 1) * POOLING_SIZE]
+            spectrogram[frame, b] = np.log10(group.mean(dtype=np.float32) + EPSILON)
+    return spectrogram
+
+
+def wav_to_model_input(file_path):
+    """Спектрограмма WAV-файла в форме входного тензора модели [1, 99, 41, 1]."""
+    spectrogram = get_spectrogram_device(read_wav(file_path))
+    return spectrogram.reshape(1, spectrogram.shape[0], POOLED_BINS, 1)
+
+
+def convert_dataset(dataset_path, output_dir):
+    """Сохранить спектрограммы всех файлов датасета в output_dir/<label>/<name>.npy."""
+    for label in sorted(os.listdir(dataset_path)):
+        folder_path = os.path.join(dataset_path, label)
+        if not os.path.isdir(folder_path):
+            continue
+        os.makedirs(os.path.join(output_dir, label), exist_ok=True)
+        for file_name in sorted(f for f in os.listdir(folder_path) if f.endswith('.wav')):
+            output_path = os.path.join(output_dir, label, os.path.splitext(file_name)[0] + '.npy')
+            np.save(output_path, wav_to_model_input(os.path.join(folder_path, file_name)))
+            print(output_path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('wav_file', nargs='?', help='WAV-файл (16 kHz, 16 бит, моно).')
+    parser.add_argument('output_file', nargs='?', help='Путь к .npy с входом модели.')
+    parser.add_argument('--dataset', help='Папка датасета (<label>/*.wav) для пакетной обработки.')
+    parser.add_argument('--output_dir', default='device_spectrograms',
+                        help='Куда сохранять спектрограммы датасета.')
+    args = parser.parse_args()
+
+    if args.dataset:
+        convert_dataset(args.dataset, args.output_dir)
+    elif args.wav_file and args.output_file:
+        np.save(args.output_file, wav_to_model_input(args.wav_file))
+    else:
+        parser.error('укажите wav_file и output_file или --dataset')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,74 @@
+"""
+Сборка веб-странички скетча 01_INMP441_collect_dataset в сжатый заголовок HomePage.h.
+
+Исходный текст странички хранится в 01_INMP441_collect_dataset/HomePage.html. Скрипт сжимает
+его gzip и записывает HomePage.h с массивом байт во flash (PROGMEM) и ETag (CRC-32 сжатых байт).
+Веб-сервер отдаёт массив как есть с Content-Encoding: gzip, без копирования в оперативную память.
+
+Сжатие воспроизводимое (mtime = 0): одна и та же страничка всегда даёт тот же HomePage.h и тот же
+ETag. После каждого изменения HomePage.html скрипт нужно запустить заново.
+
+Пример:
+  python3 homepage_gzip.py
+"""
+
+import argparse
+import gzip
+import os
+import zlib
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SKETCH_DIR = os.path.join(HERE, '..', '01_INMP441_collect_dataset')
+BYTES_PER_LINE = 16
+
+
+def compress(html):
+    """Сжатые байты и ETag (в кавычках, как в заголовке HTTP)."""
+    data = gzip.compress(html, compresslevel=9, mtime=0)
+    return data, '"%08x"' % zlib.crc32(data)
+
+
+def render_header(html):
+    """Текст HomePage.h для исходного текста странички html (bytes)."""
+    data, etag = compress(html)
+    lines = [
+        '// Веб-страничка, сжатая gzip (сгенерировано Python_INMP441/homepage_gzip.py из HomePage.html).',
+        '// Не редактировать: изменить HomePage.html и запустить скрипт заново.',
+        '// Исходный размер %d байт, сжатый %d байт.' % (len(html), len(data)),
+        '',
+        '#ifndef HOMEPAGE_H',
+        '#define HOMEPAGE_H',
+        '',
+        '#include <stdint.h>',
+        '#include <stddef.h>',
+        '',
+        '// ETag странички: браузер присылает его в If-None-Match, и сервер отвечает 304 без тела.',
+        '#define HOMEPAGE_ETAG "%s"' % etag.replace('"', '\\"'),
+        '',
+        'const size_t HOMEPAGE_GZ_SIZE = %d;' % len(data),
+        'const uint8_t HOMEPAGE_GZ[] PROGMEM = {',
+    ]
+    for i in range(0, len(data), BYTES_PER_LINE):
+        lines.append('  ' + ', '.join('0x%02x' % b for b in data[i:i + BYTES_PER_LINE]) + ',')
+    lines += ['};', '', '#endif  // HOMEPAGE_H', '']
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--html', default=os.path.join(SKETCH_DIR, 'HomePage.html'))
+    parser.add_argument('--header', default=os.path.join(SKETCH_DIR, 'HomePage.h'))
+    args = parser.parse_args()
+
+    with open(args.html, 'rb') as f:
+        html = f.read()
+    header = render_header(html)
+    with open(args.header, 'w', newline='\n', encoding='utf-8') as f:
+        f.write(header)
+    data, etag = compress(html)
+    print(f'{os.path.normpath(args.header)}: {len(html)} -> {len(data)} bytes, ETag {etag}')
+
+
+if __name__ == '__main__':
+    main()
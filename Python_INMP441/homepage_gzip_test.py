@@ -0,0 +1,58 @@
+"""
+Проверка сжатой веб-странички скетча 01_INMP441_collect_dataset (homepage_gzip.py).
+
+HomePage.h должен совпадать с тем, что генерирует скрипт из HomePage.html. Программа
+01_INMP441_collect_dataset/host/homepage_dump.cc выводит байты ответа на запрос "/" так,
+как они скомпилированы в скетч; они должны распаковываться в HomePage.html. Тест с программой
+пропускается, если нет g++.
+
+Пример:
+  python3 -m unittest homepage_gzip_test
+"""
+
+import gzip
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+import zlib
+
+import homepage_gzip
+
+HTML_PATH = os.path.join(homepage_gzip.SKETCH_DIR, 'HomePage.html')
+HEADER_PATH = os.path.join(homepage_gzip.SKETCH_DIR, 'HomePage.h')
+
+
+class HomePageTest(unittest.TestCase):
+
+    def setUp(self):
+        with open(HTML_PATH, 'rb') as f:
+            self.html = f.read()
+
+    def test_header_is_up_to_date(self):
+        with open(HEADER_PATH, encoding='utf-8') as f:
+            self.assertEqual(f.read(), homepage_gzip.render_header(self.html),
+                             'HomePage.h устарел: запустите python3 homepage_gzip.py')
+
+    def test_compression_is_reproducible(self):
+        first, etag = homepage_gzip.compress(self.html)
+        self.assertEqual(homepage_gzip.compress(self.html), (first, etag))
+        self.assertEqual(gzip.decompress(first), self.html)
+        self.assertLess(len(first), len(self.html) // 2)
+
+    @unittest.skipIf(shutil.which('g++') is None, 'нет g++ для сборки программы')
+    def test_served_bytes(self):
+        with tempfile.TemporaryDirectory() as directory:
+            binary = os.path.join(directory, 'homepage_dump')
+            subprocess.run(['g++', '-std=c++17', '-O2', '-I.', 'host/homepage_dump.cc',
+                            '-o', binary], cwd=homepage_gzip.SKETCH_DIR, check=True)
+            body = subprocess.run([binary], capture_output=True, check=True).stdout
+            etag = subprocess.run([binary, '--etag'], capture_output=True, text=True,
+                                  check=True).stdout.strip()
+        self.assertEqual(gzip.decompress(body), self.html)
+        self.assertEqual(etag, '"%08x"' % zlib.crc32(body))
+
+
+if __name__ == '__main__':
+    unittest.main()